@@ -13,6 +13,11 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
 #include <netinet/in.h>
 
 #include "config.h"
@@ -64,33 +69,348 @@ int wrapper_features_selector[IPV6CALC_DB_FEATURE_NUM_MAX + 1][IPV6CALC_DB_PRIO_
 unsigned int wrapper_source_priority_selector[IPV6CALC_DB_SOURCE_MAX + 1];
 int wrapper_source_priority_selector_by_option = -1; // -1: uninitialized, 0: initialized, > 0: touched by option
 
+int libipv6calc_db_wrapper_cache_size = IPV6CALC_DB_CACHE_SIZE_DEFAULT; // entries per cache, 0: disabled
+
+int libipv6calc_db_wrapper_preload = 0; // 1: Berkeley DB data is loaded into memory during init
+
+int libipv6calc_db_wrapper_init_eager = 0; // 1: database sources are initialized during init, 0: on first use
+
+static int wrapper_sources_state = 0; // 0: not initialized, 1: initialized, 2: initialization failed
+static const char *wrapper_init_prefix_string = "";
+
+static int libipv6calc_db_wrapper_sources_init(void);
+static int libipv6calc_db_wrapper_sources_check(void);
+static int libipv6calc_db_wrapper_country_code_by_addr_range(char *string, const int length, const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr, ipv6calc_ipaddr_range *rangep);
+static char *libipv6calc_db_wrapper_as_text_by_addr_range(const ipv6calc_ipaddr *ipaddrp, ipv6calc_ipaddr_range *rangep);
+
+// initialize database sources on first use, return given value in case of failed initialization
+//  not thread-safe, libipv6calc_db_wrapper_ctx_init initializes database sources before threads are started
+#define IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(retval) \
+	if (libipv6calc_db_wrapper_sources_check() != 0) { \
+		return(retval); \
+	};
+
 
 /*
- * function initialise the main wrapper
+ * range cache
  *
- * in : (nothing)
- * out: 0=ok, 1=error
+ * database results are constant over the address range of the matched row, so each
+ * (type, protocol) has a bounded direct-mapped table of (range -> value), the slot is
+ * selected by a hash of the /24 (IPv4) or /48 (IPv6) of the address, a hit requires
+ * the address inside the stored range, a store replaces the slot content
+ *
+ * caches are part of the lookup context, the non-reentrant functions use the context bound
+ * to the calling thread (libipv6calc_db_wrapper_ctx_bind) or the default context
  */
-int libipv6calc_db_wrapper_init(const char *prefix_string) {
-	int result = 0, f, p, s, j;
+static s_ipv6calc_db_wrapper_ctx wrapper_ctx_default;
+static __thread s_ipv6calc_db_wrapper_ctx *wrapper_ctx_bound = NULL;
 
-#if defined SUPPORT_GEOIP || defined SUPPORT_IP2LOCATION || defined SUPPORT_DBIP || defined SUPPORT_EXTERNAL || defined SUPPORT_BUILTIN
-	int r;
+#define IPV6CALC_DB_WRAPPER_CTX_DEFAULT ((wrapper_ctx_bound != NULL) ? wrapper_ctx_bound : &wrapper_ctx_default)
+
+static const char *wrapper_cache_type_name[IPV6CALC_DB_CACHE_MAX] = { "Registry", "CountryCode", "AS" };
+
+
+/*
+ * compare address with address of range
+ * ret: <0: addr < range_addr, 0: equal, >0: addr > range_addr
+ */
+static int libipv6calc_db_wrapper_cache_cmp(const uint32_t *addr, const uint32_t *range_addr) {
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		if (addr[i] != range_addr[i]) {
+			return((addr[i] < range_addr[i]) ? -1 : 1);
+		};
+	};
+
+	return(0);
+};
+
+
+/*
+ * get slot of range cache for address
+ * ret: slot number
+ */
+static unsigned int libipv6calc_db_wrapper_cache_slot(const int proto, const uint32_t *addr) {
+	uint32_t h;
+
+	if (proto == IPV6CALC_PROTO_IPV4) {
+		h = addr[0] >> 8;
+	} else {
+		h = addr[0] ^ ((addr[1] >> 16) * 0x9e3779b1);
+	};
+
+	return((h * 0x9e3779b1) % (unsigned int) libipv6calc_db_wrapper_cache_size);
+};
+
+
+/*
+ * lookup value in range cache
+ *
+ * in : ctx = lookup context
+ * in : type = IPV6CALC_DB_CACHE_*
+ * in : ipaddrp = IP address
+ * out: *value_ptr = cached value
+ * out: *rangep = range of cached value (skipped if NULL)
+ * ret: 1 = hit, 0 = miss (or cache disabled)
+ */
+static int libipv6calc_db_wrapper_cache_lookup(s_ipv6calc_db_wrapper_ctx *ctx, const int type, const ipv6calc_ipaddr *ipaddrp, uint32_t *value_ptr, ipv6calc_ipaddr_range *rangep) {
+	s_ipv6calc_db_wrapper_cache *cachep;
+	s_ipv6calc_db_wrapper_cache_entry *entryp;
+
+	if ((libipv6calc_db_wrapper_cache_size == 0) || (ctx->cache_disabled != 0)) {
+		return(0);
+	};
+
+	cachep = &ctx->cache[type][(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? IPV6CALC_DB_CACHE_PROTO_IPV4 : IPV6CALC_DB_CACHE_PROTO_IPV6];
+
+	if (cachep->entry != NULL) {
+		entryp = &cachep->entry[libipv6calc_db_wrapper_cache_slot(ipaddrp->proto, ipaddrp->addr)];
+
+		if ((entryp->range.flag_valid == 1)
+		    && (libipv6calc_db_wrapper_cache_cmp(ipaddrp->addr, entryp->range.first) >= 0)
+		    && (libipv6calc_db_wrapper_cache_cmp(ipaddrp->addr, entryp->range.last) <= 0)
+		) {
+			*value_ptr = entryp->value;
+			if (rangep != NULL) {
+				*rangep = entryp->range;
+			};
+			cachep->hit++;
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Cache hit: type=%d addr=%08x%08x%08x%08x value=%u", type, ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], *value_ptr);
+			return(1);
+		};
+	};
+
+	cachep->miss++;
+	return(0);
+};
+
+
+/*
+ * store value for range in range cache
+ *
+ * in : ctx = lookup context
+ * in : type = IPV6CALC_DB_CACHE_*
+ * in : ipaddrp = IP address the value was retrieved for (selects the slot)
+ * in : rangep = range with constant value (containing the address)
+ * in : value = value to store
+ */
+static void libipv6calc_db_wrapper_cache_store(s_ipv6calc_db_wrapper_ctx *ctx, const int type, const ipv6calc_ipaddr *ipaddrp, const ipv6calc_ipaddr_range *rangep, const uint32_t value) {
+	s_ipv6calc_db_wrapper_cache *cachep;
+	s_ipv6calc_db_wrapper_cache_entry *entryp;
+
+	if ((libipv6calc_db_wrapper_cache_size == 0) || (ctx->cache_disabled != 0) || (rangep->flag_valid != 1)) {
+		return;
+	};
+
+	cachep = &ctx->cache[type][(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? IPV6CALC_DB_CACHE_PROTO_IPV4 : IPV6CALC_DB_CACHE_PROTO_IPV6];
+
+	if (cachep->entry == NULL) {
+		cachep->entry = calloc(libipv6calc_db_wrapper_cache_size, sizeof(s_ipv6calc_db_wrapper_cache_entry));
+		if (cachep->entry == NULL) {
+			ERRORPRINT_WA("cannot allocate memory for database cache, disable cache: %d entries", libipv6calc_db_wrapper_cache_size);
+			ctx->cache_disabled = 1;
+			return;
+		};
+	};
+
+	entryp = &cachep->entry[libipv6calc_db_wrapper_cache_slot(ipaddrp->proto, ipaddrp->addr)];
+
+	if (entryp->range.flag_valid == 0) {
+		cachep->entries++;
+	};
+
+	entryp->range = *rangep;
+	entryp->value = value;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Cache store: type=%d first=%08x%08x%08x%08x last=%08x%08x%08x%08x value=%u", type, rangep->first[0], rangep->first[1], rangep->first[2], rangep->first[3], rangep->last[0], rangep->last[1], rangep->last[2], rangep->last[3], value);
+};
+
+
+/*
+ * reduce range to intersection with another range (both containing the same address)
+ *
+ * mod: *rangep = range (flag_valid=0 if one of both is not valid)
+ * in : otherp = other range
+ */
+static void libipv6calc_db_wrapper_range_intersect(ipv6calc_ipaddr_range *rangep, const ipv6calc_ipaddr_range *otherp) {
+	if ((rangep->flag_valid != 1) || (otherp->flag_valid != 1)) {
+		rangep->flag_valid = 0;
+		return;
+	};
+
+	if (libipv6calc_db_wrapper_cache_cmp(otherp->first, rangep->first) > 0) {
+		memcpy(rangep->first, otherp->first, sizeof(rangep->first));
+	};
+
+	if (libipv6calc_db_wrapper_cache_cmp(otherp->last, rangep->last) < 0) {
+		memcpy(rangep->last, otherp->last, sizeof(rangep->last));
+	};
+};
+
+
+/*
+ * free range cache
+ *
+ * in : ctx = lookup context
+ */
+static void libipv6calc_db_wrapper_cache_free(s_ipv6calc_db_wrapper_ctx *ctx) {
+	int t, p;
+
+	for (t = 0; t < IPV6CALC_DB_CACHE_MAX; t++) {
+		for (p = 0; p < IPV6CALC_DB_CACHE_PROTO_MAX; p++) {
+			if (ctx->cache[t][p].entry != NULL) {
+				free(ctx->cache[t][p].entry);
+				ctx->cache[t][p].entry = NULL;
+			};
+			ctx->cache[t][p].entries = 0;
+		};
+	};
+};
+
+
+/*
+ * initialize lookup context for reentrant lookups (libipv6calc_db_wrapper_*_r)
+ *  one context per thread, database sources, lazily opened databases and lookup structures are initialized here,
+ *  so call after libipv6calc_db_wrapper_init and before starting threads
+ *
+ * in : ctx = lookup context
+ * ret: 0 = ok, 1 = initialization of database sources failed
+ */
+int libipv6calc_db_wrapper_ctx_init(s_ipv6calc_db_wrapper_ctx *ctx) {
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
+
+	memset(ctx, 0, sizeof(s_ipv6calc_db_wrapper_ctx));
+
+	// database sources are initialized here at latest, lookups of threads find them ready
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
+
+#ifdef SUPPORT_DBIP
+	if (wrapper_DBIP_status == 1) {
+		libipv6calc_db_wrapper_DBIP_wrapper_prepare();
+	};
 #endif
-	s = strlen(prefix_string); // make compiler happy (avoid unused "...")
 
+#ifdef SUPPORT_EXTERNAL
+	if (wrapper_External_status == 1) {
+		libipv6calc_db_wrapper_External_wrapper_prepare();
+	};
+#endif
+
+#ifdef SUPPORT_BUILTIN
+	if (wrapper_BuiltIn_status == 1) {
+		libipv6calc_db_wrapper_BuiltIn_wrapper_prepare();
+	};
+#endif
+
+	return(0);
+};
+
+
+/*
+ * check whether reentrant lookups (libipv6calc_db_wrapper_*_r) can run concurrently
+ *  GeoIP and IP2Location libraries keep lookup state in their shared handles
+ *
+ * in : (nothing)
+ * ret: 1 = concurrent lookups supported, 0 = active source does not support concurrent lookups
+ */
+int libipv6calc_db_wrapper_ctx_threadsafe(void) {
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(0)
+
+	if ((wrapper_GeoIP_status == 1) || (wrapper_IP2Location_status == 1)) {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "GeoIP or IP2Location active, concurrent lookups not supported");
+		return(0);
+	};
+
+	return(1);
+};
+
+
+/*
+ * cleanup lookup context (frees range cache)
+ *
+ * in : ctx = lookup context
+ */
+void libipv6calc_db_wrapper_ctx_cleanup(s_ipv6calc_db_wrapper_ctx *ctx) {
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
-	// clear feature selector
-	for (f = IPV6CALC_DB_FEATURE_NUM_MIN; f <= IPV6CALC_DB_FEATURE_NUM_MAX; f++) {
-		for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
-			wrapper_features_selector[f][p] = 0;
-		};
+	libipv6calc_db_wrapper_cache_free(ctx);
+
+	memset(ctx, 0, sizeof(s_ipv6calc_db_wrapper_ctx));
+};
+
+
+/*
+ * bind lookup context to calling thread, non-reentrant functions use it afterwards
+ *
+ * in : ctx = lookup context (initialized), NULL: unbind (use default context again)
+ */
+void libipv6calc_db_wrapper_ctx_bind(s_ipv6calc_db_wrapper_ctx *ctx) {
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: %s", (ctx == NULL) ? "unbind" : "bind");
+
+	wrapper_ctx_bound = ctx;
+};
+
+
+/*
+ * print range cache and batch lookup statistics of lookup context (to stderr)
+ *
+ * in : ctx = lookup context
+ * in : prefix_string = prefix of each line
+ */
+void libipv6calc_db_wrapper_ctx_print_cache_statistics(const s_ipv6calc_db_wrapper_ctx *ctx, const char *prefix_string) {
+	int t, p;
+
+	if ((ctx->batch_lookup > 0) || (ctx->batch_reused > 0)) {
+		fprintf(stderr, "%sDB batch lookup: lookups=%lu reused=%lu\n", prefix_string, ctx->batch_lookup, ctx->batch_reused);
 	};
 
-	for (s = 0; s <= IPV6CALC_DB_SOURCE_MAX; s++) {
-		wrapper_features_by_source[s] = 0;
+	if ((libipv6calc_db_wrapper_cache_size == 0) || (ctx->cache_disabled != 0)) {
+		fprintf(stderr, "%sDB cache disabled\n", prefix_string);
+		return;
+	};
+
+	for (t = 0; t < IPV6CALC_DB_CACHE_MAX; t++) {
+		for (p = 0; p < IPV6CALC_DB_CACHE_PROTO_MAX; p++) {
+			if ((ctx->cache[t][p].hit == 0) && (ctx->cache[t][p].miss == 0)) {
+				continue;
+			};
+
+			fprintf(stderr, "%sDB cache %-11s %s: size=%d entries=%d hits=%lu misses=%lu\n"
+				, prefix_string
+				, wrapper_cache_type_name[t]
+				, (p == IPV6CALC_DB_CACHE_PROTO_IPV4) ? "IPv4" : "IPv6"
+				, libipv6calc_db_wrapper_cache_size
+				, ctx->cache[t][p].entries
+				, ctx->cache[t][p].hit
+				, ctx->cache[t][p].miss
+			);
+		};
 	};
+};
+
+
+/*
+ * print range cache statistics of default context (to stderr)
+ *
+ * in : prefix_string = prefix of each line
+ */
+void libipv6calc_db_wrapper_print_cache_statistics(const char *prefix_string) {
+	libipv6calc_db_wrapper_ctx_print_cache_statistics(&wrapper_ctx_default, prefix_string);
+};
+
+
+/*
+ * function initialise the main wrapper
+ *  database sources are initialized on first use (or now in case of libipv6calc_db_wrapper_init_eager)
+ *
+ * in : prefix_string = prefix of messages
+ * out: 0=ok, 1=error
+ */
+int libipv6calc_db_wrapper_init(const char *prefix_string) {
+	int result = 0, s, j;
+
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 	// initialize priority selector
 	if (wrapper_source_priority_selector_by_option < 0) {
@@ -137,6 +457,51 @@ int libipv6calc_db_wrapper_init(const char *prefix_string) {
 		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Database priorization/defined by option entry %d: %s", j, libipv6calc_db_wrapper_get_data_source_name_by_number(wrapper_source_priority_selector[j]));
 	};
 
+	wrapper_init_prefix_string = prefix_string;
+	wrapper_sources_state = 0;
+
+	if (libipv6calc_db_wrapper_init_eager == 1) {
+		result = libipv6calc_db_wrapper_sources_init();
+	} else {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Initialization of database sources delayed until first use");
+	};
+
+	return(result);
+};
+
+
+/*
+ * initialize database sources and select source for each feature by priority
+ *  all sources are initialized together, selection by priority requires the features of each source
+ *
+ * in : (nothing)
+ * out: 0=ok, 1=error
+ */
+static int libipv6calc_db_wrapper_sources_init(void) {
+	int result = 0, f, p, s;
+
+#if defined SUPPORT_GEOIP || defined SUPPORT_IP2LOCATION || defined SUPPORT_DBIP || defined SUPPORT_EXTERNAL || defined SUPPORT_BUILTIN
+	int r;
+#endif
+
+	const char *prefix_string = wrapper_init_prefix_string;
+	s = strlen(prefix_string); // make compiler happy (avoid unused "...")
+
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
+
+	wrapper_sources_state = 1;
+
+	// clear feature selector
+	for (f = IPV6CALC_DB_FEATURE_NUM_MIN; f <= IPV6CALC_DB_FEATURE_NUM_MAX; f++) {
+		for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
+			wrapper_features_selector[f][p] = 0;
+		};
+	};
+
+	for (s = 0; s <= IPV6CALC_DB_SOURCE_MAX; s++) {
+		wrapper_features_by_source[s] = 0;
+	};
+
 	if (wrapper_GeoIP_disable != 1) {
 #ifdef SUPPORT_GEOIP
 		// Call GeoIP wrapper
@@ -331,10 +696,32 @@ int libipv6calc_db_wrapper_init(const char *prefix_string) {
 #endif // SUPPORT_BUILTIN && SUPPORT_EXTERNAL
 #endif
 
+	if (result != 0) {
+		wrapper_sources_state = 2;
+	};
+
 	return(result);
 };
 
 
+/*
+ * initialize database sources on first use (not thread-safe)
+ *  failed initialization is reported once, afterwards only the result is returned
+ *
+ * in : (nothing)
+ * out: 0=ok, 1=error
+ */
+static int libipv6calc_db_wrapper_sources_check(void) {
+	if (wrapper_sources_state == 0) {
+		if (libipv6calc_db_wrapper_sources_init() != 0) {
+			ERRORPRINT_NA("initialization of database sources failed");
+		};
+	};
+
+	return((wrapper_sources_state == 1) ? 0 : 1);
+};
+
+
 /*
  * function cleanup the main wrapper
  *
@@ -350,6 +737,11 @@ int libipv6calc_db_wrapper_cleanup(void) {
 
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
+	if (wrapper_sources_state == 0) {
+		// database sources not initialized
+		goto END_libipv6calc_db_wrapper_cleanup;
+	};
+
 #ifdef SUPPORT_GEOIP
 	// Call GeoIP wrapper
 	r = libipv6calc_db_wrapper_GeoIP_wrapper_cleanup();
@@ -382,12 +774,20 @@ int libipv6calc_db_wrapper_cleanup(void) {
 	};
 #endif
 
+	wrapper_sources_state = 0;
+
+END_libipv6calc_db_wrapper_cleanup:
+	libipv6calc_db_wrapper_ctx_cleanup(&wrapper_ctx_default);
+
 	return(result);
 };
 
 
 /* function get info strings */
 void libipv6calc_db_wrapper_info(char *string, const size_t size) {
+	// failed initialization is already reported, show available database sources
+	(void) libipv6calc_db_wrapper_sources_check();
+
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 #ifdef SUPPORT_GEOIP
@@ -422,6 +822,9 @@ void libipv6calc_db_wrapper_features(char *string, const size_t size) {
 	char tempstring[NI_MAXHOST];
 	char *separator;
 
+	// failed initialization is already reported, show available database sources
+	(void) libipv6calc_db_wrapper_sources_check();
+
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 	for (i = 0; i < MAXENTRIES_ARRAY(ipv6calc_db_features); i++) {
@@ -448,6 +851,9 @@ void libipv6calc_db_wrapper_capabilities(char *string, const size_t size) {
 	char tempstring[NI_MAXHOST];
 #endif
 
+	// failed initialization is already reported, show available database sources
+	(void) libipv6calc_db_wrapper_sources_check();
+
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 	if (wrapper_GeoIP_disable != 1) {
@@ -569,6 +975,9 @@ static int libipv6calc_db_wrapper_get_feature_index_by_feature(const uint32_t fe
 void libipv6calc_db_wrapper_features_help(void) {
 	int i, s, first;
 
+	// failed initialization is already reported, show available database sources
+	(void) libipv6calc_db_wrapper_sources_check();
+
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 	for (i = 0; i < MAXENTRIES_ARRAY(ipv6calc_db_features); i++) {
@@ -596,6 +1005,9 @@ void libipv6calc_db_wrapper_features_help(void) {
 void libipv6calc_db_wrapper_print_db_info(const int level_verbose, const char *prefix_string) {
 	int f, p, f_index;
 
+	// failed initialization is already reported, show available database sources
+	(void) libipv6calc_db_wrapper_sources_check();
+
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
 	fprintf(stderr, "%sDB features: 0x%08x\n\n", prefix_string, wrapper_features);
@@ -702,6 +1114,8 @@ void libipv6calc_db_wrapper_print_db_info(const int level_verbose, const char *p
 int libipv6calc_db_wrapper_has_features(uint32_t features) {
 	int result = -1;
 
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(-1)
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called with feature value to test: 0x%08x", features);
 
 	if ((wrapper_features & features) == features) {
@@ -760,6 +1174,15 @@ int libipv6calc_db_wrapper_options(const int opt, const char *optarg, const stru
 			result = 0;
 			break;
 
+		case DB_builtin_lookup_generic:
+#ifdef SUPPORT_BUILTIN
+			builtin_lookup_generic = 1;
+#else
+			NONQUIETPRINT_NA("Support for BuiltIn not compiled-in, skipping option: --db-builtin-lookup-generic");
+#endif
+			result = 0;
+			break;
+
 		case DB_ip2location_lib:
 #ifdef SUPPORT_IP2LOCATION_DYN
 			result = snprintf(ip2location_lib_file, sizeof(ip2location_lib_file), "%s", optarg);
@@ -778,6 +1201,18 @@ int libipv6calc_db_wrapper_options(const int opt, const char *optarg, const stru
 			result = 0;
 			break;
 
+		case DB_geoip_mode:
+#ifdef SUPPORT_GEOIP
+			if (libipv6calc_db_wrapper_GeoIP_open_mode_set(optarg) != 0) {
+				fprintf(stderr, " Argument of option 'db-geoip-mode' is not supported (standard|memory|mmap|index): %s\n", optarg);
+				exit(EXIT_FAILURE);
+			};
+#else
+			NONQUIETPRINT_WA("Support for GeoIP not compiled-in, skipping option: --%s", ipv6calcoption_name(opt, longopts));
+#endif
+			result = 0;
+			break;
+
 		case DB_ip2location_dir:
 #ifdef SUPPORT_IP2LOCATION
 			result = snprintf(ip2location_db_dir, sizeof(ip2location_db_dir), "%s", optarg);
@@ -907,19 +1342,55 @@ int libipv6calc_db_wrapper_options(const int opt, const char *optarg, const stru
 			result = 0;
 			break;
 
-		case DB_common_priorization:
-#if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP || defined SUPPORT_GEOIP || SUPPORT_IP2LOCATION
-			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Parse database priorization string: %s", optarg);
-			char tempstring[NI_MAXHOST];
-			char *token, *cptr, **ptrptr;
-			ptrptr = &cptr;
-			int i, j;
-			snprintf(tempstring, sizeof(tempstring), "%s", optarg);
-
-			s = IPV6CALC_DB_SOURCE_MIN;
-
-			token = strtok_r(tempstring, ":", ptrptr);
-			while (token != NULL) {
+		case DB_ip2location_mode:
+#ifdef SUPPORT_IP2LOCATION
+			if (libipv6calc_db_wrapper_IP2Location_access_mode_set(optarg) != 0) {
+				fprintf(stderr, " Argument of option 'db-ip2location-mode' is not supported (file|cache|shared): %s\n", optarg);
+				exit(EXIT_FAILURE);
+			};
+#else
+			NONQUIETPRINT_WA("Support for IP2Location not compiled-in, skipping option: --%s", ipv6calcoption_name(opt, longopts));
+#endif
+			result = 0;
+			break;
+
+		case DB_common_cache_size:
+			if ((atoi(optarg) >= 0) && (atoi(optarg) <= IPV6CALC_DB_CACHE_SIZE_MAX)) {
+				libipv6calc_db_wrapper_cache_size = atoi(optarg);
+			} else {
+				fprintf(stderr, " Argument of option 'db-cache-size' is out or range (0-%d): %d\n", IPV6CALC_DB_CACHE_SIZE_MAX, atoi(optarg));
+				exit(EXIT_FAILURE);
+			};
+			result = 0;
+			break;
+
+		case DB_common_init_eager:
+			libipv6calc_db_wrapper_init_eager = 1;
+			result = 0;
+			break;
+
+		case DB_common_preload:
+#if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP
+			libipv6calc_db_wrapper_preload = 1;
+#else
+			NONQUIETPRINT_WA("Support for External/DBIP not compiled-in, skipping option: --%s", ipv6calcoption_name(opt, longopts));
+#endif
+			result = 0;
+			break;
+
+		case DB_common_priorization:
+#if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP || defined SUPPORT_GEOIP || SUPPORT_IP2LOCATION
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Parse database priorization string: %s", optarg);
+			char tempstring[NI_MAXHOST];
+			char *token, *cptr, **ptrptr;
+			ptrptr = &cptr;
+			int i, j;
+			snprintf(tempstring, sizeof(tempstring), "%s", optarg);
+
+			s = IPV6CALC_DB_SOURCE_MIN;
+
+			token = strtok_r(tempstring, ":", ptrptr);
+			while (token != NULL) {
 				DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Parsing of token: %s", token);
 				for (i = 0; i < MAXENTRIES_ARRAY(data_sources); i++) {
 					if (strcasecmp(data_sources[i].shortname, token) == 0) {
@@ -982,6 +1453,8 @@ int libipv6calc_db_wrapper_options(const int opt, const char *optarg, const stru
  * get registry number by AS number
  */
 int libipv6calc_db_wrapper_registry_num_by_as_num32(const uint32_t as_num32) {
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(REGISTRY_UNKNOWN)
+
 	// currently only supported by BuiltIn
 	return(libipv6calc_db_wrapper_BuiltIn_registry_num_by_as_num32(as_num32));
 };
@@ -991,6 +1464,8 @@ int libipv6calc_db_wrapper_registry_num_by_as_num32(const uint32_t as_num32) {
  * get registry number by CC index
  */
 int libipv6calc_db_wrapper_registry_num_by_cc_index(const uint16_t cc_index) {
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(REGISTRY_UNKNOWN)
+
 	// currently only supported by BuiltIn
 	return(libipv6calc_db_wrapper_BuiltIn_registry_num_by_cc_index(cc_index));
 };
@@ -999,15 +1474,19 @@ int libipv6calc_db_wrapper_registry_num_by_cc_index(const uint16_t cc_index) {
  * get registry number by IP address
  */
 int libipv6calc_db_wrapper_registry_num_by_ipaddr(const ipv6calc_ipaddr *ipaddrp) {
+	return(libipv6calc_db_wrapper_registry_num_by_ipaddr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp));
+};
+
+int libipv6calc_db_wrapper_registry_num_by_ipaddr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp) {
 	ipv6calc_ipv4addr ipv4addr;
 	ipv6calc_ipv6addr ipv6addr;
 
 	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
 		CONVERT_IPADDRP_IPV4ADDR(ipaddrp, ipv4addr)
-		return(libipv6calc_db_wrapper_registry_num_by_ipv4addr(&ipv4addr));
+		return(libipv6calc_db_wrapper_registry_num_by_ipv4addr_r(ctx, &ipv4addr));
 	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
 		CONVERT_IPADDRP_IPV6ADDR(ipaddrp, ipv6addr)
-		return(libipv6calc_db_wrapper_registry_num_by_ipv6addr(&ipv6addr));
+		return(libipv6calc_db_wrapper_registry_num_by_ipv6addr_r(ctx, &ipv6addr));
 	} else {
 		ERRORPRINT_WA("unsupported proto=%d (FIX CODE)", ipaddrp->proto);
 		exit(EXIT_FAILURE);
@@ -1034,6 +1513,122 @@ int libipv6calc_db_wrapper_registry_string_by_ipaddr(const ipv6calc_ipaddr *ipad
 };
 
 
+/*
+ * get CountryCode in text form from one database source
+ * in: data_source, ipaddrp, length
+ * mod: string, addrstring (filled on first use, shared between calls for same address)
+ * out: *rangep = address range with identical result, if reported by source (flag_valid=0 otherwise)
+ * return: 0=found, 1=not found, 2=end of priority list
+ */
+static int libipv6calc_db_wrapper_country_code_by_source(const int data_source, char *string, const int length, const ipv6calc_ipaddr *ipaddrp, char *addrstring, const size_t addrstring_size, ipv6calc_ipaddr_range *rangep) {
+	int result = 1;
+
+	rangep->flag_valid = 0;
+
+#if ! defined SUPPORT_GEOIP && ! defined SUPPORT_IP2LOCATION
+	// make compiler happy (avoid unused "...")
+	(void) addrstring;
+	(void) addrstring_size;
+#if ! defined SUPPORT_DBIP && ! defined SUPPORT_EXTERNAL
+	(void) string;
+	(void) length;
+	(void) ipaddrp;
+#endif
+#endif
+
+#if defined SUPPORT_GEOIP || defined SUPPORT_IP2LOCATION
+	char *result_char_ptr = NULL;
+
+	switch(data_source) {
+	    case IPV6CALC_DB_SOURCE_IP2LOCATION:
+		// need IP address as string (GeoIP is using numeric lookup)
+		if (strlen(addrstring) == 0) {
+			libipaddr_ipaddrstruct_to_string(ipaddrp, addrstring, addrstring_size, 0);
+		};
+	};
+#endif
+
+	switch(data_source) {
+	    case 0:
+		// last
+		result = 2;
+		break;
+
+	    case IPV6CALC_DB_SOURCE_GEOIP:
+		if (wrapper_GeoIP_status == 1) {
+#ifdef SUPPORT_GEOIP
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now GeoIP");
+
+			result_char_ptr = (char *) libipv6calc_db_wrapper_GeoIP_wrapper_country_code_by_ipaddr(ipaddrp, addrstring, addrstring_size);
+
+			if (result_char_ptr != NULL) {
+				snprintf(string, length, "%s", result_char_ptr);
+				result = 0;
+			} else {
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called GeoIP did not return a valid country_code");
+			};
+#endif
+		};
+		break;
+
+	    case IPV6CALC_DB_SOURCE_IP2LOCATION:
+		if (wrapper_IP2Location_status == 1) {
+#ifdef SUPPORT_IP2LOCATION
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now IP2Location with %s", addrstring);
+
+			result_char_ptr = libipv6calc_db_wrapper_IP2Location_wrapper_country_code_by_addr(addrstring, ipaddrp->proto);
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called IP2Location returned: %s", result_char_ptr);
+
+			if (result_char_ptr != NULL) {
+				snprintf(string, length, "%s", result_char_ptr);
+				result = 0;
+			} else {
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called IP2Location did not return a valid country_code");
+			};
+#endif
+		};
+		break;
+
+	    case IPV6CALC_DB_SOURCE_DBIP:
+		if (wrapper_DBIP_status == 1) {
+#ifdef SUPPORT_DBIP
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now DBIP");
+
+			int ret = libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(ipaddrp, string, length, rangep);
+			if (ret == 0) {
+				result = 0;
+			} else {
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called db-ip.com did not return a valid country_code");
+			};
+#endif
+		};
+		break;
+
+	    case IPV6CALC_DB_SOURCE_EXTERNAL:
+		if (wrapper_External_status == 1) {
+#ifdef SUPPORT_EXTERNAL
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
+
+			int ret = libipv6calc_db_wrapper_External_country_code_by_addr(ipaddrp, string, length, rangep);
+
+			if (ret == 0) {
+				result = 0;
+			} else {
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called External did not return a valid country_code");
+			};
+#endif
+		};
+		break;
+
+	    default:
+		result = 2; // dummy in case no db is enabled
+		break;
+	};
+
+	return(result);
+};
+
+
 /*
  * get CountryCode in text form
  * in: ipaddrp, length
@@ -1041,13 +1636,28 @@ int libipv6calc_db_wrapper_registry_string_by_ipaddr(const ipv6calc_ipaddr *ipad
  * return: 0=ok
  */
 int libipv6calc_db_wrapper_country_code_by_addr(char *string, const int length, const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr) {
-	unsigned int data_source = IPV6CALC_DB_SOURCE_UNKNOWN;
-	int f = 0, p, result = -1;
+	ipv6calc_ipaddr_range range;
 
-#if defined SUPPORT_GEOIP || defined SUPPORT_IP2LOCATION
+	return(libipv6calc_db_wrapper_country_code_by_addr_range(string, length, ipaddrp, data_source_ptr, &range));
+};
+
+
+/*
+ * get CountryCode in text form and address range with identical result
+ *  range is only valid if the answering source reports one and no source of higher priority was asked before
+ * in: ipaddrp, length
+ * mod: string, data_source_ptr (if != NULL)
+ * out: *rangep (flag_valid=0 if not available)
+ * return: 0=ok
+ */
+static int libipv6calc_db_wrapper_country_code_by_addr_range(char *string, const int length, const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr, ipv6calc_ipaddr_range *rangep) {
+	unsigned int data_source = IPV6CALC_DB_SOURCE_UNKNOWN;
+	int f = 0, p, r, result = -1;
 	char tempstring[IPV6CALC_ADDR_STRING_MAX] = "";
-	char *result_char_ptr = NULL;
-#endif
+
+	rangep->flag_valid = 0;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(-1)
 
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called");
 
@@ -1084,100 +1694,18 @@ int libipv6calc_db_wrapper_country_code_by_addr(char *string, const int length,
 
 	// run through priorities
 	for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
-#if defined SUPPORT_GEOIP || defined SUPPORT_IP2LOCATION
-		switch(wrapper_features_selector[f][p]) {
-		    case IPV6CALC_DB_SOURCE_GEOIP:
-		    case IPV6CALC_DB_SOURCE_IP2LOCATION:
-			// need IP address as string
-			if (strlen(tempstring) == 0) {
-				libipaddr_ipaddrstruct_to_string(ipaddrp, tempstring, sizeof(tempstring), 0);
-			};
-		};
-#endif
-
-		switch(wrapper_features_selector[f][p]) {
-		    case 0:
-			// last
-			goto END_libipv6calc_db_wrapper; // ok
-			break;
-
-		    case IPV6CALC_DB_SOURCE_GEOIP:
-			if (wrapper_GeoIP_status == 1) {
-#ifdef SUPPORT_GEOIP
-				DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now GeoIP with %s", tempstring);
-
-				result_char_ptr = (char *) libipv6calc_db_wrapper_GeoIP_wrapper_country_code_by_addr(tempstring, ipaddrp->proto);
-
-				if (result_char_ptr != NULL) {
-					snprintf(string, length, "%s", result_char_ptr);
-					result = 0;
-					data_source = IPV6CALC_DB_SOURCE_GEOIP;
-					goto END_libipv6calc_db_wrapper; // ok
-				} else {
-					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called GeoIP did not return a valid country_code");
-				};
-#endif
-			};
-			break;
-
-		    case IPV6CALC_DB_SOURCE_IP2LOCATION:
-			if (wrapper_IP2Location_status == 1) {
-#ifdef SUPPORT_IP2LOCATION
-				DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now IP2Location with %s", tempstring);
-
-				result_char_ptr = libipv6calc_db_wrapper_IP2Location_wrapper_country_code_by_addr(tempstring, ipaddrp->proto);
-				DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called IP2Location returned: %s", result_char_ptr);
-
-				if (result_char_ptr != NULL) {
-					snprintf(string, length, "%s", result_char_ptr);
-					result = 0;
-					data_source = IPV6CALC_DB_SOURCE_IP2LOCATION;
-					goto END_libipv6calc_db_wrapper; // ok
-				} else {
-					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called IP2Location did not return a valid country_code");
-				};
-#endif
-			};
-			break;
-
-		    case IPV6CALC_DB_SOURCE_DBIP:
-			if (wrapper_DBIP_status == 1) {
-#ifdef SUPPORT_DBIP
-				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now DBIP");
-
-				int ret = libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(ipaddrp, string, length);
-				if (ret == 0) {
-					result = 0;
-					data_source = IPV6CALC_DB_SOURCE_DBIP;
-					goto END_libipv6calc_db_wrapper; // ok
-				} else {
-					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called db-ip.com did not return a valid country_code");
-				};
-#endif
-			};
-			break;
-
-		    case IPV6CALC_DB_SOURCE_EXTERNAL:
-			if (wrapper_External_status == 1) {
-#ifdef SUPPORT_EXTERNAL
-				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
+		r = libipv6calc_db_wrapper_country_code_by_source(wrapper_features_selector[f][p], string, length, ipaddrp, tempstring, sizeof(tempstring), rangep);
 
-				int ret = libipv6calc_db_wrapper_External_country_code_by_addr(ipaddrp, string, length);
-
-				if (ret == 0) {
-					result = 0;
-					data_source = IPV6CALC_DB_SOURCE_EXTERNAL;
-					goto END_libipv6calc_db_wrapper; // ok
-				} else {
-					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Called External did not return a valid country_code");
-				};
-#endif
+		if (r == 0) {
+			result = 0;
+			data_source = wrapper_features_selector[f][p];
+			if (p > 0) {
+				// source of higher priority could have a result for other addresses of the range
+				rangep->flag_valid = 0;
 			};
-			break;
-
-		    default:
-			goto END_libipv6calc_db_wrapper; // dummy goto in case no db is enabled
-			break;
+			goto END_libipv6calc_db_wrapper; // ok
+		} else if (r == 2) {
+			goto END_libipv6calc_db_wrapper; // end of list
 		};
 	};
 
@@ -1198,84 +1726,126 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * convert CountryCode returned by database into special internal form (index)
+ * in: cc_text
+ * mod: index (untouched in case of not alphanumeric CountryCode)
+ * return: 0=ok, 1=something wrong
+ */
+static int libipv6calc_db_wrapper_cc_index_by_cc_text(const char *cc_text, uint16_t *index) {
+	uint8_t c1, c2;
+
+	if (strlen(cc_text) != 2) {
+		ERRORPRINT_WA("returned cc_text has not 2 chars: %s", cc_text);
+		return(1); // something wrong
+	};
+
+	if (isalpha(cc_text[0]) && isalnum(cc_text[1])) {
+		c1 = toupper(cc_text[0]);
+		if (! (c1 >= 'A' && c1 <= 'Z')) {
+			return(1); // something wrong
+		};
+		c1 -= 'A';
+
+		c2 = toupper(cc_text[1]);
+		if (c2 >= '0' && c2 <= '9') {
+			c2 -= '0';
+		} else if (c2 >= 'A' && c2 <= 'Z') {
+			c2 -= 'A';
+			c2 += 10;
+		} else {
+			return(1); // something wrong
+		};
+
+		*index = c1 + c2 * COUNTRYCODE_LETTER1_MAX;
+
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "c1=%d c2=%d index=%d (0x%03x) -> test: %c%c", c1, c2, *index, *index, COUNTRYCODE_INDEX_TO_CHAR1(*index), COUNTRYCODE_INDEX_TO_CHAR2(*index));
+
+		if (*index >= COUNTRYCODE_INDEX_MAX) {
+			*index = COUNTRYCODE_INDEX_UNKNOWN; // failsafe
+			ERRORPRINT_WA("unexpected index (too high): %d", *index);
+			return(1); // something wrong
+		};
+	};
+
+	return(0);
+};
+
+
 /*
  * get CountryCode in special internal form (index) [A-Z] (26) x [0-9A-Z] (36)
  */
 uint16_t libipv6calc_db_wrapper_cc_index_by_addr(const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr) {
+	return(libipv6calc_db_wrapper_cc_index_by_addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp, data_source_ptr));
+};
+
+uint16_t libipv6calc_db_wrapper_cc_index_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr) {
 	uint16_t index = COUNTRYCODE_INDEX_UNKNOWN;
 	char cc_text[256] = "";
-	uint8_t c1, c2;
 	int r;
 
 	int cache_hit = 0;
+	uint32_t cache_value;
+	ipv6calc_ipaddr_range range;
 
-	static ipv6calc_ipaddr ipaddr_cache_lastused;
-	static uint16_t cc_index_lastused;
-	static unsigned int data_source_lastused = IPV6CALC_DB_SOURCE_UNKNOWN;
-	static int ipaddr_cache_lastused_valid = 0;
+	s_ipv6calc_db_wrapper_ctx_lastused *lu = &ctx->lu_cc;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(COUNTRYCODE_INDEX_UNKNOWN)
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
 
-	if ((ipaddr_cache_lastused_valid == 1)
-	    &&	(ipaddr_cache_lastused.proto == ipaddrp->proto)
-	    && 	(ipaddr_cache_lastused.addr[0] == ipaddrp->addr[0])
-	    && 	(ipaddr_cache_lastused.addr[1] == ipaddrp->addr[1])
-	    && 	(ipaddr_cache_lastused.addr[2] == ipaddrp->addr[2])
-	    && 	(ipaddr_cache_lastused.addr[3] == ipaddrp->addr[3])
+	if ((lu->valid == 1)
+	    &&	(lu->ipaddr.proto == ipaddrp->proto)
+	    && 	(lu->ipaddr.addr[0] == ipaddrp->addr[0])
+	    && 	(lu->ipaddr.addr[1] == ipaddrp->addr[1])
+	    && 	(lu->ipaddr.addr[2] == ipaddrp->addr[2])
+	    && 	(lu->ipaddr.addr[3] == ipaddrp->addr[3])
 	) {
-		index = cc_index_lastused;
+		index = lu->cc_index;
 
 		// set only data_source from cache if caller request it
 		if (data_source_ptr != NULL) {
-			*data_source_ptr = data_source_lastused;
+			*data_source_ptr = lu->data_source;
+		};
+
+		cache_hit = 1;
+		goto END_libipv6calc_db_wrapper_cached;
+	} else if ((((ipaddrp->proto == IPV6CALC_PROTO_IPV4) && ((ipaddrp->typeinfo1 & IPV4_ADDR_RESERVED) == 0))
+	    ||  ((ipaddrp->proto == IPV6CALC_PROTO_IPV6) && ((ipaddrp->typeinfo1 & IPV6_ADDR_RESERVED) == 0)))
+	    &&  (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_CC, ipaddrp, &cache_value, NULL) == 1)
+	) {
+		// range cache contains data_source in upper and cc_index in lower 16 bits
+		index = cache_value & 0xffff;
+		lu->data_source = cache_value >> 16;
+
+		if (data_source_ptr != NULL) {
+			*data_source_ptr = lu->data_source;
 		};
 
+		lu->valid = 1;
+		lu->cc_index = index;
+		lu->ipaddr = *ipaddrp;
+
 		cache_hit = 1;
 		goto END_libipv6calc_db_wrapper_cached;
 	} else {
 		// retrieve always data_source for caching
-		r = libipv6calc_db_wrapper_country_code_by_addr(cc_text, sizeof(cc_text), ipaddrp, &data_source_lastused);
+		r = libipv6calc_db_wrapper_country_code_by_addr_range(cc_text, sizeof(cc_text), ipaddrp, &lu->data_source, &range);
 		if (r != 0) {
 			goto END_libipv6calc_db_wrapper_cached; // something wrong
 		};
 
-		if (strlen(cc_text) == 2) {
-			if (isalpha(cc_text[0]) && isalnum(cc_text[1])) {
-				c1 = toupper(cc_text[0]);
-				if (! (c1 >= 'A' && c1 <= 'Z')) {
-					goto END_libipv6calc_db_wrapper_cached; // something wrong
-				};
-				c1 -= 'A';
-
-				c2 = toupper(cc_text[1]);
-				if (c2 >= '0' && c2 <= '9') {
-					c2 -= '0';
-				} else if (c2 >= 'A' && c2 <= 'Z') {
-					c2 -= 'A';
-					c2 += 10;
-				} else {
-					goto END_libipv6calc_db_wrapper_cached; // something wrong
-				};
-
-				index = c1 + c2 * COUNTRYCODE_LETTER1_MAX;
-
-				DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "c1=%d c2=%d index=%d (0x%03x) -> test: %c%c", c1, c2, index, index, COUNTRYCODE_INDEX_TO_CHAR1(index), COUNTRYCODE_INDEX_TO_CHAR2(index));
-
-				if (index >= COUNTRYCODE_INDEX_MAX) {
-					index = COUNTRYCODE_INDEX_UNKNOWN; // failsafe
-					ERRORPRINT_WA("unexpected index (too high): %d", index);
-					goto END_libipv6calc_db_wrapper_cached; // something wrong
-				};
-			};
-		} else {
-			ERRORPRINT_WA("returned cc_text has not 2 chars: %s", cc_text);
+		if (libipv6calc_db_wrapper_cc_index_by_cc_text(cc_text, &index) != 0) {
 			goto END_libipv6calc_db_wrapper_cached; // something wrong
 		};
 
+		// store in range cache (only if range is reported by source)
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_CC, ipaddrp, &range, ((uint32_t) lu->data_source << 16) | index);
+
 		// store in last used cache
-		ipaddr_cache_lastused_valid = 1;
-		cc_index_lastused = index;
-		ipaddr_cache_lastused = *ipaddrp;
+		lu->valid = 1;
+		lu->cc_index = index;
+		lu->ipaddr = *ipaddrp;
 	};
 
 END_libipv6calc_db_wrapper_cached:
@@ -1312,12 +1882,27 @@ int libipv6calc_db_wrapper_country_code_by_cc_index(char *string, const int leng
  * get AS information in text form
  */
 char *libipv6calc_db_wrapper_as_text_by_addr(const ipv6calc_ipaddr *ipaddrp) {
+	return(libipv6calc_db_wrapper_as_text_by_addr_range(ipaddrp, NULL));
+};
+
+
+/*
+ * get AS information in text form and address range with identical result
+ * out: *rangep (skipped if NULL, flag_valid=0 if not available)
+ */
+static char *libipv6calc_db_wrapper_as_text_by_addr_range(const ipv6calc_ipaddr *ipaddrp, ipv6calc_ipaddr_range *rangep) {
 	char *result_char_ptr = NULL;
 
 #if defined SUPPORT_GEOIP
 	char tempstring[IPV6CALC_ADDR_STRING_MAX] = "";
 #endif
 
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(NULL)
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%04x%04x%04x%04x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
 
 	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
@@ -1339,14 +1924,9 @@ char *libipv6calc_db_wrapper_as_text_by_addr(const ipv6calc_ipaddr *ipaddrp) {
 
 	if (wrapper_GeoIP_status == 1) {
 #ifdef SUPPORT_GEOIP
-		// conversion sto string needed for GeoIP
-		if (strlen(tempstring) == 0) {
-			libipaddr_ipaddrstruct_to_string(ipaddrp, tempstring, sizeof(tempstring), 0);
-		};
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now GeoIP with proto=%d", ipaddrp->proto);
 
-		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now GeoIP with addr=%s proto=%d)", tempstring, ipaddrp->proto);
-
-		result_char_ptr = libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_addr(tempstring, ipaddrp->proto);
+		result_char_ptr = libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_ipaddr(ipaddrp, tempstring, sizeof(tempstring), rangep);
 #endif
 	};
 
@@ -1359,20 +1939,61 @@ END_libipv6calc_db_wrapper:
 
 
 /*
- * get AS 32-bit number
+ * get AS 32-bit number from text representation "AS<number> ..."
  */
-uint32_t libipv6calc_db_wrapper_as_num32_by_addr(const ipv6calc_ipaddr *ipaddrp) {
-	char *as_text;
+static uint32_t libipv6calc_db_wrapper_as_num32_by_as_text(const char *as_text) {
 	char as_number_string[11];  // max: 4294967295 = 10 digits + \0
 	uint32_t as_num32 = ASNUM_AS_UNKNOWN; // default
 	int valid = 1;
 	unsigned int s;
 
+	if ((as_text != NULL) && (strncmp(as_text, "AS", 2) == 0) && (strlen(as_text) > 2)) {
+		// catch AS....
+		for (s = 0; s < (strlen(as_text) - 2); s++) {
+			if ((as_text[s+2] == ' ') || (as_text[s+2] == '\0')) {
+				break;
+			} else if (isdigit(as_text[s+2])) {
+				continue;
+			} else {
+				// something wrong
+				valid = 0;
+				break;
+			};
+		};
+
+		if (s > 10) {
+			// too many digits
+			valid = 0;
+		};
+
+		if (valid == 1) {
+			snprintf(as_number_string, 11, "%s", as_text + 2);
+			as_num32 = atol(as_number_string);
+		};
+	};
+
+	return(as_num32);
+};
+
+
+/*
+ * get AS 32-bit number
+ */
+uint32_t libipv6calc_db_wrapper_as_num32_by_addr(const ipv6calc_ipaddr *ipaddrp) {
+	return(libipv6calc_db_wrapper_as_num32_by_addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp));
+};
+
+uint32_t libipv6calc_db_wrapper_as_num32_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp) {
+	char *as_text;
+	uint32_t as_num32 = ASNUM_AS_UNKNOWN; // default
+
 	int cache_hit = 0;
+	uint32_t cache_value;
+	ipv6calc_ipaddr_range range;
+
+	s_ipv6calc_db_wrapper_ctx_lastused *lu = &ctx->lu_as;
 
-	static ipv6calc_ipaddr ipaddr_cache_lastused;
-	static uint32_t as_num32_lastused;
-	static int ipaddr_cache_lastused_valid = 0;
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(ASNUM_AS_UNKNOWN)
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
 
@@ -1393,48 +2014,36 @@ uint32_t libipv6calc_db_wrapper_as_num32_by_addr(const ipv6calc_ipaddr *ipaddrp)
 		exit(EXIT_FAILURE);
 	};
 
-	if ((ipaddr_cache_lastused_valid == 1)
-	    &&	(ipaddr_cache_lastused.proto == ipaddrp->proto)
-	    && 	(ipaddr_cache_lastused.addr[0] == ipaddrp->addr[0])
-	    && 	(ipaddr_cache_lastused.addr[1] == ipaddrp->addr[1])
-	    && 	(ipaddr_cache_lastused.addr[2] == ipaddrp->addr[2])
-	    && 	(ipaddr_cache_lastused.addr[3] == ipaddrp->addr[3])
+	if ((lu->valid == 1)
+	    &&	(lu->ipaddr.proto == ipaddrp->proto)
+	    && 	(lu->ipaddr.addr[0] == ipaddrp->addr[0])
+	    && 	(lu->ipaddr.addr[1] == ipaddrp->addr[1])
+	    && 	(lu->ipaddr.addr[2] == ipaddrp->addr[2])
+	    && 	(lu->ipaddr.addr[3] == ipaddrp->addr[3])
 	) {
-		as_num32 = as_num32_lastused;
+		as_num32 = lu->as_num32;
 		cache_hit = 1;
+	} else if (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_AS, ipaddrp, &cache_value, NULL) == 1) {
+		as_num32 = cache_value;
+		cache_hit = 1;
+
+		// store in last used cache
+		lu->valid = 1;
+		lu->as_num32 = as_num32;
+		lu->ipaddr = *ipaddrp;
 	} else {
 		// TODO: switch mechanism depending on backend (GeoIP supports AS only by text representation)
-		as_text = libipv6calc_db_wrapper_as_text_by_addr(ipaddrp);
+		as_text = libipv6calc_db_wrapper_as_text_by_addr_range(ipaddrp, &range);
 
-		if ((as_text != NULL) && (strncmp(as_text, "AS", 2) == 0) && (strlen(as_text) > 2)) {
-			// catch AS....
-			for (s = 0; s < (strlen(as_text) - 2); s++) {
-				if ((as_text[s+2] == ' ') || (as_text[s+2] == '\0')) {
-					break;
-				} else if (isdigit(as_text[s+2])) {
-					continue;
-				} else {
-					// something wrong
-					valid = 0;
-					break;
-				};
-			};
+		as_num32 = libipv6calc_db_wrapper_as_num32_by_as_text(as_text);
 
-			if (s > 10) {
-				// too many digits
-				valid = 0;
-			};
-
-			if (valid == 1) {
-				snprintf(as_number_string, 11, "%s", as_text + 2);
-				as_num32 = atol(as_number_string);
-			};
-		};
+		// store in range cache (only if range is reported by source)
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_AS, ipaddrp, &range, as_num32);
 
 		// store in last used cache
-		ipaddr_cache_lastused_valid = 1;
-		as_num32_lastused = as_num32;
-		ipaddr_cache_lastused = *ipaddrp;
+		lu->valid = 1;
+		lu->as_num32 = as_num32;
+		lu->ipaddr = *ipaddrp;
 	};
 
 END_libipv6calc_db_wrapper:
@@ -1533,6 +2142,9 @@ uint32_t libipv6calc_db_wrapper_as_num32_decomp17(const uint32_t as_num32_comp17
  */
 int libipv6calc_db_wrapper_ieee_vendor_string_by_macaddr(char *resultstring, const size_t resultstring_length, const ipv6calc_macaddr *macaddrp) {
 	int retval = 1;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
+
 #ifdef SUPPORT_BUILTIN
 	retval = libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_by_macaddr(resultstring, resultstring_length, macaddrp);
 #endif
@@ -1548,6 +2160,9 @@ int libipv6calc_db_wrapper_ieee_vendor_string_by_macaddr(char *resultstring, con
  */
 int libipv6calc_db_wrapper_ieee_vendor_string_short_by_macaddr(char *resultstring, const size_t resultstring_length, const ipv6calc_macaddr *macaddrp) {
 	int retval = 1;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
+
 #ifdef SUPPORT_BUILTIN
 	retval = libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_short_by_macaddr(resultstring, resultstring_length, macaddrp);
 #endif
@@ -1746,24 +2361,28 @@ int libipv6calc_db_wrapper_registry_string_by_ipv4addr(const ipv6calc_ipv4addr *
  * out: registry number
  */
 int libipv6calc_db_wrapper_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp) {
+	return(libipv6calc_db_wrapper_registry_num_by_ipv4addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipv4addrp));
+};
+
+int libipv6calc_db_wrapper_registry_num_by_ipv4addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipv4addr *ipv4addrp) {
 	int retval = REGISTRY_UNKNOWN, p, f;
 
 	int cache_hit = 0;
 
-	static ipv6calc_ipv4addr cache_lu_ipv4addr;
-	static uint32_t cache_lu_ipv4addr_registry_num;
-	static int      cache_lu_ipv4addr_valid = 0;
-
-#if defined SUPPORT_EXTERNAL
 	ipv6calc_ipaddr ipaddr;
-#endif
+	ipv6calc_ipaddr_range range;
+	uint32_t cache_value;
+
+	range.flag_valid = 0;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(REGISTRY_UNKNOWN)
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x", ipv4addr_getdword(ipv4addrp));
 
-	if ((cache_lu_ipv4addr_valid == 1)
-	    && 	(memcmp(&cache_lu_ipv4addr.in_addr, &ipv4addrp->in_addr, sizeof(struct in_addr)) == 0)
+	if ((ctx->lu_ipv4addr_valid == 1)
+	    && 	(memcmp(&ctx->lu_ipv4addr.in_addr, &ipv4addrp->in_addr, sizeof(struct in_addr)) == 0)
 	) {
-		retval= cache_lu_ipv4addr_registry_num;
+		retval = ctx->lu_ipv4addr_registry_num;
 		cache_hit = 1;
 		goto END_libipv6calc_db_wrapper_cached;
 	};
@@ -1775,6 +2394,13 @@ int libipv6calc_db_wrapper_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv
 		goto END_libipv6calc_db_wrapper;
 	};
 
+	CONVERT_IPV4ADDRP_IPADDR(ipv4addrp, ipaddr);
+
+	if (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_REGISTRY, &ipaddr, &cache_value, NULL) == 1) {
+		retval = cache_value;
+		goto END_libipv6calc_db_wrapper;
+	};
+
 	f = IPV6CALC_DB_FEATURE_NUM_IPV4_TO_REGISTRY;
 
 	// run through priorities
@@ -1782,7 +2408,7 @@ int libipv6calc_db_wrapper_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv
 		switch(wrapper_features_selector[f][p]) {
 		    case 0:
 			// last
-			goto END_libipv6calc_db_wrapper; // ok
+			goto END_libipv6calc_db_wrapper_store; // ok
 			break;
 
 		    case IPV6CALC_DB_SOURCE_BUILTIN:
@@ -1790,7 +2416,7 @@ int libipv6calc_db_wrapper_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv
 #ifdef SUPPORT_BUILTIN
 				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now BuiltIn");
 
-				retval = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(ipv4addrp);
+				retval = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(ipv4addrp, &range);
 #endif
 			};
 			break;
@@ -1799,23 +2425,28 @@ int libipv6calc_db_wrapper_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv
 			if (wrapper_External_status == 1) {
 #ifdef SUPPORT_EXTERNAL
 				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
-				CONVERT_IPV4ADDRP_IPADDR(ipv4addrp, ipaddr);
-				retval = libipv6calc_db_wrapper_External_registry_num_by_addr(&ipaddr);
+				retval = libipv6calc_db_wrapper_External_registry_num_by_addr(&ipaddr, &range);
 #endif
 			};
 			break;
 
 		    default:
-			goto END_libipv6calc_db_wrapper; // dummy goto in case no db is enabled
+			goto END_libipv6calc_db_wrapper_store; // dummy goto in case no db is enabled
 			break;
 		};
 	};
 
+END_libipv6calc_db_wrapper_store:
+	// store in range cache, range belongs to the source called last
+	if (retval != REGISTRY_UNKNOWN) {
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_REGISTRY, &ipaddr, &range, retval);
+	};
+
 END_libipv6calc_db_wrapper:
 	// store in last used cache
-	cache_lu_ipv4addr_valid = 1;
-	cache_lu_ipv4addr_registry_num = retval;
-	cache_lu_ipv4addr.in_addr = ipv4addrp->in_addr;
+	ctx->lu_ipv4addr_valid = 1;
+	ctx->lu_ipv4addr_registry_num = retval;
+	ctx->lu_ipv4addr.in_addr = ipv4addrp->in_addr;
 
 END_libipv6calc_db_wrapper_cached:
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Result: addr=%08x reg=%d%s"
@@ -1868,93 +2499,586 @@ int libipv6calc_db_wrapper_registry_string_by_ipv6addr(const ipv6calc_ipv6addr *
  * out: assignment number (-1 = no result)
  */
 int libipv6calc_db_wrapper_registry_num_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp) {
+	return(libipv6calc_db_wrapper_registry_num_by_ipv6addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipv6addrp));
+};
+
+int libipv6calc_db_wrapper_registry_num_by_ipv6addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipv6addr *ipv6addrp) {
 	int retval = REGISTRY_UNKNOWN, p, f;
 
 	int cache_hit = 0;
 
-	static ipv6calc_ipv6addr cache_lu_ipv6addr;
-	static uint32_t cache_lu_ipv6addr_registry_num;
-	static int      cache_lu_ipv6addr_valid = 0;
-
-#if defined SUPPORT_EXTERNAL
 	ipv6calc_ipaddr ipaddr;
+	ipv6calc_ipaddr_range range;
+	uint32_t cache_value;
+
+	range.flag_valid = 0;
+
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(REGISTRY_UNKNOWN)
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x", ipv6addr_getdword(ipv6addrp, 0), ipv6addr_getdword(ipv6addrp, 1), ipv6addr_getdword(ipv6addrp, 2), ipv6addr_getdword(ipv6addrp, 3));
+
+	if ((ctx->lu_ipv6addr_valid == 1)
+	    && 	(memcmp(&ctx->lu_ipv6addr.in6_addr, &ipv6addrp->in6_addr, sizeof(struct in6_addr)) == 0)
+	) {
+		retval = ctx->lu_ipv6addr_registry_num;
+		cache_hit = 1;
+		goto END_libipv6calc_db_wrapper_cached;
+	};
+
+	const char *info = libipv6calc_db_wrapper_reserved_string_by_ipv6addr(ipv6addrp);
+
+	if (info != NULL) {
+		retval = REGISTRY_RESERVED;
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (ipv6addr_getword(ipv6addrp, 0) == 0x3ffe) {
+		// special handling of 6BONE
+		retval = REGISTRY_6BONE;
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	CONVERT_IPV6ADDRP_IPADDR(ipv6addrp, ipaddr);
+
+	if (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_REGISTRY, &ipaddr, &cache_value, NULL) == 1) {
+		retval = cache_value;
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	f = IPV6CALC_DB_FEATURE_NUM_IPV6_TO_REGISTRY;
+
+	// run through priorities
+	for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
+		switch(wrapper_features_selector[f][p]) {
+		    case 0:
+			// last
+			goto END_libipv6calc_db_wrapper_store; // ok
+			break;
+
+		    case IPV6CALC_DB_SOURCE_BUILTIN:
+			if (wrapper_BuiltIn_status == 1) {
+#ifdef SUPPORT_BUILTIN
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now BuiltIn");
+
+				retval = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(ipv6addrp, &range);
+#endif
+			};
+			break;
+
+		    case IPV6CALC_DB_SOURCE_EXTERNAL:
+			if (wrapper_External_status == 1) {
+#ifdef SUPPORT_EXTERNAL
+				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
+				retval = libipv6calc_db_wrapper_External_registry_num_by_addr(&ipaddr, &range);
+#endif
+			};
+			break;
+
+		    default:
+			goto END_libipv6calc_db_wrapper_store; // dummy goto in case no db is enabled
+			break;
+		};
+	};
+
+END_libipv6calc_db_wrapper_store:
+	// store in range cache, range belongs to the source called last
+	if (retval != REGISTRY_UNKNOWN) {
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_REGISTRY, &ipaddr, &range, retval);
+	};
+
+END_libipv6calc_db_wrapper:
+	// store in last used cache
+	ctx->lu_ipv6addr_valid = 1;
+	ctx->lu_ipv6addr_registry_num = retval;
+	ctx->lu_ipv6addr.in6_addr = ipv6addrp->in6_addr;
+
+END_libipv6calc_db_wrapper_cached:
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Result: addr=%08x%08x%08x%08x reg=%d%s"
+		, ipv6addr_getdword(ipv6addrp, 0)
+		, ipv6addr_getdword(ipv6addrp, 1)
+		, ipv6addr_getdword(ipv6addrp, 2)
+		, ipv6addr_getdword(ipv6addrp, 3)
+		, retval
+		, (cache_hit == 1 ? " (cached)" : "")
+	);
+	return (retval);
+};
+
+
+// values retrieved by libipv6calc_db_wrapper_all_by_addr
+#define IPV6CALC_DB_ALL_CC	0x1
+#define IPV6CALC_DB_ALL_AS	0x2
+#define IPV6CALC_DB_ALL_REGISTRY	0x4
+
+/*
+ * get CountryCode index, AS 32-bit number and registry number of an IP address in one run
+ *  one walk through the source priorities, address conversions are done only once
+ *  results are identical to libipv6calc_db_wrapper_{cc_index,as_num32,registry_num}_by_*
+ *
+ * in : ipaddrp = IP address
+ * out: cc_index = CountryCode index (skipped if NULL)
+ * out: data_source_ptr = data source of CountryCode (skipped if NULL)
+ * out: as_num32 = AS 32-bit number (skipped if NULL)
+ * out: registry = registry number (skipped if NULL)
+ * out: rangep = address range with identical results of all requested values (skipped if NULL)
+ *       flag_valid=0 if not reported by every source in use
+ * ret: 0 = ok, 1 = initialization of database sources failed (unknown values returned)
+ */
+int libipv6calc_db_wrapper_all_by_addr(const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry) {
+	return(libipv6calc_db_wrapper_all_by_addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp, cc_index, data_source_ptr, as_num32, registry, NULL));
+};
+
+int libipv6calc_db_wrapper_all_by_addr_range(const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry, ipv6calc_ipaddr_range *rangep) {
+	return(libipv6calc_db_wrapper_all_by_addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp, cc_index, data_source_ptr, as_num32, registry, rangep));
+};
+
+int libipv6calc_db_wrapper_all_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry, ipv6calc_ipaddr_range *rangep) {
+	char tempstring[IPV6CALC_ADDR_STRING_MAX] = "";
+	char cc_text[256] = "";
+	ipv6calc_ipv4addr ipv4addr;
+	ipv6calc_ipv6addr ipv6addr;
+	const char *info = NULL;
+	int f_cc, f_reg, p, r, reserved = 0;
+
+	uint16_t cc_index_result = COUNTRYCODE_INDEX_UNKNOWN;
+	unsigned int data_source = IPV6CALC_DB_SOURCE_UNKNOWN;
+	uint32_t as_num32_result = ASNUM_AS_UNKNOWN;
+	int registry_result = REGISTRY_UNKNOWN;
+
+	int requested = 0, todo, cached = 0;
+	int cache_hit = 0, result = 0;
+
+	ipv6calc_ipaddr_range range_registry, range_cc, range_as, range_all;
+	uint32_t cache_value;
+
+	range_registry.flag_valid = 0;
+	range_cc.flag_valid = 0;
+	range_as.flag_valid = 0;
+	range_all.flag_valid = 0;
+
+	s_ipv6calc_db_wrapper_ctx_lastused *lu = &ctx->lu_all; // valid: bitmask of cached values
+
+#if defined SUPPORT_GEOIP
+	char *as_text = NULL;
+#endif
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
+
+	if (libipv6calc_db_wrapper_sources_check() != 0) {
+		// initialization of database sources failed, return unknown values
+		result = 1;
+		goto END_libipv6calc_db_wrapper_cached;
+	};
+
+	if ((cc_index != NULL) || (data_source_ptr != NULL)) {
+		requested |= IPV6CALC_DB_ALL_CC;
+	};
+
+	if (as_num32 != NULL) {
+		requested |= IPV6CALC_DB_ALL_AS;
+	};
+
+	if (registry != NULL) {
+		requested |= IPV6CALC_DB_ALL_REGISTRY;
+	};
+
+	if ((lu->valid != 0)
+	    &&	((lu->valid & requested) == requested)
+	    &&	(lu->ipaddr.proto == ipaddrp->proto)
+	    && 	(lu->ipaddr.addr[0] == ipaddrp->addr[0])
+	    && 	(lu->ipaddr.addr[1] == ipaddrp->addr[1])
+	    && 	(lu->ipaddr.addr[2] == ipaddrp->addr[2])
+	    && 	(lu->ipaddr.addr[3] == ipaddrp->addr[3])
+	) {
+		cc_index_result = lu->cc_index;
+		data_source = lu->data_source;
+		as_num32_result = lu->as_num32;
+		registry_result = lu->registry;
+		range_all = lu->range;
+		cache_hit = 1;
+		goto END_libipv6calc_db_wrapper_cached;
+	};
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		f_cc = IPV6CALC_DB_FEATURE_NUM_IPV4_TO_CC;
+		f_reg = IPV6CALC_DB_FEATURE_NUM_IPV4_TO_REGISTRY;
+		if ((ipaddrp->typeinfo1 & IPV4_ADDR_RESERVED) != 0) {
+			// reserved IPv4 address has no country and no AS
+			reserved = 1;
+		};
+
+		if ((requested & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+			CONVERT_IPADDRP_IPV4ADDR(ipaddrp, ipv4addr)
+			info = libipv6calc_db_wrapper_reserved_string_by_ipv4addr(&ipv4addr);
+			if (info != NULL) {
+				registry_result = REGISTRY_RESERVED;
+			};
+		};
+	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
+		f_cc = IPV6CALC_DB_FEATURE_NUM_IPV6_TO_CC;
+		f_reg = IPV6CALC_DB_FEATURE_NUM_IPV6_TO_REGISTRY;
+		if ((ipaddrp->typeinfo1 & IPV6_ADDR_RESERVED) != 0) {
+			// reserved IPv6 address has no country and no AS
+			reserved = 1;
+		};
+
+		if ((requested & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+			CONVERT_IPADDRP_IPV6ADDR(ipaddrp, ipv6addr)
+			info = libipv6calc_db_wrapper_reserved_string_by_ipv6addr(&ipv6addr);
+			if (info != NULL) {
+				registry_result = REGISTRY_RESERVED;
+			} else if (ipv6addr_getword(&ipv6addr, 0) == 0x3ffe) {
+				// special handling of 6BONE
+				registry_result = REGISTRY_6BONE;
+			};
+		};
+	} else {
+		ERRORPRINT_WA("unsupported proto=%d (FIX CODE)", ipaddrp->proto);
+		exit(EXIT_FAILURE);
+	};
+
+	todo = requested;
+
+	if (reserved == 1) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Given address is reserved (skip CountryCode/AS lookup): addr=%08x%08x%08x%08x", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3]);
+		todo &= ~(IPV6CALC_DB_ALL_CC | IPV6CALC_DB_ALL_AS);
+	};
+
+	if (registry_result != REGISTRY_UNKNOWN) {
+		// reserved or 6bone
+		todo &= ~IPV6CALC_DB_ALL_REGISTRY;
+	} else if (((todo & IPV6CALC_DB_ALL_REGISTRY) != 0) && (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_REGISTRY, ipaddrp, &cache_value, &range_registry) == 1)) {
+		registry_result = cache_value;
+		todo &= ~IPV6CALC_DB_ALL_REGISTRY;
+		cached |= IPV6CALC_DB_ALL_REGISTRY;
+	};
+
+	if (((todo & IPV6CALC_DB_ALL_CC) != 0) && (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_CC, ipaddrp, &cache_value, &range_cc) == 1)) {
+		// range cache contains data_source in upper and cc_index in lower 16 bits
+		cc_index_result = cache_value & 0xffff;
+		data_source = cache_value >> 16;
+		todo &= ~IPV6CALC_DB_ALL_CC;
+		cached |= IPV6CALC_DB_ALL_CC;
+	};
+
+	if (((todo & IPV6CALC_DB_ALL_AS) != 0) && (libipv6calc_db_wrapper_cache_lookup(ctx, IPV6CALC_DB_CACHE_AS, ipaddrp, &cache_value, &range_as) == 1)) {
+		as_num32_result = cache_value;
+		todo &= ~IPV6CALC_DB_ALL_AS;
+		cached |= IPV6CALC_DB_ALL_AS;
+	};
+
+	// AS number, currently only supported by GeoIP
+	if ((todo & IPV6CALC_DB_ALL_AS) != 0) {
+		if (wrapper_GeoIP_status == 1) {
+#ifdef SUPPORT_GEOIP
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Call now GeoIP with proto=%d", ipaddrp->proto);
+
+			// numeric lookup, tempstring is only filled on fallback and shared with CountryCode lookups below
+			as_text = libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_ipaddr(ipaddrp, tempstring, sizeof(tempstring), &range_as);
+			as_num32_result = libipv6calc_db_wrapper_as_num32_by_as_text(as_text);
 #endif
+		};
+		todo &= ~IPV6CALC_DB_ALL_AS;
+	};
+
+	// run through priorities of CountryCode and registry at once
+	for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
+		if ((todo & (IPV6CALC_DB_ALL_CC | IPV6CALC_DB_ALL_REGISTRY)) == 0) {
+			break;
+		};
+
+		if ((todo & IPV6CALC_DB_ALL_CC) != 0) {
+			r = libipv6calc_db_wrapper_country_code_by_source(wrapper_features_selector[f_cc][p], cc_text, sizeof(cc_text), ipaddrp, tempstring, sizeof(tempstring), &range_cc);
+
+			if (r == 0) {
+				data_source = wrapper_features_selector[f_cc][p];
+				if (libipv6calc_db_wrapper_cc_index_by_cc_text(cc_text, &cc_index_result) != 0) {
+					range_cc.flag_valid = 0; // don't cache failed conversion
+				};
+				if (p > 0) {
+					// source of higher priority could have a result for other addresses of the range
+					range_cc.flag_valid = 0;
+				};
+				todo &= ~IPV6CALC_DB_ALL_CC;
+			} else if (r == 2) {
+				// end of list
+				todo &= ~IPV6CALC_DB_ALL_CC;
+			};
+		};
+
+		if ((todo & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+			switch(wrapper_features_selector[f_reg][p]) {
+			    case IPV6CALC_DB_SOURCE_BUILTIN:
+				if (wrapper_BuiltIn_status == 1) {
+#ifdef SUPPORT_BUILTIN
+					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now BuiltIn");
+
+					if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+						registry_result = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(&ipv4addr, &range_registry);
+					} else {
+						registry_result = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(&ipv6addr, &range_registry);
+					};
+#endif
+				};
+				break;
+
+			    case IPV6CALC_DB_SOURCE_EXTERNAL:
+				if (wrapper_External_status == 1) {
+#ifdef SUPPORT_EXTERNAL
+					DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
+					registry_result = libipv6calc_db_wrapper_External_registry_num_by_addr(ipaddrp, &range_registry);
+#endif
+				};
+				break;
+
+			    default:
+				// last or no db enabled
+				todo &= ~IPV6CALC_DB_ALL_REGISTRY;
+				break;
+			};
+		};
+	};
+
+	if (registry_result == REGISTRY_UNKNOWN) {
+		range_registry.flag_valid = 0;
+	};
+
+	// store in range cache, range belongs to the source called last
+	if ((cached & IPV6CALC_DB_ALL_REGISTRY) == 0) {
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_REGISTRY, ipaddrp, &range_registry, registry_result);
+	};
+
+	// store in range cache (only if range is reported by source)
+	if ((cached & IPV6CALC_DB_ALL_CC) == 0) {
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_CC, ipaddrp, &range_cc, ((uint32_t) data_source << 16) | cc_index_result);
+	};
+	if ((cached & IPV6CALC_DB_ALL_AS) == 0) {
+		libipv6calc_db_wrapper_cache_store(ctx, IPV6CALC_DB_CACHE_AS, ipaddrp, &range_as, as_num32_result);
+	};
+
+	// range with identical results of all requested values
+	range_all.flag_valid = 1;
+	for (p = 0; p < 4; p++) {
+		range_all.first[p] = 0;
+		range_all.last[p] = 0xffffffffu;
+	};
+	if ((requested & IPV6CALC_DB_ALL_CC) != 0) {
+		libipv6calc_db_wrapper_range_intersect(&range_all, &range_cc);
+	};
+	if ((requested & IPV6CALC_DB_ALL_AS) != 0) {
+		libipv6calc_db_wrapper_range_intersect(&range_all, &range_as);
+	};
+	if ((requested & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+		libipv6calc_db_wrapper_range_intersect(&range_all, &range_registry);
+	};
+
+	// store in last used cache
+	lu->valid = requested;
+	lu->ipaddr = *ipaddrp;
+	lu->cc_index = cc_index_result;
+	lu->data_source = data_source;
+	lu->as_num32 = as_num32_result;
+	lu->registry = registry_result;
+	lu->range = range_all;
+
+END_libipv6calc_db_wrapper_cached:
+	if (cc_index != NULL) {
+		*cc_index = cc_index_result;
+	};
+
+	if ((data_source_ptr != NULL) && (cc_index_result != COUNTRYCODE_INDEX_UNKNOWN)) {
+		*data_source_ptr = data_source;
+	};
+
+	if (as_num32 != NULL) {
+		*as_num32 = as_num32_result;
+	};
+
+	if (registry != NULL) {
+		*registry = registry_result;
+	};
+
+	if (rangep != NULL) {
+		*rangep = range_all;
+	};
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Result: addr=%08x%08x%08x%08x cc_index=%d (0x%03x) as_num32=%d (0x%08x) reg=%d%s", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], cc_index_result, cc_index_result, as_num32_result, as_num32_result, registry_result, (cache_hit == 1 ? " (cached)" : ""));
+
+	return(result);
+};
+
+
+/*
+ * batch lookup: sort entry (address and position in given array)
+ */
+typedef struct {
+	const ipv6calc_ipaddr *ipaddrp;
+	int index;
+} s_ipv6calc_db_wrapper_batch_entry;
+
+/*
+ * batch lookup: compare addresses (proto, address)
+ */
+static int libipv6calc_db_wrapper_batch_cmp_addr(const ipv6calc_ipaddr *a1, const ipv6calc_ipaddr *a2) {
+	if (a1->proto != a2->proto) {
+		return((a1->proto < a2->proto) ? -1 : 1);
+	};
+
+	return(libipv6calc_db_wrapper_cache_cmp(a1->addr, a2->addr));
+};
+
+/*
+ * batch lookup: compare function for qsort, keeping original order of identical addresses
+ */
+static int libipv6calc_db_wrapper_batch_cmp(const void *p1, const void *p2) {
+	const s_ipv6calc_db_wrapper_batch_entry *e1 = p1;
+	const s_ipv6calc_db_wrapper_batch_entry *e2 = p2;
+	int r;
+
+	r = libipv6calc_db_wrapper_batch_cmp_addr(e1->ipaddrp, e2->ipaddrp);
+	if (r != 0) {
+		return(r);
+	};
+
+	return(e1->index - e2->index);
+};
+
+/*
+ * batch lookup: check for address handled before any database lookup by libipv6calc_db_wrapper_all_by_addr_r
+ *  (reserved, 6bone), result can't be taken from the range of a neighbour address
+ *
+ * in : ipaddrp = IP address
+ * in : requested = values to retrieve (IPV6CALC_DB_ALL_*)
+ * ret: 1 = special, 0 = regular
+ */
+static int libipv6calc_db_wrapper_batch_special(const ipv6calc_ipaddr *ipaddrp, const int requested) {
+	ipv6calc_ipv4addr ipv4addr;
+	ipv6calc_ipv6addr ipv6addr;
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		if (((requested & (IPV6CALC_DB_ALL_CC | IPV6CALC_DB_ALL_AS)) != 0) && ((ipaddrp->typeinfo1 & IPV4_ADDR_RESERVED) != 0)) {
+			return(1);
+		};
+
+		if ((requested & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+			CONVERT_IPADDRP_IPV4ADDR(ipaddrp, ipv4addr)
+			if (libipv6calc_db_wrapper_reserved_string_by_ipv4addr(&ipv4addr) != NULL) {
+				return(1);
+			};
+		};
+	} else {
+		if (((requested & (IPV6CALC_DB_ALL_CC | IPV6CALC_DB_ALL_AS)) != 0) && ((ipaddrp->typeinfo1 & IPV6_ADDR_RESERVED) != 0)) {
+			return(1);
+		};
+
+		if ((requested & IPV6CALC_DB_ALL_REGISTRY) != 0) {
+			CONVERT_IPADDRP_IPV6ADDR(ipaddrp, ipv6addr)
+			if ((libipv6calc_db_wrapper_reserved_string_by_ipv6addr(&ipv6addr) != NULL) || (ipv6addr_getword(&ipv6addr, 0) == 0x3ffe)) {
+				return(1);
+			};
+		};
+	};
+
+	return(0);
+};
+
+
+/*
+ * batch lookup of CountryCode index, AS 32-bit number and registry
+ *  addresses are sorted internally, the range with identical results reported for
+ *  an address is reused for the following addresses inside, only addresses outside
+ *  are looked up (by the database handles of the given context)
+ *
+ * in : ipaddrp = array of addresses
+ * in : count = number of addresses
+ * out: cc_index = array of CountryCode index (skipped if NULL)
+ * out: as_num32 = array of AS 32-bit numbers (skipped if NULL)
+ * out: registry = array of registry numbers (skipped if NULL)
+ * ret: 0 = ok, !0 = error
+ */
+int libipv6calc_db_wrapper_batch_by_addr(const ipv6calc_ipaddr *ipaddrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry) {
+	return(libipv6calc_db_wrapper_batch_by_addr_r(IPV6CALC_DB_WRAPPER_CTX_DEFAULT, ipaddrp, count, cc_index, as_num32, registry));
+};
+
+int libipv6calc_db_wrapper_batch_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry) {
+	s_ipv6calc_db_wrapper_batch_entry *entries;
+	const ipv6calc_ipaddr *ep;
+	ipv6calc_ipaddr_range range;
+	int range_proto = 0;
+	uint16_t cc_index_result = COUNTRYCODE_INDEX_UNKNOWN;
+	uint32_t as_num32_result = ASNUM_AS_UNKNOWN;
+	int registry_result = REGISTRY_UNKNOWN;
+	int requested = 0, i;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: count=%d", count);
+
+	if (count <= 0) {
+		return(0);
+	};
 
-	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x", ipv6addr_getdword(ipv6addrp, 0), ipv6addr_getdword(ipv6addrp, 1), ipv6addr_getdword(ipv6addrp, 2), ipv6addr_getdword(ipv6addrp, 3));
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
 
-	if ((cache_lu_ipv6addr_valid == 1)
-	    && 	(memcmp(&cache_lu_ipv6addr.in6_addr, &ipv6addrp->in6_addr, sizeof(struct in6_addr)) == 0)
-	) {
-		retval= cache_lu_ipv6addr_registry_num;
-		cache_hit = 1;
-		goto END_libipv6calc_db_wrapper_cached;
+	if (cc_index != NULL) {
+		requested |= IPV6CALC_DB_ALL_CC;
 	};
 
-	const char *info = libipv6calc_db_wrapper_reserved_string_by_ipv6addr(ipv6addrp);
+	if (as_num32 != NULL) {
+		requested |= IPV6CALC_DB_ALL_AS;
+	};
 
-	if (info != NULL) {
-		retval = REGISTRY_RESERVED;
-		goto END_libipv6calc_db_wrapper;
+	if (registry != NULL) {
+		requested |= IPV6CALC_DB_ALL_REGISTRY;
 	};
 
-	if (ipv6addr_getword(ipv6addrp, 0) == 0x3ffe) {
-		// special handling of 6BONE
-		retval = REGISTRY_6BONE;
-		goto END_libipv6calc_db_wrapper;
+	entries = malloc(sizeof(s_ipv6calc_db_wrapper_batch_entry) * count);
+	if (entries == NULL) {
+		ERRORPRINT_WA("can't allocate memory for batch lookup: count=%d", count);
+		return(1);
 	};
 
-	f = IPV6CALC_DB_FEATURE_NUM_IPV6_TO_REGISTRY;
+	for (i = 0; i < count; i++) {
+		entries[i].ipaddrp = &ipaddrp[i];
+		entries[i].index = i;
+	};
 
-	// run through priorities
-	for (p = 0; p < IPV6CALC_DB_PRIO_MAX; p++) {
-		switch(wrapper_features_selector[f][p]) {
-		    case 0:
-			// last
-			goto END_libipv6calc_db_wrapper; // ok
-			break;
+	qsort(entries, count, sizeof(s_ipv6calc_db_wrapper_batch_entry), libipv6calc_db_wrapper_batch_cmp);
 
-		    case IPV6CALC_DB_SOURCE_BUILTIN:
-			if (wrapper_BuiltIn_status == 1) {
-#ifdef SUPPORT_BUILTIN
-				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now BuiltIn");
+	range.flag_valid = 0;
 
-				retval = libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(ipv6addrp);
-#endif
-			};
-			break;
+	for (i = 0; i < count; i++) {
+		ep = entries[i].ipaddrp;
 
-		    case IPV6CALC_DB_SOURCE_EXTERNAL:
-			if (wrapper_External_status == 1) {
-#ifdef SUPPORT_EXTERNAL
-				DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Call now External");
-				CONVERT_IPV6ADDRP_IPADDR(ipv6addrp, ipaddr);
-				retval = libipv6calc_db_wrapper_External_registry_num_by_addr(&ipaddr);
-#endif
-			};
-			break;
+		if ((range.flag_valid == 1)
+		    && (ep->proto == range_proto)
+		    && (libipv6calc_db_wrapper_cache_cmp(ep->addr, range.last) <= 0)
+		    && (libipv6calc_db_wrapper_batch_special(ep, requested) == 0)
+		) {
+			// sorted: inside range of previous lookup, results are identical
+			ctx->batch_reused++;
+		} else {
+			libipv6calc_db_wrapper_all_by_addr_r(ctx, ep, (cc_index != NULL) ? &cc_index_result : NULL, NULL, (as_num32 != NULL) ? &as_num32_result : NULL, (registry != NULL) ? &registry_result : NULL, &range);
+			range_proto = ep->proto;
+			ctx->batch_lookup++;
+		};
 
-		    default:
-			goto END_libipv6calc_db_wrapper; // dummy goto in case no db is enabled
-			break;
+		if (cc_index != NULL) {
+			cc_index[entries[i].index] = cc_index_result;
+		};
+
+		if (as_num32 != NULL) {
+			as_num32[entries[i].index] = as_num32_result;
+		};
+
+		if (registry != NULL) {
+			registry[entries[i].index] = registry_result;
 		};
 	};
 
-END_libipv6calc_db_wrapper:
-	// store in last used cache
-	cache_lu_ipv6addr_valid = 1;
-	cache_lu_ipv6addr_registry_num = retval;
-	cache_lu_ipv6addr.in6_addr = ipv6addrp->in6_addr;
+	free(entries);
 
-END_libipv6calc_db_wrapper_cached:
-	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Result: addr=%08x%08x%08x%08x reg=%d%s"
-		, ipv6addr_getdword(ipv6addrp, 0)
-		, ipv6addr_getdword(ipv6addrp, 1)
-		, ipv6addr_getdword(ipv6addrp, 2)
-		, ipv6addr_getdword(ipv6addrp, 3)
-		, retval
-		, (cache_hit == 1 ? " (cached)" : "")
-	);
-	return (retval);
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Finished: count=%d", count);
+
+	return(0);
 };
 
 
@@ -1972,6 +3096,8 @@ int libipv6calc_db_wrapper_info_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp,
 	ipv6calc_ipaddr ipaddr;
 #endif
 
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x", ipv4addr_getdword(ipv4addrp));
 
 	f = IPV6CALC_DB_FEATURE_NUM_IPV4_TO_INFO;
@@ -2029,6 +3155,8 @@ int libipv6calc_db_wrapper_info_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp,
 	ipv6calc_ipaddr ipaddr;
 #endif
 
+	IPV6CALC_DB_WRAPPER_SOURCES_INIT_CHECK(1)
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: addr=%08x%08x%08x%08x", ipv6addr_getdword(ipv6addrp, 0), ipv6addr_getdword(ipv6addrp, 1), ipv6addr_getdword(ipv6addrp, 2), ipv6addr_getdword(ipv6addrp, 3));
 
 	f = IPV6CALC_DB_FEATURE_NUM_IPV6_TO_INFO;
@@ -2089,6 +3217,7 @@ int libipv6calc_db_wrapper_bdb_get_data_by_key(DB *dbp, char *token, char *value
 
 	DBT key, data;
 	int ret;
+	char buffer[NI_MAXHOST];
 
 	memset(&key, 0, sizeof(key));
 	memset(&data, 0, sizeof(data));
@@ -2096,6 +3225,11 @@ int libipv6calc_db_wrapper_bdb_get_data_by_key(DB *dbp, char *token, char *value
 	key.data = token;
 	key.size = strlen(token);
 
+	// result into own buffer, required for handles opened with DB_THREAD
+	data.data = buffer;
+	data.ulen = sizeof(buffer) - 1;
+	data.flags = DB_DBT_USERMEM;
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "try to get key.data=%p key.size=%d", key.data, key.size);
 
 	if ((ret = dbp->get(dbp, NULL, &key, &data, 0)) != 0) {
@@ -2103,6 +3237,8 @@ int libipv6calc_db_wrapper_bdb_get_data_by_key(DB *dbp, char *token, char *value
 		return(-1);
 	};
 
+	buffer[data.size] = '\0';
+
 	snprintf(value, (data.size + 1) >= value_size ? value_size : data.size + 1, "%s", (char *) data.data);
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Return: dbp=%p token=%s value=%s", dbp, token, value);
@@ -2112,8 +3248,55 @@ int libipv6calc_db_wrapper_bdb_get_data_by_key(DB *dbp, char *token, char *value
 
 
 
+/*
+ * parse binary Berkeley DB row (dbformat=2)
+ *
+ * in : row_ptr = row data
+ * in : row_size = size of row data
+ * in : keys = number of expected 32-bit keys (2 or 4)
+ * in : value_expected = 1: value is expected
+ * out: key_ptr[] = keys
+ * out: *value_ptr = value (if expected)
+ * out: data_ptr = data (terminated, truncated to data_size)
+ * ret: 0 = ok, -1 = malformed row
+ */
+static int libipv6calc_db_wrapper_bdb_parse_row_binary(const uint8_t *row_ptr, const uint32_t row_size, const int keys, const int value_expected, uint32_t *key_ptr, int *value_ptr, char *data_ptr, const size_t data_size) {
+	uint32_t offset = IPV6CALC_DB_ROW_BINARY_HEADER_SIZE, word;
+	size_t length;
+	int k;
+
+	if ((row_ptr[1] != keys) \
+	  || (((row_ptr[2] & IPV6CALC_DB_ROW_BINARY_FLAG_VALUE) != 0) != (value_expected != 0)) \
+	  || (row_ptr[3] < IPV6CALC_DB_ROW_BINARY_HEADER_SIZE + 4 * (keys + value_expected)) \
+	  || (row_ptr[3] > row_size)) {
+		return(-1);
+	};
+
+	for (k = 0; k < keys; k++) {
+		memcpy(&word, row_ptr + offset, sizeof(word));
+		key_ptr[k] = ntohl(word);
+		offset += sizeof(word);
+	};
+
+	if (value_expected != 0) {
+		memcpy(&word, row_ptr + offset, sizeof(word));
+		*value_ptr = (int) ntohl(word);
+	};
+
+	length = row_size - row_ptr[3];
+	if (length >= data_size) {
+		length = data_size - 1;
+	};
+	memcpy(data_ptr, row_ptr + row_ptr[3], length);
+	data_ptr[length] = '\0';
+
+	return(0);
+};
+
+
 /*
  * generic fetch of a Berkeley DB row
+ *  supports ';' separated text rows and binary rows (see IPV6CALC_DB_ROW_BINARY_*)
  */
 int libipv6calc_db_wrapper_bdb_fetch_row(
 	DB 			*db_ptr,		// pointer to DB
@@ -2163,6 +3346,7 @@ int libipv6calc_db_wrapper_bdb_fetch_row(
 	};
 
 	char datastring[NI_MAXHOST];
+	char buffer[NI_MAXHOST];
 
 	DBT key, data;
 
@@ -2174,6 +3358,11 @@ int libipv6calc_db_wrapper_bdb_fetch_row(
 	key.data = &recno;
 	key.size = sizeof(recno);
 
+	// result into own buffer, required for handles opened with DB_THREAD
+	data.data = buffer;
+	data.ulen = sizeof(buffer) - 1;
+	data.flags = DB_DBT_USERMEM;
+
 	int ret, value;
 
 	// DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Try to get row");
@@ -2187,8 +3376,36 @@ int libipv6calc_db_wrapper_bdb_fetch_row(
 		goto END_libipv6calc_db_wrapper_bdb_fetch_row;
 	};
 
+	buffer[data.size] = '\0';
+
 	// DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper, "Got row");
 
+	if ((data.size >= IPV6CALC_DB_ROW_BINARY_HEADER_SIZE) && (((const uint8_t *) data.data)[0] == IPV6CALC_DB_ROW_BINARY_MARKER)) {
+		// binary row, fixed-width keys, no text parsing required
+		uint32_t keys[4];
+		int keys_num = (db_format_values[db_format] < 5) ? 2 : 4;
+		int value_expected = ((db_format_values[db_format] == 4) || (db_format_values[db_format] == 6)) ? 1 : 0;
+
+		if (libipv6calc_db_wrapper_bdb_parse_row_binary((const uint8_t *) data.data, data.size, keys_num, value_expected, keys, &value, (char *) data_ptr, NI_MAXHOST) != 0) {
+			ERRORPRINT_WA("binary row parsing error, corrupted database: row %u (size=%d keys=%u flags=0x%02x offset=%u expectedkeys=%d expectedvalue=%d)", recno, data.size, ((const uint8_t *) data.data)[1], ((const uint8_t *) data.data)[2], ((const uint8_t *) data.data)[3], keys_num, value_expected);
+			goto END_libipv6calc_db_wrapper_bdb_fetch_row;
+		};
+
+		if (keys_num == 2) {
+			*data_1_00_31_ptr = keys[0];
+			*data_1_32_63_ptr = 0;
+			*data_2_00_31_ptr = keys[1];
+			*data_2_32_63_ptr = 0;
+		} else {
+			*data_1_00_31_ptr = keys[0];
+			*data_1_32_63_ptr = keys[1];
+			*data_2_00_31_ptr = keys[2];
+			*data_2_32_63_ptr = keys[3];
+		};
+
+		goto END_libipv6calc_db_wrapper_bdb_fetch_row_parsed;
+	};
+
 	snprintf(datastring, (data.size + 1) >= sizeof(datastring) ? sizeof(datastring) : data.size + 1, "%s", (char *) data.data);
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "start parsing database row %u: %s (size=%d) data_ptr=%p values=%u format=%s", recno, datastring, data.size, data_ptr, db_format_values[db_format], db_format_row[db_format]);
@@ -2215,6 +3432,7 @@ int libipv6calc_db_wrapper_bdb_fetch_row(
 		goto END_libipv6calc_db_wrapper_bdb_fetch_row;
 	};
 
+END_libipv6calc_db_wrapper_bdb_fetch_row_parsed:
 	if ((db_format == IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_VALUE_32x4) \
 	  || (db_format == IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_VALUE_32x4)) {
 		retval = value; // for Longest Match
@@ -2227,11 +3445,424 @@ int libipv6calc_db_wrapper_bdb_fetch_row(
 END_libipv6calc_db_wrapper_bdb_fetch_row:
 	return(retval);
 };
+
+
+/*
+ * preload all rows of a Berkeley DB (RECNO) into memory
+ *  same layout as compiled database (1 section, identical strings stored once),
+ *  lookups are using IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP afterwards
+ * in : DB pointer, DB format, number of rows, section name
+ * ret: pointer to database in memory (free with libipv6calc_db_wrapper_mmap_close), NULL = error
+ */
+s_ipv6calc_db_mmap *libipv6calc_db_wrapper_bdb_preload(DB *dbp, const uint8_t db_format, const long int recno_max, const char *name) {
+	s_ipv6calc_db_mmap *mmapp = NULL;
+	s_ipv6calc_db_mmap_section *sectionp;
+	uint32_t *block_ptr = NULL, *keys_ptr, *values_ptr = NULL, *strings_ptr, *hash_ptr = NULL;
+	uint32_t d[4], h, hash_size = 2, pool_size = 1, pool_max = 65536, offset;
+	char *pool_ptr = NULL, *new_ptr;
+	char datastring[NI_MAXHOST];
+	const char *c;
+	size_t arrays_size, length;
+	struct timeval tv_start, tv_end;
+	long int row;
+	int ret;
+
+	int keys = ((db_format % 2) == 0) ? 2 : 4;
+	int value_expected = ((db_format == IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_VALUE_32x2) || (db_format == IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_VALUE_32x4)) ? 1 : 0;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: dbp=%p db_format=%u recno_max=%ld name=%s", dbp, db_format, recno_max, name);
+
+	gettimeofday(&tv_start, NULL);
+
+	if ((recno_max < 1) || (recno_max > INT32_MAX / 16)) {
+		ERRORPRINT_WA("unsupported number of rows for preload: %ld", recno_max);
+		goto END_libipv6calc_db_wrapper_bdb_preload;
+	};
+
+	arrays_size = (size_t) recno_max * (keys + value_expected + 1) * sizeof(uint32_t);
+
+	while (hash_size < 2 * recno_max) {
+		hash_size <<= 1;
+	};
+
+	mmapp = calloc(1, sizeof(s_ipv6calc_db_mmap));
+	block_ptr = malloc(arrays_size);
+	pool_ptr = malloc(pool_max);
+	hash_ptr = calloc(hash_size, sizeof(uint32_t)); // pool offset, 0 = empty
+
+	if ((mmapp == NULL) || (block_ptr == NULL) || (pool_ptr == NULL) || (hash_ptr == NULL)) {
+		ERRORPRINT_WA("can't allocate memory for preload of %ld rows", recno_max);
+		goto END_libipv6calc_db_wrapper_bdb_preload_error;
+	};
+
+	keys_ptr = block_ptr;
+	if (value_expected == 1) {
+		values_ptr = block_ptr + recno_max * keys;
+	};
+	strings_ptr = block_ptr + recno_max * (keys + value_expected);
+
+	pool_ptr[0] = '\0'; // offset 0: empty string
+
+	for (row = 0; row < recno_max; row++) {
+		ret = libipv6calc_db_wrapper_bdb_fetch_row(dbp, db_format, row + 1, &d[0], &d[1], &d[2], &d[3], datastring);
+		if (ret < 0) {
+			ERRORPRINT_WA("can't retrieve row for preload: %ld", row + 1);
+			goto END_libipv6calc_db_wrapper_bdb_preload_error;
+		};
+
+		if (keys == 2) {
+			keys_ptr[row * 2 + 0] = htonl(d[0]);
+			keys_ptr[row * 2 + 1] = htonl(d[2]);
+		} else {
+			keys_ptr[row * 4 + 0] = htonl(d[0]);
+			keys_ptr[row * 4 + 1] = htonl(d[1]);
+			keys_ptr[row * 4 + 2] = htonl(d[2]);
+			keys_ptr[row * 4 + 3] = htonl(d[3]);
+		};
+
+		if (value_expected == 1) {
+			values_ptr[row] = htonl((uint32_t) ret);
+		};
+
+		length = strlen(datastring);
+		offset = 0;
+
+		if (length > 0) {
+			// FNV-1a
+			h = 2166136261U;
+			for (c = datastring; *c != '\0'; c++) {
+				h = (h ^ (uint8_t) *c) * 16777619U;
+			};
+			h &= hash_size - 1;
+
+			while (hash_ptr[h] != 0) {
+				if (strcmp(pool_ptr + hash_ptr[h], datastring) == 0) {
+					offset = hash_ptr[h];
+					break;
+				};
+				h = (h + 1) & (hash_size - 1);
+			};
+
+			if (offset == 0) {
+				while (pool_size + length + 1 > pool_max) {
+					if (pool_max > INT32_MAX / 2) {
+						ERRORPRINT_NA("string pool exceeds limit for preload");
+						goto END_libipv6calc_db_wrapper_bdb_preload_error;
+					};
+					pool_max *= 2;
+					new_ptr = realloc(pool_ptr, pool_max);
+					if (new_ptr == NULL) {
+						ERRORPRINT_NA("can't allocate memory for string pool of preload");
+						goto END_libipv6calc_db_wrapper_bdb_preload_error;
+					};
+					pool_ptr = new_ptr;
+				};
+
+				memcpy(pool_ptr + pool_size, datastring, length + 1);
+				offset = pool_size;
+				hash_ptr[h] = offset;
+				pool_size += length + 1;
+			};
+		};
+
+		strings_ptr[row] = htonl(offset);
+	};
+
+	// append string pool to arrays
+	new_ptr = realloc(block_ptr, arrays_size + pool_size);
+	if (new_ptr == NULL) {
+		ERRORPRINT_NA("can't allocate memory for preload");
+		goto END_libipv6calc_db_wrapper_bdb_preload_error;
+	};
+	block_ptr = (uint32_t *) new_ptr;
+	memcpy(new_ptr + arrays_size, pool_ptr, pool_size);
+
+	sectionp = &mmapp->section[0];
+	snprintf(sectionp->name, sizeof(sectionp->name), "%s", name);
+	sectionp->rows = recno_max;
+	sectionp->keys = keys;
+	sectionp->flags = (value_expected == 1) ? IPV6CALC_DB_MMAP_FLAG_VALUE : 0;
+	sectionp->keys_ptr = block_ptr;
+	sectionp->values_ptr = (value_expected == 1) ? block_ptr + recno_max * keys : NULL;
+	sectionp->strings_ptr = block_ptr + recno_max * (keys + value_expected);
+	sectionp->pool_ptr = new_ptr + arrays_size;
+	sectionp->pool_size = pool_size;
+
+	mmapp->base_ptr = block_ptr;
+	mmapp->size = arrays_size + pool_size;
+	mmapp->sections = 1;
+	mmapp->flag_preload = 1;
+
+	gettimeofday(&tv_end, NULL);
+	mmapp->load_usec = (tv_end.tv_sec - tv_start.tv_sec) * 1000000L + (tv_end.tv_usec - tv_start.tv_usec);
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Preload finished: rows=%ld size=%lu pool=%u usec=%ld", recno_max, (unsigned long) mmapp->size, pool_size, mmapp->load_usec);
+
+	free(pool_ptr);
+	free(hash_ptr);
+	goto END_libipv6calc_db_wrapper_bdb_preload;
+
+END_libipv6calc_db_wrapper_bdb_preload_error:
+	free(block_ptr);
+	free(pool_ptr);
+	free(hash_ptr);
+	free(mmapp);
+	mmapp = NULL;
+
+END_libipv6calc_db_wrapper_bdb_preload:
+	return(mmapp);
+};
 #endif // HAVE_BERKELEY_DB_SUPPORT
 
 
+/********************************************
+ * compiled database (memory mapped) helper functions
+ ********************************************/
+
+/*
+ * open and map compiled database
+ * in : filename
+ * ret: pointer to mapped database, NULL = not available or invalid
+ */
+s_ipv6calc_db_mmap *libipv6calc_db_wrapper_mmap_open(const char *filename) {
+	s_ipv6calc_db_mmap *mmapp = NULL;
+	const uint8_t *base_ptr;
+	const uint32_t *word_ptr;
+	struct stat st;
+	uint32_t pool_offset, pool_size, rows, keys, keys_offset, values_offset, strings_offset;
+	int fd, s, sections;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called: filename=%s", filename);
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "can't open compiled database: %s (%s)", filename, strerror(errno));
+		goto END_libipv6calc_db_wrapper_mmap_open;
+	};
+
+	if ((fstat(fd, &st) != 0) || (st.st_size < IPV6CALC_DB_MMAP_HEADER_SIZE) || ((uint64_t) st.st_size > UINT32_MAX)) {
+		ERRORPRINT_WA("compiled database has unsupported size: %s", filename);
+		goto END_libipv6calc_db_wrapper_mmap_open_close;
+	};
+
+	mmapp = malloc(sizeof(s_ipv6calc_db_mmap));
+	if (mmapp == NULL) {
+		ERRORPRINT_NA("can't allocate memory for compiled database");
+		goto END_libipv6calc_db_wrapper_mmap_open_close;
+	};
+	memset(mmapp, 0, sizeof(s_ipv6calc_db_mmap));
+
+	mmapp->size = st.st_size;
+	mmapp->base_ptr = mmap(NULL, mmapp->size, PROT_READ, MAP_SHARED, fd, 0);
+	if (mmapp->base_ptr == MAP_FAILED) {
+		ERRORPRINT_WA("can't map compiled database: %s (%s)", filename, strerror(errno));
+		goto END_libipv6calc_db_wrapper_mmap_open_free;
+	};
+
+	base_ptr = (const uint8_t *) mmapp->base_ptr;
+	word_ptr = (const uint32_t *) mmapp->base_ptr;
+
+	// header
+	if ((memcmp(base_ptr, IPV6CALC_DB_MMAP_MAGIC, 8) != 0) || (ntohl(word_ptr[2]) != IPV6CALC_DB_MMAP_VERSION)) {
+		ERRORPRINT_WA("compiled database has unsupported magic/version: %s", filename);
+		goto END_libipv6calc_db_wrapper_mmap_open_unmap;
+	};
+
+	sections = ntohl(word_ptr[3]);
+	pool_offset = ntohl(word_ptr[4]);
+	pool_size = ntohl(word_ptr[5]);
+
+	if ((sections < 1) || (sections > IPV6CALC_DB_MMAP_SECTION_MAX) \
+	  || (IPV6CALC_DB_MMAP_HEADER_SIZE + (size_t) sections * IPV6CALC_DB_MMAP_SECTION_SIZE > mmapp->size) \
+	  || (pool_size < 1) || (pool_offset > mmapp->size) || (pool_size > mmapp->size - pool_offset) \
+	  || (base_ptr[pool_offset + pool_size - 1] != '\0')) {
+		ERRORPRINT_WA("compiled database has corrupt header: %s", filename);
+		goto END_libipv6calc_db_wrapper_mmap_open_unmap;
+	};
+
+	// sections, arrays are checked against mapped size once here, lookups are not checking again
+	for (s = 0; s < sections; s++) {
+		word_ptr = (const uint32_t *) (base_ptr + IPV6CALC_DB_MMAP_HEADER_SIZE + s * IPV6CALC_DB_MMAP_SECTION_SIZE);
+
+		memcpy(mmapp->section[s].name, word_ptr, IPV6CALC_DB_MMAP_SECTION_NAME_SIZE);
+		mmapp->section[s].name[IPV6CALC_DB_MMAP_SECTION_NAME_SIZE - 1] = '\0';
+
+		rows = ntohl(word_ptr[4]);
+		keys = ntohl(word_ptr[5]);
+		keys_offset = ntohl(word_ptr[7]);
+		values_offset = ntohl(word_ptr[8]);
+		strings_offset = ntohl(word_ptr[9]);
+
+		if ((rows > INT32_MAX / 4) || ((keys != 0) && (keys != 2) && (keys != 4)) \
+		  || ((keys_offset | values_offset | strings_offset) % 4 != 0) \
+		  || (keys_offset > mmapp->size) || ((uint64_t) rows * keys * 4 > mmapp->size - keys_offset) \
+		  || (values_offset > mmapp->size) || ((values_offset != 0) && ((uint64_t) rows * 4 > mmapp->size - values_offset)) \
+		  || (strings_offset > mmapp->size) || ((uint64_t) rows * 4 > mmapp->size - strings_offset)) {
+			ERRORPRINT_WA("compiled database has corrupt section %d: %s", s, filename);
+			goto END_libipv6calc_db_wrapper_mmap_open_unmap;
+		};
+
+		mmapp->section[s].rows = rows;
+		mmapp->section[s].keys = keys;
+		mmapp->section[s].flags = ntohl(word_ptr[6]);
+		mmapp->section[s].keys_ptr = (const uint32_t *) (base_ptr + keys_offset);
+		mmapp->section[s].values_ptr = (values_offset != 0) ? (const uint32_t *) (base_ptr + values_offset) : NULL;
+		mmapp->section[s].strings_ptr = (const uint32_t *) (base_ptr + strings_offset);
+		mmapp->section[s].pool_ptr = (const char *) (base_ptr + pool_offset);
+		mmapp->section[s].pool_size = pool_size;
+
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "compiled database section %d: name=%s rows=%u keys=%u flags=0x%x", s, mmapp->section[s].name, rows, keys, mmapp->section[s].flags);
+	};
+
+	mmapp->sections = sections;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "compiled database mapped: %s size=%lu sections=%d", filename, (unsigned long) mmapp->size, sections);
+	goto END_libipv6calc_db_wrapper_mmap_open_close;
+
+END_libipv6calc_db_wrapper_mmap_open_unmap:
+	munmap(mmapp->base_ptr, mmapp->size);
+
+END_libipv6calc_db_wrapper_mmap_open_free:
+	free(mmapp);
+	mmapp = NULL;
+
+END_libipv6calc_db_wrapper_mmap_open_close:
+	close(fd); // mapping stays valid
+
+END_libipv6calc_db_wrapper_mmap_open:
+	return(mmapp);
+};
+
+
+/*
+ * unmap compiled database (or free preloaded database)
+ */
+void libipv6calc_db_wrapper_mmap_close(s_ipv6calc_db_mmap *mmapp) {
+	if (mmapp == NULL) {
+		return;
+	};
+
+	if (mmapp->flag_preload == 1) {
+		free(mmapp->base_ptr);
+	} else {
+		munmap(mmapp->base_ptr, mmapp->size);
+	};
+	free(mmapp);
+};
+
+
+/*
+ * get section of compiled database
+ * in : mapped database, section name
+ * ret: pointer to section, NULL = not found
+ */
+const s_ipv6calc_db_mmap_section *libipv6calc_db_wrapper_mmap_section(const s_ipv6calc_db_mmap *mmapp, const char *name) {
+	int s;
+
+	for (s = 0; s < mmapp->sections; s++) {
+		if (strcmp(mmapp->section[s].name, name) == 0) {
+			return(&mmapp->section[s]);
+		};
+	};
+
+	return(NULL);
+};
+
+
+/*
+ * get value of token from section "info" of compiled database
+ * in : mapped database, token, max length of value
+ * out: value
+ * ret: 0=ok -1=error
+ */
+int libipv6calc_db_wrapper_mmap_get_data_by_key(const s_ipv6calc_db_mmap *mmapp, const char *token, char *value, const size_t value_size) {
+	const s_ipv6calc_db_mmap_section *sectionp;
+	const char *string_ptr;
+	size_t token_length = strlen(token);
+	uint32_t offset, r;
+
+	sectionp = libipv6calc_db_wrapper_mmap_section(mmapp, "info");
+	if (sectionp == NULL) {
+		return(-1);
+	};
+
+	for (r = 0; r < sectionp->rows; r++) {
+		offset = ntohl(sectionp->strings_ptr[r]);
+		if (offset >= sectionp->pool_size) {
+			return(-1);
+		};
+
+		string_ptr = sectionp->pool_ptr + offset;
+		if ((strncmp(string_ptr, token, token_length) == 0) && (string_ptr[token_length] == '=')) {
+			snprintf(value, value_size, "%s", string_ptr + token_length + 1);
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Return: token=%s value=%s", token, value);
+			return(0);
+		};
+	};
+
+	return(-1);
+};
+
+
+/*
+ * fetch row of compiled database section, keys are read in place
+ *  data is only copied if data_ptr is not NULL
+ * ret: value of row (for longest match) or 0 if section has no values, -1 = error
+ */
+int libipv6calc_db_wrapper_mmap_fetch_row(
+	const s_ipv6calc_db_mmap_section *sectionp,	// pointer to section
+	const long int		row,			// row number (starting with 0)
+	uint32_t		*data_1_00_31_ptr,	// data 1 (MSB in case of 64 bits)
+	uint32_t		*data_1_32_63_ptr,	// data 1 (LSB in case of 64 bits)
+	uint32_t		*data_2_00_31_ptr,	// data 2 (MSB in case of 64 bits)
+	uint32_t		*data_2_32_63_ptr,	// data 2 (LSB in case of 64 bits)
+	char			*data_ptr,		// pointer to data
+	const size_t		data_size		// size of data
+	) {
+
+	const uint32_t *key_ptr;
+	uint32_t offset;
+
+	if ((row < 0) || (row >= (long int) sectionp->rows)) {
+		return(-1);
+	};
+
+	key_ptr = sectionp->keys_ptr + row * sectionp->keys;
+
+	if (sectionp->keys == 2) {
+		*data_1_00_31_ptr = ntohl(key_ptr[0]);
+		*data_1_32_63_ptr = 0;
+		*data_2_00_31_ptr = ntohl(key_ptr[1]);
+		*data_2_32_63_ptr = 0;
+	} else if (sectionp->keys == 4) {
+		*data_1_00_31_ptr = ntohl(key_ptr[0]);
+		*data_1_32_63_ptr = ntohl(key_ptr[1]);
+		*data_2_00_31_ptr = ntohl(key_ptr[2]);
+		*data_2_32_63_ptr = ntohl(key_ptr[3]);
+	} else {
+		return(-1);
+	};
+
+	if (data_ptr != NULL) {
+		offset = ntohl(sectionp->strings_ptr[row]);
+		if (offset >= sectionp->pool_size) {
+			ERRORPRINT_WA("string offset out of range, corrupted compiled database: row %ld section %s", row, sectionp->name);
+			return(-1);
+		};
+		snprintf(data_ptr, data_size, "%s", sectionp->pool_ptr + offset);
+	};
+
+	if (sectionp->values_ptr != NULL) {
+		return((int) ntohl(sectionp->values_ptr[row]));
+	};
+
+	return(0);
+};
+
+
 /*
  * generic internal/external database lookup function
+ *  range of matching row is only reported on binary search over first/last keys (rows with constant result)
  * return:	 -1 : no lookup result
  * 		>= 0: matching row
  */
@@ -2246,7 +3877,8 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 	const uint32_t	lookup_key_00_31,	// lookup key MSB
 	const uint32_t	lookup_key_32_63,	// lookup key LSB
 	void            *data_ptr,		// pointer to DB data in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB, otherwise NULL
-	int  (*get_array_row)()			// function to get array row
+	int  (*get_array_row)(),		// function to get array row
+	ipv6calc_ipaddr_range *rangep		// range of matching row (skipped if NULL)
 	) {
 
 	int retval = -1;
@@ -2258,6 +3890,12 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 	DB *dbp = NULL;
 #endif // HAVE_BERKELEY_DB_SUPPORT
 
+	const s_ipv6calc_db_mmap_section *sectionp = NULL;
+
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Called with data_ptr_type=%u data_key_type=%u data_key_format=%u, data_key_length=%u data_num_rows=%u lookup_key_00_31=%08lx lookup_key_32_63=%08lx db_ptr=%p, data_ptr=%p",
 		data_ptr_type,
 		data_key_type,
@@ -2311,6 +3949,21 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 		break;
 #endif // HAVE_BERKELEY_DB_SUPPORT
 
+	    case IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP:
+		if (get_array_row != NULL) {
+			ERRORPRINT_NA("get_array_row function is unexpected NOT NULL (FIX CODE)");
+			exit(EXIT_FAILURE);
+		};
+
+		if ((db_ptr == NULL) || (data_ptr == NULL)) {
+			ERRORPRINT_NA("db_ptr/data_ptr is unexpected NULL - not supported on IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP (FIX CODE)");
+			exit(EXIT_FAILURE);
+		};
+
+		// supported
+		sectionp = (const s_ipv6calc_db_mmap_section *) db_ptr; // map db_ptr to section ptr
+		break;
+
 	    default:
 		ERRORPRINT_WA("unsupported data_ptr_type (FIX CODE): %u", data_ptr_type);
 		exit(EXIT_FAILURE);
@@ -2371,8 +4024,8 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 		i = i_max / 2;
 		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Start binary search over entries: data_num_rows=%u", data_num_rows);
 	} else if (data_search_type == IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_SEQLONGEST) {
-		// sequential search in provided data
-		i_old = i_max;
+		// sequential search in provided data (including last row)
+		i_old = i_max + 1;
 		i = 0;
 		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Start sequential search over entries: data_num_rows=%u", data_num_rows);
 	};
@@ -2410,6 +4063,13 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 				exit(EXIT_FAILURE);
 			};
 #endif // HAVE_BERKELEY_DB_SUPPORT
+		} else if (data_ptr_type == IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP) {
+			// keys only, data is copied after match
+			ret = libipv6calc_db_wrapper_mmap_fetch_row(sectionp, i, &value_first_00_31, &value_first_32_63, &value_last_00_31, &value_last_32_63, NULL, 0);
+			if (ret < 0) {
+				ERRORPRINT_WA("can't retrieve keys from compiled database for row: %ld", i);
+				exit(EXIT_FAILURE);
+			};
 		};
 
 		if (data_key_length == 32) {
@@ -2661,6 +4321,37 @@ long int libipv6calc_db_wrapper_get_entry_generic(
 			};
 		};
 
+		if (data_ptr_type == IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP) {
+			// copy data of matching row
+			ret = libipv6calc_db_wrapper_mmap_fetch_row(sectionp, match, &value_first_00_31, &value_first_32_63, &value_last_00_31, &value_last_32_63, (char *) data_ptr, NI_MAXHOST);
+			if (ret < 0) {
+				ERRORPRINT_WA("can't retrieve data from compiled database for row: %ld", match);
+				exit(EXIT_FAILURE);
+			};
+		};
+
+		if ((rangep != NULL) && (data_key_type == IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST) && (data_search_type == IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY)) {
+			// keys of matching row
+			rangep->first[0] = value_first_00_31;
+			rangep->last[0]  = value_last_00_31;
+			if (data_key_length == 32) {
+				rangep->first[1] = 0;
+				rangep->last[1]  = 0;
+				rangep->first[2] = 0;
+				rangep->last[2]  = 0;
+				rangep->first[3] = 0;
+				rangep->last[3]  = 0;
+			} else {
+				rangep->first[1] = value_first_32_63;
+				rangep->last[1]  = value_last_32_63;
+				rangep->first[2] = 0;
+				rangep->last[2]  = 0xffffffff;
+				rangep->first[3] = 0;
+				rangep->last[3]  = 0xffffffff;
+			};
+			rangep->flag_valid = 1;
+		};
+
 		if (data_ptr != NULL) {
 			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper, "Finished with success result (DB): match=%ld", match);
 		};
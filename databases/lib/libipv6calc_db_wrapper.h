@@ -216,6 +216,7 @@ typedef struct {
 #ifdef HAVE_BERKELEY_DB_SUPPORT
 #define IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB		2	 // Berkeley DB
 #endif // HAVE_BERKELEY_DB_SUPPORT
+#define IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP		3	 // compiled database (memory mapped)
 
 // data storage type
 #define IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST	1	 // key is first-last
@@ -225,6 +226,80 @@ typedef struct {
 #define IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY	1	 // binary search
 #define IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_SEQLONGEST	2	 // sequential longest match
 
+/*
+ * type-specialized search kernels for arrays of structs
+ *  replacement of libipv6calc_db_wrapper_get_entry_generic in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,
+ *  keys are read directly from the row struct (no callback), no runtime checks of key/search type
+ *
+ * BINARY: same walk as the generic function (incl. workaround for last entry and loop/limit detection)
+ *  cmp: < 0 = to high in array, jump down; > 0 = to low in array, jump up; 0 = hit
+ *
+ * defines: static long int name(const row_type *table, const uint32_t num_rows, const uint32_t key_00_31, const uint32_t key_32_63)
+ * return: matching row, -1 = no match
+ */
+#define IPV6CALC_DB_LOOKUP_KERNEL_BINARY(name, row_type, cmp) \
+static long int name(const row_type *table, const uint32_t num_rows, const uint32_t key_00_31, const uint32_t key_32_63) { \
+	long int i, i_min = 0, i_max = (long int) num_rows - 1, i_old = -1, i_old2 = -1; \
+	int c, count = 0, count_max = 1; \
+	uint32_t n; \
+	const row_type *row; \
+	(void) key_32_63; /* unused by 32 bit kernels */ \
+	if (num_rows == 0) { return(-1); }; \
+	for (n = num_rows; n > 1; n >>= 1) { count_max++; }; \
+	i = i_max / 2; \
+	while (i_old != i) { \
+		row = &table[i]; \
+		c = (cmp); \
+		if (c < 0) { i_max = i; } else if (c > 0) { i_min = i; } else { return(i); }; \
+		i_old2 = i_old; \
+		i_old = i; \
+		i = (i_max - i_min) / 2 + i_min; \
+		count++; \
+		if ((i == i_old) && ((i + 1) == ((long int) num_rows - 1))) { i = i_max; }; \
+		if (i_old2 == i) { break; }; \
+		if (count > count_max) { break; }; \
+	}; \
+	return(-1); \
+}
+
+// FIRST_LAST / 32 bit key / BINARY
+#define IPV6CALC_DB_LOOKUP_KERNEL_FIRST_LAST_32(name, row_type, first, last) \
+	IPV6CALC_DB_LOOKUP_KERNEL_BINARY(name, row_type, \
+		(key_00_31 < row->first) ? -1 : ((key_00_31 > row->last) ? 1 : 0))
+
+// FIRST_LAST / 64 bit key / BINARY
+#define IPV6CALC_DB_LOOKUP_KERNEL_FIRST_LAST_64(name, row_type, first_00_31, first_32_63, last_00_31, last_32_63) \
+	IPV6CALC_DB_LOOKUP_KERNEL_BINARY(name, row_type, \
+		(key_00_31 < row->first_00_31) ? -1 : \
+		(key_00_31 > row->last_00_31) ? 1 : \
+		((key_00_31 == row->first_00_31) && (key_32_63 < row->first_32_63)) ? -1 : \
+		((key_00_31 == row->last_00_31) && (key_32_63 > row->last_32_63)) ? 1 : 0)
+
+// BASE_MASK / 32 bit key / BINARY
+#define IPV6CALC_DB_LOOKUP_KERNEL_BASE_MASK_32(name, row_type, base, mask) \
+	IPV6CALC_DB_LOOKUP_KERNEL_BINARY(name, row_type, \
+		((key_00_31 & row->mask) < row->base) ? -1 : (((key_00_31 & row->mask) > row->base) ? 1 : 0))
+
+// BASE_MASK / 64 bit key / BINARY
+#define IPV6CALC_DB_LOOKUP_KERNEL_BASE_MASK_64(name, row_type, base_00_31, base_32_63, mask_00_31, mask_32_63) \
+	IPV6CALC_DB_LOOKUP_KERNEL_BINARY(name, row_type, \
+		((key_00_31 & row->mask_00_31) < row->base_00_31) ? -1 : \
+		((key_00_31 & row->mask_00_31) > row->base_00_31) ? 1 : \
+		((key_32_63 & row->mask_32_63) < row->base_32_63) ? -1 : \
+		((key_32_63 & row->mask_32_63) > row->base_32_63) ? 1 : 0)
+
+// BASE_MASK / 64 bit key / SEQLONGEST (last matching row wins)
+#define IPV6CALC_DB_LOOKUP_KERNEL_BASE_MASK_64_SEQLONGEST(name, row_type, base_00_31, base_32_63, mask_00_31, mask_32_63) \
+static long int name(const row_type *table, const uint32_t num_rows, const uint32_t key_00_31, const uint32_t key_32_63) { \
+	long int i, match = -1; \
+	for (i = 0; i < (long int) num_rows; i++) { \
+		if (((key_00_31 & table[i].mask_00_31) == table[i].base_00_31) && ((key_32_63 & table[i].mask_32_63) == table[i].base_32_63)) { \
+			match = i; \
+		}; \
+	}; \
+	return(match); \
+}
+
 // Berkeley DB  lookup function
 #ifdef HAVE_BERKELEY_DB_SUPPORT
 #define IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_DEC_32x2		0
@@ -236,6 +311,17 @@ typedef struct {
 #define IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_PREFIX_32x2	6
 #define IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_PREFIX_32x4	7
 
+// binary row format (dbformat=2), accepted in addition to ';' separated text rows (dbformat=1)
+//  byte 0   : marker (0x00, text rows never start with NUL)
+//  byte 1   : number of 32-bit keys (2 or 4)
+//  byte 2   : flags (IPV6CALC_DB_ROW_BINARY_FLAG_*)
+//  byte 3   : offset of data
+//  byte 4-  : keys, value (if flagged), all 32-bit in network byte order
+//  offset-  : data (not terminated) up to end of row
+#define IPV6CALC_DB_ROW_BINARY_MARKER		0x00
+#define IPV6CALC_DB_ROW_BINARY_FLAG_VALUE	0x01
+#define IPV6CALC_DB_ROW_BINARY_HEADER_SIZE	4
+
 // database info/data
 typedef struct {
 	DB *db_info_ptr;
@@ -245,6 +331,122 @@ typedef struct {
 
 #endif // HAVE_BERKELEY_DB_SUPPORT
 
+// compiled database format (read-only, memory mapped, created by tools/ipv6calc-db-compile.pl)
+//  all words are 32-bit in network byte order, all offsets are relative to file start and 4-byte aligned
+//  header   : magic (8 bytes), version, number of sections, offset and size of string pool, 2x reserved
+//  section  : name (16 bytes, NUL padded), rows, keys per row (0/2/4), flags (IPV6CALC_DB_MMAP_FLAG_*),
+//             offset of key array (rows x keys), offset of value array (rows, 0 = none),
+//             offset of string array (rows, offsets into string pool), reserved
+//  pool     : NUL terminated strings
+//  sections "data", "data-iana", "data-info" keep the row order of the Berkeley DB sub-databases,
+//  section "info" has no keys, strings are "token=value"
+#define IPV6CALC_DB_MMAP_MAGIC			"IP6CDBM"	// incl. terminating NUL: 8 bytes
+#define IPV6CALC_DB_MMAP_VERSION		1
+#define IPV6CALC_DB_MMAP_SUFFIX			"m"	// appended to Berkeley DB filename
+#define IPV6CALC_DB_MMAP_HEADER_SIZE		32
+#define IPV6CALC_DB_MMAP_SECTION_SIZE		48
+#define IPV6CALC_DB_MMAP_SECTION_NAME_SIZE	16
+#define IPV6CALC_DB_MMAP_SECTION_MAX		4
+#define IPV6CALC_DB_MMAP_FLAG_VALUE		0x01
+
+typedef struct {
+	char		name[IPV6CALC_DB_MMAP_SECTION_NAME_SIZE];
+	uint32_t	rows;
+	uint32_t	keys;
+	uint32_t	flags;
+	const uint32_t	*keys_ptr;
+	const uint32_t	*values_ptr;	// NULL = no values
+	const uint32_t	*strings_ptr;
+	const char	*pool_ptr;
+	uint32_t	pool_size;
+} s_ipv6calc_db_mmap_section;
+
+typedef struct {
+	void		*base_ptr;
+	size_t		size;
+	int		sections;
+	s_ipv6calc_db_mmap_section section[IPV6CALC_DB_MMAP_SECTION_MAX];
+	int		flag_preload;	// 1: memory allocated by preload (Berkeley DB), 0: file mapped
+	long int	load_usec;	// time used for preload
+} s_ipv6calc_db_mmap;
+
+extern s_ipv6calc_db_mmap *libipv6calc_db_wrapper_mmap_open(const char *filename);
+extern void libipv6calc_db_wrapper_mmap_close(s_ipv6calc_db_mmap *mmapp);
+extern const s_ipv6calc_db_mmap_section *libipv6calc_db_wrapper_mmap_section(const s_ipv6calc_db_mmap *mmapp, const char *name);
+extern int libipv6calc_db_wrapper_mmap_get_data_by_key(const s_ipv6calc_db_mmap *mmapp, const char *token, char *value, const size_t value_size);
+extern int libipv6calc_db_wrapper_mmap_fetch_row(const s_ipv6calc_db_mmap_section *sectionp, const long int row, uint32_t *data_1_00_31_ptr, uint32_t *data_1_32_63_ptr, uint32_t *data_2_00_31_ptr, uint32_t *data_2_32_63_ptr, char *data_ptr, const size_t data_size);
+
+// range cache types
+#define IPV6CALC_DB_CACHE_REGISTRY	0
+#define IPV6CALC_DB_CACHE_CC		1
+#define IPV6CALC_DB_CACHE_AS		2
+#define IPV6CALC_DB_CACHE_MAX		(2 + 1)
+
+#define IPV6CALC_DB_CACHE_SIZE_DEFAULT	1024	// entries per type and protocol
+#define IPV6CALC_DB_CACHE_SIZE_MAX	1048576
+
+#define IPV6CALC_DB_CACHE_PROTO_IPV4	0
+#define IPV6CALC_DB_CACHE_PROTO_IPV6	1
+#define IPV6CALC_DB_CACHE_PROTO_MAX	(1 + 1)
+
+typedef struct {
+	ipv6calc_ipaddr_range range;
+	uint32_t value;			// CountryCode index, AS number or registry number
+} s_ipv6calc_db_wrapper_cache_entry;
+
+typedef struct {
+	s_ipv6calc_db_wrapper_cache_entry *entry;
+	int entries;			// used entries
+	unsigned long int hit;
+	unsigned long int miss;
+} s_ipv6calc_db_wrapper_cache;
+
+// last used cache
+typedef struct {
+	ipv6calc_ipaddr	ipaddr;
+	uint16_t	cc_index;
+	unsigned int	data_source;
+	uint32_t	as_num32;
+	int		registry;
+	ipv6calc_ipaddr_range range;	// range with identical results (lu_all only)
+	int		valid;
+} s_ipv6calc_db_wrapper_ctx_lastused;
+
+// lookup context of reentrant functions (libipv6calc_db_wrapper_*_r), one per thread
+typedef struct {
+	s_ipv6calc_db_wrapper_cache cache[IPV6CALC_DB_CACHE_MAX][IPV6CALC_DB_CACHE_PROTO_MAX];
+	int		cache_disabled;	// 1: memory allocation failed
+
+	s_ipv6calc_db_wrapper_ctx_lastused lu_cc;
+	s_ipv6calc_db_wrapper_ctx_lastused lu_as;
+	s_ipv6calc_db_wrapper_ctx_lastused lu_all;
+
+	ipv6calc_ipv4addr lu_ipv4addr;
+	uint32_t	lu_ipv4addr_registry_num;
+	int		lu_ipv4addr_valid;
+
+	ipv6calc_ipv6addr lu_ipv6addr;
+	uint32_t	lu_ipv6addr_registry_num;
+	int		lu_ipv6addr_valid;
+
+	unsigned long int batch_lookup;	// batch lookup: addresses looked up
+	unsigned long int batch_reused;	// batch lookup: addresses inside range of previous lookup
+} s_ipv6calc_db_wrapper_ctx;
+
+// reentrant functions
+extern int         libipv6calc_db_wrapper_ctx_init(s_ipv6calc_db_wrapper_ctx *ctx);
+extern void        libipv6calc_db_wrapper_ctx_cleanup(s_ipv6calc_db_wrapper_ctx *ctx);
+extern void        libipv6calc_db_wrapper_ctx_bind(s_ipv6calc_db_wrapper_ctx *ctx);
+extern int         libipv6calc_db_wrapper_ctx_threadsafe(void);
+extern void        libipv6calc_db_wrapper_ctx_print_cache_statistics(const s_ipv6calc_db_wrapper_ctx *ctx, const char *prefix_string);
+extern uint16_t    libipv6calc_db_wrapper_cc_index_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, unsigned int *data_source_ptr);
+extern uint32_t    libipv6calc_db_wrapper_as_num32_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp);
+extern int         libipv6calc_db_wrapper_registry_num_by_ipaddr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp);
+extern int         libipv6calc_db_wrapper_all_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry, ipv6calc_ipaddr_range *rangep);
+extern int         libipv6calc_db_wrapper_batch_by_addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipaddr *ipaddrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry);
+extern int         libipv6calc_db_wrapper_registry_num_by_ipv4addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipv4addr *ipv4addrp);
+extern int         libipv6calc_db_wrapper_registry_num_by_ipv6addr_r(s_ipv6calc_db_wrapper_ctx *ctx, const ipv6calc_ipv6addr *ipv6addrp);
+
 #define IPV6CALC_DB_LIB_VERSION_CHECK_EXIT(version_numeric, version_string) \
 	if (version_numeric != libipv6calc_db_lib_version_numeric()) { \
 		ERRORPRINT_WA("Database library version is not matching: has:%s required:%s", libipv6calc_db_lib_version_string(), version_string); \
@@ -264,6 +466,11 @@ extern void libipv6calc_db_wrapper_print_db_info(const int level_verbose, const
 extern int  libipv6calc_db_wrapper_has_features(uint32_t features);
 extern int  libipv6calc_db_wrapper_options(const int opt, const char *optarg, const struct option longopts[]);
 extern const char *libipv6calc_db_wrapper_get_data_source_name_by_number(const unsigned int number);
+extern void libipv6calc_db_wrapper_print_cache_statistics(const char *prefix_string);
+
+extern int  libipv6calc_db_wrapper_cache_size;
+extern int  libipv6calc_db_wrapper_preload;
+extern int  libipv6calc_db_wrapper_init_eager;
 
 
 /* functional wrappers */
@@ -287,6 +494,13 @@ extern int         libipv6calc_db_wrapper_registry_num_by_cc_index(const uint16_
 extern int         libipv6calc_db_wrapper_registry_num_by_ipaddr(const ipv6calc_ipaddr *ipaddrp);
 extern int         libipv6calc_db_wrapper_registry_string_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *resultstring, const size_t resultstring_length);
 
+// CountryCode/Autonomous System/Registry in one run
+extern int         libipv6calc_db_wrapper_all_by_addr(const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry);
+extern int         libipv6calc_db_wrapper_all_by_addr_range(const ipv6calc_ipaddr *ipaddrp, uint16_t *cc_index, unsigned int *data_source_ptr, uint32_t *as_num32, int *registry, ipv6calc_ipaddr_range *rangep);
+
+// Batch lookup
+extern int         libipv6calc_db_wrapper_batch_by_addr(const ipv6calc_ipaddr *ipaddrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry);
+
 // IEEE
 extern int libipv6calc_db_wrapper_ieee_vendor_string_by_macaddr(char *resultstring, const size_t resultstring_length, const ipv6calc_macaddr *macaddrp);
 extern int libipv6calc_db_wrapper_ieee_vendor_string_short_by_macaddr(char *resultstring, const size_t resultstring_length, const ipv6calc_macaddr *macaddrp);
@@ -304,11 +518,12 @@ extern int libipv6calc_db_wrapper_info_by_ipv6addr(const ipv6calc_ipv6addr *ipv6
 
 #ifdef HAVE_BERKELEY_DB_SUPPORT
 extern int libipv6calc_db_wrapper_bdb_get_data_by_key(DB *dbp, char *token, char *value, const size_t value_size);
+extern s_ipv6calc_db_mmap *libipv6calc_db_wrapper_bdb_preload(DB *dbp, const uint8_t db_format, const long int recno_max, const char *name);
 #endif // HAVE_BERKELEY_DB_SUPPORT
 
 // generic DB lookup
 extern long int libipv6calc_db_wrapper_get_entry_generic(
-	void 		*db_ptr,		// pointer to database in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB, otherwise NULL
+	void 		*db_ptr,		// pointer to database in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB/MMAP, otherwise NULL
 	const uint8_t	data_ptr_type,		// type of data_ptr
 	const uint8_t	data_key_type,		// key type
 	const uint8_t   data_key_format,        // key format
@@ -317,8 +532,9 @@ extern long int libipv6calc_db_wrapper_get_entry_generic(
 	const uint32_t	data_num_rows,		// number of rows
 	const uint32_t	lookup_key_00_31,	// lookup key MSB
 	const uint32_t	lookup_key_32_63,	// lookup key LSB
-	void            *data_ptr,		// pointer to DB data in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB, otherwise NULL
-	int  (*get_array_row)()			// function to get array row
+	void            *data_ptr,		// pointer to DB data in case of IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB/MMAP, otherwise NULL
+	int  (*get_array_row)(),		// function to get array row
+	ipv6calc_ipaddr_range *rangep		// range of matching row (skipped if NULL)
 	);
 
 /* filter powered by database */
@@ -58,7 +58,9 @@ static uint32_t builtin_db_usage_map[BUILTIN_DB_MAX_BLOCKS_32];
 
 #define BUILTIN_DB_USAGE_MAP_TAG(db)	if (db < (32 * BUILTIN_DB_MAX_BLOCKS_32)) { \
 							DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Tag usage for db: %d", db); \
-							builtin_db_usage_map[db / 32] |= 1 << (db % 32); \
+							if ((__atomic_load_n(&builtin_db_usage_map[db / 32], __ATOMIC_RELAXED) & (1U << (db % 32))) == 0) { \
+								__atomic_fetch_or(&builtin_db_usage_map[db / 32], 1U << (db % 32), __ATOMIC_RELAXED); \
+							}; \
 						} else { \
 							fprintf(stderr, "FIXME: unsupported db value (exceed limit): %d (%d)\n", db, 32 * BUILTIN_DB_MAX_BLOCKS_32 - 1); \
 							exit(1); \
@@ -66,6 +68,635 @@ static uint32_t builtin_db_usage_map[BUILTIN_DB_MAX_BLOCKS_32];
 
 char builtin_db_usage_string[NI_MAXHOST] = "";
 
+int builtin_lookup_generic = 0; // 1: use only generic lookup function (no compiled index)
+
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IPV6_REG
+/*
+ * multibit trie (stride 8 bit) for longest prefix match over the 64-bit prefixes of dbipv6addr_assignment
+ *
+ * each slot stores the highest row number of all prefixes covering the slot on this level,
+ * lookup takes the highest row number found along the path, which results in the same row
+ * as the sequential scan (last matching row wins, table is sorted by prefix and length)
+ */
+#define BUILTIN_IPV6_TRIE_STRIDE	8
+#define BUILTIN_IPV6_TRIE_SLOTS		(1 << BUILTIN_IPV6_TRIE_STRIDE)
+#define BUILTIN_IPV6_TRIE_LEVELS	(64 / BUILTIN_IPV6_TRIE_STRIDE)
+
+typedef struct {
+	int32_t  row[BUILTIN_IPV6_TRIE_SLOTS];		// highest matching row, -1: none
+	uint32_t child[BUILTIN_IPV6_TRIE_SLOTS];	// index of child node, 0: none (0 is root)
+} s_builtin_ipv6_trie_node;
+
+static s_builtin_ipv6_trie_node *builtin_ipv6_trie = NULL;
+static uint32_t builtin_ipv6_trie_nodes = 0;
+static uint32_t builtin_ipv6_trie_nodes_max = 0;
+
+
+/*
+ * free IPv6 trie
+ */
+static void libipv6calc_db_wrapper_BuiltIn_ipv6_trie_free(void) {
+	if (builtin_ipv6_trie != NULL) {
+		free(builtin_ipv6_trie);
+		builtin_ipv6_trie = NULL;
+	};
+	builtin_ipv6_trie_nodes = 0;
+	builtin_ipv6_trie_nodes_max = 0;
+};
+
+
+/*
+ * allocate new IPv6 trie node
+ * ret: index of node, 0 = error (root is always 0)
+ */
+static uint32_t libipv6calc_db_wrapper_BuiltIn_ipv6_trie_node_new(void) {
+	s_builtin_ipv6_trie_node *ptr;
+	int i;
+
+	if (builtin_ipv6_trie_nodes >= builtin_ipv6_trie_nodes_max) {
+		uint32_t nodes_max_new = (builtin_ipv6_trie_nodes_max == 0) ? 16 : builtin_ipv6_trie_nodes_max * 2;
+
+		ptr = realloc(builtin_ipv6_trie, nodes_max_new * sizeof(s_builtin_ipv6_trie_node));
+		if (ptr == NULL) {
+			ERRORPRINT_WA("can't allocate memory for IPv6 trie nodes: %u", nodes_max_new);
+			return(0);
+		};
+
+		builtin_ipv6_trie = ptr;
+		builtin_ipv6_trie_nodes_max = nodes_max_new;
+	};
+
+	for (i = 0; i < BUILTIN_IPV6_TRIE_SLOTS; i++) {
+		builtin_ipv6_trie[builtin_ipv6_trie_nodes].row[i] = -1;
+		builtin_ipv6_trie[builtin_ipv6_trie_nodes].child[i] = 0;
+	};
+
+	builtin_ipv6_trie_nodes++;
+
+	return(builtin_ipv6_trie_nodes - 1);
+};
+
+
+/*
+ * create IPv6 trie from dbipv6addr_assignment
+ * out: 0=ok, 1=error (trie not available)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ipv6_trie_create(void) {
+	uint32_t row, node, child, slot, slot_first, slot_last;
+	uint64_t base, mask;
+	int length, level, l;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Create IPv6 trie for rows: %lu", (unsigned long int) MAXENTRIES_ARRAY(dbipv6addr_assignment));
+
+	libipv6calc_db_wrapper_BuiltIn_ipv6_trie_free();
+
+	// root node
+	libipv6calc_db_wrapper_BuiltIn_ipv6_trie_node_new();
+	if (builtin_ipv6_trie == NULL) {
+		return(1);
+	};
+
+	for (row = 0; row < MAXENTRIES_ARRAY(dbipv6addr_assignment); row++) {
+		base = ((uint64_t) dbipv6addr_assignment[row].ipv6addr_00_31 << 32) | dbipv6addr_assignment[row].ipv6addr_32_63;
+		mask = ((uint64_t) dbipv6addr_assignment[row].ipv6mask_00_31 << 32) | dbipv6addr_assignment[row].ipv6mask_32_63;
+
+		// only contiguous masks are supported, base must not contain bits outside mask
+		if ((((~mask) & ((~mask) + 1)) != 0) || ((base & ~mask) != 0)) {
+			ERRORPRINT_WA("unsupported base/mask in dbipv6addr_assignment row %u, trie disabled", row);
+			libipv6calc_db_wrapper_BuiltIn_ipv6_trie_free();
+			return(1);
+		};
+
+		length = libipv6calc_bitcount_uint32_t(mask >> 32) + libipv6calc_bitcount_uint32_t(mask & 0xffffffff);
+
+		// level containing the last bit of the prefix
+		level = (length == 0) ? 0 : (length - 1) / BUILTIN_IPV6_TRIE_STRIDE;
+
+		// walk down, create missing nodes
+		node = 0;
+		for (l = 0; l < level; l++) {
+			slot = (base >> (64 - (l + 1) * BUILTIN_IPV6_TRIE_STRIDE)) & (BUILTIN_IPV6_TRIE_SLOTS - 1);
+			child = builtin_ipv6_trie[node].child[slot];
+			if (child == 0) {
+				child = libipv6calc_db_wrapper_BuiltIn_ipv6_trie_node_new();
+				if (child == 0) {
+					libipv6calc_db_wrapper_BuiltIn_ipv6_trie_free();
+					return(1);
+				};
+				builtin_ipv6_trie[node].child[slot] = child;
+			};
+			node = child;
+		};
+
+		// expand prefix into slots of level
+		slot_first = (base >> (64 - (level + 1) * BUILTIN_IPV6_TRIE_STRIDE)) & (BUILTIN_IPV6_TRIE_SLOTS - 1);
+		slot_last  = slot_first + (1 << ((level + 1) * BUILTIN_IPV6_TRIE_STRIDE - length)) - 1;
+
+		for (slot = slot_first; slot <= slot_last; slot++) {
+			if ((int32_t) row > builtin_ipv6_trie[node].row[slot]) {
+				builtin_ipv6_trie[node].row[slot] = row;
+			};
+		};
+	};
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IPv6 trie created, nodes: %u", builtin_ipv6_trie_nodes);
+	return(0);
+};
+
+
+/*
+ * lookup in IPv6 trie
+ * out: *length_ptr = length of prefix covered by the walked path (result is constant inside), skipped if NULL
+ * ret: matching row, -1 = no match
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ipv6_trie_lookup(const uint32_t ipv6_00_31, const uint32_t ipv6_32_63, int *length_ptr) {
+	uint64_t key = ((uint64_t) ipv6_00_31 << 32) | ipv6_32_63;
+	uint32_t node = 0;
+	int32_t match = -1;
+	int l, slot;
+
+	for (l = 0; l < BUILTIN_IPV6_TRIE_LEVELS; l++) {
+		slot = (key >> (64 - (l + 1) * BUILTIN_IPV6_TRIE_STRIDE)) & (BUILTIN_IPV6_TRIE_SLOTS - 1);
+
+		if (builtin_ipv6_trie[node].row[slot] > match) {
+			match = builtin_ipv6_trie[node].row[slot];
+		};
+
+		node = builtin_ipv6_trie[node].child[slot];
+		if (node == 0) {
+			break;
+		};
+	};
+
+	if (length_ptr != NULL) {
+		*length_ptr = (l < BUILTIN_IPV6_TRIE_LEVELS) ? (l + 1) * BUILTIN_IPV6_TRIE_STRIDE : 64;
+	};
+
+	return(match);
+};
+#endif
+
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IPV4_REG
+/*
+ * direct-indexed table (16 bit first level) for IPv4 range tables
+ *
+ * each bucket covers a /16 and points to the rows of the (sorted, non-overlapping) table
+ * overlapping it, lookup is bucket fetch plus compare (binary search in case of more rows)
+ * created on first lookup, memory: 65536 * sizeof(s_builtin_ipv4_index_bucket) per table
+ */
+#define BUILTIN_IPV4_INDEX_BUCKETS	(1 << 16)
+
+#define BUILTIN_IPV4_INDEX_ASSIGNMENT		0
+#define BUILTIN_IPV4_INDEX_ASSIGNMENT_IANA	1
+#define BUILTIN_IPV4_INDEX_MAX			(1 + 1)
+
+typedef struct {
+	uint16_t row;		// first row overlapping the bucket
+	uint16_t count;		// number of rows overlapping the bucket
+} s_builtin_ipv4_index_bucket;
+
+typedef struct {
+	int state;				// 0: not created, 1: created, -1: not available
+	s_builtin_ipv4_index_bucket *bucket;
+} s_builtin_ipv4_index;
+
+static s_builtin_ipv4_index builtin_ipv4_index[BUILTIN_IPV4_INDEX_MAX];
+
+
+/*
+ * free IPv4 index
+ */
+static void libipv6calc_db_wrapper_BuiltIn_ipv4_index_free(void) {
+	int i;
+
+	for (i = 0; i < BUILTIN_IPV4_INDEX_MAX; i++) {
+		if (builtin_ipv4_index[i].bucket != NULL) {
+			free(builtin_ipv4_index[i].bucket);
+			builtin_ipv4_index[i].bucket = NULL;
+		};
+		builtin_ipv4_index[i].state = 0;
+	};
+};
+#endif
+
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_AS_REG
+/*
+ * Eytzinger layout (implicit binary tree in BFS order) for 32-bit range tables
+ *
+ * search keys (first) are stored separately from last and row number (SoA), the search walks
+ * down the tree branchless, the top levels share cache lines and are prefetched
+ * created on first use from a sorted table of non-overlapping ranges
+ *
+ * used for the ASN table only, the IPv4 assignment tables are looked up by the /16
+ * direct-indexed table and the IPv6 assignment table by the multibit trie, both touch
+ * fewer cache lines per lookup than a tree search over the whole table
+ */
+#define BUILTIN_EYTZINGER_ASN			0
+#define BUILTIN_EYTZINGER_MAX			(0 + 1)
+
+typedef struct {
+	int state;		// 0: not created, 1: created, -1: not available
+	uint32_t num_rows;
+	uint32_t *first;	// search keys, index 1..num_rows ([0] unused)
+	uint32_t *last;		// last of range
+	uint32_t *row;		// row number in original table
+} s_builtin_eytzinger;
+
+static s_builtin_eytzinger builtin_eytzinger[BUILTIN_EYTZINGER_MAX];
+
+
+/*
+ * free Eytzinger layouts
+ */
+static void libipv6calc_db_wrapper_BuiltIn_eytzinger_free(void) {
+	int i;
+
+	for (i = 0; i < BUILTIN_EYTZINGER_MAX; i++) {
+		free(builtin_eytzinger[i].first);
+		free(builtin_eytzinger[i].last);
+		free(builtin_eytzinger[i].row);
+		builtin_eytzinger[i].first = NULL;
+		builtin_eytzinger[i].last = NULL;
+		builtin_eytzinger[i].row = NULL;
+		builtin_eytzinger[i].num_rows = 0;
+		builtin_eytzinger[i].state = 0;
+	};
+};
+
+
+/*
+ * fill Eytzinger layout by in-order walk of the implicit tree
+ * in : row = next row of sorted table, k = tree node
+ * out: next row
+ */
+static uint32_t libipv6calc_db_wrapper_BuiltIn_eytzinger_fill(s_builtin_eytzinger *eytzinger, int (*get_array_row)(), uint32_t row, const uint32_t k) {
+	uint32_t first_32_63, last_32_63;
+
+	if (k <= eytzinger->num_rows) {
+		row = libipv6calc_db_wrapper_BuiltIn_eytzinger_fill(eytzinger, get_array_row, row, 2 * k);
+		get_array_row(row, &eytzinger->first[k], &first_32_63, &eytzinger->last[k], &last_32_63);
+		eytzinger->row[k] = row;
+		row++;
+		row = libipv6calc_db_wrapper_BuiltIn_eytzinger_fill(eytzinger, get_array_row, row, 2 * k + 1);
+	};
+
+	return(row);
+};
+
+
+/*
+ * create Eytzinger layout for a sorted table of non-overlapping ranges
+ *
+ * in : num = BUILTIN_EYTZINGER_*
+ * in : num_rows = number of rows of table
+ * in : get_array_row = callback function for retrieving first/last of a row
+ * out: 0=ok, 1=error (layout not available)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_eytzinger_create(const int num, const uint32_t num_rows, int (*get_array_row)()) {
+	s_builtin_eytzinger *eytzinger = &builtin_eytzinger[num];
+	uint32_t row, first, last, first_32_63, last_32_63, last_prev = 0;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Create Eytzinger layout %d for rows: %u", num, num_rows);
+
+	eytzinger->state = -1;
+
+	for (row = 0; row < num_rows; row++) {
+		if (get_array_row(row, &first, &first_32_63, &last, &last_32_63) != 0) {
+			return(1);
+		};
+
+		if ((first > last) || ((row > 0) && (first <= last_prev))) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Eytzinger layout %d not possible, row %u not sorted or overlapping: %08x-%08x", num, row, first, last);
+			return(1);
+		};
+		last_prev = last;
+	};
+
+	eytzinger->num_rows = num_rows;
+	eytzinger->first = malloc((num_rows + 1) * sizeof(uint32_t));
+	eytzinger->last  = malloc((num_rows + 1) * sizeof(uint32_t));
+	eytzinger->row   = malloc((num_rows + 1) * sizeof(uint32_t));
+
+	if ((eytzinger->first == NULL) || (eytzinger->last == NULL) || (eytzinger->row == NULL)) {
+		ERRORPRINT_WA("can't allocate memory for Eytzinger layout %d", num);
+		free(eytzinger->first);
+		free(eytzinger->last);
+		free(eytzinger->row);
+		eytzinger->first = NULL;
+		eytzinger->last = NULL;
+		eytzinger->row = NULL;
+		return(1);
+	};
+
+	libipv6calc_db_wrapper_BuiltIn_eytzinger_fill(eytzinger, get_array_row, 0, 1);
+
+	eytzinger->state = 1;
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Eytzinger layout %d created, memory: %lu bytes", num, (unsigned long int) ((num_rows + 1) * 3 * sizeof(uint32_t)));
+	return(0);
+};
+
+
+/*
+ * check Eytzinger layout state, create it on first use
+ * out: 1=layout available, 0=use search kernel
+ */
+static int libipv6calc_db_wrapper_BuiltIn_eytzinger_check(const int num, const uint32_t num_rows, int (*get_array_row)()) {
+	if (builtin_eytzinger[num].state == 0) {
+		if (libipv6calc_db_wrapper_BuiltIn_eytzinger_create(num, num_rows, get_array_row) != 0) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Eytzinger layout %d not available, fallback to search kernel", num);
+		};
+	};
+
+	return((builtin_eytzinger[num].state == 1) ? 1 : 0);
+};
+
+
+/*
+ * lookup key in Eytzinger layout
+ *  walk down (right if first <= key), the last right turn is the row with the largest first <= key
+ * ret: matching row of original table, -1 = no match
+ */
+static long int libipv6calc_db_wrapper_BuiltIn_eytzinger_lookup(const int num, const uint32_t key) {
+	const s_builtin_eytzinger *eytzinger = &builtin_eytzinger[num];
+	uint32_t k = 1;
+
+	while (k <= eytzinger->num_rows) {
+		__builtin_prefetch(eytzinger->first + 16 * k);
+		k = 2 * k + (eytzinger->first[k] <= key);
+	};
+
+	// strip trailing left turns and the last right turn
+	k >>= __builtin_ffs(k);
+
+	if ((k == 0) || (eytzinger->last[k] < key)) {
+		return(-1);
+	};
+
+	return(eytzinger->row[k]);
+};
+#endif
+
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IEEE
+/*
+ * sorted index over the 24-bit IDs of the IEEE OUI, OUI-36 and IAB lists
+ *
+ * each entry points to the OUI row and to the sub-ranges of the same ID (IAB first, then OUI-36,
+ * each sorted by begin), lookup is binary search over the IDs plus binary search over the sub-ranges
+ * created on first lookup, not available in case of overlapping sub-ranges (fallback to linear scan)
+ */
+typedef struct {
+	uint32_t id;
+	int32_t  oui_row;	// row in libieee_oui, -1: none
+	uint32_t sub_first;	// first sub-range in builtin_ieee_sub
+	uint16_t iab_count;	// number of IAB sub-ranges
+	uint16_t oui36_count;	// number of OUI-36 sub-ranges (following the IAB ones)
+} s_builtin_ieee_index;
+
+typedef struct {
+	uint32_t subid_begin;
+	uint32_t subid_end;
+	uint32_t row;		// row in libieee_iab or libieee_oui36
+} s_builtin_ieee_sub;
+
+typedef struct {
+	uint32_t id;
+	uint32_t db;		// BUILTIN_DB_IAB, BUILTIN_DB_OUI36, BUILTIN_DB_OUI (order of precedence)
+	uint32_t subid_begin;
+	uint32_t subid_end;
+	uint32_t row;
+} s_builtin_ieee_item;
+
+static int builtin_ieee_index_state = 0;	// 0: not created, 1: created, -1: not available
+static s_builtin_ieee_index *builtin_ieee_index = NULL;
+static uint32_t builtin_ieee_index_entries = 0;
+static s_builtin_ieee_sub *builtin_ieee_sub = NULL;
+static uint32_t builtin_ieee_sub_entries = 0;
+
+
+/*
+ * free IEEE index
+ */
+static void libipv6calc_db_wrapper_BuiltIn_ieee_index_free(void) {
+	free(builtin_ieee_index);
+	free(builtin_ieee_sub);
+	builtin_ieee_index = NULL;
+	builtin_ieee_sub = NULL;
+	builtin_ieee_index_entries = 0;
+	builtin_ieee_sub_entries = 0;
+	builtin_ieee_index_state = 0;
+};
+
+
+/*
+ * precedence of IEEE list (IAB before OUI-36 before OUI, like the linear scan)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ieee_precedence(const uint32_t db) {
+	return((db == BUILTIN_DB_IAB) ? 0 : ((db == BUILTIN_DB_OUI36) ? 1 : 2));
+};
+
+
+/*
+ * compare IEEE items by id, precedence, begin and row (qsort callback)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ieee_item_cmp(const void *a, const void *b) {
+	const s_builtin_ieee_item *ia = a, *ib = b;
+	int pa, pb;
+
+	if (ia->id != ib->id) {
+		return((ia->id < ib->id) ? -1 : 1);
+	};
+
+	pa = libipv6calc_db_wrapper_BuiltIn_ieee_precedence(ia->db);
+	pb = libipv6calc_db_wrapper_BuiltIn_ieee_precedence(ib->db);
+	if (pa != pb) {
+		return(pa - pb);
+	};
+
+	if (ia->subid_begin != ib->subid_begin) {
+		return((ia->subid_begin < ib->subid_begin) ? -1 : 1);
+	};
+
+	return((ia->row < ib->row) ? -1 : ((ia->row > ib->row) ? 1 : 0));
+};
+
+
+/*
+ * create IEEE index
+ * ret: 0=ok, 1=not possible (overlapping sub-ranges or no memory)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ieee_index_create(void) {
+	s_builtin_ieee_item *items;
+	s_builtin_ieee_index *entry = NULL;
+	uint32_t num_items = 0, i, n_iab = MAXENTRIES_ARRAY(libieee_iab), n_oui36 = MAXENTRIES_ARRAY(libieee_oui36), n_oui = MAXENTRIES_ARRAY(libieee_oui);
+	int retval = 1;
+
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Create IEEE index");
+
+	builtin_ieee_index_state = -1;
+
+	items = malloc((n_iab + n_oui36 + n_oui) * sizeof(s_builtin_ieee_item));
+	builtin_ieee_index = malloc((n_iab + n_oui36 + n_oui) * sizeof(s_builtin_ieee_index));
+	builtin_ieee_sub = malloc((n_iab + n_oui36) * sizeof(s_builtin_ieee_sub));
+
+	if ((items == NULL) || (builtin_ieee_index == NULL) || (builtin_ieee_sub == NULL)) {
+		ERRORPRINT_NA("can't allocate memory for IEEE index");
+		goto END_libipv6calc_db_wrapper_BuiltIn_ieee_index_create;
+	};
+
+	for (i = 0; i < n_iab; i++) {
+		items[num_items++] = (s_builtin_ieee_item) { libieee_iab[i].id, BUILTIN_DB_IAB, libieee_iab[i].subid_begin, libieee_iab[i].subid_end, i };
+	};
+
+	for (i = 0; i < n_oui36; i++) {
+		items[num_items++] = (s_builtin_ieee_item) { libieee_oui36[i].id, BUILTIN_DB_OUI36, libieee_oui36[i].subid_begin, libieee_oui36[i].subid_end, i };
+	};
+
+	for (i = 0; i < n_oui; i++) {
+		items[num_items++] = (s_builtin_ieee_item) { libieee_oui[i].id, BUILTIN_DB_OUI, 0, 0, i };
+	};
+
+	qsort(items, num_items, sizeof(s_builtin_ieee_item), libipv6calc_db_wrapper_BuiltIn_ieee_item_cmp);
+
+	for (i = 0; i < num_items; i++) {
+		if ((entry == NULL) || (entry->id != items[i].id)) {
+			entry = &builtin_ieee_index[builtin_ieee_index_entries++];
+			entry->id = items[i].id;
+			entry->oui_row = -1;
+			entry->sub_first = builtin_ieee_sub_entries;
+			entry->iab_count = 0;
+			entry->oui36_count = 0;
+		};
+
+		if (items[i].db == BUILTIN_DB_OUI) {
+			if (entry->oui_row < 0) {
+				// first row wins (like the linear scan)
+				entry->oui_row = items[i].row;
+			};
+			continue;
+		};
+
+		if ((i > 0) && (items[i - 1].id == items[i].id) && (items[i - 1].db == items[i].db) && (items[i - 1].subid_end >= items[i].subid_begin)) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IEEE index not possible, overlapping sub-ranges: %06x %06x-%06x", items[i].id, items[i].subid_begin, items[i].subid_end);
+			goto END_libipv6calc_db_wrapper_BuiltIn_ieee_index_create;
+		};
+
+		if (((items[i].db == BUILTIN_DB_IAB) ? entry->iab_count : entry->oui36_count) == UINT16_MAX) {
+			goto END_libipv6calc_db_wrapper_BuiltIn_ieee_index_create;
+		};
+
+		builtin_ieee_sub[builtin_ieee_sub_entries++] = (s_builtin_ieee_sub) { items[i].subid_begin, items[i].subid_end, items[i].row };
+
+		if (items[i].db == BUILTIN_DB_IAB) {
+			entry->iab_count++;
+		} else {
+			entry->oui36_count++;
+		};
+	};
+
+	builtin_ieee_index_state = 1;
+	retval = 0;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IEEE index created, entries: %u sub-ranges: %u", builtin_ieee_index_entries, builtin_ieee_sub_entries);
+
+END_libipv6calc_db_wrapper_BuiltIn_ieee_index_create:
+	free(items);
+
+	if (retval != 0) {
+		free(builtin_ieee_index);
+		free(builtin_ieee_sub);
+		builtin_ieee_index = NULL;
+		builtin_ieee_sub = NULL;
+		builtin_ieee_index_entries = 0;
+		builtin_ieee_sub_entries = 0;
+	};
+
+	return(retval);
+};
+
+
+/*
+ * binary search in sub-ranges (sorted, non-overlapping)
+ * ret: row of matching sub-range, -1 = no match
+ */
+static long int libipv6calc_db_wrapper_BuiltIn_ieee_sub_lookup(const uint32_t first, const uint32_t count, const uint32_t subidval) {
+	uint32_t low = first, high = first + count;	// [low, high)
+	uint32_t mid;
+
+	// find first sub-range with begin > subidval
+	while (low < high) {
+		mid = low + (high - low) / 2;
+		if (builtin_ieee_sub[mid].subid_begin <= subidval) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		};
+	};
+
+	if ((low == first) || (builtin_ieee_sub[low - 1].subid_end < subidval)) {
+		return(-1);
+	};
+
+	return(builtin_ieee_sub[low - 1].row);
+};
+
+
+/*
+ * lookup IEEE index, create it on first use
+ * in : id, subid
+ * mod: row
+ * ret: BUILTIN_DB_IAB|BUILTIN_DB_OUI36|BUILTIN_DB_OUI, 0 = no match, -1 = index not available
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ieee_index_lookup(const uint32_t idval, const uint32_t subidval, long int *row_ptr) {
+	const s_builtin_ieee_index *entry;
+	uint32_t low = 0, high, mid;
+
+	if (builtin_ieee_index_state == 0) {
+		if (libipv6calc_db_wrapper_BuiltIn_ieee_index_create() != 0) {
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IEEE index not available, fallback to linear scan");
+		};
+	};
+
+	if (builtin_ieee_index_state != 1) {
+		return(-1);
+	};
+
+	high = builtin_ieee_index_entries;
+	while (low < high) {
+		mid = low + (high - low) / 2;
+		if (builtin_ieee_index[mid].id < idval) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		};
+	};
+
+	if ((low == builtin_ieee_index_entries) || (builtin_ieee_index[low].id != idval)) {
+		return(0);
+	};
+
+	entry = &builtin_ieee_index[low];
+
+	if ((entry->iab_count > 0) && ((*row_ptr = libipv6calc_db_wrapper_BuiltIn_ieee_sub_lookup(entry->sub_first, entry->iab_count, subidval)) >= 0)) {
+		return(BUILTIN_DB_IAB);
+	};
+
+	if ((entry->oui36_count > 0) && ((*row_ptr = libipv6calc_db_wrapper_BuiltIn_ieee_sub_lookup(entry->sub_first + entry->iab_count, entry->oui36_count, subidval)) >= 0)) {
+		return(BUILTIN_DB_OUI36);
+	};
+
+	if (entry->oui_row >= 0) {
+		*row_ptr = entry->oui_row;
+		return(BUILTIN_DB_OUI);
+	};
+
+	return(0);
+};
+#endif
+
 
 /*
  * function initialise the BuiltIn wrapper
@@ -98,6 +729,12 @@ int libipv6calc_db_wrapper_BuiltIn_wrapper_init(void) {
 #ifdef SUPPORT_DB_IPV6_REG
 	wrapper_features_by_source[IPV6CALC_DB_SOURCE_BUILTIN] |= IPV6CALC_DB_IPV6_TO_REGISTRY | IPV6CALC_DB_IPV6_TO_INFO;
 	builtin_ipv6       = 1;
+
+	if (builtin_lookup_generic == 0) {
+		if (libipv6calc_db_wrapper_BuiltIn_ipv6_trie_create() != 0) {
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IPv6 trie not available, fallback to generic lookup");
+		};
+	};
 #endif
 
 #ifdef SUPPORT_DB_IEEE
@@ -123,7 +760,21 @@ int libipv6calc_db_wrapper_BuiltIn_wrapper_init(void) {
 int libipv6calc_db_wrapper_BuiltIn_wrapper_cleanup(void) {
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Called");
 
-	// currently nothing to do
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IPV4_REG
+	libipv6calc_db_wrapper_BuiltIn_ipv4_index_free();
+#endif
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_AS_REG
+	libipv6calc_db_wrapper_BuiltIn_eytzinger_free();
+#endif
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IPV6_REG
+	libipv6calc_db_wrapper_BuiltIn_ipv6_trie_free();
+#endif
+
+#if defined SUPPORT_BUILTIN && defined SUPPORT_DB_IEEE
+	libipv6calc_db_wrapper_BuiltIn_ieee_index_free();
+#endif
 
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Finished");
 	return 0;
@@ -179,6 +830,13 @@ void libipv6calc_db_wrapper_BuiltIn_wrapper_print_db_info(const int level_verbos
 #ifdef SUPPORT_DB_AS_REG
 	if (wrapper_features_by_source[IPV6CALC_DB_SOURCE_BUILTIN] & IPV6CALC_DB_AS_TO_REGISTRY) {
 		fprintf(stderr, "%sBuiltIn: %-5s: %s\n", prefix, "ASN", dbasn_registry_status);
+		if (level_verbose >= LEVEL_VERBOSE2) {
+			if (builtin_lookup_generic == 0) {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by Eytzinger layout (created on first use, memory: %lu bytes)\n", prefix, "ASN", (unsigned long int) ((MAXENTRIES_ARRAY(dbasn_assignment) + 1) * 3 * sizeof(uint32_t)));
+			} else {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by binary search\n", prefix, "ASN");
+			};
+		};
 	};
 #endif
 
@@ -192,6 +850,22 @@ void libipv6calc_db_wrapper_BuiltIn_wrapper_print_db_info(const int level_verbos
 	if (wrapper_features_by_source[IPV6CALC_DB_SOURCE_BUILTIN] & IPV6CALC_DB_IPV4_TO_REGISTRY) {
 		strftime(tempstring, sizeof(tempstring), "%Y%m%d-%H%M%S UTC", gmtime(&dbipv4addr_registry_unixtime));
 		fprintf(stderr, "%sBuiltIn: %-5s: %s (created: %s)\n", prefix, "IPv4", dbipv4addr_registry_status, tempstring);
+		if (level_verbose >= LEVEL_VERBOSE2) {
+			if (builtin_lookup_generic == 0) {
+				int i, created = 0;
+				for (i = 0; i < BUILTIN_IPV4_INDEX_MAX; i++) {
+					if (builtin_ipv4_index[i].state == 1) {
+						created++;
+					};
+				};
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by /16 index (created on first use, memory: %lu bytes per table, currently created: %d of %d)\n", prefix, "IPv4",
+					(unsigned long int) (BUILTIN_IPV4_INDEX_BUCKETS * sizeof(s_builtin_ipv4_index_bucket)),
+					created, BUILTIN_IPV4_INDEX_MAX
+				);
+			} else {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by generic binary search\n", prefix, "IPv4");
+			};
+		};
 	};
 #endif
 
@@ -199,12 +873,26 @@ void libipv6calc_db_wrapper_BuiltIn_wrapper_print_db_info(const int level_verbos
 	if (wrapper_features_by_source[IPV6CALC_DB_SOURCE_BUILTIN] & IPV6CALC_DB_IPV6_TO_REGISTRY) {
 		strftime(tempstring, sizeof(tempstring), "%Y%m%d-%H%M%S UTC", gmtime(&dbipv6addr_registry_unixtime));
 		fprintf(stderr, "%sBuiltIn: %-5s: %s (created: %s)\n", prefix, "IPv6", dbipv6addr_registry_status, tempstring);
+		if (level_verbose >= LEVEL_VERBOSE2) {
+			if (builtin_ipv6_trie != NULL) {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by trie (nodes: %u, memory: %lu bytes)\n", prefix, "IPv6", builtin_ipv6_trie_nodes, (unsigned long int) (builtin_ipv6_trie_nodes * sizeof(s_builtin_ipv6_trie_node)));
+			} else {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by generic sequential scan\n", prefix, "IPv6");
+			};
+		};
 	};
 #endif
 
 #ifdef SUPPORT_DB_IEEE
 	if (wrapper_features_by_source[IPV6CALC_DB_SOURCE_BUILTIN] & IPV6CALC_DB_IEEE_TO_INFO) {
 		fprintf(stderr, "%sBuiltIn: %-5s: %s %s %s\n", prefix, "IEEE", libieee_iab_status, libieee_oui_status, libieee_oui36_status);
+		if (level_verbose >= LEVEL_VERBOSE2) {
+			if (builtin_lookup_generic == 0) {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by sorted OUI index (created on first use)\n", prefix, "IEEE");
+			} else {
+				fprintf(stderr, "%sBuiltIn: %-5s: lookup by linear scan\n", prefix, "IEEE");
+			};
+		};
 	};
 #endif
 
@@ -361,6 +1049,26 @@ time_t libipv6calc_db_wrapper_BuiltIn_db_unixtime_by_feature(uint32_t feature) {
  * Wrapper functions for BuiltIn
  *******************************/
 
+#ifdef SUPPORT_DB_AS_REG
+/*
+ * dbasn_assignment / get row (callback function for retrieving value from array)
+ */
+int libipv6calc_db_wrapper_BuiltIn_get_row_dbasn_assignment(const uint32_t row, uint32_t *key_first_00_31_ptr, uint32_t *key_first_32_63_ptr, uint32_t *key_last_00_31_ptr, uint32_t *key_last_32_63_ptr) {
+	if (row >= MAXENTRIES_ARRAY(dbasn_assignment)) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "row out of range: %lu (maximum: %lu)", (unsigned long int) row, (unsigned long int) MAXENTRIES_ARRAY(dbasn_assignment) - 1);
+		return(-1);
+	};
+
+	*key_first_00_31_ptr = dbasn_assignment[row].asn_start;
+	*key_last_00_31_ptr  = dbasn_assignment[row].asn_stop;
+	*key_first_32_63_ptr = 0;
+	*key_last_32_63_ptr  = 0;
+
+	return(0);
+};
+#endif // SUPPORT_DB_AS_REG
+
+
 // get registry number by AS number
 int libipv6calc_db_wrapper_BuiltIn_registry_num_by_as_num32(const uint32_t as_num32) {
 	int result = REGISTRY_UNKNOWN;
@@ -370,30 +1078,35 @@ int libipv6calc_db_wrapper_BuiltIn_registry_num_by_as_num32(const uint32_t as_nu
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Called with as_num32=%d max=%d", as_num32, max);
 
 #ifdef SUPPORT_DB_AS_REG
-	// binary search
 	int i, r = -1;
 	int i_min = 0;
 	int i_max = max;
 	int i_old = -1;
 
-	i = max / 2;
-	while (i_old != i) {
-		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Search for as_num32=%d max=%d i=%d start=%d stop=%d", as_num32, max, i, dbasn_assignment[i].asn_start, dbasn_assignment[i].asn_stop);
+	if ((builtin_lookup_generic == 0) && (libipv6calc_db_wrapper_BuiltIn_eytzinger_check(BUILTIN_EYTZINGER_ASN, max, libipv6calc_db_wrapper_BuiltIn_get_row_dbasn_assignment) == 1)) {
+		r = libipv6calc_db_wrapper_BuiltIn_eytzinger_lookup(BUILTIN_EYTZINGER_ASN, as_num32);
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Result of Eytzinger lookup: r=%d", r);
+	} else {
+		// binary search
+		i = max / 2;
+		while (i_old != i) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Search for as_num32=%d max=%d i=%d start=%d stop=%d", as_num32, max, i, dbasn_assignment[i].asn_start, dbasn_assignment[i].asn_stop);
+
+			if (as_num32 < dbasn_assignment[i].asn_start) {
+				// to high in array, jump down
+				i_max = i;
+			} else if (as_num32 > dbasn_assignment[i].asn_stop) {
+				// to low in array, jump up
+				i_min = i;
+			} else {
+				// hit
+				r = i;
+				break;
+			};
 
-		if (as_num32 < dbasn_assignment[i].asn_start) {
-			// to high in array, jump down
-			i_max = i;
-		} else if (as_num32 > dbasn_assignment[i].asn_stop) {
-			// to low in array, jump up
-			i_min = i;
-		} else {
-			// hit
-			r = i;
-			break;
+			i_old = i;
+			i = (i_max - i_min) / 2 + i_min;
 		};
-
-		i_old = i;
-		i = (i_max - i_min) / 2 + i_min;
 	};
 
 	if (r != -1) {
@@ -450,7 +1163,8 @@ int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_by_macaddr(char *resultstr
 	int retval = 1;
 
 #ifdef SUPPORT_DB_IEEE
-	int i;
+	int i, db;
+	long int row;
 	uint32_t idval, subidval;
 #endif
 
@@ -472,6 +1186,20 @@ int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_by_macaddr(char *resultstr
 	idval = (macaddrp->addr[0] << 16) | (macaddrp->addr[1] << 8) | macaddrp->addr[2];
 	subidval = (macaddrp->addr[3] << 16) | (macaddrp->addr[4] << 8) | macaddrp->addr[5];
 
+	if (builtin_lookup_generic == 0) {
+		db = libipv6calc_db_wrapper_BuiltIn_ieee_index_lookup(idval, subidval, &row);
+
+		if (db == 0) {
+			/* not found */
+			return (1);
+		} else if (db > 0) {
+			snprintf(resultstring, resultstring_length, "%s", (db == BUILTIN_DB_IAB) ? libieee_iab[row].string_owner : ((db == BUILTIN_DB_OUI36) ? libieee_oui36[row].string_owner : libieee_oui[row].string_owner));
+			BUILTIN_DB_USAGE_MAP_TAG(db);
+			return (0);
+		};
+		/* index not available, fallback to linear scan */
+	};
+
 	/* run through IAB list */
 	for (i = 0; i < MAXENTRIES_ARRAY(libieee_iab); i++) {
 		if (libieee_iab[i].id == idval) {
@@ -526,7 +1254,8 @@ int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_short_by_macaddr(char *res
 	int retval = 1;
 
 #ifdef SUPPORT_DB_IEEE
-	int i;
+	int i, db;
+	long int row;
 	uint32_t idval, subidval;
 #endif
 
@@ -548,6 +1277,20 @@ int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_short_by_macaddr(char *res
 	idval = (macaddrp->addr[0] << 16) | (macaddrp->addr[1] << 8) | macaddrp->addr[2];
 	subidval = (macaddrp->addr[3] << 16) | (macaddrp->addr[4] << 8) | macaddrp->addr[5];
 
+	if (builtin_lookup_generic == 0) {
+		db = libipv6calc_db_wrapper_BuiltIn_ieee_index_lookup(idval, subidval, &row);
+
+		if (db == 0) {
+			/* not found */
+			return (1);
+		} else if (db > 0) {
+			snprintf(resultstring, resultstring_length, "%s", (db == BUILTIN_DB_IAB) ? libieee_iab[row].shortstring_owner : ((db == BUILTIN_DB_OUI36) ? libieee_oui36[row].shortstring_owner : libieee_oui[row].shortstring_owner));
+			BUILTIN_DB_USAGE_MAP_TAG(db);
+			return (0);
+		};
+		/* index not available, fallback to linear scan */
+	};
+
 	/* run through IAB list */
 	for (i = 0; i < MAXENTRIES_ARRAY(libieee_iab); i++) {
 		if (libieee_iab[i].id == idval) {
@@ -669,6 +1412,102 @@ int libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_info(const uint32_t row, u
 
 	return(0);
 };
+
+
+/*
+ * type-specialized search kernels
+ */
+IPV6CALC_DB_LOOKUP_KERNEL_FIRST_LAST_32(libipv6calc_db_wrapper_BuiltIn_search_dbipv4addr_assignment, s_ipv4addr_assignment, first, last)
+IPV6CALC_DB_LOOKUP_KERNEL_FIRST_LAST_32(libipv6calc_db_wrapper_BuiltIn_search_dbipv4addr_info, s_ipv4addr_info, first, last)
+
+
+/*
+ * create IPv4 index for a sorted table of non-overlapping ranges
+ *
+ * in : index_num = BUILTIN_IPV4_INDEX_*
+ * in : num_rows = number of rows of table
+ * in : get_array_row = callback function for retrieving first/last of a row
+ * out: 0=ok, 1=error (index not available)
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ipv4_index_create(const int index_num, const uint32_t num_rows, int (*get_array_row)()) {
+	s_builtin_ipv4_index *index = &builtin_ipv4_index[index_num];
+	uint32_t row, b, first, last, first_32_63, last_32_63, last_prev = 0;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Create IPv4 index %d for rows: %u", index_num, num_rows);
+
+	index->state = -1;
+
+	if (num_rows > 0xffff) {
+		ERRORPRINT_WA("too many rows for IPv4 index %d: %u", index_num, num_rows);
+		return(1);
+	};
+
+	index->bucket = calloc(BUILTIN_IPV4_INDEX_BUCKETS, sizeof(s_builtin_ipv4_index_bucket));
+	if (index->bucket == NULL) {
+		ERRORPRINT_WA("can't allocate memory for IPv4 index %d", index_num);
+		return(1);
+	};
+
+	for (row = 0; row < num_rows; row++) {
+		if (get_array_row(row, &first, &first_32_63, &last, &last_32_63) != 0) {
+			goto END_libipv6calc_db_wrapper_BuiltIn_ipv4_index_create_fail;
+		};
+
+		if ((first > last) || ((row > 0) && (first <= last_prev))) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IPv4 index %d not possible, row %u not sorted or overlapping: %08x-%08x", index_num, row, first, last);
+			goto END_libipv6calc_db_wrapper_BuiltIn_ipv4_index_create_fail;
+		};
+		last_prev = last;
+
+		for (b = first >> 16; b <= (last >> 16); b++) {
+			if (index->bucket[b].count == 0) {
+				index->bucket[b].row = row;
+			};
+			index->bucket[b].count++;
+		};
+	};
+
+	index->state = 1;
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IPv4 index %d created, memory: %lu bytes", index_num, (unsigned long int) (BUILTIN_IPV4_INDEX_BUCKETS * sizeof(s_builtin_ipv4_index_bucket)));
+	return(0);
+
+END_libipv6calc_db_wrapper_BuiltIn_ipv4_index_create_fail:
+	free(index->bucket);
+	index->bucket = NULL;
+	return(1);
+};
+
+
+/*
+ * lookup IPv4 address in index of table
+ *  binary search over the rows of the bucket
+ */
+#define BUILTIN_IPV4_INDEX_LOOKUP(index_num, table, key, match) { \
+		const s_builtin_ipv4_index_bucket *bucket = &builtin_ipv4_index[index_num].bucket[(key) >> 16]; \
+		uint32_t lo = bucket->row, hi = bucket->row + bucket->count, mid; \
+		while ((hi - lo) > 1) { \
+			mid = (lo + hi) / 2; \
+			if (table[mid].first <= (key)) { lo = mid; } else { hi = mid; }; \
+		}; \
+		if ((hi > lo) && (table[lo].first <= (key)) && (table[lo].last >= (key))) { \
+			match = lo; \
+		}; \
+	}
+
+
+/*
+ * check IPv4 index state, create it on first use
+ * out: 1=index available, 0=use search kernel
+ */
+static int libipv6calc_db_wrapper_BuiltIn_ipv4_index_check(const int index_num, const uint32_t num_rows, int (*get_array_row)()) {
+	if (builtin_ipv4_index[index_num].state == 0) {
+		if (libipv6calc_db_wrapper_BuiltIn_ipv4_index_create(index_num, num_rows, get_array_row) != 0) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IPv4 index %d not available, fallback to search kernel", index_num);
+		};
+	};
+
+	return((builtin_ipv4_index[index_num].state == 1) ? 1 : 0);
+};
 #endif // SUPPORT_DB_IPV4_REG
 
 
@@ -676,42 +1515,24 @@ int libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_info(const uint32_t row, u
  * get registry number of an IPv4 address
  *
  * in:  ipv4addr = IPv4 address structure
+ * out: *rangep = address range of matching row with identical result (skipped if NULL, flag_valid=0 if not available)
  * out: assignment number (-1 = no result)
  */
-int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp) {
+int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp, ipv6calc_ipaddr_range *rangep) {
 	uint32_t ipv4 = ipv4addr_getdword(ipv4addrp);
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Given IPv4 address: %08x", (unsigned int) ipv4);
 
 	int result = IPV4_ADDR_REGISTRY_UNKNOWN;
 
-#ifdef SUPPORT_DB_IPV4_REG
-	int match = -1;
-
-	match = libipv6calc_db_wrapper_get_entry_generic(
-		NULL,							// pointer to data
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
-		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
-		0,							// key format (not relevant)
-		32,							// key length
-		IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
-		MAXENTRIES_ARRAY(dbipv4addr_assignment),		// number of rows
-		ipv4,							// lookup key MSB
-		0,							// lookup key LSB
-		NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
-		libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment	// function pointer
-	);
-
-	if (match > -1) {
-		result = dbipv4addr_assignment[match].registry;
-		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Finished with success result (dbipv4addr_assignment): match=%d reg=%d", match, result);
-		BUILTIN_DB_USAGE_MAP_TAG(BUILTIN_DB_IPV4_REGISTRY);
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
 	};
 
-	if (result == IPV4_ADDR_REGISTRY_UNKNOWN) {
-		// IANA fallback
-		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Nothing found in dbipv4addr_assignment, fallback now to dbipv4addr_assignment_iana");
+#ifdef SUPPORT_DB_IPV4_REG
+	int match = -1;
 
+	if (builtin_lookup_generic != 0) {
 		match = libipv6calc_db_wrapper_get_entry_generic(
 			NULL,							// pointer to data
 			IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
@@ -719,12 +1540,68 @@ int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(const ipv6calc_ipv4a
 			0,							// key format (not relevant)
 			32,							// key length
 			IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
-			MAXENTRIES_ARRAY(dbipv4addr_assignment_iana),		// number of rows
+			MAXENTRIES_ARRAY(dbipv4addr_assignment),		// number of rows
 			ipv4,							// lookup key MSB
 			0,							// lookup key LSB
 			NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
-			libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment_iana	// function pointer
+			libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment,	// function pointer
+			NULL							// range of matching row (not used)
 		);
+	} else if (libipv6calc_db_wrapper_BuiltIn_ipv4_index_check(BUILTIN_IPV4_INDEX_ASSIGNMENT, MAXENTRIES_ARRAY(dbipv4addr_assignment), libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment) == 1) {
+		BUILTIN_IPV4_INDEX_LOOKUP(BUILTIN_IPV4_INDEX_ASSIGNMENT, dbipv4addr_assignment, ipv4, match);
+	} else {
+		match = libipv6calc_db_wrapper_BuiltIn_search_dbipv4addr_assignment(dbipv4addr_assignment, MAXENTRIES_ARRAY(dbipv4addr_assignment), ipv4, 0);
+	};
+
+	if (match > -1) {
+		result = dbipv4addr_assignment[match].registry;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Finished with success result (dbipv4addr_assignment): match=%d reg=%d", match, result);
+		BUILTIN_DB_USAGE_MAP_TAG(BUILTIN_DB_IPV4_REGISTRY);
+
+		if (rangep != NULL) {
+			// rows are non-overlapping, no range for IANA fallback (could be shadowed by neighbor rows)
+			rangep->first[0] = dbipv4addr_assignment[match].first;
+			rangep->last[0]  = dbipv4addr_assignment[match].last;
+			rangep->first[1] = 0;
+			rangep->last[1]  = 0;
+			rangep->first[2] = 0;
+			rangep->last[2]  = 0;
+			rangep->first[3] = 0;
+			rangep->last[3]  = 0;
+			rangep->flag_valid = 1;
+		};
+	};
+
+	if (result == IPV4_ADDR_REGISTRY_UNKNOWN) {
+		// IANA fallback
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Nothing found in dbipv4addr_assignment, fallback now to dbipv4addr_assignment_iana");
+
+		// result of fallback is not related to range of a matching assignment row with unknown registry
+		match = -1;
+		if (rangep != NULL) {
+			rangep->flag_valid = 0;
+		};
+
+		if (builtin_lookup_generic != 0) {
+			match = libipv6calc_db_wrapper_get_entry_generic(
+				NULL,							// pointer to data
+				IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
+				IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
+				0,							// key format (not relevant)
+				32,							// key length
+				IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
+				MAXENTRIES_ARRAY(dbipv4addr_assignment_iana),		// number of rows
+				ipv4,							// lookup key MSB
+				0,							// lookup key LSB
+				NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
+				libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment_iana,	// function pointer
+				NULL							// range of matching row (not used)
+			);
+		} else if (libipv6calc_db_wrapper_BuiltIn_ipv4_index_check(BUILTIN_IPV4_INDEX_ASSIGNMENT_IANA, MAXENTRIES_ARRAY(dbipv4addr_assignment_iana), libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment_iana) == 1) {
+			BUILTIN_IPV4_INDEX_LOOKUP(BUILTIN_IPV4_INDEX_ASSIGNMENT_IANA, dbipv4addr_assignment_iana, ipv4, match);
+		} else {
+			match = libipv6calc_db_wrapper_BuiltIn_search_dbipv4addr_assignment(dbipv4addr_assignment_iana, MAXENTRIES_ARRAY(dbipv4addr_assignment_iana), ipv4, 0);
+		};
 
 		if (match > -1) {
 			result = dbipv4addr_assignment_iana[match].registry;
@@ -757,19 +1634,24 @@ int libipv6calc_db_wrapper_BuiltIn_info_by_ipv4addr(const ipv6calc_ipv4addr *ipv
 #ifdef SUPPORT_DB_IPV4_REG
 	int match = -1;
 
-	match = libipv6calc_db_wrapper_get_entry_generic(
-		NULL,							// pointer to data
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
-		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
-		0,							// key format (not relevant)
-		32,							// key length
-		IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
-		MAXENTRIES_ARRAY(dbipv4addr_info),			// number of rows
-		ipv4,							// lookup key MSB
-		0,							// lookup key LSB
-		NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
-		libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_info	// function pointer
-	);
+	if (builtin_lookup_generic != 0) {
+		match = libipv6calc_db_wrapper_get_entry_generic(
+			NULL,							// pointer to data
+			IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
+			IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
+			0,							// key format (not relevant)
+			32,							// key length
+			IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
+			MAXENTRIES_ARRAY(dbipv4addr_info),			// number of rows
+			ipv4,							// lookup key MSB
+			0,							// lookup key LSB
+			NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
+			libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_info,	// function pointer
+			NULL							// range of matching row (not used)
+		);
+	} else {
+		match = libipv6calc_db_wrapper_BuiltIn_search_dbipv4addr_info(dbipv4addr_info, MAXENTRIES_ARRAY(dbipv4addr_info), ipv4, 0);
+	};
 
 	if (match > -1) {
 		snprintf(string, string_len, "%s", dbipv4addr_info[match].info);
@@ -843,6 +1725,13 @@ int libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_info(const uint32_t row, u
 
 	return(dbipv6addr_info[row].prefixlength);
 };
+
+
+/*
+ * type-specialized search kernels
+ */
+IPV6CALC_DB_LOOKUP_KERNEL_BASE_MASK_64_SEQLONGEST(libipv6calc_db_wrapper_BuiltIn_search_dbipv6addr_assignment, s_ipv6addr_assignment, ipv6addr_00_31, ipv6addr_32_63, ipv6mask_00_31, ipv6mask_32_63)
+IPV6CALC_DB_LOOKUP_KERNEL_BASE_MASK_64(libipv6calc_db_wrapper_BuiltIn_search_dbipv6addr_info, s_ipv6addr_info, ipv6addr_00_31, ipv6addr_32_63, ipv6mask_00_31, ipv6mask_32_63)
 #endif // SUPPORT_DB_IPV6_REG
 
 
@@ -850,14 +1739,19 @@ int libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_info(const uint32_t row, u
  * get registry number of an IPv6 address
  *
  * in:  ipv6addr = IPv6 address structure
+ * out: *rangep = address range with identical result (skipped if NULL, flag_valid=0 if not available)
  * out: assignment number (-1 = no result)
  */
-int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp) {
+int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp, ipv6calc_ipaddr_range *rangep) {
 	uint32_t ipv6_00_31 = ipv6addr_getdword(ipv6addrp, 0);
 	uint32_t ipv6_32_63 = ipv6addr_getdword(ipv6addrp, 1);
 	
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Given ipv6 prefix: %08x%08x", (unsigned int) ipv6_00_31, (unsigned int) ipv6_32_63);
 
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
 	if ((ipv6addrp->typeinfo & IPV6_NEW_ADDR_6BONE) != 0) {
 		return(IPV6_ADDR_REGISTRY_6BONE);
 	};
@@ -865,26 +1759,49 @@ int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(const ipv6calc_ipv6a
 	int result = IPV6_ADDR_REGISTRY_UNKNOWN;
 
 #ifdef SUPPORT_DB_IPV6_REG
-	int match = -1;
+	int match = -1, length = 0;
+	uint64_t mask;
 
-	match = libipv6calc_db_wrapper_get_entry_generic(
-		NULL,							// pointer to data
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
-		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,		// key type
-		0,							// key format (not relevant)
-		64,							// key length
-		IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_SEQLONGEST,		// search type
-		MAXENTRIES_ARRAY(dbipv6addr_assignment),		// number of rows
-		ipv6_00_31,						// lookup key MSB
-		ipv6_32_63,						// lookup key LSB
-		NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
-		libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_assignment	// function pointer
-	);
+	if (builtin_ipv6_trie != NULL) {
+		match = libipv6calc_db_wrapper_BuiltIn_ipv6_trie_lookup(ipv6_00_31, ipv6_32_63, &length);
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Result of trie lookup: match=%d length=%d", match, length);
+	} else if (builtin_lookup_generic != 0) {
+		match = libipv6calc_db_wrapper_get_entry_generic(
+			NULL,							// pointer to data
+			IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
+			IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,		// key type
+			0,							// key format (not relevant)
+			64,							// key length
+			IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_SEQLONGEST,		// search type
+			MAXENTRIES_ARRAY(dbipv6addr_assignment),		// number of rows
+			ipv6_00_31,						// lookup key MSB
+			ipv6_32_63,						// lookup key LSB
+			NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
+			libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_assignment,	// function pointer
+			NULL							// range of matching row (not used)
+		);
+	} else {
+		match = libipv6calc_db_wrapper_BuiltIn_search_dbipv6addr_assignment(dbipv6addr_assignment, MAXENTRIES_ARRAY(dbipv6addr_assignment), ipv6_00_31, ipv6_32_63);
+	};
 
 	/* result */
 	if ( match > -1 ) {
 		result = dbipv6addr_assignment[match].registry;
 		BUILTIN_DB_USAGE_MAP_TAG(BUILTIN_DB_IPV6_REGISTRY);
+
+		if ((rangep != NULL) && (length > 0)) {
+			// result of trie lookup is constant inside the prefix covered by the walked path
+			mask = (~0ULL) << (64 - length);
+			rangep->first[0] = ipv6_00_31 & (uint32_t) (mask >> 32);
+			rangep->first[1] = ipv6_32_63 & (uint32_t) mask;
+			rangep->last[0]  = ipv6_00_31 | (uint32_t) (~mask >> 32);
+			rangep->last[1]  = ipv6_32_63 | (uint32_t) ~mask;
+			rangep->first[2] = 0;
+			rangep->last[2]  = 0xffffffff;
+			rangep->first[3] = 0;
+			rangep->last[3]  = 0xffffffff;
+			rangep->flag_valid = 1;
+		};
 	};
 #endif
 	return(result);
@@ -909,19 +1826,24 @@ int libipv6calc_db_wrapper_BuiltIn_info_by_ipv6addr(const ipv6calc_ipv6addr *ipv
 #ifdef SUPPORT_DB_IPV6_REG
 	int match = -1;
 
-	match = libipv6calc_db_wrapper_get_entry_generic(
-		NULL,							// pointer to data
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
-		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,		// key type
-		0,							// key format (not relevant)
-		64,							// key length
-		IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
-		MAXENTRIES_ARRAY(dbipv6addr_info),			// number of rows
-		ipv6_00_31,						// lookup key MSB
-		ipv6_32_63,						// lookup key LSB
-		NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
-		libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_info	// function pointer
-	);
+	if (builtin_lookup_generic != 0) {
+		match = libipv6calc_db_wrapper_get_entry_generic(
+			NULL,							// pointer to data
+			IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY,			// type of data_ptr
+			IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,		// key type
+			0,							// key format (not relevant)
+			64,							// key length
+			IPV6CALC_DB_LOOKUP_DATA_SEARCH_TYPE_BINARY,		// search type
+			MAXENTRIES_ARRAY(dbipv6addr_info),			// number of rows
+			ipv6_00_31,						// lookup key MSB
+			ipv6_32_63,						// lookup key LSB
+			NULL,							// data ptr (not used in IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_ARRAY)
+			libipv6calc_db_wrapper_BuiltIn_get_row_dbipv6addr_info,	// function pointer
+			NULL							// range of matching row (not used)
+		);
+	} else {
+		match = libipv6calc_db_wrapper_BuiltIn_search_dbipv6addr_info(dbipv6addr_info, MAXENTRIES_ARRAY(dbipv6addr_info), ipv6_00_31, ipv6_32_63);
+	};
 
 	if (match > -1) {
 		snprintf(string, string_len, "%s", dbipv6addr_info[match].info);
@@ -937,4 +1859,42 @@ int libipv6calc_db_wrapper_BuiltIn_info_by_ipv6addr(const ipv6calc_ipv6addr *ipv
 	return(result);
 };
 
+
+/*
+ * create all lazily built lookup indexes now
+ *  afterwards lookups only read shared data, call before starting concurrent lookups
+ *
+ * in : (nothing)
+ * out: 0=ok
+ */
+int libipv6calc_db_wrapper_BuiltIn_wrapper_prepare(void) {
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Called");
+
+	if (builtin_lookup_generic != 0) {
+		// no compiled index used
+		goto END_libipv6calc_db_wrapper_BuiltIn_wrapper_prepare;
+	};
+
+#ifdef SUPPORT_DB_IPV4_REG
+	libipv6calc_db_wrapper_BuiltIn_ipv4_index_check(BUILTIN_IPV4_INDEX_ASSIGNMENT, MAXENTRIES_ARRAY(dbipv4addr_assignment), libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment);
+	libipv6calc_db_wrapper_BuiltIn_ipv4_index_check(BUILTIN_IPV4_INDEX_ASSIGNMENT_IANA, MAXENTRIES_ARRAY(dbipv4addr_assignment_iana), libipv6calc_db_wrapper_BuiltIn_get_row_dbipv4addr_assignment_iana);
+#endif
+
+#ifdef SUPPORT_DB_AS_REG
+	libipv6calc_db_wrapper_BuiltIn_eytzinger_check(BUILTIN_EYTZINGER_ASN, MAXENTRIES_ARRAY(dbasn_assignment), libipv6calc_db_wrapper_BuiltIn_get_row_dbasn_assignment);
+#endif
+
+#ifdef SUPPORT_DB_IEEE
+	if (builtin_ieee_index_state == 0) {
+		if (libipv6calc_db_wrapper_BuiltIn_ieee_index_create() != 0) {
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "IEEE index not available, fallback to linear scan");
+		};
+	};
+#endif
+
+END_libipv6calc_db_wrapper_BuiltIn_wrapper_prepare:
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_BuiltIn, "Finished");
+	return(0);
+};
+
 #endif		// SUPPORT_BUILTIN
@@ -12,6 +12,7 @@
 #include "libmac.h"
 #include "libipv4addr.h"
 #include "libipv6addr.h"
+#include "libipaddr.h"
 
 #ifndef _libipv6calc_db_wrapper_BuiltIn_h
 
@@ -31,6 +32,9 @@
 // features
 extern uint32_t wrapper_features_BuiltIn;
 
+// options
+extern int builtin_lookup_generic;
+
 /* ASN->Registry assignment structure */
 typedef struct {
 	const uint32_t asn_start;
@@ -92,6 +96,7 @@ typedef struct {
 
 extern int  libipv6calc_db_wrapper_BuiltIn_wrapper_init(void);
 extern int  libipv6calc_db_wrapper_BuiltIn_wrapper_cleanup(void);
+extern int  libipv6calc_db_wrapper_BuiltIn_wrapper_prepare(void);
 extern void libipv6calc_db_wrapper_BuiltIn_wrapper_info(char *string, const size_t size);
 extern void libipv6calc_db_wrapper_BuiltIn_wrapper_print_db_info(const int level_verbose, const char *prefix_string);
 extern char *libipv6calc_db_wrapper_BuiltIn_wrapper_db_info_used(void);
@@ -107,9 +112,9 @@ extern int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_by_macaddr(char *re
 extern int libipv6calc_db_wrapper_BuiltIn_ieee_vendor_string_short_by_macaddr(char *resultstring, const size_t resultstring_length, const ipv6calc_macaddr *macaddrp); 
 
 // IPv4 Registry
-extern int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp);
+extern int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp, ipv6calc_ipaddr_range *rangep);
 extern int libipv6calc_db_wrapper_BuiltIn_info_by_ipv4addr(const ipv6calc_ipv4addr *ipv4addrp, char *string, const size_t string_len);
 
 // IPv6 Registry
-extern int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp);
+extern int libipv6calc_db_wrapper_BuiltIn_registry_num_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp, ipv6calc_ipaddr_range *rangep);
 extern int libipv6calc_db_wrapper_BuiltIn_info_by_ipv6addr(const ipv6calc_ipv6addr *ipv6addrp, char *string, const size_t string_len);
@@ -75,7 +75,9 @@ static uint32_t dbip_db_usage_map[DBIP_DB_MAX_BLOCKS_32];
 
 #define DBIP_DB_USAGE_MAP_TAG(db)	if (db < (32 * DBIP_DB_MAX_BLOCKS_32)) { \
 							DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "Tag usage for db: %d", db); \
-							dbip_db_usage_map[db / 32] |= 1 << (db % 32); \
+							if ((__atomic_load_n(&dbip_db_usage_map[db / 32], __ATOMIC_RELAXED) & (1U << (db % 32))) == 0) { \
+								__atomic_fetch_or(&dbip_db_usage_map[db / 32], 1U << (db % 32), __ATOMIC_RELAXED); \
+							}; \
 						} else { \
 							fprintf(stderr, "FIXME: unsupported db value (exceed limit): %d (%d)\n", db, 32 * DBIP_DB_MAX_BLOCKS_32 - 1); \
 							exit(1); \
@@ -87,12 +89,24 @@ char dbip_db_usage_string[NI_MAXHOST] = "";
 static DB*      db_ptr_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
 static db_recno_t db_recno_max_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
 
+// compiled databases (memory mapped), checked once per database
+static s_ipv6calc_db_mmap *db_mmap_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
+static int db_mmap_checked[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
+
+// preloaded databases (--db-preload), loaded once per database
+static s_ipv6calc_db_mmap *db_preload_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
+static int db_preload_checked[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
+
+// data of selected databases opened by prepare, no lazy open afterwards
+static int wrapper_DBIP_prepared = 0;
+
 // creation time of databases
 time_t wrapper_db_unixtime_DBIP[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc)];
 
 // local prototyping
 static char     *libipv6calc_db_wrapper_DBIP_dbfilename(const unsigned int type); 
 static int libipv6calc_db_wrapper_DBIP_close(DB *dbp);
+static void *libipv6calc_db_wrapper_DBIP_open_data(const unsigned int type_flag, long int *db_recno_max_ptr, uint8_t *data_ptr_type_ptr);
 
 
 /*
@@ -131,6 +145,10 @@ int libipv6calc_db_wrapper_DBIP_wrapper_init(void) {
 		// clean local cache
 		db_ptr_cache[i] = NULL;
 		db_recno_max_cache[i] = -1;
+		db_mmap_cache[i] = NULL;
+		db_mmap_checked[i] = 0;
+		db_preload_cache[i] = NULL;
+		db_preload_checked[i] = 0;
 
 		dbp = libipv6calc_db_wrapper_DBIP_open_type(libipv6calc_db_wrapper_DBIP_db_file_desc[i].number | 0x10000, NULL);
 		if (dbp == NULL) {
@@ -257,6 +275,11 @@ int libipv6calc_db_wrapper_DBIP_wrapper_init(void) {
 		};
 	};
 
+	if (libipv6calc_db_wrapper_preload == 1) {
+		/* load data of selected databases now (compiled database has precedence), Berkeley DB is closed afterwards */
+		libipv6calc_db_wrapper_DBIP_wrapper_prepare();
+	};
+
 	wrapper_features |= wrapper_features_by_source[IPV6CALC_DB_SOURCE_DBIP];
 
 	return 0;
@@ -304,7 +327,17 @@ int libipv6calc_db_wrapper_DBIP_wrapper_cleanup(void) {
 			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "Close DBIP: type=%d desc='%s'", libipv6calc_db_wrapper_DBIP_db_file_desc[i].number, libipv6calc_db_wrapper_DBIP_db_file_desc[i].description);
 			libipv6calc_db_wrapper_DBIP_close(db_ptr_cache[i]);
 		};
+
+		libipv6calc_db_wrapper_mmap_close(db_mmap_cache[i]);
+		db_mmap_cache[i] = NULL;
+		db_mmap_checked[i] = 0;
+
+		libipv6calc_db_wrapper_mmap_close(db_preload_cache[i]);
+		db_preload_cache[i] = NULL;
+		db_preload_checked[i] = 0;
 	};
+
+	wrapper_DBIP_prepared = 0;
 #endif
 
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Finished");
@@ -312,6 +345,38 @@ int libipv6calc_db_wrapper_DBIP_wrapper_cleanup(void) {
 };
 
 
+/*
+ * open data of selected databases now (compiled, preloaded or Berkeley DB)
+ *  afterwards lookups only use already opened data, call before starting concurrent lookups
+ *
+ * in : (nothing)
+ * out: 0=ok
+ */
+int libipv6calc_db_wrapper_DBIP_wrapper_prepare(void) {
+	uint8_t data_ptr_type;
+	int selected[4] = { dbip_db_country_v4, dbip_db_country_v6, dbip_db_region_city_v4, dbip_db_region_city_v6 };
+	int i;
+
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Called");
+
+	if (wrapper_DBIP_prepared == 1) {
+		goto END_libipv6calc_db_wrapper_DBIP_wrapper_prepare;
+	};
+
+	for (i = 0; i < 4; i++) {
+		if (selected[i] > 0) {
+			libipv6calc_db_wrapper_DBIP_open_data(selected[i], NULL, &data_ptr_type);
+		};
+	};
+
+	wrapper_DBIP_prepared = 1;
+
+END_libipv6calc_db_wrapper_DBIP_wrapper_prepare:
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Finished");
+	return(0);
+};
+
+
 /*
  * function info of DBIP wrapper
  *
@@ -365,6 +430,10 @@ void libipv6calc_db_wrapper_DBIP_wrapper_print_db_info(const int level_verbose,
 				fprintf(stderr, "%sDBIP: %-30s: %-30s (%s)\n", prefix, libipv6calc_db_wrapper_DBIP_db_file_desc[i].description, libipv6calc_db_wrapper_DBIP_db_file_desc[i].filename, libipv6calc_db_wrapper_DBIP_database_info(type));
 				libipv6calc_db_wrapper_DBIP_close(dbp);
 				count++;
+
+				if ((level_verbose == LEVEL_VERBOSE2) && (db_preload_cache[i] != NULL)) {
+					fprintf(stderr, "%sDBIP: %-30s: preloaded rows=%u memory=%lu bytes load-time=%ld.%03ld ms\n", prefix, libipv6calc_db_wrapper_DBIP_db_file_desc[i].description, db_preload_cache[i]->section[0].rows, (unsigned long) db_preload_cache[i]->size, db_preload_cache[i]->load_usec / 1000, db_preload_cache[i]->load_usec % 1000);
+				};
 			};
 		} else {
 			if (level_verbose == LEVEL_VERBOSE2) {
@@ -617,6 +686,8 @@ DB *libipv6calc_db_wrapper_DBIP_open_type(const unsigned int type_flag, long int
 	DB *dbp = NULL;
 	DBC *dbcp;
 	DBT key, data;
+	db_recno_t recno;
+	char buffer[NI_MAXHOST];
 
 	int type = (type_flag & 0xffff);
 	int info_selector = ((type_flag & 0x10000) != 0) ? 1 : 0;
@@ -650,6 +721,12 @@ DB *libipv6calc_db_wrapper_DBIP_open_type(const unsigned int type_flag, long int
 		goto END_libipv6calc_db_wrapper;
 	};
 
+	if ((info_selector == 0) && (wrapper_DBIP_prepared == 1)) {
+		// no lazy open of data while lookups may run concurrently
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "Database not opened by prepare: type=%d", type);
+		return(NULL);
+	};
+
 	// retrieve filename
 	filename = libipv6calc_db_wrapper_DBIP_dbfilename(type);
 
@@ -664,7 +741,7 @@ DB *libipv6calc_db_wrapper_DBIP_open_type(const unsigned int type_flag, long int
 		return(NULL);
 	};
 
-	if ((ret = dbp->open(dbp, NULL, filename, (info_selector == 0) ? "data" : "info", (info_selector == 0) ? DB_RECNO : DB_BTREE, DB_RDONLY, 0444)) != 0) {
+	if ((ret = dbp->open(dbp, NULL, filename, (info_selector == 0) ? "data" : "info", (info_selector == 0) ? DB_RECNO : DB_BTREE, (info_selector == 0) ? (DB_RDONLY | DB_THREAD) : DB_RDONLY, 0444)) != 0) {
 		if (ipv6calc_quiet == 0) {
 			fprintf(stderr, "db->open failed: %s (%s)\n", db_strerror(ret), filename);
 		};
@@ -679,6 +756,14 @@ DB *libipv6calc_db_wrapper_DBIP_open_type(const unsigned int type_flag, long int
 		memset(&key, 0, sizeof(key));
 		memset(&data, 0, sizeof(data));
 
+		// results into own buffers, required for handles opened with DB_THREAD
+		key.data = &recno;
+		key.ulen = sizeof(recno);
+		key.flags = DB_DBT_USERMEM;
+		data.data = buffer;
+		data.ulen = sizeof(buffer) - 1;
+		data.flags = DB_DBT_USERMEM;
+
 		/* Acquire a cursor for the database. */
 		if ((ret = dbp->cursor(dbp, NULL, &dbcp, 0)) != 0) {
 			dbp->err(dbp, ret, "DB->cursor");
@@ -697,7 +782,7 @@ DB *libipv6calc_db_wrapper_DBIP_open_type(const unsigned int type_flag, long int
 			goto END_libipv6calc_db_wrapper_close_error;
 		};
 
-		db_recno_max_cache[entry] = *(db_recno_t *)key.data;
+		db_recno_max_cache[entry] = recno;
 
 		if (db_recno_max_cache[entry] < 2) {
 			goto END_libipv6calc_db_wrapper_close_error;
@@ -725,6 +810,144 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * wrapper extension: DBIP_open_data
+ *  compiled database (<filename>m) has precedence, if available and matching 'dbcreated_unixtime'
+ *  preloaded database (--db-preload) is used next, loaded from Berkeley DB on first call (or by prepare)
+ * input:
+ * 	type (mandatory)
+ * 	db_recno_max_ptr (set if not NULL)
+ * output:
+ * 	data_ptr_type_ptr (IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP or IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB)
+ * ret: pointer to database (section or DB), NULL = error
+ */
+static void *libipv6calc_db_wrapper_DBIP_open_data(const unsigned int type_flag, long int *db_recno_max_ptr, uint8_t *data_ptr_type_ptr) {
+	const s_ipv6calc_db_mmap_section *sectionp;
+	char filename[NI_MAXHOST];
+	char datastring[NI_MAXHOST];
+	char datastring_mmap[NI_MAXHOST];
+	DB *dbp_info, *dbp;
+	long int recno_max;
+	int entry = -1, i, ret;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_DBIP_db_file_desc); i++) {
+		if (libipv6calc_db_wrapper_DBIP_db_file_desc[i].number == (type_flag & 0xffff)) {
+			entry = i;
+			break;
+		};
+	};
+
+	if (entry < 0) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	if ((db_mmap_checked[entry] == 0) && (wrapper_DBIP_prepared == 0)) {
+		db_mmap_checked[entry] = 1;
+
+		snprintf(filename, sizeof(filename), "%s%s", libipv6calc_db_wrapper_DBIP_dbfilename(type_flag & 0xffff), IPV6CALC_DB_MMAP_SUFFIX);
+
+		if (access(filename, R_OK) != 0) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "No compiled database available: %s", filename);
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		db_mmap_cache[entry] = libipv6calc_db_wrapper_mmap_open(filename);
+
+		if (db_mmap_cache[entry] == NULL) {
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		// compare creation time with Berkeley DB
+		dbp_info = libipv6calc_db_wrapper_DBIP_open_type(type_flag | 0x10000, NULL);
+		ret = -1;
+		if (dbp_info != NULL) {
+			ret = libipv6calc_db_wrapper_bdb_get_data_by_key(dbp_info, "dbcreated_unixtime", datastring, sizeof(datastring));
+			libipv6calc_db_wrapper_DBIP_close(dbp_info);
+		};
+
+		if ((ret != 0) \
+		  || (libipv6calc_db_wrapper_mmap_get_data_by_key(db_mmap_cache[entry], "dbcreated_unixtime", datastring_mmap, sizeof(datastring_mmap)) != 0) \
+		  || (strcmp(datastring, datastring_mmap) != 0)) {
+			if (ipv6calc_quiet == 0) {
+				fprintf(stderr, "Compiled database is not matching Berkeley DB, ignored: %s\n", filename);
+			};
+			libipv6calc_db_wrapper_mmap_close(db_mmap_cache[entry]);
+			db_mmap_cache[entry] = NULL;
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "Compiled database mapped: %s", filename);
+	};
+
+END_libipv6calc_db_wrapper_mmap:
+	if (db_mmap_cache[entry] == NULL) {
+		goto END_libipv6calc_db_wrapper_preload;
+	};
+
+	sectionp = libipv6calc_db_wrapper_mmap_section(db_mmap_cache[entry], "data");
+
+	if ((sectionp == NULL) || (sectionp->rows < 1)) {
+		goto END_libipv6calc_db_wrapper_preload;
+	};
+
+	goto END_libipv6calc_db_wrapper_section;
+
+END_libipv6calc_db_wrapper_preload:
+	if (libipv6calc_db_wrapper_preload == 0) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	if ((db_preload_checked[entry] == 0) && (wrapper_DBIP_prepared == 0)) {
+		db_preload_checked[entry] = 1;
+
+		dbp = libipv6calc_db_wrapper_DBIP_open_type(type_flag, &recno_max);
+
+		if (dbp == NULL) {
+			goto END_libipv6calc_db_wrapper_bdb;
+		};
+
+		db_preload_cache[entry] = libipv6calc_db_wrapper_bdb_preload(dbp, \
+			((libipv6calc_db_wrapper_DBIP_db_file_desc[entry].features & IPV6CALC_DB_DBIP_IPV4) != 0) \
+			  ? IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2 \
+			  : IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4, \
+			recno_max, "data");
+
+		// data is now in memory
+		libipv6calc_db_wrapper_DBIP_close(dbp);
+	};
+
+	if (db_preload_cache[entry] == NULL) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	sectionp = &db_preload_cache[entry]->section[0];
+
+END_libipv6calc_db_wrapper_section:
+	if (db_recno_max_ptr != NULL) {
+		*db_recno_max_ptr = sectionp->rows;
+	};
+
+	*data_ptr_type_ptr = IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP;
+	return((void *) sectionp);
+
+END_libipv6calc_db_wrapper_bdb:
+	*data_ptr_type_ptr = IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB;
+	return((void *) libipv6calc_db_wrapper_DBIP_open_type(type_flag, db_recno_max_ptr));
+};
+
+
+/*
+ * wrapper extension: DBIP_close_data
+ *  compiled databases stay mapped until cleanup
+ *  prepared Berkeley DB handles are shared by concurrent lookups and stay open until cleanup
+ */
+static void libipv6calc_db_wrapper_DBIP_close_data(void *db_ptr, const uint8_t data_ptr_type) {
+	if ((data_ptr_type == IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB) && (wrapper_DBIP_prepared == 0)) {
+		libipv6calc_db_wrapper_DBIP_close((DB *) db_ptr);
+	};
+};
+
+
 /*******************************
  * Wrapper functions for DBIP
  *******************************/
@@ -861,17 +1084,22 @@ int libipv6calc_db_wrapper_DBIP_has_features(uint32_t features) {
 };
 
 
-/* country code */
-int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len) {
+/* country code, *rangep = address range of matching row with identical result (skipped if NULL, flag_valid=0 if not available) */
+int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len, ipv6calc_ipaddr_range *rangep) {
 	int result = -1;
-	DB *dbp;
+	void *dbp;
+	uint8_t data_ptr_type;
 
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 
 	int DBIP_type = 0;
 
 	long int recno_max;
 
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
 	//DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "Called with addr=%s proto=%d", addr, proto);
 
 	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
@@ -893,7 +1121,7 @@ int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipad
 		goto END_libipv6calc_db_wrapper;
 	};
 
-	dbp = libipv6calc_db_wrapper_DBIP_open_type(DBIP_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_DBIP_open_data(DBIP_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Error opening DBIP by type");
@@ -903,8 +1131,8 @@ int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipad
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_DBIP, "database opened type=%d recno_max=%ld", DBIP_type, recno_max);
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,						// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,			// type of data_ptr
+		dbp,							// pointer to database
+		data_ptr_type,						// type of data_ptr
 		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2 : IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4,	// key format
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? 32 : 64,	// key length
@@ -913,7 +1141,8 @@ int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipad
 		ipaddrp->addr[0],					// lookup key MSB
 		ipaddrp->addr[1],					// lookup key LSB
 		resultstring,						// data ptr
-		NULL							// function pointer
+		NULL,							// function pointer
+		rangep							// range of matching row
 	);
 
 	if (result < 0) {
@@ -968,7 +1197,7 @@ int libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipad
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_DBIP_close(dbp);
+	libipv6calc_db_wrapper_DBIP_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	return(result);
@@ -978,9 +1207,10 @@ END_libipv6calc_db_wrapper:
 /* city (& region) */
 int libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipaddrp, char *city, const size_t city_len, char *region, const size_t region_len) {
 	int result = -1;
-	DB *dbp;
+	void *dbp;
+	uint8_t data_ptr_type;
 
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 
 	int DBIP_type = 0;
 
@@ -1016,7 +1246,7 @@ int libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipad
 		goto END_libipv6calc_db_wrapper;
 	};
 
-	dbp = libipv6calc_db_wrapper_DBIP_open_type(DBIP_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_DBIP_open_data(DBIP_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Error opening DBIP by type");
@@ -1024,8 +1254,8 @@ int libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipad
 	};
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,						// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,			// type of data_ptr
+		dbp,							// pointer to database
+		data_ptr_type,						// type of data_ptr
 		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2 : IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4,	// key format
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? 32 : 64,	// key length
@@ -1034,7 +1264,8 @@ int libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipad
 		ipaddrp->addr[0],					// lookup key MSB
 		ipaddrp->addr[1],					// lookup key LSB
 		resultstring,						// data ptr
-		NULL							// function pointer
+		NULL,							// function pointer
+		NULL							// range of matching row (not used)
 	);
 
 	if (result < 0) {
@@ -1100,7 +1331,7 @@ int libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipad
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_DBIP_close(dbp);
+	libipv6calc_db_wrapper_DBIP_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	return(result);
@@ -1111,9 +1342,10 @@ END_libipv6calc_db_wrapper:
 int libipv6calc_db_wrapper_DBIP_all_by_addr(const ipv6calc_ipaddr *ipaddrp, DBIP_Record *recordp) {
 	int result = -1;
 
-	DB *dbp;
+	void *dbp;
+	uint8_t data_ptr_type;
 
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 
 	int DBIP_type = 0;
 
@@ -1194,7 +1426,7 @@ int libipv6calc_db_wrapper_DBIP_all_by_addr(const ipv6calc_ipaddr *ipaddrp, DBIP
 		goto END_libipv6calc_db_wrapper;
 	};
 
-	dbp = libipv6calc_db_wrapper_DBIP_open_type(DBIP_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_DBIP_open_data(DBIP_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_DBIP, "Error opening DBIP by type");
@@ -1202,8 +1434,8 @@ int libipv6calc_db_wrapper_DBIP_all_by_addr(const ipv6calc_ipaddr *ipaddrp, DBIP
 	};
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,						// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,			// type of data_ptr
+		dbp,							// pointer to database
+		data_ptr_type,						// type of data_ptr
 		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2 : IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4,	// key format
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) ? 32 : 64,	// key length
@@ -1212,7 +1444,8 @@ int libipv6calc_db_wrapper_DBIP_all_by_addr(const ipv6calc_ipaddr *ipaddrp, DBIP
 		ipaddrp->addr[0],					// lookup key MSB
 		ipaddrp->addr[1],					// lookup key LSB
 		resultstring,						// data ptr
-		NULL							// function pointer
+		NULL,							// function pointer
+		NULL							// range of matching row (not used)
 	);
 
 	if (result < 0) {
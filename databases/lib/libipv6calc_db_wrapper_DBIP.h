@@ -150,11 +150,12 @@ typedef struct
 
 extern int         libipv6calc_db_wrapper_DBIP_wrapper_init(void);
 extern int         libipv6calc_db_wrapper_DBIP_wrapper_cleanup(void);
+extern int         libipv6calc_db_wrapper_DBIP_wrapper_prepare(void);
 extern void        libipv6calc_db_wrapper_DBIP_wrapper_info(char* string, const size_t size);
 extern void        libipv6calc_db_wrapper_DBIP_wrapper_print_db_info(const int level_verbose, const char *prefix_string);
 extern char       *libipv6calc_db_wrapper_DBIP_wrapper_db_info_used(void);
 
-extern int         libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len);
+extern int         libipv6calc_db_wrapper_DBIP_wrapper_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len, ipv6calc_ipaddr_range *rangep);
 extern int	   libipv6calc_db_wrapper_DBIP_wrapper_city_by_addr(const ipv6calc_ipaddr *ipaddrp, char *city, const size_t city_len, char *region, const size_t region_len); 
 
 extern int         libipv6calc_db_wrapper_DBIP_has_features(const uint32_t features);
@@ -41,7 +41,9 @@ static uint32_t external_db_usage_map[EXTERNAL_DB_MAX_BLOCKS_32];
 
 #define EXTERNAL_DB_USAGE_MAP_TAG(db)	if (db < (32 * EXTERNAL_DB_MAX_BLOCKS_32)) { \
 							DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "Tag usage for db: %d", db); \
-							external_db_usage_map[db / 32] |= 1 << (db % 32); \
+							if ((__atomic_load_n(&external_db_usage_map[db / 32], __ATOMIC_RELAXED) & (1U << (db % 32))) == 0) { \
+								__atomic_fetch_or(&external_db_usage_map[db / 32], 1U << (db % 32), __ATOMIC_RELAXED); \
+							}; \
 						} else { \
 							fprintf(stderr, "FIXME: unsupported db value (exceed limit): %d (%d)\n", db, 32 * EXTERNAL_DB_MAX_BLOCKS_32 - 1); \
 							exit(1); \
@@ -54,6 +56,17 @@ char external_db_usage_string[NI_MAXHOST] = "";
 static DB *db_ptr_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)][IPV6CALC_DBD_SUBDB_MAX];
 static db_recno_t db_recno_max_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)][IPV6CALC_DBD_SUBDB_MAX];
 
+// compiled databases (memory mapped), checked once per database
+static s_ipv6calc_db_mmap *db_mmap_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)];
+static int db_mmap_checked[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)];
+
+// preloaded databases (--db-preload), loaded once per database and sub-database
+static s_ipv6calc_db_mmap *db_preload_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)][IPV6CALC_DBD_SUBDB_MAX];
+static int db_preload_checked[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)][IPV6CALC_DBD_SUBDB_MAX];
+
+// data of available databases opened by prepare, no lazy open afterwards
+static int wrapper_External_prepared = 0;
+
 // creation time of databases
 time_t wrapper_db_unixtime_External[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc)];
 
@@ -61,6 +74,7 @@ time_t wrapper_db_unixtime_External[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_Exte
 // local prototyping
 static char     *libipv6calc_db_wrapper_External_dbfilename(unsigned int type); 
 static char     *libipv6calc_db_wrapper_External_database_info(unsigned int type);
+static void     *libipv6calc_db_wrapper_External_open_data(const unsigned int type_flag, long int *db_recno_max_ptr, uint8_t *data_ptr_type_ptr);
 
 
 /*
@@ -85,7 +99,11 @@ int libipv6calc_db_wrapper_External_wrapper_init(void) {
 		for (j = 0; j < IPV6CALC_DBD_SUBDB_MAX; j++) {
 			db_ptr_cache[i][j] = NULL;
 			db_recno_max_cache[i][j] = -1;
+			db_preload_cache[i][j] = NULL;
+			db_preload_checked[i][j] = 0;
 		};
+		db_mmap_cache[i] = NULL;
+		db_mmap_checked[i] = 0;
 		wrapper_db_unixtime_External[i] = 0;
 
 		// add features to implemented
@@ -131,6 +149,11 @@ int libipv6calc_db_wrapper_External_wrapper_init(void) {
 		};
 	};
 
+	if (libipv6calc_db_wrapper_preload == 1) {
+		// load data now (compiled database has precedence), Berkeley DB is closed afterwards
+		libipv6calc_db_wrapper_External_wrapper_prepare();
+	};
+
 	wrapper_features |= wrapper_features_by_source[IPV6CALC_DB_SOURCE_EXTERNAL];
 
 	return 0;
@@ -182,7 +205,19 @@ int libipv6calc_db_wrapper_External_wrapper_cleanup(void) {
 				libipv6calc_db_wrapper_External_close(db_ptr_cache[i][j]);
 			};
 		};
+
+		for (j = 0; j < IPV6CALC_DBD_SUBDB_MAX; j++) {
+			libipv6calc_db_wrapper_mmap_close(db_preload_cache[i][j]);
+			db_preload_cache[i][j] = NULL;
+			db_preload_checked[i][j] = 0;
+		};
+
+		libipv6calc_db_wrapper_mmap_close(db_mmap_cache[i]);
+		db_mmap_cache[i] = NULL;
+		db_mmap_checked[i] = 0;
 	};
+
+	wrapper_External_prepared = 0;
 #endif
 
 	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Finished");
@@ -190,6 +225,49 @@ int libipv6calc_db_wrapper_External_wrapper_cleanup(void) {
 };
 
 
+/*
+ * open data of available databases now (compiled, preloaded or Berkeley DB)
+ *  afterwards lookups only use already opened data, call before starting concurrent lookups
+ *
+ * in : (nothing)
+ * out: 0=ok
+ */
+int libipv6calc_db_wrapper_External_wrapper_prepare(void) {
+	uint8_t data_ptr_type;
+	unsigned int type;
+	int i;
+
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Called");
+
+	if (wrapper_External_prepared == 1) {
+		goto END_libipv6calc_db_wrapper_External_wrapper_prepare;
+	};
+
+	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc); i++) {
+		if (wrapper_db_unixtime_External[i] == 0) {
+			// no proper database
+			continue;
+		};
+
+		type = libipv6calc_db_wrapper_External_db_file_desc[i].number;
+
+		libipv6calc_db_wrapper_External_open_data(type, NULL, &data_ptr_type);
+		if (type == EXTERNAL_DB_IPV4_REGISTRY) {
+			libipv6calc_db_wrapper_External_open_data(type | 0x20000, NULL, &data_ptr_type);
+		};
+		if ((type == EXTERNAL_DB_IPV4_REGISTRY) || (type == EXTERNAL_DB_IPV6_REGISTRY)) {
+			libipv6calc_db_wrapper_External_open_data(type | 0x40000, NULL, &data_ptr_type);
+		};
+	};
+
+	wrapper_External_prepared = 1;
+
+END_libipv6calc_db_wrapper_External_wrapper_prepare:
+	DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Finished");
+	return(0);
+};
+
+
 /*
  * function info of External wrapper
  *
@@ -217,7 +295,7 @@ void libipv6calc_db_wrapper_External_wrapper_info(char* string, const size_t siz
  * out: (void)
  */
 void libipv6calc_db_wrapper_External_wrapper_print_db_info(const int level_verbose, const char *prefix_string) {
-	int i, type, count = 0;
+	int i, j, type, count = 0;
 
 	const char *prefix = "\0";
 	if (prefix_string != NULL) {
@@ -237,6 +315,15 @@ void libipv6calc_db_wrapper_External_wrapper_print_db_info(const int level_verbo
 		if (libipv6calc_db_wrapper_External_db_avail(type)) {
 			printf("%sExternal: %-20s: %-40s (%s)\n", prefix, libipv6calc_db_wrapper_External_db_file_desc[i].description, libipv6calc_db_wrapper_External_db_file_desc[i].filename, libipv6calc_db_wrapper_External_database_info(type));
 			count++;
+
+			if (level_verbose == LEVEL_VERBOSE2) {
+				for (j = 0; j < IPV6CALC_DBD_SUBDB_MAX; j++) {
+					if (db_preload_cache[i][j] == NULL) {
+						continue;
+					};
+					printf("%sExternal: %-20s: preloaded %-9s rows=%u memory=%lu bytes load-time=%ld.%03ld ms\n", prefix, libipv6calc_db_wrapper_External_db_file_desc[i].description, db_preload_cache[i][j]->section[0].name, db_preload_cache[i][j]->section[0].rows, (unsigned long) db_preload_cache[i][j]->size, db_preload_cache[i][j]->load_usec / 1000, db_preload_cache[i][j]->load_usec % 1000);
+				};
+			};
 		} else {
 			if (level_verbose == LEVEL_VERBOSE2) {
 				printf("%sExternal: %-20s: %-40s (%s)\n", prefix, libipv6calc_db_wrapper_External_db_file_desc[i].description, libipv6calc_db_wrapper_External_dbfilename(type), strerror(errno));
@@ -406,6 +493,8 @@ DB *libipv6calc_db_wrapper_External_open_type(const unsigned int type_flag, long
 	DB *dbp = NULL;
 	DBC *dbcp;
 	DBT key, data;
+	db_recno_t recno;
+	char buffer[NI_MAXHOST];
 
 	int type = (type_flag & 0xffff);
 	int info_selector = ((type_flag & 0x10000) != 0) ? 1 : 0;
@@ -457,6 +546,12 @@ DB *libipv6calc_db_wrapper_External_open_type(const unsigned int type_flag, long
 		goto END_libipv6calc_db_wrapper;
 	};
 
+	if ((info_selector == 0) && (wrapper_External_prepared == 1)) {
+		// no lazy open of data while lookups may run concurrently
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "Database not opened by prepare: type=%d", type);
+		return(NULL);
+	};
+
 	// retrieve filename
 	filename = libipv6calc_db_wrapper_External_dbfilename(type);
 
@@ -476,7 +571,7 @@ DB *libipv6calc_db_wrapper_External_open_type(const unsigned int type_flag, long
 		return(NULL);
 	};
 
-	if ((ret = dbp->open(dbp, NULL, filename, type_text, (info_selector == 0) ? DB_RECNO : DB_BTREE, DB_RDONLY, 0444)) != 0) {
+	if ((ret = dbp->open(dbp, NULL, filename, type_text, (info_selector == 0) ? DB_RECNO : DB_BTREE, (info_selector == 0) ? (DB_RDONLY | DB_THREAD) : DB_RDONLY, 0444)) != 0) {
 		if ((ipv6calc_quiet == 0) && (data_info_selector == 0)) {
 			fprintf(stderr, "db->open failed: %s (%s) subdb=%s\n", db_strerror(ret), filename, type_text);
 		};
@@ -491,6 +586,14 @@ DB *libipv6calc_db_wrapper_External_open_type(const unsigned int type_flag, long
 		memset(&key, 0, sizeof(key));
 		memset(&data, 0, sizeof(data));
 
+		// results into own buffers, required for handles opened with DB_THREAD
+		key.data = &recno;
+		key.ulen = sizeof(recno);
+		key.flags = DB_DBT_USERMEM;
+		data.data = buffer;
+		data.ulen = sizeof(buffer) - 1;
+		data.flags = DB_DBT_USERMEM;
+
 		/* Acquire a cursor for the database. */
 		if ((ret = dbp->cursor(dbp, NULL, &dbcp, 0)) != 0) {
 			dbp->err(dbp, ret, "DB->cursor");
@@ -509,7 +612,7 @@ DB *libipv6calc_db_wrapper_External_open_type(const unsigned int type_flag, long
 			goto END_libipv6calc_db_wrapper_close_error;
 		};
 
-		db_recno_max_cache[entry][subdb] = *(db_recno_t *)key.data;
+		db_recno_max_cache[entry][subdb] = recno;
 
 		if (db_recno_max_cache[entry][subdb] < 2) {
 			goto END_libipv6calc_db_wrapper_close_error;
@@ -537,6 +640,163 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * wrapper extension: External_db_format
+ *  format of rows in Berkeley DB (used for preload)
+ */
+static uint8_t libipv6calc_db_wrapper_External_db_format(const unsigned int type_flag) {
+	switch (type_flag & 0xffff) {
+	    case EXTERNAL_DB_IPV6_REGISTRY:
+		if ((type_flag & 0x40000) != 0) {
+			return(IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4);
+		};
+		return(IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_WITH_VALUE_32x4);
+
+	    case EXTERNAL_DB_IPV6_COUNTRYCODE:
+		return(IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x4);
+
+	    default:
+		return(IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2);
+	};
+};
+
+
+/*
+ * wrapper extension: External_open_data
+ *  compiled database (<filename>m) has precedence, if available and matching 'dbcreated_unixtime'
+ *  preloaded database (--db-preload) is used next, loaded from Berkeley DB on first call (or by prepare)
+ * input:
+ * 	type (mandatory, see External_open_type, except 0x10000)
+ * 	db_recno_max_ptr (set if not NULL)
+ * output:
+ * 	data_ptr_type_ptr (IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP or IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB)
+ * ret: pointer to database (section or DB), NULL = error
+ */
+static void *libipv6calc_db_wrapper_External_open_data(const unsigned int type_flag, long int *db_recno_max_ptr, uint8_t *data_ptr_type_ptr) {
+	const s_ipv6calc_db_mmap_section *sectionp;
+	char filename[NI_MAXHOST];
+	char datastring[NI_MAXHOST];
+	const char *type_text;
+	int entry = -1, i, subdb;
+	long int recno_max;
+	DB *dbp;
+
+	if ((type_flag & 0x20000) != 0) {
+		type_text = "data-iana";
+		subdb = 1;
+	} else if ((type_flag & 0x40000) != 0) {
+		type_text = "data-info";
+		subdb = 2;
+	} else {
+		type_text = "data";
+		subdb = 0;
+	};
+
+	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_External_db_file_desc); i++) {
+		if (libipv6calc_db_wrapper_External_db_file_desc[i].number == (type_flag & 0xffff)) {
+			entry = i;
+			break;
+		};
+	};
+
+	if (entry < 0) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	if ((db_mmap_checked[entry] == 0) && (wrapper_External_prepared == 0)) {
+		db_mmap_checked[entry] = 1;
+
+		snprintf(filename, sizeof(filename), "%s%s", libipv6calc_db_wrapper_External_dbfilename(type_flag & 0xffff), IPV6CALC_DB_MMAP_SUFFIX);
+
+		if (access(filename, R_OK) != 0) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "No compiled database available: %s", filename);
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		db_mmap_cache[entry] = libipv6calc_db_wrapper_mmap_open(filename);
+
+		if (db_mmap_cache[entry] == NULL) {
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		if ((libipv6calc_db_wrapper_mmap_get_data_by_key(db_mmap_cache[entry], "dbcreated_unixtime", datastring, sizeof(datastring)) != 0) \
+		  || (atoi(datastring) != wrapper_db_unixtime_External[entry])) {
+			if (ipv6calc_quiet == 0) {
+				fprintf(stderr, "Compiled database is not matching Berkeley DB, ignored: %s\n", filename);
+			};
+			libipv6calc_db_wrapper_mmap_close(db_mmap_cache[entry]);
+			db_mmap_cache[entry] = NULL;
+			goto END_libipv6calc_db_wrapper_mmap;
+		};
+
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "Compiled database mapped: %s", filename);
+	};
+
+END_libipv6calc_db_wrapper_mmap:
+	if (db_mmap_cache[entry] == NULL) {
+		goto END_libipv6calc_db_wrapper_preload;
+	};
+
+	sectionp = libipv6calc_db_wrapper_mmap_section(db_mmap_cache[entry], type_text);
+
+	if ((sectionp == NULL) || (sectionp->rows < 1)) {
+		goto END_libipv6calc_db_wrapper_preload;
+	};
+
+	goto END_libipv6calc_db_wrapper_section;
+
+END_libipv6calc_db_wrapper_preload:
+	if (libipv6calc_db_wrapper_preload == 0) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	if ((db_preload_checked[entry][subdb] == 0) && (wrapper_External_prepared == 0)) {
+		db_preload_checked[entry][subdb] = 1;
+
+		dbp = libipv6calc_db_wrapper_External_open_type(type_flag, &recno_max);
+
+		if (dbp == NULL) {
+			goto END_libipv6calc_db_wrapper_bdb;
+		};
+
+		db_preload_cache[entry][subdb] = libipv6calc_db_wrapper_bdb_preload(dbp, libipv6calc_db_wrapper_External_db_format(type_flag), recno_max, type_text);
+
+		// data is now in memory
+		libipv6calc_db_wrapper_External_close(dbp);
+	};
+
+	if (db_preload_cache[entry][subdb] == NULL) {
+		goto END_libipv6calc_db_wrapper_bdb;
+	};
+
+	sectionp = &db_preload_cache[entry][subdb]->section[0];
+
+END_libipv6calc_db_wrapper_section:
+	if (db_recno_max_ptr != NULL) {
+		*db_recno_max_ptr = sectionp->rows;
+	};
+
+	*data_ptr_type_ptr = IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_MMAP;
+	return((void *) sectionp);
+
+END_libipv6calc_db_wrapper_bdb:
+	*data_ptr_type_ptr = IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB;
+	return((void *) libipv6calc_db_wrapper_External_open_type(type_flag, db_recno_max_ptr));
+};
+
+
+/*
+ * wrapper extension: External_close_data
+ *  compiled databases stay mapped until cleanup
+ *  prepared Berkeley DB handles are shared by concurrent lookups and stay open until cleanup
+ */
+static void libipv6calc_db_wrapper_External_close_data(void *db_ptr, const uint8_t data_ptr_type) {
+	if ((data_ptr_type == IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB) && (wrapper_External_prepared == 0)) {
+		libipv6calc_db_wrapper_External_close((DB *) db_ptr);
+	};
+};
+
+
 /*******************************
  * Wrapper functions for External
  *******************************/
@@ -679,9 +939,10 @@ int libipv6calc_db_wrapper_External_wrapper_registry_by_addr(const char *addr, c
 	int result = REGISTRY_UNKNOWN;
 
 	int i;
-	DB *dbp;
+	void *dbp;
+	uint8_t data_ptr_type;
 
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 
 	char *data_ptr = "";
 
@@ -725,7 +986,7 @@ int libipv6calc_db_wrapper_External_wrapper_registry_by_addr(const char *addr, c
 		goto END_libipv6calc_db_wrapper;
 	};
 
-	dbp = libipv6calc_db_wrapper_External_open_type(External_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_External_open_data(External_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Error opening External by type");
@@ -742,8 +1003,8 @@ int libipv6calc_db_wrapper_External_wrapper_registry_by_addr(const char *addr, c
 	};
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,						// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,			// type of data_ptr
+		dbp,							// pointer to database
+		data_ptr_type,						// type of data_ptr
 		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
 		(proto == 4) ? IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_DEC_32x2 : IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_DEC_32x4,   // key format
 		(proto == 4) ? 32 : 64,					// key length
@@ -752,7 +1013,8 @@ int libipv6calc_db_wrapper_External_wrapper_registry_by_addr(const char *addr, c
 		(proto == 4) ? ipv4 : ipv6_00_31,			// lookup key MSB
 		(proto == 4) ? 0    : ipv6_32_63,			// lookup key LSB
 		resultstring,						// data ptr
-		NULL							// function pointer
+		NULL,							// function pointer
+		NULL							// range of matching row (not used)
 	);
 
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "resultstring=%s", resultstring);
@@ -803,7 +1065,7 @@ int libipv6calc_db_wrapper_External_wrapper_registry_by_addr(const char *addr, c
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_External_close(dbp);
+	libipv6calc_db_wrapper_External_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	return(result);
@@ -814,18 +1076,24 @@ END_libipv6calc_db_wrapper:
  * get registry number of an IPv4/IPv6 address
  *
  * in:  ipaddr
+ * out: *rangep = address range of matching row with identical result (skipped if NULL, flag_valid=0 if not available)
  * out: assignment number (-1 = no result)
  */
-int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *ipaddrp) {
-	DB *dbp, *dbp_iana;
+int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *ipaddrp, ipv6calc_ipaddr_range *rangep) {
+	void *dbp, *dbp_iana;
+	uint8_t data_ptr_type, data_ptr_type_iana;
 	long int recno_max;
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 	char *data_ptr = "";
 	int i, result;
 	int retval = REGISTRY_UNKNOWN;
 
 	int External_type;
 
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
 	switch (ipaddrp->proto) {
 	    case IPV6CALC_PROTO_IPV4:
 		External_type = EXTERNAL_DB_IPV4_REGISTRY;
@@ -845,7 +1113,7 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 
 
 	// data (standard)
-	dbp = libipv6calc_db_wrapper_External_open_type(External_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_External_open_data(External_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Error opening External by type");
@@ -855,8 +1123,8 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "database opened type=%d recno_max=%ld dbp=%p", External_type, recno_max, dbp);
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,							// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,				// type of data_ptr
+		dbp,								// pointer to database
+		data_ptr_type,							// type of data_ptr
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) \
 		  ? IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST \
 		  : IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,			// key type
@@ -875,7 +1143,8 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 		  ? 0 \
 		  : ipaddrp->addr[1],						// lookup key LSB
 		resultstring,							// data ptr
-		NULL								// function pointer
+		NULL,								// function pointer
+		rangep								// range of matching row
 	);
 
 	if (result >= 0 ) {
@@ -889,7 +1158,7 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 
 	// data-iana (fallback for IPv4 only)
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "no found match in database type=%d, fallback to IANA data now for: %08x", External_type, ipaddrp->addr[0]);
-	dbp_iana = libipv6calc_db_wrapper_External_open_type(External_type | 0x20000, &recno_max);
+	dbp_iana = libipv6calc_db_wrapper_External_open_data(External_type | 0x20000, &recno_max, &data_ptr_type_iana);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Error opening External by type");
@@ -899,8 +1168,8 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "database opened type=%d (data-iana) recno_max=%ld", External_type, recno_max);
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp_iana,					// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,			// type of data_ptr
+		dbp_iana,						// pointer to database
+		data_ptr_type_iana,					// type of data_ptr
 		IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST,		// key type
 		IPV6CALC_DB_LOOKUP_DATA_DBD_FORMAT_SEMICOLON_SEP_HEX_32x2,   // key format
 		32,							// key length
@@ -909,10 +1178,11 @@ int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *
 		ipaddrp->addr[0],					// lookup key MSB
 		0,							// lookup key LSB
 		resultstring,						// data ptr
-		NULL							// function pointer
+		NULL,							// function pointer
+		NULL							// range of matching row (not used)
 	);
 
-	libipv6calc_db_wrapper_External_close(dbp_iana);
+	libipv6calc_db_wrapper_External_close_data(dbp_iana, data_ptr_type_iana);
 
 	if (result >= 0 ) {
 		goto END_libipv6calc_db_wrapper_match;
@@ -970,7 +1240,7 @@ END_libipv6calc_db_wrapper_match:
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_External_close(dbp);
+	libipv6calc_db_wrapper_External_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "retval=%d", retval);
@@ -983,18 +1253,24 @@ END_libipv6calc_db_wrapper:
  *
  * in:  ipaddr
  * mod: country code
+ * out: *rangep = address range of matching row with identical result (skipped if NULL, flag_valid=0 if not available)
  * out: status of retrievment (0=success, -1=problem)
  */
-int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len) {
-	DB *dbp;
+int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len, ipv6calc_ipaddr_range *rangep) {
+	void *dbp;
+	uint8_t data_ptr_type;
 	long int recno_max;
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 	char *data_ptr = "";
 	int result;
 	int retval = -1;
 
 	int External_type;
 
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
 	switch (ipaddrp->proto) {
 	    case IPV6CALC_PROTO_IPV4:
 		External_type = EXTERNAL_DB_IPV4_COUNTRYCODE;
@@ -1014,7 +1290,7 @@ int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *
 
 
 	// data (standard)
-	dbp = libipv6calc_db_wrapper_External_open_type(External_type, &recno_max);
+	dbp = libipv6calc_db_wrapper_External_open_data(External_type, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Error opening External by type");
@@ -1024,8 +1300,8 @@ int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "database opened type=%d recno_max=%ld dbp=%p", External_type, recno_max, dbp);
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,							// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,				// type of data_ptr
+		dbp,								// pointer to database
+		data_ptr_type,							// type of data_ptr
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) \
 		  ? IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST \
 		  : IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,			// key type
@@ -1042,7 +1318,8 @@ int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *
 		  ? 0 \
 		  : ipaddrp->addr[1],						// lookup key LSB
 		resultstring,							// data ptr
-		NULL								// function pointer
+		NULL,								// function pointer
+		rangep								// range of matching row
 	);
 
 	if (result < 0) {
@@ -1096,7 +1373,7 @@ int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_External_close(dbp);
+	libipv6calc_db_wrapper_External_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "retval=%d", retval);
@@ -1113,9 +1390,10 @@ END_libipv6calc_db_wrapper:
  * out: 0=OK
  */
 int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *string, const size_t string_len) {
-	DB *dbp;
+	void *dbp;
+	uint8_t data_ptr_type;
 	long int recno_max;
-	static char resultstring[NI_MAXHOST];
+	char resultstring[NI_MAXHOST];
 	char *data_ptr = "";
 	int result;
 	int retval = -1;
@@ -1141,7 +1419,7 @@ int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddr
 
 
 	// data-info
-	dbp = libipv6calc_db_wrapper_External_open_type(External_type | 0x40000, &recno_max);
+	dbp = libipv6calc_db_wrapper_External_open_data(External_type | 0x40000, &recno_max, &data_ptr_type);
 
 	if (dbp == NULL) {
 		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_External, "Error opening External by type");
@@ -1151,8 +1429,8 @@ int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddr
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "database opened type=%x recno_max=%ld dbp=%p", External_type | 0x40000, recno_max, dbp);
 
 	result = libipv6calc_db_wrapper_get_entry_generic(
-		(void *) dbp,							// pointer to database
-		IPV6CALC_DB_LOOKUP_DATA_PTR_TYPE_BDB,				// type of data_ptr
+		dbp,								// pointer to database
+		data_ptr_type,							// type of data_ptr
 		(ipaddrp->proto == IPV6CALC_PROTO_IPV4) \
 		  ? IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_FIRST_LAST \
 		  : IPV6CALC_DB_LOOKUP_DATA_KEY_TYPE_BASE_MASK,			// key type
@@ -1169,7 +1447,8 @@ int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddr
 		  ? 0 \
 		  : ipaddrp->addr[1],						// lookup key LSB
 		resultstring,							// data ptr
-		NULL								// function pointer
+		NULL,								// function pointer
+		NULL								// range of matching row (not used)
 	);
 
 	if (result < 0) {
@@ -1223,7 +1502,7 @@ int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddr
 	goto END_libipv6calc_db_wrapper; // keep db open
 
 END_libipv6calc_db_wrapper_close:
-	libipv6calc_db_wrapper_External_close(dbp);
+	libipv6calc_db_wrapper_External_close_data(dbp, data_ptr_type);
 
 END_libipv6calc_db_wrapper:
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_External, "retval=%d", retval);
@@ -53,6 +53,7 @@ typedef struct
 
 extern int         libipv6calc_db_wrapper_External_wrapper_init(void);
 extern int         libipv6calc_db_wrapper_External_wrapper_cleanup(void);
+extern int         libipv6calc_db_wrapper_External_wrapper_prepare(void);
 extern void        libipv6calc_db_wrapper_External_wrapper_info(char* string, const size_t size);
 extern void        libipv6calc_db_wrapper_External_wrapper_print_db_info(const int level_verbose, const char *prefix_string);
 extern char       *libipv6calc_db_wrapper_External_wrapper_db_info_used(void);
@@ -73,10 +74,10 @@ extern DB          *libipv6calc_db_wrapper_External_open_type(const unsigned int
 extern const char  *libipv6calc_db_wrapper_External_dbdescription(const unsigned int type);
 
 // IPv4/v6 Registry Number
-extern int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *ipaddrp);
+extern int libipv6calc_db_wrapper_External_registry_num_by_addr(const ipv6calc_ipaddr *ipaddrp, ipv6calc_ipaddr_range *rangep);
 
 // IPv4/v6 CountryCode 
-extern int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len);
+extern int libipv6calc_db_wrapper_External_country_code_by_addr(const ipv6calc_ipaddr *ipaddrp, char *country, const size_t country_len, ipv6calc_ipaddr_range *rangep);
 
 // IPv4/v6 Info
 extern int libipv6calc_db_wrapper_External_info_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *string, const size_t string_len);
@@ -17,6 +17,7 @@
 
 #include "libipv6calcdebug.h"
 #include "libipv6addr.h"
+#include "libipaddr.h"
 
 #include "libipv6calc_db_wrapper.h"
 
@@ -35,6 +36,16 @@ uint32_t lib_features_GeoIP = 0;
 
 char geoip_db_dir[NI_MAXHOST] = GEOIP_DB;
 
+/* database open mode (flags for GeoIP_open/GeoIP_open_type) */
+int geoip_db_open_flags = GEOIP_STANDARD;
+
+static const s_type geoip_db_open_modes[] = {
+	{ GEOIP_STANDARD     , "standard" },
+	{ GEOIP_MEMORY_CACHE , "memory"   },
+	{ GEOIP_MMAP_CACHE   , "mmap"     },
+	{ GEOIP_INDEX_CACHE  , "index"    },
+};
+
 #ifdef SUPPORT_GEOIP_DYN
 char geoip_lib_file[NI_MAXHOST] = GEOIP_DYN_LIB;
 static const char* wrapper_geoip_info = "dyn-load";
@@ -76,6 +87,18 @@ static int dl_status_GeoIP_name_by_addr = IPV6CALC_DL_STATUS_UNKNOWN;
 typedef char *(*dl_GeoIP_name_by_addr_t)(GeoIP* gi, const char *addr);
 static union { dl_GeoIP_name_by_addr_t func; void * obj; } dl_GeoIP_name_by_addr;
 
+static int dl_status_GeoIP_country_code_by_ipnum = IPV6CALC_DL_STATUS_UNKNOWN;
+typedef char *(*dl_GeoIP_country_code_by_ipnum_t)(GeoIP* gi, unsigned long ipnum);
+static union { dl_GeoIP_country_code_by_ipnum_t func; void * obj; } dl_GeoIP_country_code_by_ipnum;
+
+static int dl_status_GeoIP_name_by_ipnum = IPV6CALC_DL_STATUS_UNKNOWN;
+typedef char *(*dl_GeoIP_name_by_ipnum_t)(GeoIP* gi, unsigned long ipnum);
+static union { dl_GeoIP_name_by_ipnum_t func; void * obj; } dl_GeoIP_name_by_ipnum;
+
+static int dl_status_GeoIP_last_netmask = IPV6CALC_DL_STATUS_UNKNOWN;
+typedef int (*dl_GeoIP_last_netmask_t)(GeoIP* gi);
+static union { dl_GeoIP_last_netmask_t func; void * obj; } dl_GeoIP_last_netmask;
+
 static int dl_status_GeoIP_record_by_addr = IPV6CALC_DL_STATUS_UNKNOWN;
 typedef GeoIPRecord *(*dl_GeoIP_record_by_addr_t)(GeoIP* gi, const char *addr);
 static union { dl_GeoIP_record_by_addr_t func; void * obj; } dl_GeoIP_record_by_addr;
@@ -120,6 +143,7 @@ static char ***dl_GeoIPDBFileName_ptr = NULL;
 /* prototyping of feature check dl_load */
 static void libipv6calc_db_wrapper_dl_load_GeoIP_country_code_by_ipnum_v6 (void);
 static void libipv6calc_db_wrapper_dl_load_GeoIP_country_name_by_ipnum_v6 (void);
+static void libipv6calc_db_wrapper_dl_load_GeoIP_name_by_ipnum_v6 (void);
 static void libipv6calc_db_wrapper_dl_load_GeoIP_country_code_by_addr_v6 (void);
 static void libipv6calc_db_wrapper_dl_load_GeoIP_country_name_by_addr_v6 (void);
 static void libipv6calc_db_wrapper_dl_load_GeoIP_lib_version (void);
@@ -138,6 +162,10 @@ static int dl_status_GeoIP_country_code_by_ipnum_v6 = IPV6CALC_DL_STATUS_UNKNOWN
 typedef char *(*dl_GeoIP_country_code_by_ipnum_v6_t)(GeoIP* gi, geoipv6_t ipnum);
 static union { dl_GeoIP_country_code_by_ipnum_v6_t func; void * obj; } dl_GeoIP_country_code_by_ipnum_v6;
 
+static int dl_status_GeoIP_name_by_ipnum_v6 = IPV6CALC_DL_STATUS_UNKNOWN;
+typedef char *(*dl_GeoIP_name_by_ipnum_v6_t)(GeoIP* gi, geoipv6_t ipnum);
+static union { dl_GeoIP_name_by_ipnum_v6_t func; void * obj; } dl_GeoIP_name_by_ipnum_v6;
+
 #else // SUPPORT_GEOIP_DYN
 static const char* wrapper_geoip_info = "built-in";
 #endif // SUPPORT_GEOIP_DYN
@@ -162,7 +190,9 @@ static uint32_t geoip_db_usage_map[GEOIP_DB_MAX_BLOCKS_32];
 
 #define GEOIP_DB_USAGE_MAP_TAG(db)	if (db < (32 * GEOIP_DB_MAX_BLOCKS_32)) { \
 						DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Tag usage for db: %d", db); \
-						geoip_db_usage_map[db / 32] |= 1 << (db % 32); \
+						if ((__atomic_load_n(&geoip_db_usage_map[db / 32], __ATOMIC_RELAXED) & (1U << (db % 32))) == 0) { \
+							__atomic_fetch_or(&geoip_db_usage_map[db / 32], 1U << (db % 32), __ATOMIC_RELAXED); \
+						}; \
 					} else { \
 						fprintf(stderr, "FIXME: unsupported db value (exceed limit): %d (%d)\n", db, 32 * GEOIP_DB_MAX_BLOCKS_32 - 1); \
 						exit(1); \
@@ -230,6 +260,11 @@ int libipv6calc_db_wrapper_GeoIP_wrapper_init(void) {
 		lib_features_GeoIP |= GEOIP_LIB_FEATURE_IPV6_CN_BY_IPNUM;
 	};
 
+	libipv6calc_db_wrapper_dl_load_GeoIP_name_by_ipnum_v6();
+	if (dl_status_GeoIP_name_by_ipnum_v6 == IPV6CALC_DL_STATUS_OK) {
+		lib_features_GeoIP |= GEOIP_LIB_FEATURE_IPV6_AS_BY_IPNUM;
+	};
+
 	/* check for IPv6 full support */
 	libipv6calc_db_wrapper_dl_load_GeoIP_country_code_by_addr_v6();
 	if (dl_status_GeoIP_country_code_by_addr_v6 == IPV6CALC_DL_STATUS_OK) {
@@ -260,11 +295,10 @@ int libipv6calc_db_wrapper_GeoIP_wrapper_init(void) {
 
 #if defined SUPPORT_GEOIP_COUNTRY_CODE_BY_ADDR_V6 && defined SUPPORT_GEOIP_COUNTRY_NAME_BY_ADDR_V6
 		lib_features_GeoIP |= (GEOIP_LIB_FEATURE_IPV6_CC_BY_ADDR | GEOIP_LIB_FEATURE_IPV6_CN_BY_ADDR);
-#else // SUPPORT_GEOIP_COUNTRY_CODE_BY_ADDR_V6 && SUPPORT_GEOIP_COUNTRY_NAME_BY_ADDR_V6
+#endif // SUPPORT_GEOIP_COUNTRY_CODE_BY_ADDR_V6 && SUPPORT_GEOIP_COUNTRY_NAME_BY_ADDR_V6
 #ifdef SUPPORT_GEOIP_V6
-		lib_features_GeoIP |= (GEOIP_LIB_FEATURE_IPV6_CC_BY_IPNUM | GEOIP_LIB_FEATURE_IPV6_CN_BY_IPNUM);
+		lib_features_GeoIP |= (GEOIP_LIB_FEATURE_IPV6_CC_BY_IPNUM | GEOIP_LIB_FEATURE_IPV6_CN_BY_IPNUM | GEOIP_LIB_FEATURE_IPV6_AS_BY_IPNUM);
 #endif // SUPPORT_GEOIP_V6
-#endif // SUPPORT_GEOIP_COUNTRY_CODE_BY_ADDR_V6 && SUPPORT_GEOIP_COUNTRY_NAME_BY_ADDR_V6
 
 	libipv6calc_db_wrapper_GeoIPDBDescription = GeoIPDBDescription;
 	libipv6calc_db_wrapper_GeoIPDBFileName_ptr = &GeoIPDBFileName;
@@ -506,6 +540,7 @@ void libipv6calc_db_wrapper_GeoIP_wrapper_print_db_info(const int level_verbose,
 #endif // SUPPORT_GEOIP_DYN
 
 	fprintf(stderr, "%sGeoIP: info of available databases in directory: %s (max: %d)\n", prefix, geoip_db_dir, geoip_num_db_types - 1);
+	fprintf(stderr, "%sGeoIP: database open mode: %s\n", prefix, libipv6calc_db_wrapper_GeoIP_open_mode_name());
 
 	for (i = 0; i < geoip_num_db_types; i++) {
 		if (libipv6calc_db_wrapper_GeoIP_db_avail(i)) {
@@ -851,6 +886,43 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * set database open mode by name
+ * in : name (standard|memory|mmap|index)
+ * ret: 0=ok, 1=unsupported name
+ */
+int libipv6calc_db_wrapper_GeoIP_open_mode_set(const char *name) {
+	int i;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(geoip_db_open_modes); i++) {
+		if (strcmp(name, geoip_db_open_modes[i].token) == 0) {
+			geoip_db_open_flags = geoip_db_open_modes[i].number;
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Database open mode selected: %s (flags=%d)", name, geoip_db_open_flags);
+			return(0);
+		};
+	};
+
+	return(1);
+};
+
+
+/*
+ * get name of database open mode
+ * ret: name of mode
+ */
+const char *libipv6calc_db_wrapper_GeoIP_open_mode_name(void) {
+	int i;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(geoip_db_open_modes); i++) {
+		if (geoip_db_open_flags == geoip_db_open_modes[i].number) {
+			return(geoip_db_open_modes[i].token);
+		};
+	};
+
+	return("unknown");
+};
+
+
 /*
  * wrapper: GeoIP_open_type
  */
@@ -905,15 +977,14 @@ GeoIP *libipv6calc_db_wrapper_GeoIP_open_type(int type, int flags) {
 
 	dlerror();    /* Clear any existing error */
 
-	gi = (*dl_GeoIP_open_type.func)(type, flags);
+	gi = (*dl_GeoIP_open_type.func)(type, flags | geoip_db_open_flags);
 
 	if ((error = dlerror()) != NULL)  {
 		NONQUIETPRINT_WA("%s", error);
 		goto END_libipv6calc_db_wrapper;
 	};
 #else
-	if (flags == 0) { };  // make compiler happy (avoid unused "...")
-	gi = GeoIP_open_type(type, GEOIP_STANDARD);
+	gi = GeoIP_open_type(type, flags | geoip_db_open_flags);
 #endif
 
 	if (gi == NULL) {
@@ -971,7 +1042,7 @@ GeoIP* libipv6calc_db_wrapper_GeoIP_open(const char * filename, int flags) {
 
 	dlerror();    /* Clear any existing error */
 
-	gi = (*dl_GeoIP_open.func)(filename, flags);
+	gi = (*dl_GeoIP_open.func)(filename, flags | geoip_db_open_flags);
 
 	if ((error = dlerror()) != NULL)  {
 		fprintf(stderr, "%s\n", error);
@@ -981,8 +1052,7 @@ GeoIP* libipv6calc_db_wrapper_GeoIP_open(const char * filename, int flags) {
 END_libipv6calc_db_wrapper:
 	return(gi);
 #else
-	if (flags == 0) { };  // make compiler happy (avoid unused "...")
-	return(GeoIP_open(filename, GEOIP_STANDARD));
+	return(GeoIP_open(filename, flags | geoip_db_open_flags));
 #endif
 };
 
@@ -1254,6 +1324,62 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * wrapper: GeoIP_country_code_by_ipnum
+ */
+const char* libipv6calc_db_wrapper_GeoIP_country_code_by_ipnum (GeoIP* gi, unsigned long ipnum) {
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called: %s", wrapper_geoip_info);
+
+#ifdef SUPPORT_GEOIP_DYN
+	char* result_GeoIP_country_code_by_ipnum = NULL;
+	const char *dl_symbol = "GeoIP_country_code_by_ipnum";
+	char *error;
+
+	if (dl_GeoIP_handle == NULL) {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "dl_GeoIP_handle not defined");
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (dl_status_GeoIP_country_code_by_ipnum == IPV6CALC_DL_STATUS_UNKNOWN) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Call dlsym: %s", dl_symbol);
+
+		dlerror();    /* Clear any existing error */
+
+		*(void **) (&dl_GeoIP_country_code_by_ipnum.obj) = dlsym(dl_GeoIP_handle, dl_symbol);
+
+		if ((error = dlerror()) != NULL)  {
+			dl_status_GeoIP_country_code_by_ipnum = IPV6CALC_DL_STATUS_ERROR;
+			fprintf(stderr, "%s\n", error);
+			goto END_libipv6calc_db_wrapper;
+		};
+
+		dl_status_GeoIP_country_code_by_ipnum = IPV6CALC_DL_STATUS_OK;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called dlsym successful: %s", dl_symbol);
+	} else if (dl_status_GeoIP_country_code_by_ipnum == IPV6CALC_DL_STATUS_ERROR) {
+		/* already known issue */
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already failed: %s", dl_symbol);
+		goto END_libipv6calc_db_wrapper;
+	} else {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already successful: %s", dl_symbol);
+	};
+
+	dlerror();    /* Clear any existing error */
+
+	result_GeoIP_country_code_by_ipnum = (*dl_GeoIP_country_code_by_ipnum.func)(gi, ipnum);
+
+	if ((error = dlerror()) != NULL)  {
+		fprintf(stderr, "%s\n", error);
+		goto END_libipv6calc_db_wrapper;
+	};
+
+END_libipv6calc_db_wrapper:
+	return(result_GeoIP_country_code_by_ipnum);
+#else
+	return(GeoIP_country_code_by_ipnum(gi, ipnum));
+#endif
+};
+
+
 /*
  * wrapper: GeoIP_country_name_by_addr
  */
@@ -1598,8 +1724,145 @@ END_libipv6calc_db_wrapper:
 #endif
 };
 
+
+/*
+ * wrapper: GeoIP_name_by_ipnum_v6
+ */
+char * libipv6calc_db_wrapper_GeoIP_name_by_ipnum_v6 (GeoIP* gi, geoipv6_t ipnum) {
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called: %s", wrapper_geoip_info);;
+
+#ifdef SUPPORT_GEOIP_DYN
+	char* result_GeoIP_name_by_ipnum_v6 = NULL;
+
+	libipv6calc_db_wrapper_dl_load_GeoIP_name_by_ipnum_v6();
+
+	if (dl_status_GeoIP_name_by_ipnum_v6 != IPV6CALC_DL_STATUS_OK) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	result_GeoIP_name_by_ipnum_v6 = (*dl_GeoIP_name_by_ipnum_v6.func)(gi, ipnum);
+
+END_libipv6calc_db_wrapper:
+	return(result_GeoIP_name_by_ipnum_v6);
+#else
+	return(GeoIP_name_by_ipnum_v6(gi, ipnum));
+#endif
+};
+
 #endif // SUPPORT_GEOIP_V6
 
+/*
+ * wrapper: GeoIP_name_by_ipnum
+ */
+char* libipv6calc_db_wrapper_GeoIP_name_by_ipnum (GeoIP* gi, unsigned long ipnum) {
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called: %s", wrapper_geoip_info);
+
+#ifdef SUPPORT_GEOIP_DYN
+	char* result_GeoIP_name_by_ipnum = NULL;
+	const char *dl_symbol = "GeoIP_name_by_ipnum";
+	char *error;
+
+	if (dl_GeoIP_handle == NULL) {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "dl_GeoIP_handle not defined");
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (dl_status_GeoIP_name_by_ipnum == IPV6CALC_DL_STATUS_UNKNOWN) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Call dlsym: %s", dl_symbol);
+
+		dlerror();    /* Clear any existing error */
+
+		*(void **) (&dl_GeoIP_name_by_ipnum.obj) = dlsym(dl_GeoIP_handle, dl_symbol);
+
+		if ((error = dlerror()) != NULL)  {
+			dl_status_GeoIP_name_by_ipnum = IPV6CALC_DL_STATUS_ERROR;
+			fprintf(stderr, "%s\n", error);
+			goto END_libipv6calc_db_wrapper;
+		};
+
+		dl_status_GeoIP_name_by_ipnum = IPV6CALC_DL_STATUS_OK;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called dlsym successful: %s", dl_symbol);
+	} else if (dl_status_GeoIP_name_by_ipnum == IPV6CALC_DL_STATUS_ERROR) {
+		/* already known issue */
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already failed: %s", dl_symbol);
+		goto END_libipv6calc_db_wrapper;
+	} else {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already successful: %s", dl_symbol);
+	};
+
+	dlerror();    /* Clear any existing error */
+
+	result_GeoIP_name_by_ipnum = (*dl_GeoIP_name_by_ipnum.func)(gi, ipnum);
+
+	if ((error = dlerror()) != NULL)  {
+		fprintf(stderr, "%s\n", error);
+		goto END_libipv6calc_db_wrapper;
+	};
+
+END_libipv6calc_db_wrapper:
+	return(result_GeoIP_name_by_ipnum);
+#else
+	return(GeoIP_name_by_ipnum(gi, ipnum));
+#endif
+};
+
+
+/*
+ * wrapper: GeoIP_last_netmask
+ */
+int libipv6calc_db_wrapper_GeoIP_last_netmask (GeoIP* gi) {
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called: %s", wrapper_geoip_info);
+
+#ifdef SUPPORT_GEOIP_DYN
+	int result_GeoIP_last_netmask = 0;
+	const char *dl_symbol = "GeoIP_last_netmask";
+	char *error;
+
+	if (dl_GeoIP_handle == NULL) {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "dl_GeoIP_handle not defined");
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (dl_status_GeoIP_last_netmask == IPV6CALC_DL_STATUS_UNKNOWN) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Call dlsym: %s", dl_symbol);
+
+		dlerror();    /* Clear any existing error */
+
+		*(void **) (&dl_GeoIP_last_netmask.obj) = dlsym(dl_GeoIP_handle, dl_symbol);
+
+		if ((error = dlerror()) != NULL)  {
+			dl_status_GeoIP_last_netmask = IPV6CALC_DL_STATUS_ERROR;
+			fprintf(stderr, "%s\n", error);
+			goto END_libipv6calc_db_wrapper;
+		};
+
+		dl_status_GeoIP_last_netmask = IPV6CALC_DL_STATUS_OK;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called dlsym successful: %s", dl_symbol);
+	} else if (dl_status_GeoIP_last_netmask == IPV6CALC_DL_STATUS_ERROR) {
+		/* already known issue */
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already failed: %s", dl_symbol);
+		goto END_libipv6calc_db_wrapper;
+	} else {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already successful: %s", dl_symbol);
+	};
+
+	dlerror();    /* Clear any existing error */
+
+	result_GeoIP_last_netmask = (*dl_GeoIP_last_netmask.func)(gi);
+
+	if ((error = dlerror()) != NULL)  {
+		fprintf(stderr, "%s\n", error);
+		goto END_libipv6calc_db_wrapper;
+	};
+
+END_libipv6calc_db_wrapper:
+	return(result_GeoIP_last_netmask);
+#else
+	return(GeoIP_last_netmask(gi));
+#endif
+};
+
+
 /*
  * wrapper: GeoIP_name_by_addr
  */
@@ -1798,6 +2061,45 @@ END_libipv6calc_db_wrapper_dl_load:
 };
 
 
+/* libipv6calc_db_wrapper_dl_load_GeoIP_name_by_ipnum_v6 */
+static void libipv6calc_db_wrapper_dl_load_GeoIP_name_by_ipnum_v6(void) {
+	const char *dl_symbol = "GeoIP_name_by_ipnum_v6";
+	char *error;
+
+	if (dl_GeoIP_handle == NULL) {
+		DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "dl_GeoIP_handle not defined");
+		goto END_libipv6calc_db_wrapper_dl_load;
+	};
+
+	if (dl_status_GeoIP_name_by_ipnum_v6 == IPV6CALC_DL_STATUS_UNKNOWN) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Call dlsym: %s", dl_symbol);
+
+		dlerror();    /* Clear any existing error */
+
+		*(void **) (&dl_GeoIP_name_by_ipnum_v6.obj) = dlsym(dl_GeoIP_handle, dl_symbol);
+
+		if ((error = dlerror()) != NULL)  {
+			dl_status_GeoIP_name_by_ipnum_v6 = IPV6CALC_DL_STATUS_ERROR;
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "dl_symbol GeoIP_name_by_ipnum_v6 not found");
+			// fprintf(stderr, "%s\n", error); // stay silent
+			goto END_libipv6calc_db_wrapper_dl_load;
+		};
+
+		dl_status_GeoIP_name_by_ipnum_v6 = IPV6CALC_DL_STATUS_OK;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called dlsym successful: %s", dl_symbol);
+	} else if (dl_status_GeoIP_name_by_ipnum_v6 == IPV6CALC_DL_STATUS_ERROR) {
+		/* already known issue */
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already failed: %s", dl_symbol);
+		goto END_libipv6calc_db_wrapper_dl_load;
+	} else {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Previous call of dlsym already successful: %s", dl_symbol);
+	};
+
+END_libipv6calc_db_wrapper_dl_load:
+	return;
+};
+
+
 /* libipv6calc_db_wrapper_dl_load_GeoIP_country_code_by_addr_v6 */
 static void libipv6calc_db_wrapper_dl_load_GeoIP_country_code_by_addr_v6(void) {
 	const char *dl_symbol = "GeoIP_country_code_by_addr_v6";
@@ -2130,6 +2432,195 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * country_code by address structure
+ *  numeric lookup is used where provided by the library, string only on fallback
+ * in : ipaddrp
+ * mod: addrstring (filled on first use, can be shared between lookups of same address)
+ * ret: country code or NULL
+ */
+const char *libipv6calc_db_wrapper_GeoIP_wrapper_country_code_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *addrstring, const size_t addrstring_size) {
+	GeoIP *gi;
+	int GeoIP_type = 0;
+	const char *GeoIP_result_ptr = NULL;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called with addr=%08x%08x%08x%08x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		GeoIP_type = GEOIP_COUNTRY_EDITION;
+#ifdef SUPPORT_GEOIP_V6
+#if HAVE_DECL_GEOIP_COUNTRY_EDITION_V6 == 1
+	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
+		GeoIP_type = GEOIP_COUNTRY_EDITION_V6;
+#endif
+#endif // SUPPORT_GEOIP_V6
+	} else {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	gi = libipv6calc_db_wrapper_GeoIP_open_type(GeoIP_type, 0);
+
+	if (gi == NULL) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_country_code_by_ipnum(gi, (unsigned long) ipaddrp->addr[0]);
+#ifdef SUPPORT_GEOIP_V6
+	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
+		if ((lib_features_GeoIP & GEOIP_LIB_FEATURE_IPV6_CC_BY_IPNUM) != 0) {
+			ipv6calc_ipv6addr ipv6addr;
+			CONVERT_IPADDRP_IPV6ADDR(ipaddrp, ipv6addr)
+			GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_country_code_by_ipnum_v6(gi, ipv6addr.in6_addr);
+		} else if ((lib_features_GeoIP & GEOIP_LIB_FEATURE_IPV6_CC_BY_ADDR) != 0) {
+			if (strlen(addrstring) == 0) {
+				libipaddr_ipaddrstruct_to_string(ipaddrp, addrstring, addrstring_size, 0);
+			};
+			GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_country_code_by_addr_v6(gi, addrstring);
+		};
+#endif // SUPPORT_GEOIP_V6
+	};
+
+	if (GeoIP_result_ptr == NULL) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (strlen(GeoIP_result_ptr) > 2) {
+		GeoIP_result_ptr = NULL;
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	GEOIP_DB_USAGE_MAP_TAG(GeoIP_type);
+
+END_libipv6calc_db_wrapper:
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Result: %s", GeoIP_result_ptr);
+	return(GeoIP_result_ptr);
+};
+
+
+/*
+ * asnum by address structure
+ *  numeric lookup is used where provided by the library, string only on fallback
+ * in : ipaddrp
+ * mod: addrstring (filled on first use, can be shared between lookups of same address)
+ * out: *rangep = address range of matching netmask (skipped if NULL, flag_valid=0 if not available)
+ * ret: AS text or NULL
+ */
+char *libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *addrstring, const size_t addrstring_size, ipv6calc_ipaddr_range *rangep) {
+	GeoIP *gi;
+	int GeoIP_type = 0;
+	char *GeoIP_result_ptr = NULL;
+	int netmask, i;
+
+	if (rangep != NULL) {
+		rangep->flag_valid = 0;
+	};
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Called with addr=%08x%08x%08x%08x proto=%d", ipaddrp->addr[0], ipaddrp->addr[1], ipaddrp->addr[2], ipaddrp->addr[3], ipaddrp->proto);
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		if ((wrapper_features_by_source[IPV6CALC_DB_SOURCE_GEOIP] & IPV6CALC_DB_IPV4_TO_AS) == 0) {
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Database/Support not available: GEOIP_ASNUM_EDITION");
+			goto END_libipv6calc_db_wrapper;
+		};
+
+#if HAVE_DECL_GEOIP_ASNUM_EDITION == 1
+		GeoIP_type = GEOIP_ASNUM_EDITION;
+#else
+		goto END_libipv6calc_db_wrapper;
+#endif
+
+#ifdef SUPPORT_GEOIP_V6
+	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
+		if ((wrapper_features_by_source[IPV6CALC_DB_SOURCE_GEOIP] & IPV6CALC_DB_IPV6_TO_AS) == 0) {
+			DEBUGPRINT_NA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Database/Support not available: GEOIP_ASNUM_EDITION_V6");
+			goto END_libipv6calc_db_wrapper;
+		};
+
+#if HAVE_DECL_GEOIP_ASNUM_EDITION_V6 == 1
+		GeoIP_type = GEOIP_ASNUM_EDITION_V6;
+#else
+		goto END_libipv6calc_db_wrapper;
+#endif
+
+#endif // SUPPORT_GEOIP_V6
+	} else {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	gi = libipv6calc_db_wrapper_GeoIP_open_type(GeoIP_type, 0);
+
+	if (gi == NULL) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_name_by_ipnum(gi, (unsigned long) ipaddrp->addr[0]);
+#ifdef SUPPORT_GEOIP_V6
+	} else if (ipaddrp->proto == IPV6CALC_PROTO_IPV6) {
+		if ((lib_features_GeoIP & GEOIP_LIB_FEATURE_IPV6_AS_BY_IPNUM) != 0) {
+			ipv6calc_ipv6addr ipv6addr;
+			CONVERT_IPADDRP_IPV6ADDR(ipaddrp, ipv6addr)
+			GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_name_by_ipnum_v6(gi, ipv6addr.in6_addr);
+		} else {
+			if (strlen(addrstring) == 0) {
+				libipaddr_ipaddrstruct_to_string(ipaddrp, addrstring, addrstring_size, 0);
+			};
+			GeoIP_result_ptr = libipv6calc_db_wrapper_GeoIP_name_by_addr_v6(gi, addrstring);
+		};
+#endif // SUPPORT_GEOIP_V6
+	};
+
+	if (GeoIP_result_ptr == NULL) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	GEOIP_DB_USAGE_MAP_TAG(GeoIP_type);
+
+	if (rangep == NULL) {
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	// netmask of the matching tree node covers all addresses with identical result
+	netmask = libipv6calc_db_wrapper_GeoIP_last_netmask(gi);
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Netmask of result: %d", netmask);
+
+	if (ipaddrp->proto == IPV6CALC_PROTO_IPV4) {
+		if ((netmask < 1) || (netmask > 32)) {
+			goto END_libipv6calc_db_wrapper;
+		};
+		rangep->first[0] = ipaddrp->addr[0] & (0xffffffffu << (32 - netmask));
+		rangep->last[0] = rangep->first[0] | ~(0xffffffffu << (32 - netmask));
+		rangep->first[1] = 0; rangep->first[2] = 0; rangep->first[3] = 0;
+		rangep->last[1] = 0; rangep->last[2] = 0; rangep->last[3] = 0;
+	} else {
+		// range of IPv6 is limited to prefix (0-63)
+		if ((netmask < 1) || (netmask > 64)) {
+			goto END_libipv6calc_db_wrapper;
+		};
+		for (i = 0; i < 2; i++) {
+			if (netmask >= (i + 1) * 32) {
+				rangep->first[i] = ipaddrp->addr[i];
+				rangep->last[i] = ipaddrp->addr[i];
+			} else if (netmask <= i * 32) {
+				rangep->first[i] = 0;
+				rangep->last[i] = 0xffffffffu;
+			} else {
+				rangep->first[i] = ipaddrp->addr[i] & (0xffffffffu << ((i + 1) * 32 - netmask));
+				rangep->last[i] = rangep->first[i] | ~(0xffffffffu << ((i + 1) * 32 - netmask));
+			};
+		};
+		rangep->first[2] = 0; rangep->first[3] = 0;
+		rangep->last[2] = 0xffffffffu; rangep->last[3] = 0xffffffffu;
+	};
+	rangep->flag_valid = 1;
+
+END_libipv6calc_db_wrapper:
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_GeoIP, "Result: %s", GeoIP_result_ptr);
+	return(GeoIP_result_ptr);
+};
+
+
 /* record: city */
 GeoIPRecord *libipv6calc_db_wrapper_GeoIP_wrapper_record_city_by_addr(const char *addr, const int proto) {
 	GeoIP *gi;
@@ -9,6 +9,7 @@
  */
 
 #include "ipv6calctypes.h"
+#include "libipaddr.h"
 
 #ifndef _libipv6calc_db_wrapper_GeoIP_h
 
@@ -25,6 +26,7 @@
 #define GEOIP_LIB_FEATURE_IPV6_CN_BY_IPNUM	0x0200
 #define GEOIP_LIB_FEATURE_IPV6_CC_BY_ADDR	0x0400
 #define GEOIP_LIB_FEATURE_IPV6_CN_BY_ADDR	0x0800
+#define GEOIP_LIB_FEATURE_IPV6_AS_BY_IPNUM	0x1000
 
 // features
 extern uint32_t wrapper_features_GeoIP;
@@ -37,14 +39,19 @@ extern int          libipv6calc_db_wrapper_GeoIP_wrapper_cleanup(void);
 extern const char  *libipv6calc_db_wrapper_GeoIP_wrapper_country_code_by_addr(const char *addr, const int proto);
 extern const char  *libipv6calc_db_wrapper_GeoIP_wrapper_country_name_by_addr(const char *addr, const int proto);
 extern char        *libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_addr(const char *addr, const int proto);
+extern const char  *libipv6calc_db_wrapper_GeoIP_wrapper_country_code_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *addrstring, const size_t addrstring_size);
+extern char        *libipv6calc_db_wrapper_GeoIP_wrapper_asnum_by_ipaddr(const ipv6calc_ipaddr *ipaddrp, char *addrstring, const size_t addrstring_size, ipv6calc_ipaddr_range *rangep);
 extern void         libipv6calc_db_wrapper_GeoIP_wrapper_info(char* string, const size_t size);
 extern void         libipv6calc_db_wrapper_GeoIP_wrapper_print_db_info(const int level_verbose, const char *prefix_string);
 extern char        *libipv6calc_db_wrapper_GeoIP_wrapper_db_info_used(void);
+extern int          libipv6calc_db_wrapper_GeoIP_open_mode_set(const char *name);
+extern const char  *libipv6calc_db_wrapper_GeoIP_open_mode_name(void);
 
 extern int          libipv6calc_db_wrapper_GeoIP_has_features(uint32_t features);
 
 extern char geoip_lib_file[NI_MAXHOST];
 extern char geoip_db_dir[NI_MAXHOST];
+extern int  geoip_db_open_flags;
 
 
 #ifdef SUPPORT_GEOIP
@@ -56,6 +63,9 @@ extern unsigned char libipv6calc_db_wrapper_GeoIP_database_edition(GeoIP *gi);
 extern char         *libipv6calc_db_wrapper_GeoIP_database_info(GeoIP *gi);
 extern void          libipv6calc_db_wrapper_GeoIP_delete(GeoIP *gi);
 extern const char   *libipv6calc_db_wrapper_GeoIP_country_code_by_addr(GeoIP *gi, const char *addr);
+extern const char   *libipv6calc_db_wrapper_GeoIP_country_code_by_ipnum(GeoIP *gi, unsigned long ipnum);
+extern char         *libipv6calc_db_wrapper_GeoIP_name_by_ipnum(GeoIP *gi, unsigned long ipnum);
+extern int           libipv6calc_db_wrapper_GeoIP_last_netmask(GeoIP *gi);
 extern const char   *libipv6calc_db_wrapper_GeoIP_country_name_by_addr(GeoIP *gi, const char *addr);
 extern const char   *libipv6calc_db_wrapper_GeoIP_country_name_by_addr(GeoIP *gi, const char *addr);
 extern GeoIPRecord  *libipv6calc_db_wrapper_GeoIP_record_by_addr(GeoIP *gi, const char *addr);
@@ -68,6 +78,7 @@ extern const char   *libipv6calc_db_wrapper_GeoIP_country_name_by_addr_v6(GeoIP
 #if HAVE_DECL_GEOIP_COUNTRY_CODE_BY_IPNUM_V6 == 1
 extern const char   *libipv6calc_db_wrapper_GeoIP_country_code_by_ipnum_v6(GeoIP *gi, geoipv6_t ipnum);
 extern const char   *libipv6calc_db_wrapper_GeoIP_country_name_by_ipnum_v6(GeoIP *gi, geoipv6_t ipnum);
+extern char         *libipv6calc_db_wrapper_GeoIP_name_by_ipnum_v6(GeoIP *gi, geoipv6_t ipnum);
 #endif
 #endif
 
@@ -52,6 +52,10 @@ static int dl_status_IP2Location_open = IPV6CALC_DL_STATUS_UNKNOWN;
 typedef IP2Location *(*dl_IP2Location_open_t)(char *db);
 static union { dl_IP2Location_open_t func; void * obj; } dl_IP2Location_open;
 
+static int dl_status_IP2Location_open_mem = IPV6CALC_DL_STATUS_UNKNOWN;
+typedef int (*dl_IP2Location_open_mem_t)(IP2Location *loc, int mtype);
+static union { dl_IP2Location_open_mem_t func; void * obj; } dl_IP2Location_open_mem;
+
 static int dl_status_IP2Location_close = IPV6CALC_DL_STATUS_UNKNOWN;
 typedef int (*dl_IP2Location_close_t)(IP2Location *loc);
 static union { dl_IP2Location_close_t func; void * obj; } dl_IP2Location_close;
@@ -137,6 +141,18 @@ int ip2location_db_only_type = 0;
 // allow soft links (usually skipped)
 int ip2location_db_allow_softlinks = 0;
 
+// database access mode, applied to databases opened after selection has finished
+int ip2location_db_access_mode = IP2LOCATION_DB_ACCESS_FILE_IO;
+
+static const s_type ip2location_db_access_modes[] = {
+	{ IP2LOCATION_DB_ACCESS_FILE_IO      , "file"   },
+	{ IP2LOCATION_DB_ACCESS_CACHE_MEMORY , "cache"  },
+	{ IP2LOCATION_DB_ACCESS_SHARED_MEMORY, "shared" },
+};
+
+static int ip2location_db_access_mode_active = 0;	// set after database selection during init
+static int ip2location_db_access_shared_entry = -1;	// library supports only one shared memory segment per process
+
 #define IP2L_PACK_YM(loc) (loc->databaseyear * 12 + (loc->databasemonth -1))
 #define IP2L_UNPACK_YM(dbym) ((dbym > 0) ? ((dbym % 12) + 1 + ((dbym / 12) + 2000) * 100) : 0)
 
@@ -173,7 +189,9 @@ static uint32_t ip2location_db_usage_map[IP2LOCATION_DB_MAX_BLOCKS_32];
 
 #define IP2LOCATION_DB_USAGE_MAP_TAG(db)	if (db < (32 * IP2LOCATION_DB_MAX_BLOCKS_32)) { \
 							DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Tag usage for db: %d", db); \
-							ip2location_db_usage_map[db / 32] |= 1 << (db % 32); \
+							if ((__atomic_load_n(&ip2location_db_usage_map[db / 32], __ATOMIC_RELAXED) & (1U << (db % 32))) == 0) { \
+								__atomic_fetch_or(&ip2location_db_usage_map[db / 32], 1U << (db % 32), __ATOMIC_RELAXED); \
+							}; \
 						} else { \
 							fprintf(stderr, "FIXME: unsupported db value (exceed limit): %d (%d)\n", db, 32 * IP2LOCATION_DB_MAX_BLOCKS_32 - 1); \
 							exit(1); \
@@ -183,10 +201,12 @@ char ip2location_db_usage_string[NI_MAXHOST] = "";
 
 // local cache
 static IP2Location *db_ptr_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_IP2Location_db_file_desc)];
+static int db_access_mode_cache[MAXENTRIES_ARRAY(libipv6calc_db_wrapper_IP2Location_db_file_desc)];
 
 // local prototyping
 static char     *libipv6calc_db_wrapper_IP2Location_dbfilename(const unsigned int type); 
 static int       libipv6calc_db_wrapper_IP2Location_db_compatible(const unsigned int type); 
+static void      libipv6calc_db_wrapper_IP2Location_access_mode_apply(const int entry);
 
 
 /*
@@ -440,6 +460,14 @@ int libipv6calc_db_wrapper_IP2Location_wrapper_init(void) {
 		};
 	};
 
+	/* apply database access mode to databases in use, further opened ones get it on open */
+	ip2location_db_access_mode_active = 1;
+	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_IP2Location_db_file_desc); i++) {
+		if (db_ptr_cache[i] != NULL) {
+			libipv6calc_db_wrapper_IP2Location_access_mode_apply(i);
+		};
+	};
+
 	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Version of linked library: %s / IPv6 support: %s / custom directory: %s", libipv6calc_db_wrapper_IP2Location_lib_version(), libipv6calc_db_wrapper_IP2Location_IPv6_support[wrapper_ip2location_ipv6_support].token, ip2location_db_dir);
 
 	wrapper_features |= wrapper_features_by_source[IPV6CALC_DB_SOURCE_IP2LOCATION];
@@ -510,6 +538,10 @@ END_libipv6calc_db_wrapper:
 	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_IP2Location_db_file_desc); i++) {
 		if (db_ptr_cache[i] == loc) {
 			db_ptr_cache[i] = NULL;
+			db_access_mode_cache[i] = IP2LOCATION_DB_ACCESS_FILE_IO;
+			if (ip2location_db_access_shared_entry == i) {
+				ip2location_db_access_shared_entry = -1;
+			};
 		};
 	};
 
@@ -566,6 +598,7 @@ void libipv6calc_db_wrapper_IP2Location_wrapper_print_db_info(const int level_ve
 #ifdef SUPPORT_IP2LOCATION
 	fprintf(stderr, "%sIP2Location: info of available databases in directory: %s\n", prefix, ip2location_db_dir);
 	fprintf(stderr, "%sIP2Location: Copyright (c) IP2Location All Rights Reserved\n", prefix);
+	fprintf(stderr, "%sIP2Location: database access mode: %s\n", prefix, libipv6calc_db_wrapper_IP2Location_access_mode_name(ip2location_db_access_mode));
 
 	for (i = 0; i < MAXENTRIES_ARRAY(libipv6calc_db_wrapper_IP2Location_db_file_desc); i++) {
 		type = libipv6calc_db_wrapper_IP2Location_db_file_desc[i].number;
@@ -1128,6 +1161,10 @@ IP2Location *libipv6calc_db_wrapper_IP2Location_open_type(const unsigned int typ
 		db_ptr_cache[entry] = loc;
 
 		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Database successfully opened (fill-cache), loc=%p type=%d", loc, type);
+
+		if (ip2location_db_access_mode_active == 1) {
+			libipv6calc_db_wrapper_IP2Location_access_mode_apply(entry);
+		};
 	};
 
 END_libipv6calc_db_wrapper:
@@ -1135,6 +1172,79 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * set database access mode by name
+ * in : name (file|cache|shared)
+ * ret: 0=ok, 1=unsupported name
+ */
+int libipv6calc_db_wrapper_IP2Location_access_mode_set(const char *name) {
+	int i;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(ip2location_db_access_modes); i++) {
+		if (strcmp(name, ip2location_db_access_modes[i].token) == 0) {
+			ip2location_db_access_mode = ip2location_db_access_modes[i].number;
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Database access mode selected: %s", name);
+			return(0);
+		};
+	};
+
+	return(1);
+};
+
+
+/*
+ * get name of database access mode
+ * in : mode
+ * ret: name of mode
+ */
+const char *libipv6calc_db_wrapper_IP2Location_access_mode_name(const int mode) {
+	int i;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(ip2location_db_access_modes); i++) {
+		if (mode == ip2location_db_access_modes[i].number) {
+			return(ip2location_db_access_modes[i].token);
+		};
+	};
+
+	return("unknown");
+};
+
+
+/*
+ * apply selected database access mode to opened database
+ *  the library supports only one shared memory segment per process,
+ *  therefore further databases are using cache memory in shared mode
+ * in : entry of db_ptr_cache
+ */
+static void libipv6calc_db_wrapper_IP2Location_access_mode_apply(const int entry) {
+	int mode = ip2location_db_access_mode;
+
+	if ((mode == IP2LOCATION_DB_ACCESS_FILE_IO) || (db_ptr_cache[entry] == NULL) || (db_access_mode_cache[entry] != IP2LOCATION_DB_ACCESS_FILE_IO)) {
+		return;
+	};
+
+	if (mode == IP2LOCATION_DB_ACCESS_SHARED_MEMORY) {
+		if (ip2location_db_access_shared_entry < 0) {
+			ip2location_db_access_shared_entry = entry;
+		} else if (ip2location_db_access_shared_entry != entry) {
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Shared memory already in use by type=%d, use cache memory for type=%d", libipv6calc_db_wrapper_IP2Location_db_file_desc[ip2location_db_access_shared_entry].number, libipv6calc_db_wrapper_IP2Location_db_file_desc[entry].number);
+			mode = IP2LOCATION_DB_ACCESS_CACHE_MEMORY;
+		};
+	};
+
+	if (libipv6calc_db_wrapper_IP2Location_open_mem(db_ptr_cache[entry], mode) != 0) {
+		NONQUIETPRINT_WA("IP2Location database access mode '%s' not supported, use file I/O: %s", libipv6calc_db_wrapper_IP2Location_access_mode_name(mode), libipv6calc_db_wrapper_IP2Location_db_file_desc[entry].filename);
+		if (ip2location_db_access_shared_entry == entry) {
+			ip2location_db_access_shared_entry = -1;
+		};
+		return;
+	};
+
+	db_access_mode_cache[entry] = mode;
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Database access mode applied: type=%d mode=%s", libipv6calc_db_wrapper_IP2Location_db_file_desc[entry].number, libipv6calc_db_wrapper_IP2Location_access_mode_name(mode));
+};
+
+
 /*******************************
  * Wrapper functions for IP2Location
  *******************************/
@@ -1196,6 +1306,72 @@ END_libipv6calc_db_wrapper:
 };
 
 
+/*
+ * wrapper: IP2Location_open_mem
+ * ret: 0=ok, -1=error or not supported by library
+ */
+int libipv6calc_db_wrapper_IP2Location_open_mem(IP2Location *loc, const int mode) {
+	int result = -1;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Called: %s mode=%d", wrapper_ip2location_info, mode);
+
+#ifdef SUPPORT_IP2LOCATION_DYN
+	const char *dl_symbol = "IP2Location_open_mem";
+	char *error;
+
+	if (dl_IP2Location_handle == NULL) {
+		fprintf(stderr, "dl_IP2Location handle not defined\n");
+		goto END_libipv6calc_db_wrapper;
+	};
+
+	if (dl_status_IP2Location_open_mem == IPV6CALC_DL_STATUS_UNKNOWN) {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Call dlsym: %s", dl_symbol);
+
+		dlerror();    /* Clear any existing error */
+
+		*(void **) (&dl_IP2Location_open_mem.obj) = dlsym(dl_IP2Location_handle, dl_symbol);
+
+		if ((error = dlerror()) != NULL)  {
+			dl_status_IP2Location_open_mem = IPV6CALC_DL_STATUS_ERROR;
+			DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "dl_symbol not found (library too old): %s", dl_symbol);
+			goto END_libipv6calc_db_wrapper;
+		};
+
+		dl_status_IP2Location_open_mem = IPV6CALC_DL_STATUS_OK;
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Called dlsym successful: %s", dl_symbol);
+	} else if (dl_status_IP2Location_open_mem == IPV6CALC_DL_STATUS_ERROR) {
+		/* already known issue */
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Previous call of dlsym already failed: %s", dl_symbol);
+		goto END_libipv6calc_db_wrapper;
+	} else {
+		DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Previous call of dlsym already successful: %s", dl_symbol);
+	};
+
+	dlerror();    /* Clear any existing error */
+
+	result = (*dl_IP2Location_open_mem.func)(loc, mode);
+
+	if ((error = dlerror()) != NULL)  {
+		fprintf(stderr, "%s\n", error);
+		result = -1;
+		goto END_libipv6calc_db_wrapper;
+	};
+
+END_libipv6calc_db_wrapper:
+#else
+#ifndef SUPPORT_IP2LOCATION_IPV6_COMPAT
+	// API >= 7.0.0
+	result = IP2Location_open_mem(loc, mode);
+#else
+	if (loc == NULL) { }; // make compiler happy (avoid unused "...")
+	if (mode == 0) { }; // make compiler happy (avoid unused "...")
+#endif
+#endif
+	DEBUGPRINT_WA(DEBUG_libipv6calc_db_wrapper_IP2Location, "Result: %d", result);
+	return(result);
+};
+
+
 /*
  * wrapper: IP2Location_database_info
  */
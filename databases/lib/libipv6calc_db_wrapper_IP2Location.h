@@ -28,6 +28,11 @@
 #define IP2LOCATION_IPV6_SUPPORT_FULL		2
 #define IP2LOCATION_IPV6_SUPPORT_NOTEXISTS	3
 
+// database access mode (values of IP2Location_open_mem)
+#define IP2LOCATION_DB_ACCESS_FILE_IO		0
+#define IP2LOCATION_DB_ACCESS_CACHE_MEMORY	1
+#define IP2LOCATION_DB_ACCESS_SHARED_MEMORY	2
+
 // database types
 #define IP2LOCATION_DB_MAX	 24
 
@@ -600,6 +605,7 @@ extern char              *libipv6calc_db_wrapper_IP2Location_lib_version(void);
 extern IP2Location       *libipv6calc_db_wrapper_IP2Location_open(char *db);
 extern IP2Location       *libipv6calc_db_wrapper_IP2Location_open_type(const unsigned int type);
 extern int                libipv6calc_db_wrapper_IP2Location_close(IP2Location *loc);
+extern int                libipv6calc_db_wrapper_IP2Location_open_mem(IP2Location *loc, const int mode);
 extern IP2LocationRecord *libipv6calc_db_wrapper_IP2Location_get_all(IP2Location *loc, char *ip);
 void                      libipv6calc_db_wrapper_IP2Location_free_record(IP2LocationRecord *record);
 
@@ -614,6 +620,10 @@ extern int ip2location_db_lite_to_sample_autoswitch_max_delta_months;
 extern int ip2location_db_comm_to_lite_switch_min_delta_months;
 extern int ip2location_db_only_type;
 extern int ip2location_db_allow_softlinks;
+extern int ip2location_db_access_mode;
+
+extern int         libipv6calc_db_wrapper_IP2Location_access_mode_set(const char *name);
+extern const char *libipv6calc_db_wrapper_IP2Location_access_mode_name(const int mode);
 
 
 #endif
@@ -0,0 +1,52 @@
+#!/bin/sh
+#
+# Project    : ipv6calc
+# File       : benchmark_startup.sh
+# Version    : $Id$
+#
+# Benchmark startup time: database sources initialized on first use (default) vs. on startup (--db-init-eager)
+
+count=200
+while getopts "n:h\?" opt; do
+	case $opt in
+	    n)
+		count=$OPTARG
+		;;
+	    *)
+		echo "$0 [-n <count>]"
+		echo "    -n <count>   number of runs per case (default: $count)"
+		exit 1
+		;;
+	esac
+done
+
+if [ ! -x ./ipv6calc ]; then
+	echo "Binary for ipv6calc missing!"
+	exit 1
+fi
+
+# run given options <count> times, print average time per run in microseconds
+benchmark_run() {
+	start=$(date +%s%N)
+	i=0
+	while [ $i -lt $count ]; do
+		./ipv6calc "$@" >/dev/null 2>&1
+		if [ $? -ne 0 ]; then
+			echo "ERROR : ipv6calc exit with error: $*" >&2
+			return 1
+		fi
+		i=$((i + 1))
+	done
+	end=$(date +%s%N)
+	echo $(( (end - start) / 1000 / count ))
+}
+
+echo "INFO  : benchmark startup time with $count runs per case"
+
+for options in "--addr_to_compressed 2001:0db8:0000:0000:0000:0000:0000:0001" "-q -i 2001:db8::1" "-q -i 8.8.8.8"; do
+	lazy=$(benchmark_run $options) || exit 1
+	eager=$(benchmark_run --db-init-eager $options) || exit 1
+	echo "INFO  : $options"
+	echo "INFO  :   init on first use: $lazy us/run"
+	echo "INFO  :   init on startup  : $eager us/run"
+done
@@ -80,6 +80,14 @@ int feature_zeroize = 1; // always supported
 int feature_anon    = 1; // always supported
 int feature_kp      = 0; // will be checked later
 
+/* check for KeepTypeAsnCC support (triggers initialization of database sources) */
+void feature_kp_check(void) {
+	if ((libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV4_REQ_DB) == 1) \
+	    && (libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV6_REQ_DB) == 1)) {
+		feature_kp = 1;
+	};
+};
+
 /* showinfo machine readable filter */
 char showinfo_machine_readable_filter[32] = "";
 int showinfo_machine_readable_filter_used = 0;
@@ -701,12 +709,6 @@ int main(int argc, char *argv[]) {
 		exit(EXIT_FAILURE);
 	};
 
-	/* check for KeepTypeAsnCC support */
-	if ((libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV4_REQ_DB) == 1) \
-	    && (libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV6_REQ_DB) == 1)) {
-		feature_kp = 1;
-	};
-
 	DEBUGPRINT_WA(DEBUG_ipv6calc_general, "Debug value:%08lx command:%08lx inputtype:%08lx outputtype:%08lx action:%08lx formatoptions:%08lx", (unsigned long) ipv6calc_debug, (unsigned long) command, (unsigned long) inputtype, (unsigned long) outputtype, (unsigned long) action, (unsigned long) formatoptions); // ipv6calc_debug usage ok
 
 	/* do work depending on selection */
@@ -1825,6 +1827,8 @@ PIPE_input:
 	
 	/* catch showinfo */	
 	if (command == CMD_showinfo) {
+		feature_kp_check();
+
 		// change anonymization method depending on support
 		if (feature_kp == 1) {
 			result = libipv6calc_anon_set_by_name(&ipv6calc_anon_set, "keep-type-asn-cc");
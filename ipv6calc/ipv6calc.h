@@ -28,5 +28,7 @@ extern int feature_zeroize;
 extern int feature_anon;
 extern int feature_kp;
 
+extern void feature_kp_check(void);
+
 extern char showinfo_machine_readable_filter[];
 extern int showinfo_machine_readable_filter_used;
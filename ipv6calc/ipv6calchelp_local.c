@@ -26,6 +26,8 @@
 void printversion(void) {
 	char resultstring[NI_MAXHOST] = "";
 
+	feature_kp_check();
+
 	libipv6calc_db_wrapper_features(resultstring, sizeof(resultstring));
 
 	fprintf(stderr, "%s: version %s", PROGRAM_NAME, PACKAGE_VERSION);
@@ -56,6 +58,8 @@ void printversion_help(void) {
 
 	fprintf(stderr, "Explanation of available(x)/possible(o) feature tokens\n");
 
+	feature_kp_check();
+
 	libipv6calc_db_wrapper_features_help();
 
 	fprintf(stderr, "%-22s%c %s\n", "ANON_ZEROISE", (feature_zeroize == 1)? 'x' : 'o', "Anonymization method 'zeroize'");
@@ -886,7 +886,7 @@ static void print_external(const ipv6calc_ipaddr *ipaddrp, const uint32_t format
 
 	uint32_t machinereadable = (formatoptions & FORMATOPTION_machinereadable);
 
-	ret = libipv6calc_db_wrapper_External_country_code_by_addr(ipaddrp, returnedCountry, sizeof(returnedCountry));
+	ret = libipv6calc_db_wrapper_External_country_code_by_addr(ipaddrp, returnedCountry, sizeof(returnedCountry), NULL);
 	if ((ret == 0) && (strlen(returnedCountry) > 0)) {
 		DEBUGPRINT_WA(DEBUG_showinfo, "External IPv%d country database result", ipaddrp->proto);
 
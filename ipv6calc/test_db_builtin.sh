@@ -0,0 +1,153 @@
+#!/bin/sh
+#
+# Project    : ipv6calc
+# File       : test_db_builtin.sh
+# Version    : $Id$
+#
+# Test BuiltIn database lookups: compiled index vs. generic lookup vs. range cache disabled
+
+verbose=0
+while getopts "Vh\?" opt; do
+	case $opt in
+	    V)
+		verbose=1
+		;;
+	    *)
+		echo "$0 [-V]"
+		echo "    -V   verbose"
+		exit 1
+		;;
+	esac
+done
+
+# create test addresses from each row of the IPv4 assignment and info table
+#  first, first - 1, last, last + 1
+getexamples_ipv4() {
+	sed -n '/^static const s_ipv4addr_\(assignment\|info\) dbipv4addr_\(assignment\|info\)\[\]/,/^};/p' ../databases/ipv4-assignment/dbipv4addr_assignment.h | grep "^	{ 0x" | sed 's/[{},]/ /g' | while read first last registry rest; do
+		for v in $((first)) $((first - 1)) $((last)) $((last + 1)); do
+			v=$(( v & 0xffffffff ))
+			printf "%d.%d.%d.%d\n" $(( v >> 24 )) $(( (v >> 16) & 0xff )) $(( (v >> 8) & 0xff )) $(( v & 0xff ))
+		done
+	done
+}
+
+# create test addresses from each row of the IPv6 assignment and info table
+#  base, base - 1, last address of prefix (64-bit), last address + 1
+getexamples_ipv6() {
+	sed -n '/^static const s_ipv6addr_\(assignment\|info\) dbipv6addr_\(assignment\|info\)\[\]/,/^};/p' ../databases/ipv6-assignment/dbipv6addr_assignment.h | grep "^	{ 0x" | sed 's/[{},]/ /g' | while read a0 a1 m0 m1 length registry; do
+		base=$(( (a0 << 32) | a1 ))
+		last=$(( base | ~((m0 << 32) | m1) ))
+		for v in $base $((base - 1)) $last $((last + 1)); do
+			printf "%x:%x:%x:%x::1\n" $(( (v >> 48) & 0xffff )) $(( (v >> 32) & 0xffff )) $(( (v >> 16) & 0xffff )) $(( v & 0xffff ))
+		done
+	done
+}
+
+# create test AS numbers from each row of the ASN assignment table
+#  start, start - 1, stop, stop + 1
+getexamples_asn() {
+	sed -n '/^static const s_asn_assignment dbasn_assignment\[\]/,/^};/p' ../databases/as-assignment/dbasn_assignment.h | grep "^	{ " | sed 's/[{},]/ /g' | while read start stop registry; do
+		for v in $start $((start - 1)) $stop $((stop + 1)); do
+			[ $v -lt 0 -o $v -gt 4294967295 ] && continue
+			echo "$v"
+		done
+	done
+}
+
+# create test IPv6 addresses with EUI-64 interface identifier from each row of the IEEE OUI, OUI-36 and IAB tables
+#  OUI: first and last address, OUI-36/IAB: begin, begin - 1, end, end + 1
+#  (EUI-64 instead of MAC, because pipe mode with MAC input supports only one line)
+getexamples_ieee() {
+	sed -n '/^static const s_ieee_oui libieee_oui\[\]/,/^};/p' ../databases/ieee-oui/dbieee_oui.h | grep "^	{ 0x" | sed 's/[{},]/ /g' | while read id rest; do
+		for v in $(( (id << 24) )) $(( (id << 24) | 0xffffff )); do
+			printf "2001:db8::%x:%xff:fe%02x:%x\n" $(( ((v >> 32) & 0xffff) ^ 0x0200 )) $(( (v >> 24) & 0xff )) $(( (v >> 16) & 0xff )) $(( v & 0xffff ))
+		done
+	done
+	for f in ../databases/ieee-oui36/dbieee_oui36.h ../databases/ieee-iab/dbieee_iab.h; do
+		sed -n '/^static const s_ieee_\(oui36\|iab\) libieee_\(oui36\|iab\)\[\]/,/^};/p' $f | grep "^	{ 0x" | sed 's/[{},]/ /g' | while read id begin end rest; do
+			for sub in $((begin)) $((begin - 1)) $((end)) $((end + 1)); do
+				[ $sub -lt 0 -o $sub -gt 16777215 ] && continue
+				v=$(( (id << 24) | sub ))
+				printf "2001:db8::%x:%xff:fe%02x:%x\n" $(( ((v >> 32) & 0xffff) ^ 0x0200 )) $(( (v >> 24) & 0xff )) $(( (v >> 16) & 0xff )) $(( v & 0xffff ))
+			done
+		done
+	done
+}
+
+# compare results of compiled index, generic lookup and lookup without range cache
+#  $1: database (4|6|asn|ieee)
+testscenarios_compare() {
+	case $1 in
+	    4|6)
+		feature="DB_IPV${1}_REG"
+		token="IPV${1}_REGISTRY"
+		options=""
+		name="IPv$1"
+		examples="getexamples_ipv$1"
+		;;
+	    asn)
+		feature="DB_AS_REG"
+		token="AS_NUM_REGISTRY"
+		options="--in asn"
+		name="ASN"
+		examples="getexamples_asn"
+		;;
+	    ieee)
+		feature="DB_IEEE"
+		token="IPV6"
+		options=""
+		name="IEEE"
+		examples="getexamples_ieee"
+		;;
+	esac
+
+	if ! ./ipv6calc -v 2>&1 | grep -q "$feature"; then
+		echo "NOTICE: BuiltIn $name registry database not available, skip test"
+		return 0
+	fi
+
+	$examples >$tmpfile
+	count=$(cat $tmpfile | wc -l)
+
+	# IEEE: vendor (OUI) is optional, IPV6 token is counted
+	./ipv6calc -q -i -m $options <$tmpfile | grep "^\(${token}\|OUI\)=" >$tmpfile.index
+	./ipv6calc -q -i -m $options --db-builtin-lookup-generic <$tmpfile | grep "^\(${token}\|OUI\)=" >$tmpfile.generic
+	./ipv6calc -q -i -m $options --db-cache-size 0 <$tmpfile | grep "^\(${token}\|OUI\)=" >$tmpfile.nocache
+
+	if [ $(grep "^${token}=" $tmpfile.index | wc -l) -ne $count ]; then
+		echo "ERROR : unexpected number of $name registry results: $(grep "^${token}=" $tmpfile.index | wc -l) (expected: $count)"
+		return 1
+	fi
+
+	if ! cmp -s $tmpfile.index $tmpfile.generic; then
+		echo "ERROR : $name registry lookup results differ between compiled index and generic lookup"
+		paste $tmpfile $tmpfile.index $tmpfile.generic | awk '$2 != $3'
+		return 1
+	fi
+
+	if ! cmp -s $tmpfile.index $tmpfile.nocache; then
+		echo "ERROR : $name registry lookup results differ between range cache enabled and disabled"
+		paste $tmpfile $tmpfile.index $tmpfile.nocache | awk '$2 != $3'
+		return 1
+	fi
+
+	[ "$verbose" = "1" ] && paste $tmpfile $tmpfile.index
+
+	echo "INFO  : $name registry lookup results identical for test values: $count"
+	return 0
+}
+
+echo "Run BuiltIn database lookup tests (compiled index vs. generic vs. range cache disabled)"
+
+tmpfile=$(mktemp /tmp/test_db_builtin.XXXXXX) || exit 1
+
+for db in 4 6 asn ieee; do
+	if ! testscenarios_compare $db; then
+		rm -f $tmpfile $tmpfile.index $tmpfile.generic $tmpfile.nocache
+		exit 1
+	fi
+done
+
+rm -f $tmpfile $tmpfile.index $tmpfile.generic $tmpfile.nocache
+
+echo "All tests were successfully done!"
@@ -13,6 +13,7 @@
 #include <stdlib.h> 
 #include <getopt.h> 
 #include <unistd.h>
+#include <stdint.h>
 
 #include "ipv6loganon.h"
 #include "libipv6calcdebug.h"
@@ -38,9 +39,12 @@
 #include "librfc3056.h"
 #include "libeui64.h"
 #include "libieee.h"
+#include "liblineio.h"
 
 #include "../databases/lib/libipv6calc_db_wrapper.h"
 
+#include <pthread.h>
+
 #define LINEBUFFER	16384
 
 long int ipv6calc_debug = 0; // ipv6calc_debug usage ok
@@ -60,20 +64,66 @@ int feature_kp      = 0; // will be checked later
 
 
 /* prototypes */
-static int anonymizetoken(char *result, const size_t resultstring_length, const char *token);
-static void lineparser();
-
-
-/* LRU cache */
-
-#define CACHE_LRU_SIZE 200
-
-static int      cache_lru_max = 0;
-static int      cache_lru_last = 0;
-int      cache_lru_limit = 20; /* optimum */
-static char     cache_lru_key_token[CACHE_LRU_SIZE][NI_MAXHOST];
-static char     cache_lru_value[CACHE_LRU_SIZE][NI_MAXHOST];
-static long int cache_lru_statistics[CACHE_LRU_SIZE];
+static int anonymizetoken(char *result, const size_t resultstring_length, const char *token, s_ipv6calc_addr_cache *cachep);
+static int lineprocess(char *linebuffer, const int linecounter, char *resultstring, const size_t resultstring_length, char **restp, s_ipv6calc_addr_cache *cachep);
+static void lineparser(void);
+static int lineparser_threads(void);
+
+
+/* address cache */
+int cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_DEFAULT;
+static s_ipv6calc_addr_cache *cache_addr = NULL;
+
+/* buffered input and output */
+static s_ipv6calc_line_reader *input = NULL;
+static s_ipv6calc_line_writer *output = NULL;
+
+/* input files (none: stdin) */
+static const char *input_file[LIBLINEIO_INPUT_MAX];
+static int input_files = 0;
+
+/* threads (0: single-threaded) */
+int threads = 0;
+
+/* chunk of input lines, processed by one worker thread */
+typedef struct {
+	int state;		// see IPV6LOGANON_CHUNK_STATE_*
+	int linecounter;	// number of first line
+	int lines;		// amount of lines stored in 'in'
+	char *in;		// lines terminated by '\0' each
+	size_t in_used;
+	char *out;		// output of all lines
+	size_t out_size;
+	size_t out_used;
+} s_ipv6loganon_chunk;
+
+#define IPV6LOGANON_CHUNK_STATE_FREE	0
+#define IPV6LOGANON_CHUNK_STATE_FILLED	1
+#define IPV6LOGANON_CHUNK_STATE_WORK	2
+#define IPV6LOGANON_CHUNK_STATE_DONE	3
+
+/* worker thread with own caches */
+typedef struct {
+	pthread_t thread;
+	int number;
+	s_ipv6calc_addr_cache *cachep;
+	s_ipv6calc_db_wrapper_ctx db_ctx;
+	s_ipv6calc_anon_cache_ctx anon_ctx;
+} s_ipv6loganon_worker;
+
+/* pipeline: reader (main thread) -> workers -> writer, chunk n is stored in slot n % slots */
+static struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond_free;	// chunk slot freed by writer
+	pthread_cond_t cond_filled;	// chunk filled by reader (or end of input)
+	pthread_cond_t cond_done;	// chunk processed by worker
+	s_ipv6loganon_chunk *chunk;
+	int slots;
+	long int next_fill;
+	long int next_work;
+	long int next_write;
+	int flag_eof;
+} pipeline;
 
 char	file_out[NI_MAXHOST] = "";
 int	file_out_flag = 0;
@@ -195,12 +245,12 @@ int main(int argc,char *argv[]) {
 
 			case 'c':
 				cache_lru_limit = atoi(optarg);
-				if (cache_lru_limit > CACHE_LRU_SIZE) {
-					cache_lru_limit = CACHE_LRU_SIZE;
+				if (cache_lru_limit > IPV6CALC_ADDR_CACHE_LIMIT_MAX) {
+					cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_MAX;
 					fprintf(stderr, " Cache limit too big, built-in limit: %d\n", cache_lru_limit);
 				};
-				if (cache_lru_limit < 1) {
-					cache_lru_limit = 1;
+				if (cache_lru_limit < IPV6CALC_ADDR_CACHE_LIMIT_MIN) {
+					cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_MIN;
 					fprintf(stderr, " Cache limit too small, take minimum: %d\n", cache_lru_limit);
 				};
 				break;
@@ -209,6 +259,22 @@ int main(int argc,char *argv[]) {
 				flag_nocache = 1;
 				break;
 
+			case 'T':
+				threads = atoi(optarg);
+				if ((threads < 1) || (threads > IPV6LOGANON_THREADS_MAX)) {
+					fprintf(stderr, " Amount of threads out of range: %s (1-%d)\n", optarg, IPV6LOGANON_THREADS_MAX);
+					exit(EXIT_FAILURE);
+				};
+				break;
+
+			case 'i':
+				if (input_files >= LIBLINEIO_INPUT_MAX) {
+					fprintf(stderr, " Too many input files (max: %d)\n", LIBLINEIO_INPUT_MAX);
+					exit(EXIT_FAILURE);
+				};
+				input_file[input_files++] = optarg;
+				break;
+
 			default:
 				ipv6loganon_printinfo();
 				exit(EXIT_FAILURE);
@@ -271,19 +337,117 @@ int main(int argc,char *argv[]) {
 		};
 	};
 
-	lineparser();
+	/* regular input files are mapped, stdin and other files are read */
+	input = liblineio_reader_open(input_file, input_files, LIBLINEIO_BUFFER_SIZE, LINEBUFFER);
+	if (input == NULL) {
+		fprintf(stderr, "Can't open input\n");
+		exit(EXIT_FAILURE);
+	};
+
+	output = liblineio_writer_create((file_out_flag == 2) ? fileno(FILE_OUT) : STDOUT_FILENO, LIBLINEIO_BUFFER_SIZE);
+	if (output == NULL) {
+		fprintf(stderr, "Can't create output buffer\n");
+		exit(EXIT_FAILURE);
+	};
+
+	if ((threads > 0) && (libipv6calc_db_wrapper_ctx_threadsafe() == 0)) {
+		fprintf(stderr, "Database source in use does not support concurrent lookups, continue without threads\n");
+		threads = 0;
+	};
+
+	result = EXIT_SUCCESS;
+
+	if (threads > 0) {
+		if (lineparser_threads() != 0) {
+			result = EXIT_FAILURE;
+		};
+	} else {
+		if (flag_nocache == 0) {
+			cache_addr = libipv6calc_addr_cache_create(cache_lru_limit);
+			if (cache_addr == NULL) {
+				fprintf(stderr, "Can't create cache, continue without\n");
+				flag_nocache = 1;
+			};
+		};
+
+		lineparser();
+
+		libipv6calc_addr_cache_free(cache_addr);
+	};
+
+	if ((input->flag_error != 0) || (output->flag_error != 0)) {
+		result = EXIT_FAILURE;
+	};
+
+	if (liblineio_writer_free(output) != 0) {
+		result = EXIT_FAILURE;
+	};
+	liblineio_reader_free(input);
 
 	if (file_out_flag == 2) {
 		DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Output file is closed now: %s", file_out);
-		fflush(FILE_OUT);
-		fclose(FILE_OUT);
+		if ((fflush(FILE_OUT) != 0) || (fclose(FILE_OUT) != 0)) {
+			fprintf(stderr, "Can't close Output file: %s\n", file_out);
+			result = EXIT_FAILURE;
+		};
 	} else {
 		fflush(stdout);
 	};
 
 	libipv6calc_db_wrapper_cleanup();
 
-	exit(EXIT_SUCCESS);
+	exit(result);
+};
+
+
+/*
+ * Line processor: anonymize first token of line
+ *
+ * in : linebuffer = line (modified by tokenizer)
+ * in : linecounter = line number (for messages)
+ * in : cachep = address cache (NULL: no cache)
+ * mod: resultstring = anonymized token
+ * out: *restp = rest of line after token ('\0' if none)
+ * ret: 0 = line to print, 1 = line skipped
+ */
+static int lineprocess(char *linebuffer, const int linecounter, char *resultstring, const size_t resultstring_length, char **restp, s_ipv6calc_addr_cache *cachep) {
+	char *charptr;
+
+	DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Line number: %d", linecounter);
+
+	if (strlen(linebuffer) >= LINEBUFFER) {
+		fprintf(stderr, "Line too long: %d\n", linecounter);
+		return (1);
+	};
+	
+	if (strlen(linebuffer) == 0) {
+		fprintf(stderr, "Line empty: %d\n", linecounter);
+		return (1);
+	};
+	
+	DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Got line: '%s'", linebuffer);
+
+	/* look for first token */
+	charptr = strtok_r(linebuffer, " \t\n", restp);
+	
+	if ( charptr == NULL ) {
+		fprintf(stderr, "Line contains no token: %d\n", linecounter);
+		return (1);
+	};
+
+	if ( strlen(charptr) >=  LINEBUFFER) {
+		fprintf(stderr, "Line too strange: %d\n", linecounter);
+		return (1);
+	};
+
+	DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Token 1: '%s'", charptr);
+	
+	/* call anonymizer now */
+	if (anonymizetoken(resultstring, resultstring_length, charptr, cachep) != 0) {
+		return (1);
+	};
+
+	return (0);
 };
 
 
@@ -291,117 +455,391 @@ int main(int argc,char *argv[]) {
  * Line parser
  */
 static void lineparser(void) {
-	char linebuffer[LINEBUFFER];
-	char token[LINEBUFFER];
 	char resultstring[LINEBUFFER];
-	char *charptr, *cptr, **ptrptr;
-	int linecounter = 0, retval, i;
+	char linebuffer[LINEBUFFER];
+	const char *lineptr;
+	char *cptr, **ptrptr;
+	size_t length;
+	int linecounter = 0, retval;
 
 	ptrptr = &cptr;
 	
 	if (ipv6calc_quiet == 0) {
-		fprintf(stderr, "Expecting log lines on stdin\n");
+		if (input_files > 0) {
+			fprintf(stderr, "Expecting log lines from input files: %d\n", input_files);
+		} else {
+			fprintf(stderr, "Expecting log lines on stdin\n");
+		};
 	};
 
 	while (1 == 1) {
 		/* read line from stdin */
-		charptr = fgets(linebuffer, LINEBUFFER, stdin);
-		
-		if (charptr == NULL) {
+		length = liblineio_reader_getline(input, &lineptr);
+		if (length == 0) {
 			/* end of input */
 			break;
 		};
 
+		/* copy line, tokenizer modifies it */
+		memcpy(linebuffer, lineptr, length);
+		linebuffer[length] = '\0';
+
 		linecounter++;
 
 		if (linecounter == 1) {
-			if (ipv6calc_quiet == 0) {
+			if ((ipv6calc_quiet == 0) && (input_files == 0)) {
 				fprintf(stderr, "Ok, proceeding stdin...\n");
 			};
 		};
 	
-		DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Line number: %d", linecounter);
+		retval = lineprocess(linebuffer, linecounter, resultstring, sizeof(resultstring), ptrptr, cache_addr);
 
-		if (strlen(linebuffer) >= LINEBUFFER) {
-			fprintf(stderr, "Line too long: %d\n", linecounter);
+		if (retval != 0) {
 			continue;
 		};
 		
-		if (strlen(linebuffer) == 0) {
-			fprintf(stderr, "Line empty: %d\n", linecounter);
-			continue;
+		/* print result and rest of line, if available */
+		liblineio_writer_puts(output, resultstring);
+		if (*ptrptr[0] != '\0') {
+			liblineio_writer_write(output, " ", 1);
+			liblineio_writer_puts(output, *ptrptr);
+		} else {
+			liblineio_writer_write(output, "\n", 1);
 		};
-		
-		DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Got line: '%s'", linebuffer);
 
-		/* look for first token */
-		charptr = strtok_r(linebuffer, " \t\n", ptrptr);
-		
-		if ( charptr == NULL ) {
-			fprintf(stderr, "Line contains no token: %d\n", linecounter);
-			continue;
+		if (file_out_flush == 1) {
+			liblineio_writer_flush(output);
 		};
+	};
 
-		if ( strlen(charptr) >=  LINEBUFFER) {
-			fprintf(stderr, "Line too strange: %d\n", linecounter);
-			continue;
+	if (ipv6calc_quiet == 0) {
+		fprintf(stderr, "...finished\n");
+
+		if (flag_nocache == 0) {
+			fprintf(stderr, "Cache statistics:\n");
+			libipv6calc_addr_cache_print_statistics(cache_addr, "");
 		};
 
-		snprintf(token, sizeof(token), "%s", charptr);
-		
-		DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Token 1: '%s'", token);
-		
-		/* call anonymizer now */
-		retval = anonymizetoken(resultstring, sizeof(resultstring), charptr);
+		if (ipv6calc_verbose > 0) {
+			libipv6calc_db_wrapper_print_cache_statistics("");
+			libipv6calc_anon_cache_print_statistics("");
+		};
+	};
+	return;
+};
 
-		if (retval != 0) {
-			continue;
+
+/*
+ * Worker thread: process filled chunks in order of filling
+ */
+static void *lineparser_worker(void *arg) {
+	s_ipv6loganon_worker *workerp = (s_ipv6loganon_worker *) arg;
+	s_ipv6loganon_chunk *chunkp;
+	char resultstring[LINEBUFFER];
+	char *linebuffer, *cptr;
+	size_t length, needed;
+	int l;
+
+	/* non-reentrant library functions use the caches of this worker */
+	libipv6calc_db_wrapper_ctx_bind(&workerp->db_ctx);
+	libipv6calc_anon_cache_ctx_bind(&workerp->anon_ctx);
+
+	while (1 == 1) {
+		pthread_mutex_lock(&pipeline.mutex);
+		while ((pipeline.next_work == pipeline.next_fill) && (pipeline.flag_eof == 0)) {
+			pthread_cond_wait(&pipeline.cond_filled, &pipeline.mutex);
 		};
-		
-		/* print result and rest of line, if available */
-		if (*ptrptr[0] != '\0') {
-			if (file_out_flag == 2) {
-				fprintf(FILE_OUT, "%s %s", resultstring, *ptrptr);
-			} else {
-				printf("%s %s", resultstring, *ptrptr);
+
+		if (pipeline.next_work == pipeline.next_fill) {
+			/* end of input and nothing left */
+			pthread_mutex_unlock(&pipeline.mutex);
+			break;
+		};
+
+		chunkp = &pipeline.chunk[pipeline.next_work % pipeline.slots];
+		chunkp->state = IPV6LOGANON_CHUNK_STATE_WORK;
+		pipeline.next_work++;
+		pthread_mutex_unlock(&pipeline.mutex);
+
+		DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Worker %d: chunk with %d lines starting at line %d", workerp->number, chunkp->lines, chunkp->linecounter);
+
+		chunkp->out_used = 0;
+		linebuffer = chunkp->in;
+
+		for (l = 0; l < chunkp->lines; l++) {
+			length = strlen(linebuffer);
+
+			if (lineprocess(linebuffer, chunkp->linecounter + l, resultstring, sizeof(resultstring), &cptr, workerp->cachep) == 0) {
+				/* append result and rest of line, same format as single-threaded */
+				needed = strlen(resultstring) + 1 + strlen(cptr) + 2;
+
+				if (chunkp->out_used + needed > chunkp->out_size) {
+					chunkp->out_size = 2 * (chunkp->out_used + needed);
+					chunkp->out = realloc(chunkp->out, chunkp->out_size);
+					if (chunkp->out == NULL) {
+						ERRORPRINT_WA("cannot allocate memory for output buffer: %lu", (unsigned long int) chunkp->out_size);
+						exit(EXIT_FAILURE);
+					};
+				};
+
+				if (cptr[0] != '\0') {
+					chunkp->out_used += snprintf(chunkp->out + chunkp->out_used, chunkp->out_size - chunkp->out_used, "%s %s", resultstring, cptr);
+				} else {
+					chunkp->out_used += snprintf(chunkp->out + chunkp->out_used, chunkp->out_size - chunkp->out_used, "%s\n", resultstring);
+				};
 			};
-		} else {
-			if (file_out_flag == 2) {
-				fprintf(FILE_OUT, "%s\n", resultstring);
-			} else {
-				printf("%s\n", resultstring);
+
+			linebuffer += length + 1;
+		};
+
+		pthread_mutex_lock(&pipeline.mutex);
+		chunkp->state = IPV6LOGANON_CHUNK_STATE_DONE;
+		pthread_cond_broadcast(&pipeline.cond_done);
+		pthread_mutex_unlock(&pipeline.mutex);
+	};
+
+	libipv6calc_anon_cache_ctx_bind(NULL);
+	libipv6calc_db_wrapper_ctx_bind(NULL);
+
+	return (NULL);
+};
+
+
+/*
+ * Writer thread: write processed chunks in input order
+ *  on write error, remaining chunks are consumed without writing
+ *
+ * ret: 0 = ok, 1 = write error (as pointer)
+ */
+static void *lineparser_writer(void *arg) {
+	s_ipv6loganon_chunk *chunkp;
+	intptr_t result = 0;
+
+	(void) arg; // make compiler happy (avoid unused "...")
+
+	while (1 == 1) {
+		pthread_mutex_lock(&pipeline.mutex);
+		while (1 == 1) {
+			if (pipeline.next_write < pipeline.next_fill) {
+				chunkp = &pipeline.chunk[pipeline.next_write % pipeline.slots];
+				if (chunkp->state == IPV6LOGANON_CHUNK_STATE_DONE) {
+					break;
+				};
+			} else if (pipeline.flag_eof != 0) {
+				/* end of input and everything written */
+				pthread_mutex_unlock(&pipeline.mutex);
+				return ((void *) result);
 			};
+			pthread_cond_wait(&pipeline.cond_done, &pipeline.mutex);
 		};
+		pthread_mutex_unlock(&pipeline.mutex);
 
-		if (file_out_flush == 1) {
-			if (file_out_flag == 2) {
-				fflush(FILE_OUT);
-			} else {
-				fflush(stdout);
+		if ((result == 0) && (chunkp->out_used > 0)) {
+			if (liblineio_writer_write(output, chunkp->out, chunkp->out_used) != 0) {
+				result = 1;
+			};
+		};
+
+		if ((result == 0) && (file_out_flush == 1)) {
+			if (liblineio_writer_flush(output) != 0) {
+				result = 1;
+			};
+		};
+
+		pthread_mutex_lock(&pipeline.mutex);
+		chunkp->state = IPV6LOGANON_CHUNK_STATE_FREE;
+		pipeline.next_write++;
+		pthread_cond_signal(&pipeline.cond_free);
+		pthread_mutex_unlock(&pipeline.mutex);
+	};
+};
+
+
+/*
+ * Line parser with threads: main thread reads chunks of lines, worker threads process them, writer thread writes them in input order
+ *
+ * ret: 0 = ok, 1 = write error
+ */
+static int lineparser_threads(void) {
+	s_ipv6loganon_worker *worker;
+	s_ipv6loganon_chunk *chunkp;
+	pthread_t writer;
+	void *writer_result = NULL;
+	const char *lineptr;
+	char prefix[NI_MAXHOST];
+	size_t length;
+	int linecounter = 0, t, n, eof = 0;
+
+	pthread_mutex_init(&pipeline.mutex, NULL);
+	pthread_cond_init(&pipeline.cond_free, NULL);
+	pthread_cond_init(&pipeline.cond_filled, NULL);
+	pthread_cond_init(&pipeline.cond_done, NULL);
+	pipeline.slots = 2 * threads + 1;
+	pipeline.next_fill = 0;
+	pipeline.next_work = 0;
+	pipeline.next_write = 0;
+	pipeline.flag_eof = 0;
+
+	pipeline.chunk = calloc((size_t) pipeline.slots, sizeof(s_ipv6loganon_chunk));
+	worker = calloc((size_t) threads, sizeof(s_ipv6loganon_worker));
+	if ((pipeline.chunk == NULL) || (worker == NULL)) {
+		ERRORPRINT_WA("cannot allocate memory for %d threads", threads);
+		exit(EXIT_FAILURE);
+	};
+
+	for (n = 0; n < pipeline.slots; n++) {
+		pipeline.chunk[n].in = malloc(IPV6LOGANON_CHUNK_SIZE);
+		pipeline.chunk[n].out_size = IPV6LOGANON_CHUNK_SIZE + IPV6LOGANON_CHUNK_SIZE / 2;
+		pipeline.chunk[n].out = malloc(pipeline.chunk[n].out_size);
+		if ((pipeline.chunk[n].in == NULL) || (pipeline.chunk[n].out == NULL)) {
+			ERRORPRINT_WA("cannot allocate memory for chunk buffers: %d", pipeline.slots);
+			exit(EXIT_FAILURE);
+		};
+	};
+
+	for (t = 0; t < threads; t++) {
+		worker[t].number = t;
+
+		if (flag_nocache == 0) {
+			worker[t].cachep = libipv6calc_addr_cache_create(cache_lru_limit);
+			if (worker[t].cachep == NULL) {
+				fprintf(stderr, "Can't create cache of thread %d, continue without\n", t);
+			};
+		};
+
+		/* also initializes database sources before threads are running */
+		if (libipv6calc_db_wrapper_ctx_init(&worker[t].db_ctx) != 0) {
+			exit(EXIT_FAILURE);
+		};
+
+		if (pthread_create(&worker[t].thread, NULL, lineparser_worker, &worker[t]) != 0) {
+			ERRORPRINT_WA("cannot create worker thread: %d", t);
+			exit(EXIT_FAILURE);
+		};
+	};
+
+	if (pthread_create(&writer, NULL, lineparser_writer, NULL) != 0) {
+		ERRORPRINT_NA("cannot create writer thread");
+		exit(EXIT_FAILURE);
+	};
+
+	if (ipv6calc_quiet == 0) {
+		if (input_files > 0) {
+			fprintf(stderr, "Expecting log lines from input files: %d (threads: %d)\n", input_files, threads);
+		} else {
+			fprintf(stderr, "Expecting log lines on stdin (threads: %d)\n", threads);
+		};
+	};
+
+	while (eof == 0) {
+		/* wait for free chunk slot */
+		pthread_mutex_lock(&pipeline.mutex);
+		chunkp = &pipeline.chunk[pipeline.next_fill % pipeline.slots];
+		while (chunkp->state != IPV6LOGANON_CHUNK_STATE_FREE) {
+			pthread_cond_wait(&pipeline.cond_free, &pipeline.mutex);
+		};
+		pthread_mutex_unlock(&pipeline.mutex);
+
+		/* read lines (same line splitting as single-threaded) until chunk is full */
+		chunkp->linecounter = linecounter + 1;
+		chunkp->lines = 0;
+		chunkp->in_used = 0;
+
+		while (chunkp->in_used + LINEBUFFER <= IPV6LOGANON_CHUNK_SIZE) {
+			length = liblineio_reader_getline(input, &lineptr);
+			if (length == 0) {
+				/* end of input, flagged together with publishing the last chunk */
+				eof = 1;
+				break;
+			};
+
+			linecounter++;
+
+			if (linecounter == 1) {
+				if ((ipv6calc_quiet == 0) && (input_files == 0)) {
+					fprintf(stderr, "Ok, proceeding stdin...\n");
+				};
 			};
+
+			/* copy line terminated by '\0' (a '\0' inside ends it like in single-threaded mode) */
+			memcpy(chunkp->in + chunkp->in_used, lineptr, length);
+			chunkp->in[chunkp->in_used + length] = '\0';
+			chunkp->in_used += strlen(chunkp->in + chunkp->in_used) + 1;
+			chunkp->lines++;
+
+			if ((file_out_flush == 1) && (liblineio_reader_pending(input) == 0)) {
+				/* no further input waiting, hand over chunk now to get output flushed */
+				break;
+			};
+		};
+
+		pthread_mutex_lock(&pipeline.mutex);
+		if (chunkp->lines > 0) {
+			chunkp->state = IPV6LOGANON_CHUNK_STATE_FILLED;
+			pipeline.next_fill++;
 		};
+		pipeline.flag_eof = eof;
+		pthread_cond_broadcast(&pipeline.cond_filled);
+		pthread_cond_broadcast(&pipeline.cond_done);
+		pthread_mutex_unlock(&pipeline.mutex);
+	};
+
+	for (t = 0; t < threads; t++) {
+		pthread_join(worker[t].thread, NULL);
 	};
+	pthread_join(writer, &writer_result);
 
 	if (ipv6calc_quiet == 0) {
 		fprintf(stderr, "...finished\n");
 
 		if (flag_nocache == 0) {
 			fprintf(stderr, "Cache statistics:\n");
-			for (i = 0; i < cache_lru_limit; i++) {
-				fprintf(stderr, "Cache distance: %3d  hits: %8ld\n", i, cache_lru_statistics[i]);
+		};
+
+		for (t = 0; t < threads; t++) {
+			snprintf(prefix, sizeof(prefix), "Thread %d: ", t);
+
+			if (worker[t].cachep != NULL) {
+				libipv6calc_addr_cache_print_statistics(worker[t].cachep, prefix);
+			};
+
+			if (ipv6calc_verbose > 0) {
+				libipv6calc_db_wrapper_ctx_print_cache_statistics(&worker[t].db_ctx, prefix);
+				libipv6calc_anon_cache_ctx_print_statistics(&worker[t].anon_ctx, prefix);
 			};
 		};
 	};
-	return;
+
+	for (t = 0; t < threads; t++) {
+		libipv6calc_addr_cache_free(worker[t].cachep);
+		libipv6calc_db_wrapper_ctx_cleanup(&worker[t].db_ctx);
+		libipv6calc_anon_cache_ctx_cleanup(&worker[t].anon_ctx);
+	};
+
+	for (n = 0; n < pipeline.slots; n++) {
+		free(pipeline.chunk[n].in);
+		free(pipeline.chunk[n].out);
+	};
+	free(pipeline.chunk);
+	free(worker);
+
+	pthread_cond_destroy(&pipeline.cond_done);
+	pthread_cond_destroy(&pipeline.cond_filled);
+	pthread_cond_destroy(&pipeline.cond_free);
+	pthread_mutex_destroy(&pipeline.mutex);
+
+	return ((writer_result == NULL) ? 0 : 1);
 };
 
 
 /*
  * Anonymize token
  */
-static int anonymizetoken(char *resultstring, const size_t resultstring_length, const char *token) {
+static int anonymizetoken(char *resultstring, const size_t resultstring_length, const char *token, s_ipv6calc_addr_cache *cachep) {
 	uint32_t inputtype = FORMAT_undefined;
 	int retval = 1, i;
+	int flag_cachekey = 0;
+	uint32_t key_addr[IPV6CALC_ADDR_CACHE_KEY_WORDS];
 
 	/* used structures */
 	ipv6calc_ipv6addr  ipv6addr;
@@ -418,45 +856,11 @@ static int anonymizetoken(char *resultstring, const size_t resultstring_length,
 		return (1);
 	};
 
-	/* use cache ? */
-	if (flag_nocache == 0 && cache_lru_max > 0) {
-		/* check last seen one first */
-		DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "LRU cache: look for key=%s", token);
-
-		if (strcmp(cache_lru_key_token[cache_lru_last - 1], token) == 0) {
-			snprintf(resultstring, resultstring_length, "%s", cache_lru_value[cache_lru_last - 1]);
-			cache_lru_statistics[0]++;
-			DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "LRU cache: hit last line=%d key_token=%s value=%s", cache_lru_last - 1, token, resultstring);
-			return (0);
-		};
-		/* run backwards to first entry */
-		if (cache_lru_last > 1) {
-			for (i = cache_lru_last - 1; i > 0; i--) {
-				if (strcmp(cache_lru_key_token[i - 1], token) == 0) {
-					snprintf(resultstring, resultstring_length, "%s", cache_lru_value[i - 1]);
-					cache_lru_statistics[cache_lru_last - i]++;
-					DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "LRU cache: hit line=%d key_token=%s value=%s", i - 1, token, resultstring);
-					return (0);
-				};
-			};
-		};
-		/* round robin */ 
-		if (cache_lru_last < cache_lru_max) {
-			for (i = cache_lru_max; i > cache_lru_last; i--) {
-				if (strcmp(cache_lru_key_token[i - 1], token) == 0) {
-					snprintf(resultstring, resultstring_length, "%s", cache_lru_value[i - 1]);
-					cache_lru_statistics[cache_lru_max - i + cache_lru_last]++;
-					DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "LRU cache: hit line=%d key_token=%s value=%s", i - 1, token, resultstring);
-					return (0);
-				};
-			};
-		};
-	};
-
-
 	/* set addresses to invalid */
 	ipv6addr.flag_valid = 0;
 	ipv4addr.flag_valid = 0;
+	eui64addr.flag_valid = 0;
+	macaddr.flag_valid = 0;
 	
 	/* autodetection */
 	inputtype = libipv6calc_autodetectinput(token);
@@ -501,6 +905,43 @@ static int anonymizetoken(char *resultstring, const size_t resultstring_length,
 
 	DEBUGPRINT_WA(DEBUG_ipv6loganon_general, "Token: '%s'", token);
 
+	/* use cache ? (key: binary address and prefix length) */
+	if (cachep != NULL) {
+		memset(key_addr, 0, sizeof(key_addr));
+		flag_cachekey = 1;
+
+		if (ipv6addr.flag_valid == 1) {
+			for (i = 0; i < 4; i++) {
+				key_addr[i] = ipv6addr_getdword(&ipv6addr, i);
+			};
+			key_addr[4] = IPV6CALC_ADDR_CACHE_KEY_PREFIX(ipv6addr.flag_prefixuse, ipv6addr.prefixlength);
+
+			if (ipv6addr.flag_scopeid == 1) {
+				/* scope ID is not part of the key, not cached */
+				flag_cachekey = 0;
+			};
+		} else if (ipv4addr.flag_valid == 1) {
+			key_addr[0] = ipv4addr_getdword(&ipv4addr);
+			key_addr[4] = IPV6CALC_ADDR_CACHE_KEY_PREFIX(ipv4addr.flag_prefixuse, ipv4addr.prefixlength);
+		} else if (eui64addr.flag_valid == 1) {
+			memcpy(key_addr, eui64addr.addr, sizeof(eui64addr.addr));
+		} else if (macaddr.flag_valid == 1) {
+			memcpy(key_addr, macaddr.addr, sizeof(macaddr.addr));
+		} else {
+			/* not an address, not cached */
+			flag_cachekey = 0;
+		};
+
+		if (flag_cachekey == 1) {
+			DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "Address cache: look for key=%s", token);
+
+			if (libipv6calc_addr_cache_lookup(cachep, inputtype, 0, key_addr, resultstring, resultstring_length) == 1) {
+				DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "Address cache: hit key=%s value=%s", token, resultstring);
+				return (0);
+			};
+		};
+	};
+
 	/***** postprocessing input *****/
 	
 	DEBUGPRINT_NA(DEBUG_ipv6loganon_general, "Start of postprocessing input");
@@ -540,24 +981,9 @@ static int anonymizetoken(char *resultstring, const size_t resultstring_length,
 	};
 
 	/* use cache ? */
-	if (flag_nocache == 0) {
-		/* calculate pointer */
-		if (cache_lru_max < cache_lru_limit) {
-			cache_lru_last++;
-			cache_lru_max++;
-		} else {
-			if (cache_lru_last == cache_lru_limit) {
-				cache_lru_last = 1;
-			} else {
-				cache_lru_last++;
-			};
-
-		};
-
-		/* store key and value */
-		snprintf(cache_lru_key_token[cache_lru_last - 1], NI_MAXHOST, "%s", token);
-		snprintf(cache_lru_value[cache_lru_last - 1], NI_MAXHOST, "%s", resultstring);
-		DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "LRU cache: fill line=%d key_token=%s value=%s", cache_lru_last - 1, cache_lru_key_token[cache_lru_last - 1], cache_lru_value[cache_lru_last - 1]);
+	if (flag_cachekey == 1) {
+		libipv6calc_addr_cache_store(cachep, inputtype, 0, key_addr, resultstring);
+		DEBUGPRINT_WA(DEBUG_ipv6loganon_cache, "Address cache: fill key=%s value=%s", token, resultstring);
 	};
 
 	return (0);
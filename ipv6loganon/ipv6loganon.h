@@ -13,8 +13,9 @@
 #define PROGRAM_NAME "ipv6loganon"
 #define PROGRAM_COPYRIGHT "(P) & (C) 2007-" COPYRIGHT_YEAR " by Peter Bieringer <pb (at) bieringer.de>"
 
-/* LRU cache maximum size */
-#define CACHE_LRU_SIZE 200
+/* threads */
+#define IPV6LOGANON_THREADS_MAX		64
+#define IPV6LOGANON_CHUNK_SIZE		(1024 * 1024)	// input bytes per chunk
 
 #define DEBUG_ipv6loganon_general      0x00000001l
 
@@ -22,6 +23,7 @@
 
 /* prototyping */
 extern int cache_lru_limit;
+extern int threads;
 
 extern int mask_ipv4;
 extern int mask_iid;
@@ -16,6 +16,7 @@
 #include "ipv6calctypes.h"
 #include "ipv6calccommands.h"
 #include "ipv6calchelp.h"
+#include "libipv6calc.h"
 #include "config.h"
 
 /* display info */
@@ -69,6 +70,7 @@ void ipv6loganon_printhelp(void) {
 	
 	printhelp_common(IPV6CALC_HELP_ALL);
 
+	fprintf(stderr, "  [-i|--input <file>]        : read from file instead of stdin (repeatable)\n");
 	fprintf(stderr, "  [-w|--write]               : write output to file instead of stdout\n");
 	fprintf(stderr, "  [-a|--append]              : append output to file instead of stdout\n");
 	fprintf(stderr, "  [-f|--flush]               : flush output after each line\n");
@@ -76,12 +78,16 @@ void ipv6loganon_printhelp(void) {
 	fprintf(stderr, "  [-n|--nocache]             : disable caching\n");
 	fprintf(stderr, "  [-c|--cachelimit <value>]  : set cache limit\n");
 	fprintf(stderr, "                               default: %d\n", cache_lru_limit);
-	fprintf(stderr, "                               maximum: %d\n", CACHE_LRU_SIZE);
+	fprintf(stderr, "                               maximum: %d\n", IPV6CALC_ADDR_CACHE_LIMIT_MAX);
+	fprintf(stderr, "                               (per thread)\n");
+	fprintf(stderr, "  [-T|--threads <value>]     : amount of worker threads (1-%d)\n", IPV6LOGANON_THREADS_MAX);
+	fprintf(stderr, "                               output order is kept, flush (-f) also per line on live input\n");
+	fprintf(stderr, "                               not used with GeoIP/IP2Location (no concurrent lookups)\n");
 
 	printhelp_action_dispatcher(ACTION_anonymize, 1);
 
 	fprintf(stderr, "\n");
-	fprintf(stderr, " Takes data from stdin, outputs the processed data to stdout (default)\n");
+	fprintf(stderr, " Takes data from stdin (or input files), outputs the processed data to stdout (default)\n");
 	fprintf(stderr, "\n");
 	fprintf(stderr, "\n");
 
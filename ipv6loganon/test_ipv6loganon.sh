@@ -101,6 +101,15 @@ fe80::210:a489:ab01:2345 - -
 4.2.3.4 - -
 5.2.3.4 - -
 195.226.187.50	- - "IPv4 address"
+# same address with prefix length/scope ID must not hit cached result
+2.2.3.4/24 - -
+2.2.3.4 - -
+2001:db8:1234::1 - -
+2001:db8:1234::1/64 - -
+2001:db8:1234::1 - -
+fe80::1 - -
+fe80::1%eth0 - -
+fe80::1 - -
 END_CACHE
 }
 
@@ -245,6 +254,30 @@ else
 		echo "Error executing 'ipv6loganon'!" >&2
 		exit 1
 	fi
+	echo "Test with cache against without cache"
+	output="`testscenarios_cache | grep -v "^#" | ./ipv6loganon`"
+	output_nocache="`testscenarios_cache | grep -v "^#" | ./ipv6loganon -n`"
+	if [ "$output" != "$output_nocache" ]; then
+		echo "ERROR : output with cache differs" >&2
+		exit 1
+	fi
+	echo "Test with threads"
+	output_threads="`testscenarios_cache | grep -v "^#" | ./ipv6loganon -T 3`"
+	retval=$?
+	if [ $retval -ne 0 ]; then
+		echo "Error executing 'ipv6loganon'!" >&2
+		exit 1
+	fi
+	if [ "$output" != "$output_threads" ]; then
+		echo "ERROR : output with threads differs" >&2
+		exit 1
+	fi
+	echo "Test with threads and flush"
+	output_threads="`testscenarios_cache | grep -v "^#" | ./ipv6loganon -T 3 -f`"
+	if [ "$output" != "$output_threads" ]; then
+		echo "ERROR : output with threads and flush differs" >&2
+		exit 1
+	fi
 	echo
 fi
 
@@ -388,6 +421,54 @@ run_loganon_options_tests() {
 	echo "INFO  : $test successful"
 }
 
+run_loganon_prefix_cache_tests() {
+	local options="$*"
+
+	# addresses sharing IPv4 /24 or IPv6 /48 with the test scenarios, anonymized in one run (prefix cache in use)
+	# must result in the same as anonymized one-by-one
+	list="`testscenarios_kp | ../ipv6calc/ipv6calc -E ipv4,ipv6 | sort -u | while read addr; do
+		if echo "$addr" | grep -q ':'; then
+			prefix="\`../ipv6calc/ipv6calc -q --printfulluncompressed $addr | cut -d: -f1-3\`"
+			for suffix in 0000::1 4000::1 8000::1 ffff::1; do
+				echo "$prefix:$suffix"
+			done
+		else
+			for suffix in 1 64 128 254; do
+				echo "${addr%.*}.$suffix"
+			done
+		fi
+	done`"
+
+	# special addresses (LISP unicast, reserved, 6bone) following a neighbour of a possibly cached database range
+	list="$list
+153.17.0.1
+153.16.0.1
+2610:cf::1
+2610:d0::1
+2001:db9::1
+2001:db8::1
+3ffd:ffff::1
+3ffe:ffff::1"
+
+	if [ -z "$list" ]; then
+		echo "ERROR : list empty in run_loganon_prefix_cache_tests"
+		return 1
+	fi
+
+	echo "INFO  : run ipv6loganon prefix cache tests with options: $options" >&2
+	output_single="`echo "$list" | while read addr; do ../ipv6calc/ipv6calc -q -A anonymize $options $addr; done`"
+
+	for threads in "" "-T 3"; do
+		output="`echo "$list" | ./ipv6loganon -q $options $threads 2>/dev/null`"
+		if [ "$output" != "$output_single" ]; then
+			echo "ERROR : result of ipv6loganon $options $threads differs from single anonymization:"
+			diff -u <(echo "$output_single") <(echo "$output")
+			return 1
+		fi
+	done
+	echo "INFO  : ipv6loganon prefix cache tests successful" >&2
+}
+
 run_loganon_options_kp_tests() {
 	if ! ./ipv6loganon -vv 2>&1 | grep -q "Country4=1 Country6=1 ASN4=1 ASN6=1"; then
 		echo "NOTICE 'ipv6calc' has not required support for Country/ASN included, skip option kp tests..."
@@ -432,6 +513,11 @@ run_loganon_options_kp_tests() {
 		return 1
 	fi
 
+	run_loganon_prefix_cache_tests "--anonymize-preset kp"
+	if [ $? -ne 0 ]; then
+		return 1
+	fi
+
 	echo "INFO  : test scenario with huge amount of addresses..."
 	testscenario_hugelist ipv4 | ./ipv6loganon --anonymize-preset kp >/dev/null
 	if [ $? -ne 0 ]; then
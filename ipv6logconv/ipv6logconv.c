@@ -36,6 +36,7 @@
 #include "librfc3056.h"
 #include "libeui64.h"
 #include "libieee.h"
+#include "liblineio.h"
 
 #include "../databases/lib/libipv6calc_db_wrapper.h"
 
@@ -55,16 +56,16 @@ static int converttoken(char *result, const size_t resultstring_length, const ch
 static void lineparser(const long int outputtype);
 
 
-/* LRU cache */
+/* address cache */
+static s_ipv6calc_addr_cache *cache_addr = NULL;
 
-#define CACHE_LRU_SIZE 200
+/* buffered input and output */
+static s_ipv6calc_line_reader *input = NULL;
+static s_ipv6calc_line_writer *output = NULL;
 
-static int      cache_lru_max = 0;
-static int      cache_lru_last = 0;
-static char     cache_lru_key_token[CACHE_LRU_SIZE][NI_MAXHOST];
-static long int cache_lru_key_outputtype[CACHE_LRU_SIZE];
-static char     cache_lru_value[CACHE_LRU_SIZE][NI_MAXHOST];
-static long int cache_lru_statistics[CACHE_LRU_SIZE];
+/* input files (none: stdin) */
+static const char *input_file[LIBLINEIO_INPUT_MAX];
+static int input_files = 0;
 
 int feature_reg = 0;
 int feature_ieee = 0;
@@ -81,7 +82,7 @@ int main(int argc,char *argv[]) {
 	int i, lop, result;
 	unsigned long int command = 0;
 
-	cache_lru_limit = 20; /* optimum */
+	cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_DEFAULT;
 
 	/* new option style storage */	
 	uint32_t inputtype  = FORMAT_undefined, outputtype = FORMAT_undefined;
@@ -149,12 +150,12 @@ int main(int argc,char *argv[]) {
 				
 			case 'c':
 				cache_lru_limit = atoi(optarg);
-				if (cache_lru_limit > CACHE_LRU_SIZE) {
-					cache_lru_limit = CACHE_LRU_SIZE;
+				if (cache_lru_limit > IPV6CALC_ADDR_CACHE_LIMIT_MAX) {
+					cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_MAX;
 					fprintf(stderr, " Cache limit too big, built-in limit: %d\n", cache_lru_limit);
 				};
-				if (cache_lru_limit < 1) {
-					cache_lru_limit = 1;
+				if (cache_lru_limit < IPV6CALC_ADDR_CACHE_LIMIT_MIN) {
+					cache_lru_limit = IPV6CALC_ADDR_CACHE_LIMIT_MIN;
 					fprintf(stderr, " Cache limit too small, take minimum: %d\n", cache_lru_limit);
 				};
 				break;
@@ -163,6 +164,14 @@ int main(int argc,char *argv[]) {
 				flag_nocache = 1;
 				break;
 
+			case 'i':
+				if (input_files >= LIBLINEIO_INPUT_MAX) {
+					fprintf(stderr, " Too many input files (max: %d)\n", LIBLINEIO_INPUT_MAX);
+					exit(EXIT_FAILURE);
+				};
+				input_file[input_files++] = optarg;
+				break;
+
 			case CMD_outputtype:
 				DEBUGPRINT_WA(DEBUG_ipv6logconv_general, "Got output string: %s", optarg);
 
@@ -239,12 +248,40 @@ int main(int argc,char *argv[]) {
 		exit(EXIT_FAILURE);
 	};
 
+	if (flag_nocache == 0) {
+		cache_addr = libipv6calc_addr_cache_create(cache_lru_limit);
+		if (cache_addr == NULL) {
+			fprintf(stderr, "Can't create cache, continue without\n");
+			flag_nocache = 1;
+		};
+	};
+
+	/* regular input files are mapped, stdin and other files are read */
+	input = liblineio_reader_open(input_file, input_files, LIBLINEIO_BUFFER_SIZE, LINEBUFFER);
+	if (input == NULL) {
+		fprintf(stderr, "Can't open input\n");
+		exit(EXIT_FAILURE);
+	};
+
+	output = liblineio_writer_create(STDOUT_FILENO, LIBLINEIO_BUFFER_SIZE);
+	if (output == NULL) {
+		fprintf(stderr, "Can't create output buffer\n");
+		exit(EXIT_FAILURE);
+	};
+
 	/* call lineparser */
 	lineparser(outputtype);
 
+	result = (input->flag_error == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	liblineio_writer_free(output);
+	liblineio_reader_free(input);
+
+	libipv6calc_addr_cache_free(cache_addr);
+
 	libipv6calc_db_wrapper_cleanup();
 
-	exit(EXIT_SUCCESS);
+	exit(result);
 };
 
 
@@ -252,31 +289,40 @@ int main(int argc,char *argv[]) {
  * Line parser
  */
 static void lineparser(const long int outputtype) {
-	char linebuffer[LINEBUFFER];
 	char token[LINEBUFFER];
 	char resultstring[LINEBUFFER];
+	char linebuffer[LINEBUFFER];
+	const char *lineptr;
 	char *charptr, *cptr, **ptrptr;
-	int linecounter = 0, retval, i;
+	size_t length;
+	int linecounter = 0, retval;
 
 	ptrptr = &cptr;
 	
 	if (ipv6calc_quiet == 0) {
-		fprintf(stderr, "Expecting log lines on stdin\n");
+		if (input_files > 0) {
+			fprintf(stderr, "Expecting log lines from input files: %d\n", input_files);
+		} else {
+			fprintf(stderr, "Expecting log lines on stdin\n");
+		};
 	};
 
 	while (1 == 1) {
 		/* read line from stdin */
-		charptr = fgets(linebuffer, LINEBUFFER, stdin);
-		
-		if (charptr == NULL) {
+		length = liblineio_reader_getline(input, &lineptr);
+		if (length == 0) {
 			/* end of input */
 			break;
 		};
 
+		/* copy line, tokenizer modifies it */
+		memcpy(linebuffer, lineptr, length);
+		linebuffer[length] = '\0';
+
 		linecounter++;
 
 		if (linecounter == 1) {
-			if (ipv6calc_quiet == 0) {
+			if ((ipv6calc_quiet == 0) && (input_files == 0)) {
 				fprintf(stderr, "Ok, proceeding stdin...\n");
 			};
 		};
@@ -324,7 +370,7 @@ static void lineparser(const long int outputtype) {
 		};
 		
 		/* print result */
-		printf("%s", resultstring);
+		liblineio_writer_puts(output, resultstring);
 
 		if (outputtype == FORMAT_any) {
 			DEBUGPRINT_NA(DEBUG_ipv6logconv_processing, "Format is 'any', so look for next tokens");
@@ -349,7 +395,8 @@ static void lineparser(const long int outputtype) {
 			*/
 
 			/* skip this token */
-			printf(" %s", charptr);
+			liblineio_writer_write(output, " ", 1);
+			liblineio_writer_puts(output, charptr);
 			
 			/* look for next token */
 			charptr = strtok_r(NULL, " \t\n", ptrptr);
@@ -366,14 +413,16 @@ static void lineparser(const long int outputtype) {
 			DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "Token 3: '%s'", charptr);
 			retval = converttoken(resultstring, sizeof(resultstring), token, FORMAT_ouitype, 0);
 			/* print result */
-			printf(" %s", resultstring);
+			liblineio_writer_write(output, " ", 1);
+			liblineio_writer_puts(output, resultstring);
 		};
 
 END_line:
 		if ((*ptrptr != NULL) && (strlen(*ptrptr) > 0)) {
-			printf(" %s", *ptrptr);
+			liblineio_writer_write(output, " ", 1);
+			liblineio_writer_puts(output, *ptrptr);
 		} else {;
-			printf("\n");
+			liblineio_writer_write(output, "\n", 1);
 		};
 	};
 
@@ -382,9 +431,11 @@ END_line:
 
 		if (flag_nocache == 0) {
 			fprintf(stderr, "Cache statistics:\n");
-			for (i = 0; i < cache_lru_limit; i++) {
-				fprintf(stderr, "Cache distance: %3d  hits: %8ld\n", i, cache_lru_statistics[i]);
-			};
+			libipv6calc_addr_cache_print_statistics(cache_addr, "");
+		};
+
+		if (ipv6calc_verbose > 0) {
+			libipv6calc_db_wrapper_print_cache_statistics("");
 		};
 	};
 	return;
@@ -399,6 +450,8 @@ static int converttoken(char *resultstring, const size_t resultstring_length, co
 	int retval = 1, i, registry;
 	uint32_t typeinfo, typeinfo_test;
 	char tempstring[NI_MAXHOST];
+	int flag_cachekey = 0;
+	uint32_t key_addr[IPV6CALC_ADDR_CACHE_KEY_WORDS];
 	ipv6calc_macaddr macaddr;
 
 	/* used structures */
@@ -414,49 +467,6 @@ static int converttoken(char *resultstring, const size_t resultstring_length, co
 		return (1);
 	};
 
-	/* use cache ? */
-	if (flag_nocache == 0 && cache_lru_max > 0) {
-		/* check last seen one first */
-		DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "LRU cache: look for key=%s", token);
-
-		if (cache_lru_key_outputtype[cache_lru_last - 1] == outputtype) {
-			if (strcmp(cache_lru_key_token[cache_lru_last - 1], token) == 0) {
-				snprintf(resultstring, resultstring_length, "%s", cache_lru_value[cache_lru_last - 1]);
-				cache_lru_statistics[0]++;
-				DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "LRU cache: hit last line=%d key_token=%s key_outputtype=%lx value=%s", cache_lru_last - 1, token, outputtype, resultstring);
-				return (0);
-			};
-		} else {
-			/* run backwards to first entry */
-			if (cache_lru_last > 1) {
-				for (i = cache_lru_last - 1; i > 0; i--) {
-					if (cache_lru_key_outputtype[i - 1] == outputtype) {
-						if (strcmp(cache_lru_key_token[i - 1], token) == 0) {
-							snprintf(resultstring, resultstring_length, "%s", cache_lru_value[i - 1]);
-							cache_lru_statistics[cache_lru_last - i]++;
-							DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "LRU cache: hit line=%d key_token=%s key_outputtype=%lx value=%s", i - 1, token, outputtype, resultstring);
-							return (0);
-						};
-					};
-				};
-			};
-			/* round robin */ 
-			if (cache_lru_last < cache_lru_max) {
-				for (i = cache_lru_max; i > cache_lru_last; i--) {
-					if (cache_lru_key_outputtype[i - 1] == outputtype) {
-						if (strcmp(cache_lru_key_token[i - 1], token) == 0) {
-							snprintf(resultstring, resultstring_length, "%s", cache_lru_value[i - 1]);
-							cache_lru_statistics[cache_lru_max - i + cache_lru_last]++;
-							DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "LRU cache: hit line=%d key_token=%s key_outputtype=%lx value=%s", i - 1, token, outputtype, resultstring);
-							return (0);
-						};
-					};
-				};
-			};
-		};
-	};
-
-
 	/* set addresses to invalid */
 	ipv6addr.flag_valid = 0;
 	ipv4addr.flag_valid = 0;
@@ -491,6 +501,39 @@ static int converttoken(char *resultstring, const size_t resultstring_length, co
 
 	DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "Token: '%s'", token);
 
+	/* use cache ? (key: binary address, prefix length and output type) */
+	if (flag_nocache == 0) {
+		memset(key_addr, 0, sizeof(key_addr));
+		flag_cachekey = 1;
+
+		if (ipv6addr.flag_valid == 1) {
+			for (i = 0; i < 4; i++) {
+				key_addr[i] = ipv6addr_getdword(&ipv6addr, i);
+			};
+			key_addr[4] = IPV6CALC_ADDR_CACHE_KEY_PREFIX(ipv6addr.flag_prefixuse, ipv6addr.prefixlength);
+
+			if (ipv6addr.flag_scopeid == 1) {
+				/* scope ID is not part of the key, not cached */
+				flag_cachekey = 0;
+			};
+		} else if (ipv4addr.flag_valid == 1) {
+			key_addr[0] = ipv4addr_getdword(&ipv4addr);
+			key_addr[4] = IPV6CALC_ADDR_CACHE_KEY_PREFIX(ipv4addr.flag_prefixuse, ipv4addr.prefixlength);
+		} else {
+			/* not an address, not cached */
+			flag_cachekey = 0;
+		};
+
+		if (flag_cachekey == 1) {
+			DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "Address cache: look for key=%s outputtype=%lx", token, outputtype);
+
+			if (libipv6calc_addr_cache_lookup(cache_addr, inputtype, (uint32_t) outputtype, key_addr, resultstring, resultstring_length) == 1) {
+				DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "Address cache: hit key=%s outputtype=%lx value=%s", token, outputtype, resultstring);
+				return (0);
+			};
+		};
+	};
+
 	/***** postprocessing input *****/
 
 	DEBUGPRINT_NA(DEBUG_ipv6logconv_processing, "Start of postprocessing input");
@@ -702,24 +745,9 @@ static int converttoken(char *resultstring, const size_t resultstring_length, co
 	};
 
 	/* use cache ? */
-	if (flag_nocache == 0) {
-		/* calculate pointer */
-		if (cache_lru_max < cache_lru_limit) {
-			cache_lru_last++;
-			cache_lru_max++;
-		} else {
-			if (cache_lru_last == cache_lru_limit) {
-				cache_lru_last = 1;
-			} else {
-				cache_lru_last++;
-			};
-		};
-
-		/* store key and value */
-		snprintf(cache_lru_key_token[cache_lru_last - 1], NI_MAXHOST - 1, "%s", token);
-		cache_lru_key_outputtype[cache_lru_last - 1] = outputtype;
-		snprintf(cache_lru_value[cache_lru_last - 1], NI_MAXHOST - 1, "%s", resultstring);
-		DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "LRU cache: fill line=%d key_token=%s key_outputtype=%lx value=%s", cache_lru_last - 1, cache_lru_key_token[cache_lru_last - 1], cache_lru_key_outputtype[cache_lru_last - 1], cache_lru_value[cache_lru_last - 1]);
+	if (flag_cachekey == 1) {
+		libipv6calc_addr_cache_store(cache_addr, inputtype, (uint32_t) outputtype, key_addr, resultstring);
+		DEBUGPRINT_WA(DEBUG_ipv6logconv_processing, "Address cache: fill key=%s outputtype=%lx value=%s", token, outputtype, resultstring);
 	};
 
 	return (0);
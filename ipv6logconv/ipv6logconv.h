@@ -13,9 +13,6 @@
 #define PROGRAM_NAME "ipv6logconv"
 #define PROGRAM_COPYRIGHT "(P) & (C) 2002-" COPYRIGHT_YEAR " by Peter Bieringer <pb (at) bieringer.de>"
 
-/* LRU cache maximum size */
-#define CACHE_LRU_SIZE 200
-
 
 #define DEBUG_ipv6logconv_general      0x00000001l
 #define DEBUG_ipv6logconv_processing   0x00000002l
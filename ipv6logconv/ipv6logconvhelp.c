@@ -16,6 +16,7 @@
 #include "ipv6calctypes.h"
 #include "ipv6calccommands.h"
 #include "ipv6calchelp.h"
+#include "libipv6calc.h"
 #include "config.h"
 
 /* display info */
@@ -69,7 +70,9 @@ void ipv6logconv_printhelp(void) {
 	fprintf(stderr, "  [-n|--nocache]            : disable caching\n");
 	fprintf(stderr, "  [-c|--cachelimit <value>] : set cache limit\n");
 	fprintf(stderr, "                               default: %d\n", cache_lru_limit);
-	fprintf(stderr, "                               maximum: %d\n", CACHE_LRU_SIZE);
+	fprintf(stderr, "                               maximum: %d\n", IPV6CALC_ADDR_CACHE_LIMIT_MAX);
+	fprintf(stderr, " Input options:\n");
+	fprintf(stderr, "  [-i|--input <file>]       : read from file instead of stdin (repeatable)\n");
 	fprintf(stderr, " Output options:\n");
 	fprintf(stderr, "  [--out <output type>] : specify output type\n");
 	fprintf(stderr, "   addrtype       : Address type%s\n", (feature_reg == 0) ? "  (NOT-SUPPORTED)" : "");
@@ -81,7 +84,7 @@ void ipv6logconv_printhelp(void) {
 			fprintf(stderr, " NOT-SUPPORTED means either database missing or support not compiled-in\n");
 	};
 	fprintf(stderr, "\n");
-	fprintf(stderr, " Takes data from stdin, proceed it to stdout\n");
+	fprintf(stderr, " Takes data from stdin (or input files), proceed it to stdout\n");
 	fprintf(stderr, "\n");
 
 	return;
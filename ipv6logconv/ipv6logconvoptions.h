@@ -20,7 +20,7 @@
 /* Options */
 
 /* define short options */
-static char *ipv6logconv_shortopts = "vfh?nc:";
+static char *ipv6logconv_shortopts = "vfh?nc:i:";
 
 /* define long options */
 static struct option ipv6logconv_longopts[] = {
@@ -38,6 +38,7 @@ static struct option ipv6logconv_longopts[] = {
 
 	/* options */
 	{ "out"       , 1, 0, CMD_outputtype },
+	{ "input"     , 1, 0, (int) 'i' },
 };                
 
 #endif
@@ -14,6 +14,7 @@
 #include <getopt.h> 
 #include <unistd.h>
 #include <time.h>
+#include <pthread.h>
 
 #include "config.h"
 
@@ -30,6 +31,7 @@
 #include "libipv4addr.h"
 #include "libipv6addr.h"
 #include "libifinet6.h"
+#include "liblineio.h"
 
 #include "../databases/lib/libipv6calc_db_wrapper.h"
 #include "../databases/lib/libipv6calc_db_wrapper_GeoIP.h"
@@ -39,6 +41,7 @@
 #include "../databases/lib/libipv6calc_db_wrapper_BuiltIn.h"
 
 #define LINEBUFFER	16384
+#define CHUNK_LINES	1024	/* number of addresses collected for batch database lookup */
 
 long int ipv6calc_debug = 0;	// ipv6calc_debug usage ok
 
@@ -50,6 +53,9 @@ static int opt_onlyheader = 0;
 static int opt_printdirection = 0; /* rows */
 static char opt_token[NI_MAXHOST] = "";
 
+/* threads (0: single-threaded) */
+static int threads = 0;
+
 char    file_out[NI_MAXHOST] = "";
 int     file_out_flag = 0;
 FILE    *FILE_OUT;
@@ -59,71 +65,150 @@ int feature_as  = 0;
 int feature_reg = 0;
 
 static stat_entries ipv6logstats_statentries[] = {
-	{ STATS_ALL		, 0, "ALL" },
-	{ STATS_IPV4		, 0, "IPv4" },
-	{ STATS_IPV6		, 0, "IPv6" },
-	{ STATS_UNKNOWN		, 0, "UNKNOWN" },
-	{ STATS_IPV4_APNIC	, 0, "IPv4/APNIC" },
-	{ STATS_IPV4_ARIN	, 0, "IPv4/ARIN" },
-	{ STATS_IPV4_RIPENCC	, 0, "IPv4/RIPE" },
-	{ STATS_IPV4_LACNIC	, 0, "IPv4/LACNIC" },
-	{ STATS_IPV4_AFRINIC	, 0, "IPv4/AFRINIC" },
-	{ STATS_IPV4_UNKNOWN	, 0, "IPv4/UNKNOWN" },
-	{ STATS_IPV6_6BONE	, 0, "IPv6/6bone" },
-	{ STATS_IPV6_IANA	, 0, "IPv6/IANA" },
-	{ STATS_IPV6_APNIC	, 0, "IPv6/APNIC" },
-	{ STATS_IPV6_ARIN	, 0, "IPv6/ARIN" },
-	{ STATS_IPV6_RIPENCC    , 0, "IPv6/RIPE" },
-	{ STATS_IPV6_LACNIC	, 0, "IPv6/LACNIC" },
-	{ STATS_IPV6_AFRINIC	, 0, "IPv6/AFRINIC" },
-	{ STATS_IPV6_RESERVED	, 0, "IPv6/RESERVED" },
-	{ STATS_IPV6_UNKNOWN	, 0, "IPv6/UNKNOWN" },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_IANA    , 0, "IPv6/6to4/IANA"     },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_APNIC   , 0, "IPv6/6to4/APNIC"    },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_ARIN    , 0, "IPv6/6to4/ARIN"     },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_RIPENCC , 0, "IPv6/6to4/RIPE"     },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_LACNIC  , 0, "IPv6/6to4/LACNIC"   },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_AFRINIC , 0, "IPv6/6to4/AFRINIC"  },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_RESERVED, 0, "IPv6/6to4/RESERVED" },
-	{ STATS_IPV6_6TO4_BASE + REGISTRY_UNKNOWN , 0, "IPv6/6to4/UNKNOWN"  },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_IANA    , 0, "IPv6/Teredo/IANA"     },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_APNIC   , 0, "IPv6/Teredo/APNIC"    },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_ARIN    , 0, "IPv6/Teredo/ARIN"     },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_RIPENCC , 0, "IPv6/Teredo/RIPE"     },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_LACNIC  , 0, "IPv6/Teredo/LACNIC"   },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_AFRINIC , 0, "IPv6/Teredo/AFRINIC"  },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_RESERVED, 0, "IPv6/Teredo/RESERVED" },
-	{ STATS_IPV6_TEREDO_BASE + REGISTRY_UNKNOWN , 0, "IPv6/Teredo/UNKNOWN"  },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_IANA    , 0, "IPv6/NAT64/IANA"     },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_APNIC   , 0, "IPv6/NAT64/APNIC"    },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_ARIN    , 0, "IPv6/NAT64/ARIN"     },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_RIPENCC , 0, "IPv6/NAT64/RIPE"     },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_LACNIC  , 0, "IPv6/NAT64/LACNIC"   },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_AFRINIC , 0, "IPv6/NAT64/AFRINIC"  },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_RESERVED, 0, "IPv6/NAT64/RESERVED" },
-	{ STATS_IPV6_NAT64_BASE + REGISTRY_UNKNOWN , 0, "IPv6/NAT64/UNKNOWN"  },
-	{ STATS_IPV6_IID_GLOBAL, 0, "IPv6/IID/Global" },
-	{ STATS_IPV6_IID_RANDOM, 0, "IPv6/IID/Random" },
-	{ STATS_IPV6_IID_MANUAL, 0, "IPv6/IID/Manual" },
-	{ STATS_IPV6_IID_ISATAP, 0, "IPv6/IID/ISATAP" },
-	{ STATS_IPV6_IID_MANUAL, 0, "IPv6/IID/Unknown" },
+	{ STATS_ALL		, "ALL" },
+	{ STATS_IPV4		, "IPv4" },
+	{ STATS_IPV6		, "IPv6" },
+	{ STATS_UNKNOWN		, "UNKNOWN" },
+	{ STATS_IPV4_APNIC	, "IPv4/APNIC" },
+	{ STATS_IPV4_ARIN	, "IPv4/ARIN" },
+	{ STATS_IPV4_RIPENCC	, "IPv4/RIPE" },
+	{ STATS_IPV4_LACNIC	, "IPv4/LACNIC" },
+	{ STATS_IPV4_AFRINIC	, "IPv4/AFRINIC" },
+	{ STATS_IPV4_UNKNOWN	, "IPv4/UNKNOWN" },
+	{ STATS_IPV6_6BONE	, "IPv6/6bone" },
+	{ STATS_IPV6_IANA	, "IPv6/IANA" },
+	{ STATS_IPV6_APNIC	, "IPv6/APNIC" },
+	{ STATS_IPV6_ARIN	, "IPv6/ARIN" },
+	{ STATS_IPV6_RIPENCC    , "IPv6/RIPE" },
+	{ STATS_IPV6_LACNIC	, "IPv6/LACNIC" },
+	{ STATS_IPV6_AFRINIC	, "IPv6/AFRINIC" },
+	{ STATS_IPV6_RESERVED	, "IPv6/RESERVED" },
+	{ STATS_IPV6_UNKNOWN	, "IPv6/UNKNOWN" },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_IANA    , "IPv6/6to4/IANA"     },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_APNIC   , "IPv6/6to4/APNIC"    },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_ARIN    , "IPv6/6to4/ARIN"     },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_RIPENCC , "IPv6/6to4/RIPE"     },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_LACNIC  , "IPv6/6to4/LACNIC"   },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_AFRINIC , "IPv6/6to4/AFRINIC"  },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_RESERVED, "IPv6/6to4/RESERVED" },
+	{ STATS_IPV6_6TO4_BASE + REGISTRY_UNKNOWN , "IPv6/6to4/UNKNOWN"  },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_IANA    , "IPv6/Teredo/IANA"     },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_APNIC   , "IPv6/Teredo/APNIC"    },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_ARIN    , "IPv6/Teredo/ARIN"     },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_RIPENCC , "IPv6/Teredo/RIPE"     },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_LACNIC  , "IPv6/Teredo/LACNIC"   },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_AFRINIC , "IPv6/Teredo/AFRINIC"  },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_RESERVED, "IPv6/Teredo/RESERVED" },
+	{ STATS_IPV6_TEREDO_BASE + REGISTRY_UNKNOWN , "IPv6/Teredo/UNKNOWN"  },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_IANA    , "IPv6/NAT64/IANA"     },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_APNIC   , "IPv6/NAT64/APNIC"    },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_ARIN    , "IPv6/NAT64/ARIN"     },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_RIPENCC , "IPv6/NAT64/RIPE"     },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_LACNIC  , "IPv6/NAT64/LACNIC"   },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_AFRINIC , "IPv6/NAT64/AFRINIC"  },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_RESERVED, "IPv6/NAT64/RESERVED" },
+	{ STATS_IPV6_NAT64_BASE + REGISTRY_UNKNOWN , "IPv6/NAT64/UNKNOWN"  },
+	{ STATS_IPV6_IID_GLOBAL, "IPv6/IID/Global" },
+	{ STATS_IPV6_IID_RANDOM, "IPv6/IID/Random" },
+	{ STATS_IPV6_IID_MANUAL, "IPv6/IID/Manual" },
+	{ STATS_IPV6_IID_ISATAP, "IPv6/IID/ISATAP" },
+	{ STATS_IPV6_IID_MANUAL, "IPv6/IID/Unknown" },
 };
 
-/* stat by Country Code */
-static long unsigned int counter_country[COUNTRYCODE_INDEX_MAX];
-static long unsigned int counter_country_ipv4[COUNTRYCODE_INDEX_MAX];
-static long unsigned int counter_country_ipv6[COUNTRYCODE_INDEX_MAX];
-
-static long unsigned int counter_country_A46, counter_country_IPV4, counter_country_IPV6;
-
 /* stat by ASN (only 16-bit ASN supported, 32-bit ASNs are mapped to 23456 "AS_TRANS" */
 #define ASNUM_MAX     65536
-static long unsigned int counter_asn[ASNUM_MAX];
-static long unsigned int counter_asn_ipv4[ASNUM_MAX];
-static long unsigned int counter_asn_ipv6[ASNUM_MAX];
+
+/* set of counters, one per worker thread, merged at the end */
+typedef struct {
+	long unsigned int stat[MAXENTRIES_ARRAY(ipv6logstats_statentries)];
+
+	/* stat by Country Code */
+	long unsigned int country[COUNTRYCODE_INDEX_MAX];
+	long unsigned int country_ipv4[COUNTRYCODE_INDEX_MAX];
+	long unsigned int country_ipv6[COUNTRYCODE_INDEX_MAX];
+	long unsigned int country_A46, country_IPV4, country_IPV6;
+
+	/* stat by ASN */
+	long unsigned int asn[ASNUM_MAX];
+	long unsigned int asn_ipv4[ASNUM_MAX];
+	long unsigned int asn_ipv6[ASNUM_MAX];
+} s_ipv6logstats_counters;
+
+static s_ipv6logstats_counters counters;
+
+/* buffered input */
+static s_ipv6calc_line_reader *input = NULL;
+
+/* input files (none: stdin) */
+static const char *input_file[LIBLINEIO_INPUT_MAX];
+static int input_files = 0;
+
+/* chunk of parsed addresses for batch database lookup */
+typedef struct {
+	uint32_t inputtype;		/* FORMAT_ipv4addr or FORMAT_ipv6addr */
+	uint32_t typeinfo;		/* IPv6 typeinfo */
+	int      index;			/* index in ipv4addr (IPv4 or included IPv4) or ipv6addr list */
+	char     token[NI_MAXHOST];	/* address as text (only stored for option -u) */
+} s_ipv6logstats_chunk_entry;
+
+typedef struct {
+	int count;
+	int count_ipv4;
+	int count_ipv6;
+	s_ipv6logstats_chunk_entry entry[CHUNK_LINES];
+	ipv6calc_ipv4addr ipv4addr[CHUNK_LINES];
+	ipv6calc_ipv6addr ipv6addr[CHUNK_LINES];
+	uint16_t cc_index_ipv4[CHUNK_LINES];
+	uint16_t cc_index_ipv6[CHUNK_LINES];
+	uint32_t as_num32_ipv4[CHUNK_LINES];
+	uint32_t as_num32_ipv6[CHUNK_LINES];
+	int      registry_ipv4[CHUNK_LINES];
+	int      registry_ipv6[CHUNK_LINES];
+} s_ipv6logstats_chunk;
+
+static s_ipv6logstats_chunk chunk;
+
+/* block of input lines, processed by one worker thread */
+typedef struct {
+	int state;		// see IPV6LOGSTATS_BLOCK_STATE_*
+	int linecounter;	// number of first line
+	int lines;		// amount of lines stored in 'in'
+	char *in;		// lines terminated by '\0' each
+	size_t in_used;
+} s_ipv6logstats_block;
+
+#define IPV6LOGSTATS_BLOCK_STATE_FREE	0
+#define IPV6LOGSTATS_BLOCK_STATE_FILLED	1
+#define IPV6LOGSTATS_BLOCK_STATE_WORK	2
+
+/* worker thread with own counters, chunk and database cache */
+typedef struct {
+	pthread_t thread;
+	int number;
+	s_ipv6logstats_counters counters;
+	s_ipv6logstats_chunk chunk;
+	s_ipv6calc_db_wrapper_ctx db_ctx;
+} s_ipv6logstats_worker;
+
+/* queue: reader (main thread) -> workers, block n is stored in slot n % slots */
+static struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond_free;	// block slot freed by worker
+	pthread_cond_t cond_filled;	// block filled by reader (or end of input)
+	s_ipv6logstats_block *block;
+	int slots;
+	long int next_fill;
+	long int next_work;
+	int flag_eof;
+	int next_file;		// next input file to be taken by a worker (input files given)
+	int flag_error;		// read error on an input file
+} queue;
 
 /* prototypes */
 static void lineparser(void);
+static void lineparser_threads(void);
+static void statistics_print(void);
+static void chunk_process(s_ipv6logstats_chunk *chunkp, s_ipv6logstats_counters *countersp);
 
 
 /**************************************************/
@@ -246,6 +331,22 @@ int main(int argc,char *argv[]) {
 				};
 				break;
 
+			case 'i':
+				if (input_files >= LIBLINEIO_INPUT_MAX) {
+					fprintf(stderr, " Too many input files (max: %d)\n", LIBLINEIO_INPUT_MAX);
+					exit(EXIT_FAILURE);
+				};
+				input_file[input_files++] = optarg;
+				break;
+
+			case 'T':
+				threads = atoi(optarg);
+				if ((threads < 1) || (threads > IPV6LOGSTATS_THREADS_MAX)) {
+					fprintf(stderr, " Amount of threads out of range: %s (1-%d)\n", optarg, IPV6LOGSTATS_THREADS_MAX);
+					exit(EXIT_FAILURE);
+				};
+				break;
+
 			default:
 				fprintf(stderr, "Usage: (see '%s --command -?|-h|--help' for more help)\n", PROGRAM_NAME);
 				break;
@@ -304,23 +405,50 @@ int main(int argc,char *argv[]) {
 	};
 
 	/* call lineparser */
-	lineparser();
+	result = EXIT_SUCCESS;
+	if (opt_onlyheader == 0) {
+		/* regular input files are mapped, stdin and other files are read (also checks all given input files) */
+		input = liblineio_reader_open(input_file, input_files, LIBLINEIO_BUFFER_SIZE, LINEBUFFER);
+		if (input == NULL) {
+			fprintf(stderr, "Can't open input\n");
+			exit(EXIT_FAILURE);
+		};
+
+		if ((threads > 0) && (libipv6calc_db_wrapper_ctx_threadsafe() == 0)) {
+			fprintf(stderr, "Database source in use does not support concurrent lookups, continue without threads\n");
+			threads = 0;
+		};
+
+		if (threads > 0) {
+			lineparser_threads();
+		} else {
+			lineparser();
+		};
+
+		if ((input->flag_error != 0) || (queue.flag_error != 0)) {
+			result = EXIT_FAILURE;
+		};
+
+		liblineio_reader_free(input);
+	};
+
+	statistics_print();
 
 	libipv6calc_db_wrapper_cleanup();
 
-	exit(EXIT_SUCCESS);
+	exit(result);
 };
 
 
 /*
  * Statistics structure handling
  */
-static void stat_inc(int number) {
+static void stat_inc(s_ipv6logstats_counters *countersp, int number) {
 	int i;
 	
 	for (i = 0; i < MAXENTRIES_ARRAY(ipv6logstats_statentries); i++) {
 		if (number == ipv6logstats_statentries[i].number) {
-			ipv6logstats_statentries[i].counter++;
+			countersp->stat[i]++;
 			break;
 		};
 	};
@@ -330,7 +458,7 @@ static void stat_inc(int number) {
 /*
  * Country code statistics
  */
-static void stat_inc_country_code(uint16_t country_code, const int proto) {
+static void stat_inc_country_code(s_ipv6logstats_counters *countersp, uint16_t country_code, const int proto) {
 	int index = COUNTRYCODE_INDEX_UNKNOWN;
 
 	if (country_code < COUNTRYCODE_INDEX_MAX) {
@@ -342,15 +470,15 @@ static void stat_inc_country_code(uint16_t country_code, const int proto) {
 
 	DEBUGPRINT_WA(DEBUG_ipv6logstats_general, "Increment CountryCode index: %d (%d)", index, country_code);
 
-	counter_country[index]++;
-	counter_country_A46++;
+	countersp->country[index]++;
+	countersp->country_A46++;
 
 	if (proto == 4) {
-		counter_country_ipv4[index]++;
-		counter_country_IPV4++;
+		countersp->country_ipv4[index]++;
+		countersp->country_IPV4++;
 	} else if (proto == 6) {
-		counter_country_ipv6[index]++;
-		counter_country_IPV6++;
+		countersp->country_ipv6[index]++;
+		countersp->country_IPV6++;
 	} else {
 		fprintf(stderr, "%s/%s: unexpected unsupported proto: %d\n", __FILE__, __func__, proto);
 		exit(1);
@@ -361,7 +489,7 @@ static void stat_inc_country_code(uint16_t country_code, const int proto) {
 /*
  * AS Number statistics
  */
-static void stat_inc_asnum(const uint32_t as_num32, const int proto) {
+static void stat_inc_asnum(s_ipv6logstats_counters *countersp, const uint32_t as_num32, const int proto) {
 	unsigned int index = ASNUM_AS_UNKNOWN;
 
 	if (as_num32 < ASNUM_MAX) {
@@ -374,363 +502,537 @@ static void stat_inc_asnum(const uint32_t as_num32, const int proto) {
 
 	DEBUGPRINT_WA(DEBUG_ipv6logstats_general, "Increment ASN index: %d (%d)", index, as_num32);
 
-	counter_asn[index]++;
+	countersp->asn[index]++;
 
 	if (proto == 4) {
-		counter_asn_ipv4[index]++;
+		countersp->asn_ipv4[index]++;
 	} else if (proto == 6) {
-		counter_asn_ipv6[index]++;
+		countersp->asn_ipv6[index]++;
 	};
 };
 
 
 /*
- * Line parser
+ * Merge counters of a worker thread
  */
-static void lineparser(void) {
-	char linebuffer[LINEBUFFER];
+static void stat_merge(s_ipv6logstats_counters *countersp, const s_ipv6logstats_counters *sourcep) {
+	int i;
+
+	for (i = 0; i < MAXENTRIES_ARRAY(ipv6logstats_statentries); i++) {
+		countersp->stat[i] += sourcep->stat[i];
+	};
+
+	for (i = 0; i < COUNTRYCODE_INDEX_MAX; i++) {
+		countersp->country[i] += sourcep->country[i];
+		countersp->country_ipv4[i] += sourcep->country_ipv4[i];
+		countersp->country_ipv6[i] += sourcep->country_ipv6[i];
+	};
+
+	countersp->country_A46 += sourcep->country_A46;
+	countersp->country_IPV4 += sourcep->country_IPV4;
+	countersp->country_IPV6 += sourcep->country_IPV6;
+
+	for (i = 0; i < ASNUM_MAX; i++) {
+		countersp->asn[i] += sourcep->asn[i];
+		countersp->asn_ipv4[i] += sourcep->asn_ipv4[i];
+		countersp->asn_ipv6[i] += sourcep->asn_ipv6[i];
+	};
+};
+
+
+/*
+ * Process one line: parse first token, add address to chunk and process chunk if full
+ */
+static void lineprocess(char *linebuffer, const int linecounter, s_ipv6logstats_chunk *chunkp, s_ipv6logstats_counters *countersp) {
 	char token[LINEBUFFER];
 	char resultstring[LINEBUFFER];
 	char *charptr, *cptr, **ptrptr;
-	int linecounter = 0, retval, i, r;
+	int retval, r;
 
 	uint32_t inputtype  = FORMAT_undefined;
 	ipv6calc_ipv6addr ipv6addr;
 	ipv6calc_ipv4addr ipv4addr;
-	int registry, stat_registry_base;
 
-	time_t timer;
-	struct tm* tm_info;
+	ptrptr = &cptr;
 
-	int index;
-	uint16_t cc_index = COUNTRYCODE_INDEX_UNKNOWN;
-	uint32_t as_num32 = ASNUM_AS_UNKNOWN;
-	long unsigned int c_all, c_ipv4, c_ipv6;
+	DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Line counter: %d", linecounter);
 
-	int column_offset = 1;
+	if (strlen(linebuffer) >= LINEBUFFER) {
+		fprintf(stderr, "Line too long: %d\n", linecounter);
+		return;
+	};
 
-	// clear counters
-	for (i = 0; i < COUNTRYCODE_INDEX_MAX; i++) {
-		counter_country[i] = 0;
-		counter_country_ipv4[i] = 0;
-		counter_country_ipv6[i] = 0;
+	/* remove trailing \n */
+	if (linebuffer[strlen(linebuffer) - 1] == '\n') {
+		linebuffer[strlen(linebuffer) - 1] = '\0';
 	};
 
-	ptrptr = &cptr;
 	
-	if (opt_onlyheader == 0) {
-		if (ipv6calc_quiet == 0) {
+	if (strlen(linebuffer) == 0) {
+		fprintf(stderr, "Line empty: %d\n", linecounter);
+		return;
+	};
+	
+	DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Got line: '%s'", linebuffer);
+
+	/* look for first token (should be IP address) */
+	charptr = strtok_r(linebuffer, " \t\n", ptrptr);
+	
+	if ( charptr == NULL ) {
+		fprintf(stderr, "Line contains no token: %d\n", linecounter);
+		return;
+	};
+
+	if ( strlen(charptr) >=  LINEBUFFER) {
+		fprintf(stderr, "Line too strange: %d\n", linecounter);
+		return;
+	};
+
+	snprintf(token, sizeof(token), "%s", charptr);
+	
+	DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Token 1: '%s'", token);
+
+	stat_inc(countersp, STATS_ALL);
+
+	/* get input type now */
+	inputtype = libipv6calc_autodetectinput(token);
+
+	/* check for proper type */
+	if ((inputtype != FORMAT_ipv4addr) && (inputtype != FORMAT_ipv6addr)) {
+		/* fprintf(stderr, "Token 1 (address) is not an IP address in line: %d\n", linecounter); */
+		stat_inc(countersp, STATS_UNKNOWN);
+		return;
+	};
+
+	/* fill related structure */
+	switch (inputtype) {
+		case FORMAT_ipv6addr:
+			retval = addr_to_ipv6addrstruct(token, resultstring, sizeof(resultstring), &ipv6addr);
+			break;
+
+		case FORMAT_ipv4addr:
+			retval = addr_to_ipv4addrstruct(token, resultstring, sizeof(resultstring), &ipv4addr);
+			break;
+
+		default:
+			retval = 0;
+			break;
+	};
+
+	if (retval != 0 ) {
+		fprintf(stderr, "Problem during address parsing on line %d (skipped): %s\n", linecounter, resultstring);
+		return;
+	};
+
+	/* catch compat/mapped */
+	switch (inputtype) {
+		case FORMAT_ipv6addr:
+			if ((ipv6addr.typeinfo & (IPV6_ADDR_COMPATv4 | IPV6_ADDR_MAPPED)) != 0) {
+				/* extract IPv4 address */
+				r = libipv6addr_get_included_ipv4addr(&ipv6addr, &ipv4addr, IPV6_ADDR_SELECT_IPV4_DEFAULT);
+				if (r != 0) {
+					return;
+				};
+
+				// remap
+				inputtype = FORMAT_ipv4addr;
+
+				// create text represenation
+				r = libipv4addr_ipv4addrstruct_to_string(&ipv4addr, token, sizeof(token), 0);
+			};
+			break;
+
+		default:
+			// nothing to do
+			break;
+	};
+
+	/* token is stored for option -u (always fits after successful address parsing) */
+	if (strlen(token) >= sizeof(chunkp->entry[chunkp->count].token)) {
+		fprintf(stderr, "Line too strange: %d\n", linecounter);
+		return;
+	};
+
+	/* add to chunk */
+	switch (inputtype) {
+		case FORMAT_ipv6addr:
+			if ((ipv6addr.typeinfo & IPV6_ADDR_HAS_PUBLIC_IPV4) != 0) {
+				/* has public IPv4 address included, get IPv4 address (in case of Teredo the client IP) */
+				r = libipv6addr_get_included_ipv4addr(&ipv6addr, &chunkp->ipv4addr[chunkp->count_ipv4], IPV6_ADDR_SELECT_IPV4_DEFAULT);
+				if (r != 0) {
+					stat_inc(countersp, STATS_IPV6);
+					return;
+				};
+				chunkp->entry[chunkp->count].index = chunkp->count_ipv4++;
+			} else {
+				chunkp->ipv6addr[chunkp->count_ipv6] = ipv6addr;
+				chunkp->entry[chunkp->count].index = chunkp->count_ipv6++;
+			};
+			chunkp->entry[chunkp->count].typeinfo = ipv6addr.typeinfo;
+			break;
+
+		case FORMAT_ipv4addr:
+			chunkp->ipv4addr[chunkp->count_ipv4] = ipv4addr;
+			chunkp->entry[chunkp->count].index = chunkp->count_ipv4++;
+			chunkp->entry[chunkp->count].typeinfo = 0;
+			break;
+	};
+
+	chunkp->entry[chunkp->count].inputtype = inputtype;
+	if (opt_unknown == 1) {
+		memcpy(chunkp->entry[chunkp->count].token, token, strlen(token) + 1);
+	};
+	chunkp->count++;
+
+	if (chunkp->count == CHUNK_LINES) {
+		chunk_process(chunkp, countersp);
+	};
+};
+
+
+/*
+ * Line parser
+ */
+static void lineparser(void) {
+	char linebuffer[LINEBUFFER];
+	const char *lineptr;
+	size_t length;
+	int linecounter = 0;
+
+	if (ipv6calc_quiet == 0) {
+		if (input_files > 0) {
+			fprintf(stderr, "Expecting log lines from input files: %d\n", input_files);
+		} else {
 			fprintf(stderr, "Expecting log lines on stdin\n");
 		};
 	};
 
-	while (opt_onlyheader == 0) {
+	while (1 == 1) {
 		/* read line from stdin */
-		charptr = fgets(linebuffer, LINEBUFFER, stdin);
-		
-		if (charptr == NULL) {
+		length = liblineio_reader_getline(input, &lineptr);
+		if (length == 0) {
 			/* end of input */
 			break;
 		};
 
-		linecounter++;
+		/* copy line, tokenizer modifies it */
+		memcpy(linebuffer, lineptr, length);
+		linebuffer[length] = '\0';
 
-		stat_registry_base = 0;
+		linecounter++;
 
 		if (linecounter == 1) {
-			if (ipv6calc_quiet == 0) {
+			if ((ipv6calc_quiet == 0) && (input_files == 0)) {
 				fprintf(stderr, "Ok, proceeding stdin...\n");
 			};
 		};
 		
-		DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Line counter: %d", linecounter);
+		lineprocess(linebuffer, linecounter, &chunk, &counters);
+	};
 
-		if (strlen(linebuffer) >= LINEBUFFER) {
-			fprintf(stderr, "Line too long: %d\n", linecounter);
-			continue;
-		};
+	/* process remaining chunk */
+	chunk_process(&chunk, &counters);
 
-		/* remove trailing \n */
-		if (linebuffer[strlen(linebuffer) - 1] == '\n') {
-			linebuffer[strlen(linebuffer) - 1] = '\0';
-		};
+	if (ipv6calc_quiet == 0) {
+		fprintf(stderr, "...finished\n");
 
-		
-		if (strlen(linebuffer) == 0) {
-			fprintf(stderr, "Line empty: %d\n", linecounter);
-			continue;
+		if (ipv6calc_verbose > 0) {
+			libipv6calc_db_wrapper_print_cache_statistics("");
 		};
-		
-		DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Got line: '%s'", linebuffer);
+	};
 
-		/* look for first token (should be IP address) */
-		charptr = strtok_r(linebuffer, " \t\n", ptrptr);
-		
-		if ( charptr == NULL ) {
-			fprintf(stderr, "Line contains no token: %d\n", linecounter);
-			continue;
+	return;
+};
+
+
+/*
+ * Worker thread: process filled blocks into own counters
+ */
+static void *lineparser_worker(void *arg) {
+	s_ipv6logstats_worker *workerp = (s_ipv6logstats_worker *) arg;
+	s_ipv6logstats_block *blockp;
+	char *linebuffer;
+	size_t length;
+	int l;
+
+	/* non-reentrant library functions use the database cache of this worker */
+	libipv6calc_db_wrapper_ctx_bind(&workerp->db_ctx);
+
+	while (1 == 1) {
+		pthread_mutex_lock(&queue.mutex);
+		while ((queue.next_work == queue.next_fill) && (queue.flag_eof == 0)) {
+			pthread_cond_wait(&queue.cond_filled, &queue.mutex);
 		};
 
-		if ( strlen(charptr) >=  LINEBUFFER) {
-			fprintf(stderr, "Line too strange: %d\n", linecounter);
-			continue;
+		if (queue.next_work == queue.next_fill) {
+			/* end of input and every published block consumed */
+			pthread_mutex_unlock(&queue.mutex);
+			break;
 		};
 
-		snprintf(token, sizeof(token), "%s", charptr);
-		
-		DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Token 1: '%s'", token);
+		blockp = &queue.block[queue.next_work % queue.slots];
+		blockp->state = IPV6LOGSTATS_BLOCK_STATE_WORK;
+		queue.next_work++;
+		pthread_mutex_unlock(&queue.mutex);
 
-		stat_inc(STATS_ALL);
+		DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Worker %d: block with %d lines starting at line %d", workerp->number, blockp->lines, blockp->linecounter);
 
-		/* get input type now */
-		inputtype = libipv6calc_autodetectinput(token);
+		linebuffer = blockp->in;
 
-		/* check for proper type */
-		if ((inputtype != FORMAT_ipv4addr) && (inputtype != FORMAT_ipv6addr)) {
-			/* fprintf(stderr, "Token 1 (address) is not an IP address in line: %d\n", linecounter); */
-			stat_inc(STATS_UNKNOWN);
-			continue;
+		for (l = 0; l < blockp->lines; l++) {
+			length = strlen(linebuffer);
+			lineprocess(linebuffer, blockp->linecounter + l, &workerp->chunk, &workerp->counters);
+			linebuffer += length + 1;
 		};
 
-		/* fill related structure */
-		switch (inputtype) {
-			case FORMAT_ipv6addr:
-				retval = addr_to_ipv6addrstruct(token, resultstring, sizeof(resultstring), &ipv6addr);
-				break;
+		pthread_mutex_lock(&queue.mutex);
+		blockp->state = IPV6LOGSTATS_BLOCK_STATE_FREE;
+		pthread_cond_signal(&queue.cond_free);
+		pthread_mutex_unlock(&queue.mutex);
+	};
 
-			case FORMAT_ipv4addr:
-				retval = addr_to_ipv4addrstruct(token, resultstring, sizeof(resultstring), &ipv4addr);
-				break;
+	/* process remaining chunk */
+	chunk_process(&workerp->chunk, &workerp->counters);
 
-			default:
-				retval = 0;
-				break;
+	libipv6calc_db_wrapper_ctx_bind(NULL);
+
+	return (NULL);
+};
+
+
+/*
+ * Worker thread: process whole input files into own counters (one file after the other, line numbers per file)
+ */
+static void *lineparser_worker_file(void *arg) {
+	s_ipv6logstats_worker *workerp = (s_ipv6logstats_worker *) arg;
+	s_ipv6calc_line_reader *readerp;
+	char linebuffer[LINEBUFFER];
+	const char *lineptr;
+	size_t length;
+	int linecounter, n;
+
+	/* non-reentrant library functions use the database cache of this worker */
+	libipv6calc_db_wrapper_ctx_bind(&workerp->db_ctx);
+
+	while (1 == 1) {
+		pthread_mutex_lock(&queue.mutex);
+		n = queue.next_file++;
+		pthread_mutex_unlock(&queue.mutex);
+
+		if (n >= input_files) {
+			/* no more input files */
+			break;
 		};
 
-		if (retval != 0 ) {
-			fprintf(stderr, "Problem during address parsing on line %d (skipped): %s\n", linecounter, resultstring);
+		DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Worker %d: input file %s", workerp->number, input_file[n]);
+
+		readerp = liblineio_reader_open(&input_file[n], 1, LIBLINEIO_BUFFER_SIZE, LINEBUFFER);
+		if (readerp == NULL) {
+			pthread_mutex_lock(&queue.mutex);
+			queue.flag_error = 1;
+			pthread_mutex_unlock(&queue.mutex);
 			continue;
 		};
 
-		/* catch compat/mapped */
-		switch (inputtype) {
-			case FORMAT_ipv6addr:
-				if ((ipv6addr.typeinfo & (IPV6_ADDR_COMPATv4 | IPV6_ADDR_MAPPED)) != 0) {
-					/* extract IPv4 address */
-					r = libipv6addr_get_included_ipv4addr(&ipv6addr, &ipv4addr, IPV6_ADDR_SELECT_IPV4_DEFAULT);
-					if (r != 0) {
-						continue;
-					};
-
-					// remap
-					inputtype = FORMAT_ipv4addr;
+		linecounter = 0;
 
-					// create text represenation
-					r = libipv4addr_ipv4addrstruct_to_string(&ipv4addr, token, sizeof(token), 0);
-				};
+		while (1 == 1) {
+			length = liblineio_reader_getline(readerp, &lineptr);
+			if (length == 0) {
+				/* end of input file */
 				break;
+			};
 
-			default:
-				// nothing to do
-				break;
-		};
+			/* copy line, tokenizer modifies it */
+			memcpy(linebuffer, lineptr, length);
+			linebuffer[length] = '\0';
 
-		/* get information and fill statistics */
-		switch (inputtype) {
-			case FORMAT_ipv6addr:
-				/* is IPv6 address */
-				stat_inc(STATS_IPV6);
+			linecounter++;
 
-				if ((ipv6addr.typeinfo & IPV6_ADDR_HAS_PUBLIC_IPV4) != 0) {
-					/* has public IPv4 address included */
+			lineprocess(linebuffer, linecounter, &workerp->chunk, &workerp->counters);
+		};
 
-					// get IPv4 address (in case of Teredo the client IP)
-					r = libipv6addr_get_included_ipv4addr(&ipv6addr, &ipv4addr, IPV6_ADDR_SELECT_IPV4_DEFAULT);
-					if (r != 0) {
-						continue;
-					};
+		if (readerp->flag_error != 0) {
+			pthread_mutex_lock(&queue.mutex);
+			queue.flag_error = 1;
+			pthread_mutex_unlock(&queue.mutex);
+		};
 
-					if (opt_simple != 1) {
-						cc_index = libipv4addr_cc_index_by_addr(&ipv4addr, NULL);
-						as_num32 = libipv4addr_as_num32_by_addr(&ipv4addr);
-						if (feature_cc == 1) {
-							stat_inc_country_code(cc_index, 4);
-						};
+		liblineio_reader_free(readerp);
+	};
 
-						if (feature_as == 1) {
-							stat_inc_asnum(as_num32, 4);
-						};
-					};
+	/* process remaining chunk */
+	chunk_process(&workerp->chunk, &workerp->counters);
 
-					registry = libipv4addr_registry_num_by_addr(&ipv4addr);
+	libipv6calc_db_wrapper_ctx_bind(NULL);
 
-					if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_6TO4) != 0) {
-						stat_registry_base = STATS_IPV6_6TO4_BASE;
+	return (NULL);
+};
 
-					} else if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_TEREDO) != 0) {
-						stat_registry_base = STATS_IPV6_TEREDO_BASE;
 
-					} else if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_NAT64) != 0) {
-						stat_registry_base = STATS_IPV6_NAT64_BASE;
-					};
+/*
+ * Line parser with threads: main thread reads blocks of lines, worker threads count them, counters are merged at the end
+ */
+static void lineparser_threads(void) {
+	s_ipv6logstats_worker *worker;
+	s_ipv6logstats_block *blockp;
+	const char *lineptr;
+	char prefix[NI_MAXHOST];
+	size_t length;
+	int linecounter = 0, t, n, eof = 0;
+
+	pthread_mutex_init(&queue.mutex, NULL);
+	pthread_cond_init(&queue.cond_free, NULL);
+	pthread_cond_init(&queue.cond_filled, NULL);
+	queue.slots = 2 * threads;
+	queue.next_fill = 0;
+	queue.next_work = 0;
+	queue.flag_eof = 0;
+	queue.next_file = 0;
+	queue.flag_error = 0;
+
+	if (input_files > 0) {
+		/* workers read the input files on their own, no blocks required */
+		queue.slots = 0;
+		queue.flag_eof = 1;
+		queue.block = NULL;
+		eof = 1;
+	} else {
+		queue.block = calloc((size_t) queue.slots, sizeof(s_ipv6logstats_block));
+	};
 
-					if (stat_registry_base > 0) {
-						switch (registry) {
-							case IPV4_ADDR_REGISTRY_IANA:
-								stat_inc(stat_registry_base + REGISTRY_IANA);
-								break;
-							case IPV4_ADDR_REGISTRY_APNIC:
-								stat_inc(stat_registry_base + REGISTRY_APNIC);
-								break;
-							case IPV4_ADDR_REGISTRY_ARIN:
-								stat_inc(stat_registry_base + REGISTRY_ARIN);
-								break;
-							case IPV4_ADDR_REGISTRY_RIPENCC:
-								stat_inc(stat_registry_base + REGISTRY_RIPENCC);
-								break;
-							case IPV4_ADDR_REGISTRY_LACNIC:
-								stat_inc(stat_registry_base + REGISTRY_LACNIC);
-								break;
-							case IPV4_ADDR_REGISTRY_AFRINIC:
-								stat_inc(stat_registry_base + REGISTRY_AFRINIC);
-								break;
-							case IPV4_ADDR_REGISTRY_RESERVED:
-								stat_inc(stat_registry_base + REGISTRY_RESERVED);
-								break;
-							default:
-								stat_inc(stat_registry_base + REGISTRY_UNKNOWN);
-								if (opt_unknown == 1) {
-									fprintf(stderr, "Unknown address: %s\n", token);
-								};
-								break;
-						};
-					} else {
-						if (opt_unknown == 1) {
-							fprintf(stderr, "Unknown address: %s\n", token);
-						};
-					};
-				} else {
-					if (opt_simple != 1) {
-						cc_index = libipv6addr_cc_index_by_addr(&ipv6addr, NULL);
-						as_num32 = libipv6addr_as_num32_by_addr(&ipv6addr);
+	worker = calloc((size_t) threads, sizeof(s_ipv6logstats_worker));
+	if (((queue.slots > 0) && (queue.block == NULL)) || (worker == NULL)) {
+		ERRORPRINT_WA("cannot allocate memory for %d threads", threads);
+		exit(EXIT_FAILURE);
+	};
 
-						if (feature_cc == 1) {
-							/* country code */
-							stat_inc_country_code(cc_index, 6);
-						};
+	for (n = 0; n < queue.slots; n++) {
+		queue.block[n].in = malloc(IPV6LOGSTATS_BLOCK_SIZE);
+		if (queue.block[n].in == NULL) {
+			ERRORPRINT_WA("cannot allocate memory for block buffers: %d", queue.slots);
+			exit(EXIT_FAILURE);
+		};
+	};
 
-						if (feature_as == 1) {
-							/* asnum */
-							stat_inc_asnum(as_num32, 6);
-						};
-					};
+	for (t = 0; t < threads; t++) {
+		worker[t].number = t;
 
-					registry = libipv6addr_registry_num_by_addr(&ipv6addr);
+		/* also initializes database sources before threads are running */
+		if (libipv6calc_db_wrapper_ctx_init(&worker[t].db_ctx) != 0) {
+			exit(EXIT_FAILURE);
+		};
 
-					switch (registry) {
-						case IPV6_ADDR_REGISTRY_6BONE:
-							stat_inc(STATS_IPV6_6BONE);
-							break;
-						case IPV6_ADDR_REGISTRY_IANA:
-							stat_inc(STATS_IPV6_IANA);
-							break;
-						case IPV6_ADDR_REGISTRY_APNIC:
-							stat_inc(STATS_IPV6_APNIC);
-							break;
-						case IPV6_ADDR_REGISTRY_ARIN:
-							stat_inc(STATS_IPV6_ARIN);
-							break;
-						case IPV6_ADDR_REGISTRY_RIPENCC:
-							stat_inc(STATS_IPV6_RIPENCC);
-							break;
-						case IPV6_ADDR_REGISTRY_LACNIC:
-							stat_inc(STATS_IPV6_LACNIC);
-							break;
-						case IPV6_ADDR_REGISTRY_AFRINIC:
-							stat_inc(STATS_IPV6_AFRINIC);
-							break;
-						case IPV6_ADDR_REGISTRY_RESERVED:
-							stat_inc(STATS_IPV6_RESERVED);
-							break;
-						default:
-							stat_inc(STATS_IPV6_UNKNOWN);
-							if (opt_unknown == 1) {
-								fprintf(stderr, "Unknown address: %s\n", token);
-							};
-							break;
-					};
+		if (pthread_create(&worker[t].thread, NULL, (input_files > 0) ? lineparser_worker_file : lineparser_worker, &worker[t]) != 0) {
+			ERRORPRINT_WA("cannot create worker thread: %d", t);
+			exit(EXIT_FAILURE);
+		};
+	};
 
-					if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_IID) == IPV6_NEW_ADDR_IID) {
-						if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_IID_RANDOM) != 0) {
-							stat_inc(STATS_IPV6_IID_RANDOM);
-						} else if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_IID_ISATAP) != 0) {
-							stat_inc(STATS_IPV6_IID_ISATAP);
-						} else if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_IID_LOCAL) != 0) {
-							stat_inc(STATS_IPV6_IID_MANUAL);
-						} else if ((ipv6addr.typeinfo & IPV6_NEW_ADDR_IID_GLOBAL) != 0) {
-							stat_inc(STATS_IPV6_IID_GLOBAL);
-						} else {
-							stat_inc(STATS_IPV6_IID_UNKNOWN);
-						};
-					};
-				};
-				
-				break;
+	if (ipv6calc_quiet == 0) {
+		if (input_files > 0) {
+			fprintf(stderr, "Expecting log lines from input files: %d (threads: %d, one file per thread)\n", input_files, threads);
+		} else {
+			fprintf(stderr, "Expecting log lines on stdin (threads: %d)\n", threads);
+		};
+	};
 
-			case FORMAT_ipv4addr:
-				/* is IPv4 address */
-				stat_inc(STATS_IPV4);
+	while (eof == 0) {
+		/* wait for free block slot */
+		pthread_mutex_lock(&queue.mutex);
+		blockp = &queue.block[queue.next_fill % queue.slots];
+		while (blockp->state != IPV6LOGSTATS_BLOCK_STATE_FREE) {
+			pthread_cond_wait(&queue.cond_free, &queue.mutex);
+		};
+		pthread_mutex_unlock(&queue.mutex);
+
+		/* read lines (same line splitting as single-threaded) until block is full */
+		blockp->linecounter = linecounter + 1;
+		blockp->lines = 0;
+		blockp->in_used = 0;
+
+		while (blockp->in_used + LINEBUFFER <= IPV6LOGSTATS_BLOCK_SIZE) {
+			length = liblineio_reader_getline(input, &lineptr);
+			if (length == 0) {
+				/* end of input, flagged together with publishing the last block */
+				eof = 1;
+				break;
+			};
 
-				if (opt_simple != 1) {
-					cc_index = libipv4addr_cc_index_by_addr(&ipv4addr, NULL);
-					as_num32 = libipv4addr_as_num32_by_addr(&ipv4addr);
+			linecounter++;
 
-					stat_inc_country_code(cc_index, 4);
-					stat_inc_asnum(as_num32, 4);
+			if (linecounter == 1) {
+				if ((ipv6calc_quiet == 0) && (input_files == 0)) {
+					fprintf(stderr, "Ok, proceeding stdin...\n");
 				};
+			};
 
-				registry = libipv4addr_registry_num_by_addr(&ipv4addr);
+			/* copy line terminated by '\0' (a '\0' inside ends it like in single-threaded mode) */
+			memcpy(blockp->in + blockp->in_used, lineptr, length);
+			blockp->in[blockp->in_used + length] = '\0';
+			blockp->in_used += strlen(blockp->in + blockp->in_used) + 1;
+			blockp->lines++;
+		};
 
-				switch (registry) {
-					case IPV4_ADDR_REGISTRY_IANA:
-						stat_inc(STATS_IPV4_IANA);
-						break;
-					case IPV4_ADDR_REGISTRY_APNIC:
-						stat_inc(STATS_IPV4_APNIC);
-						break;
-					case IPV4_ADDR_REGISTRY_ARIN:
-						stat_inc(STATS_IPV4_ARIN);
-						break;
-					case IPV4_ADDR_REGISTRY_RIPENCC:
-						stat_inc(STATS_IPV4_RIPENCC);
-						break;
-					case IPV4_ADDR_REGISTRY_LACNIC:
-						stat_inc(STATS_IPV4_LACNIC);
-						break;
-					case IPV4_ADDR_REGISTRY_AFRINIC:
-						stat_inc(STATS_IPV4_AFRINIC);
-						break;
-					case IPV4_ADDR_REGISTRY_RESERVED:
-						stat_inc(STATS_IPV4_RESERVED);
-						break;
-					default:
-						stat_inc(STATS_IPV4_UNKNOWN);
-						if (opt_unknown == 1) {
-							fprintf(stderr, "Unknown address: %s\n", token);
-						};
-						break;
-				};
-				
-				break;
+		pthread_mutex_lock(&queue.mutex);
+		if (blockp->lines > 0) {
+			blockp->state = IPV6LOGSTATS_BLOCK_STATE_FILLED;
+			queue.next_fill++;
 		};
+		queue.flag_eof = eof;
+		pthread_cond_broadcast(&queue.cond_filled);
+		pthread_mutex_unlock(&queue.mutex);
 	};
 
-	if (opt_onlyheader == 0) {
-		if (ipv6calc_quiet == 0) {
-			fprintf(stderr, "...finished\n");
+	for (t = 0; t < threads; t++) {
+		pthread_join(worker[t].thread, NULL);
+		stat_merge(&counters, &worker[t].counters);
+	};
+
+	if (ipv6calc_quiet == 0) {
+		fprintf(stderr, "...finished\n");
+
+		if (ipv6calc_verbose > 0) {
+			for (t = 0; t < threads; t++) {
+				snprintf(prefix, sizeof(prefix), "Thread %d: ", t);
+				libipv6calc_db_wrapper_ctx_print_cache_statistics(&worker[t].db_ctx, prefix);
+			};
 		};
 	};
 
+	for (t = 0; t < threads; t++) {
+		libipv6calc_db_wrapper_ctx_cleanup(&worker[t].db_ctx);
+	};
+
+	for (n = 0; n < queue.slots; n++) {
+		free(queue.block[n].in);
+	};
+	free(queue.block);
+	free(worker);
+
+	pthread_cond_destroy(&queue.cond_filled);
+	pthread_cond_destroy(&queue.cond_free);
+	pthread_mutex_destroy(&queue.mutex);
+
+	return;
+};
+
+
+/*
+ * Print statistics
+ */
+static void statistics_print(void) {
+	char resultstring[LINEBUFFER];
+	int i;
+
+	time_t timer;
+	struct tm* tm_info;
+
+	int index;
+	long unsigned int c_all, c_ipv4, c_ipv6;
+
+	int column_offset = 1;
+
 	/* print result */
 	if (opt_printdirection == 0) {
 		/* print in rows */
@@ -753,45 +1055,45 @@ static void lineparser(void) {
 		};
 
 		for (i = 0; i < MAXENTRIES_ARRAY(ipv6logstats_statentries); i++) {
-			printf("%-20s %lu\n", ipv6logstats_statentries[i].token, ipv6logstats_statentries[i].counter);
+			printf("%-20s %lu\n", ipv6logstats_statentries[i].token, counters.stat[i]);
 		};
 
 		if (feature_cc == 1) {
 			/* country_code / proto */
 			for (index = 0; index < COUNTRYCODE_INDEX_MAX; index++) {
-				if (counter_country[index] > 0) {
+				if (counters.country[index] > 0) {
 					DEBUGPRINT_WA(DEBUG_ipv6logstats_summary, "CC-Index: %d", index);
 
 					libipv6calc_db_wrapper_country_code_by_cc_index(resultstring, sizeof(resultstring), index);
 
-					printf("*3*CC-code-proto/%s/ALL   %lu\n", resultstring, counter_country[index]);
-					printf("*3*CC-code-proto/%s/IPv4  %lu\n", resultstring, counter_country_ipv4[index]);
-					printf("*3*CC-code-proto/%s/IPv6  %lu\n", resultstring, counter_country_ipv6[index]);
-					printf("*3*CC-code-proto-list/%s  %lu %lu %lu\n", resultstring, counter_country[index], counter_country_ipv4[index], counter_country_ipv6[index]);
+					printf("*3*CC-code-proto/%s/ALL   %lu\n", resultstring, counters.country[index]);
+					printf("*3*CC-code-proto/%s/IPv4  %lu\n", resultstring, counters.country_ipv4[index]);
+					printf("*3*CC-code-proto/%s/IPv6  %lu\n", resultstring, counters.country_ipv6[index]);
+					printf("*3*CC-code-proto-list/%s  %lu %lu %lu\n", resultstring, counters.country[index], counters.country_ipv4[index], counters.country_ipv6[index]);
 				};
 			};
 
 			/* proto / country_code */
 			c_all = 0; c_ipv4 = 0; c_ipv6 = 0;
 			for (index = 0; index < COUNTRYCODE_INDEX_MAX; index++) {
-				if (counter_country[index] > 0) {
+				if (counters.country[index] > 0) {
 					libipv6calc_db_wrapper_country_code_by_cc_index(resultstring, sizeof(resultstring), index);
-					printf("*3*CC-proto-code/ALL/%s   %lu\n", resultstring, counter_country[index]);
-					c_all += counter_country[index];
+					printf("*3*CC-proto-code/ALL/%s   %lu\n", resultstring, counters.country[index]);
+					c_all += counters.country[index];
 				};
 			};
 			for (index = 0; index < COUNTRYCODE_INDEX_MAX; index++) {
-				if (counter_country_ipv4[index] > 0) {
+				if (counters.country_ipv4[index] > 0) {
 					libipv6calc_db_wrapper_country_code_by_cc_index(resultstring, sizeof(resultstring), index);
-					printf("*3*CC-proto-code/IPv4/%s  %lu\n", resultstring, counter_country_ipv4[index]);
-					c_ipv4 += counter_country_ipv4[index];
+					printf("*3*CC-proto-code/IPv4/%s  %lu\n", resultstring, counters.country_ipv4[index]);
+					c_ipv4 += counters.country_ipv4[index];
 				};
 			};
 			for (index = 0; index < COUNTRYCODE_INDEX_MAX; index++) {
-				if (counter_country_ipv6[index] > 0) {
+				if (counters.country_ipv6[index] > 0) {
 					libipv6calc_db_wrapper_country_code_by_cc_index(resultstring, sizeof(resultstring), index);
-					printf("*3*CC-proto-code/IPv6/%s  %lu\n", resultstring, counter_country_ipv6[index]);
-					c_ipv6 += counter_country_ipv6[index];
+					printf("*3*CC-proto-code/IPv6/%s  %lu\n", resultstring, counters.country_ipv6[index]);
+					c_ipv6 += counters.country_ipv6[index];
 				};
 			};
 
@@ -803,32 +1105,32 @@ static void lineparser(void) {
 		if (feature_as == 1) {
 			/* ASN number / proto */
 			for (index = 0; index < ASNUM_MAX; index++) {
-				if (counter_asn[index] > 0) {
-					printf("*3*AS-num-proto/%d/ALL   %lu\n", index, counter_asn[index]);
-					printf("*3*AS-num-proto/%d/IPv4  %lu\n", index, counter_asn_ipv4[index]);
-					printf("*3*AS-num-proto/%d/IPv6  %lu\n", index, counter_asn_ipv6[index]);
-					printf("*3*AS-num-proto-list/%d  %lu %lu %lu\n", index, counter_asn[index], counter_asn_ipv4[index], counter_asn_ipv6[index]);
+				if (counters.asn[index] > 0) {
+					printf("*3*AS-num-proto/%d/ALL   %lu\n", index, counters.asn[index]);
+					printf("*3*AS-num-proto/%d/IPv4  %lu\n", index, counters.asn_ipv4[index]);
+					printf("*3*AS-num-proto/%d/IPv6  %lu\n", index, counters.asn_ipv6[index]);
+					printf("*3*AS-num-proto-list/%d  %lu %lu %lu\n", index, counters.asn[index], counters.asn_ipv4[index], counters.asn_ipv6[index]);
 				};
 			};
 
 			/* ASN proto / number */
 			c_all = 0; c_ipv4 = 0; c_ipv6 = 0;
 			for (index = 0; index < ASNUM_MAX; index++) {
-				if (counter_asn[index] > 0) {
-					printf("*3*AS-proto-num/ALL/%d   %lu\n", index, counter_asn[index]);
-					c_all += counter_asn[index];
+				if (counters.asn[index] > 0) {
+					printf("*3*AS-proto-num/ALL/%d   %lu\n", index, counters.asn[index]);
+					c_all += counters.asn[index];
 				};
 			};
 			for (index = 0; index < ASNUM_MAX; index++) {
-				if (counter_asn_ipv4[index] > 0) {
-					printf("*3*AS-proto-num/IPv4/%d  %lu\n", index, counter_asn_ipv4[index]);
-					c_ipv4 += counter_asn_ipv4[index];
+				if (counters.asn_ipv4[index] > 0) {
+					printf("*3*AS-proto-num/IPv4/%d  %lu\n", index, counters.asn_ipv4[index]);
+					c_ipv4 += counters.asn_ipv4[index];
 				};
 			};
 			for (index = 0; index < ASNUM_MAX; index++) {
-				if (counter_asn_ipv6[index] > 0) {
-					printf("*3*AS-proto-num/IPv6/%d  %lu\n", index, counter_asn_ipv6[index]);
-					c_ipv6 += counter_asn_ipv6[index];
+				if (counters.asn_ipv6[index] > 0) {
+					printf("*3*AS-proto-num/IPv6/%d  %lu\n", index, counters.asn_ipv6[index]);
+					c_ipv6 += counters.asn_ipv6[index];
 				};
 			};
 
@@ -871,7 +1173,7 @@ static void lineparser(void) {
 				if (i > 0) {
 					printf(" ");
 				};
-				printf("%lu", ipv6logstats_statentries[i].counter);
+				printf("%lu", counters.stat[i]);
 			};
 
 			printf(" #%d.%d\n", STATS_VERSION_MAJOR, STATS_VERSION_MINOR);
@@ -924,3 +1226,208 @@ static void lineparser(void) {
 
 	return;
 };
+
+
+
+
+/*
+ * Batch lookup of database information for collected chunk and fill statistics
+ */
+static void chunk_process(s_ipv6logstats_chunk *chunkp, s_ipv6logstats_counters *countersp) {
+	s_ipv6logstats_chunk_entry *entry;
+	int registry, stat_registry_base, i;
+
+	if (chunkp->count == 0) {
+		return;
+	};
+
+	DEBUGPRINT_WA(DEBUG_ipv6logstats_processing, "Process chunk: entries=%d IPv4=%d IPv6=%d", chunkp->count, chunkp->count_ipv4, chunkp->count_ipv6);
+
+	/* database lookups */
+	libipv4addr_db_batch_by_addr(chunkp->ipv4addr, chunkp->count_ipv4, (opt_simple != 1) ? chunkp->cc_index_ipv4 : NULL, (opt_simple != 1) ? chunkp->as_num32_ipv4 : NULL, chunkp->registry_ipv4);
+	libipv6addr_db_batch_by_addr(chunkp->ipv6addr, chunkp->count_ipv6, (opt_simple != 1) ? chunkp->cc_index_ipv6 : NULL, (opt_simple != 1) ? chunkp->as_num32_ipv6 : NULL, chunkp->registry_ipv6);
+
+	for (i = 0; i < chunkp->count; i++) {
+		entry = &chunkp->entry[i];
+
+		stat_registry_base = 0;
+
+	/* fill statistics */
+	switch (entry->inputtype) {
+		case FORMAT_ipv6addr:
+			/* is IPv6 address */
+			stat_inc(countersp, STATS_IPV6);
+
+			if ((entry->typeinfo & IPV6_ADDR_HAS_PUBLIC_IPV4) != 0) {
+				/* has public IPv4 address included */
+				if (opt_simple != 1) {
+					if (feature_cc == 1) {
+						stat_inc_country_code(countersp, chunkp->cc_index_ipv4[entry->index], 4);
+					};
+
+					if (feature_as == 1) {
+						stat_inc_asnum(countersp, chunkp->as_num32_ipv4[entry->index], 4);
+					};
+				};
+
+				registry = chunkp->registry_ipv4[entry->index];
+
+				if ((entry->typeinfo & IPV6_NEW_ADDR_6TO4) != 0) {
+					stat_registry_base = STATS_IPV6_6TO4_BASE;
+
+				} else if ((entry->typeinfo & IPV6_NEW_ADDR_TEREDO) != 0) {
+					stat_registry_base = STATS_IPV6_TEREDO_BASE;
+
+				} else if ((entry->typeinfo & IPV6_NEW_ADDR_NAT64) != 0) {
+					stat_registry_base = STATS_IPV6_NAT64_BASE;
+				};
+
+				if (stat_registry_base > 0) {
+					switch (registry) {
+						case IPV4_ADDR_REGISTRY_IANA:
+							stat_inc(countersp, stat_registry_base + REGISTRY_IANA);
+							break;
+						case IPV4_ADDR_REGISTRY_APNIC:
+							stat_inc(countersp, stat_registry_base + REGISTRY_APNIC);
+							break;
+						case IPV4_ADDR_REGISTRY_ARIN:
+							stat_inc(countersp, stat_registry_base + REGISTRY_ARIN);
+							break;
+						case IPV4_ADDR_REGISTRY_RIPENCC:
+							stat_inc(countersp, stat_registry_base + REGISTRY_RIPENCC);
+							break;
+						case IPV4_ADDR_REGISTRY_LACNIC:
+							stat_inc(countersp, stat_registry_base + REGISTRY_LACNIC);
+							break;
+						case IPV4_ADDR_REGISTRY_AFRINIC:
+							stat_inc(countersp, stat_registry_base + REGISTRY_AFRINIC);
+							break;
+						case IPV4_ADDR_REGISTRY_RESERVED:
+							stat_inc(countersp, stat_registry_base + REGISTRY_RESERVED);
+							break;
+						default:
+							stat_inc(countersp, stat_registry_base + REGISTRY_UNKNOWN);
+							if (opt_unknown == 1) {
+								fprintf(stderr, "Unknown address: %s\n", entry->token);
+							};
+							break;
+					};
+				} else {
+					if (opt_unknown == 1) {
+						fprintf(stderr, "Unknown address: %s\n", entry->token);
+					};
+				};
+			} else {
+				if (opt_simple != 1) {
+					if (feature_cc == 1) {
+						/* country code */
+						stat_inc_country_code(countersp, chunkp->cc_index_ipv6[entry->index], 6);
+					};
+
+					if (feature_as == 1) {
+						/* asnum */
+						stat_inc_asnum(countersp, chunkp->as_num32_ipv6[entry->index], 6);
+					};
+				};
+
+				registry = chunkp->registry_ipv6[entry->index];
+
+				switch (registry) {
+					case IPV6_ADDR_REGISTRY_6BONE:
+						stat_inc(countersp, STATS_IPV6_6BONE);
+						break;
+					case IPV6_ADDR_REGISTRY_IANA:
+						stat_inc(countersp, STATS_IPV6_IANA);
+						break;
+					case IPV6_ADDR_REGISTRY_APNIC:
+						stat_inc(countersp, STATS_IPV6_APNIC);
+						break;
+					case IPV6_ADDR_REGISTRY_ARIN:
+						stat_inc(countersp, STATS_IPV6_ARIN);
+						break;
+					case IPV6_ADDR_REGISTRY_RIPENCC:
+						stat_inc(countersp, STATS_IPV6_RIPENCC);
+						break;
+					case IPV6_ADDR_REGISTRY_LACNIC:
+						stat_inc(countersp, STATS_IPV6_LACNIC);
+						break;
+					case IPV6_ADDR_REGISTRY_AFRINIC:
+						stat_inc(countersp, STATS_IPV6_AFRINIC);
+						break;
+					case IPV6_ADDR_REGISTRY_RESERVED:
+						stat_inc(countersp, STATS_IPV6_RESERVED);
+						break;
+					default:
+						stat_inc(countersp, STATS_IPV6_UNKNOWN);
+						if (opt_unknown == 1) {
+							fprintf(stderr, "Unknown address: %s\n", entry->token);
+						};
+						break;
+				};
+
+				if ((entry->typeinfo & IPV6_NEW_ADDR_IID) == IPV6_NEW_ADDR_IID) {
+					if ((entry->typeinfo & IPV6_NEW_ADDR_IID_RANDOM) != 0) {
+						stat_inc(countersp, STATS_IPV6_IID_RANDOM);
+					} else if ((entry->typeinfo & IPV6_NEW_ADDR_IID_ISATAP) != 0) {
+						stat_inc(countersp, STATS_IPV6_IID_ISATAP);
+					} else if ((entry->typeinfo & IPV6_NEW_ADDR_IID_LOCAL) != 0) {
+						stat_inc(countersp, STATS_IPV6_IID_MANUAL);
+					} else if ((entry->typeinfo & IPV6_NEW_ADDR_IID_GLOBAL) != 0) {
+						stat_inc(countersp, STATS_IPV6_IID_GLOBAL);
+					} else {
+						stat_inc(countersp, STATS_IPV6_IID_UNKNOWN);
+					};
+				};
+			};
+			
+			break;
+
+		case FORMAT_ipv4addr:
+			/* is IPv4 address */
+			stat_inc(countersp, STATS_IPV4);
+
+			if (opt_simple != 1) {
+				stat_inc_country_code(countersp, chunkp->cc_index_ipv4[entry->index], 4);
+				stat_inc_asnum(countersp, chunkp->as_num32_ipv4[entry->index], 4);
+			};
+
+			registry = chunkp->registry_ipv4[entry->index];
+
+			switch (registry) {
+				case IPV4_ADDR_REGISTRY_IANA:
+					stat_inc(countersp, STATS_IPV4_IANA);
+					break;
+				case IPV4_ADDR_REGISTRY_APNIC:
+					stat_inc(countersp, STATS_IPV4_APNIC);
+					break;
+				case IPV4_ADDR_REGISTRY_ARIN:
+					stat_inc(countersp, STATS_IPV4_ARIN);
+					break;
+				case IPV4_ADDR_REGISTRY_RIPENCC:
+					stat_inc(countersp, STATS_IPV4_RIPENCC);
+					break;
+				case IPV4_ADDR_REGISTRY_LACNIC:
+					stat_inc(countersp, STATS_IPV4_LACNIC);
+					break;
+				case IPV4_ADDR_REGISTRY_AFRINIC:
+					stat_inc(countersp, STATS_IPV4_AFRINIC);
+					break;
+				case IPV4_ADDR_REGISTRY_RESERVED:
+					stat_inc(countersp, STATS_IPV4_RESERVED);
+					break;
+				default:
+					stat_inc(countersp, STATS_IPV4_UNKNOWN);
+					if (opt_unknown == 1) {
+						fprintf(stderr, "Unknown address: %s\n", entry->token);
+					};
+					break;
+			};
+			
+			break;
+	};
+	};
+
+	chunkp->count = 0;
+	chunkp->count_ipv4 = 0;
+	chunkp->count_ipv6 = 0;
+};
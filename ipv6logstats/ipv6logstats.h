@@ -51,6 +51,10 @@
 #define STATS_IPV6_IID_ISATAP		0x103
 #define STATS_IPV6_IID_UNKNOWN		0x10f
 
+/* threads */
+#define IPV6LOGSTATS_THREADS_MAX	64
+#define IPV6LOGSTATS_BLOCK_SIZE		(1024 * 1024)	// input bytes per block
+
 #define DEBUG_ipv6logstats_general	0x00000001l
 #define DEBUG_ipv6logstats_summary	0x00000002l
 #define DEBUG_ipv6logstats_processing	0x00000004l
@@ -58,7 +62,6 @@
 /* labels statistic numbers */
 typedef struct {
 	const int	number;
-	long unsigned int counter;
 	const char *token;
 } stat_entries;
 
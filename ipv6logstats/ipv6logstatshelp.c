@@ -74,7 +74,7 @@ void ipv6logstats_printhelp(void) {
 	fprintf(stderr, "\n");
 
 	fprintf(stderr, " Takes web server log data (or any other data which has IPv4/v6 address in first column)\n");
-	fprintf(stderr, "   from stdin and print statistics table/list (depending on option) to stdout\n");
+	fprintf(stderr, "   from stdin (or input files) and print statistics table/list (depending on option) to stdout\n");
 
 	printhelp_common(IPV6CALC_HELP_ALL);
 
@@ -85,6 +85,9 @@ void ipv6logstats_printhelp(void) {
 	fprintf(stderr, "  [-o|--onlyheader]          : print only header in columns mode (1)\n");
 	fprintf(stderr, "  [-p|--prefix <token>]      : print token as prefix (1)\n");
 	fprintf(stderr, "  [-s|--simple]              : disable extended statistic (CountryCode/ASN)\n");
+	fprintf(stderr, "  [-T|--threads <value>]     : amount of worker threads (1-%d)\n", IPV6LOGSTATS_THREADS_MAX);
+	fprintf(stderr, "                               not used with GeoIP/IP2Location (no concurrent lookups)\n");
+	fprintf(stderr, "  [-i|--input <file>]        : read from file instead of stdin (repeatable)\n");
 	fprintf(stderr, "\n");
 	fprintf(stderr, " (1) unsupported for CountryCode & ASN statistics\n");
 	fprintf(stderr, "\n");
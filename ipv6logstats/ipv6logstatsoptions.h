@@ -20,7 +20,7 @@
 /* Options */
 
 /* define short options */
-static char *ipv6logstats_shortopts = "vh?uNosncp:w:";
+static char *ipv6logstats_shortopts = "vh?uNosncp:w:T:i:";
 
 /* define long options */
 static struct option ipv6logstats_longopts[] = {
@@ -38,6 +38,8 @@ static struct option ipv6logstats_longopts[] = {
 	{"simple"	, 0, 0, (int) 's'},
 	{"write"	, 1, 0, (int) 'O'},
 	{"column-numbers", 1, 0, (int) 'N'},
+	{"threads"	, 1, 0, (int) 'T'},
+	{"input"		, 1, 0, (int) 'i'},
 };                
 
 #endif
@@ -249,4 +249,27 @@ if [ $result -ne 0 ]; then
 fi
 echo "INFO  : test scenario with huge amount of addresses: OK"
 
+echo "INFO  : test scenario with huge amount of addresses and threads..."
+output="`testscenario_hugelist ipv4 | ./ipv6logstats -q 2>/dev/null | grep -v "Time:"`"
+output_threads="`testscenario_hugelist ipv4 | ./ipv6logstats -q -T 3 2>/dev/null | grep -v "Time:"`"
+if [ "$output" != "$output_threads" ]; then
+	echo "ERROR : output with threads differs"
+	exit 1
+fi
+echo "INFO  : test scenario with huge amount of addresses and threads: OK"
+
+echo "INFO  : test scenario with huge amount of addresses from input files..."
+tmpfile=$(mktemp /tmp/test_ipv6logstats.XXXXXX) || exit 1
+testscenario_hugelist ipv4 >$tmpfile
+for options in "-i $tmpfile" "-i $tmpfile -i /dev/null -T 3"; do
+	output_files="`./ipv6logstats -q $options 2>/dev/null | grep -v "Time:"`"
+	if [ "$output" != "$output_files" ]; then
+		echo "ERROR : output with input files differs: $options"
+		rm -f $tmpfile
+		exit 1
+	fi
+done
+rm -f $tmpfile
+echo "INFO  : test scenario with huge amount of addresses from input files: OK"
+
 echo "All tests were successfully done!"
@@ -70,10 +70,12 @@
 #define DB_ip2location_comm_to_lite_switch_min_delta_months		0x0020110
 #define DB_ip2location_only_type	0x0020120
 #define DB_ip2location_allow_softlinks	0x0020130
+#define DB_ip2location_mode		0x0020140
 
 #define DB_geoip_disable		0x0021000
 #define DB_geoip_dir			0x0021050
 #define DB_geoip_lib			0x0021060
+#define DB_geoip_mode			0x0021070
 
 #define DB_dbip_disable			0x0022000
 #define DB_dbip_dir			0x0022050
@@ -84,7 +86,11 @@
 #define DB_external_dir			0x0023050
 
 #define DB_builtin_disable		0x0024000
+#define DB_builtin_lookup_generic	0x0024010
 
+#define DB_common_init_eager		0x002ffd0
+#define DB_common_cache_size		0x002ffe0
+#define DB_common_preload		0x002ffe8
 #define DB_common_priorization		0x002fff0
 
 
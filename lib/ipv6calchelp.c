@@ -327,6 +327,7 @@ void printhelp_common(const uint32_t help_features) {
 #endif
 		fprintf(stderr, "  [--db-ip2location-only-type <TYPE>]: IP2Location database only selected type (1-%d)\n", IP2LOCATION_DB_MAX);
 		fprintf(stderr, "  [--db-ip2location-allow-softlinks] : IP2Location database softlinks allowed\n");
+		fprintf(stderr, "  [--db-ip2location-mode <mode>    ] : IP2Location database access mode: file|cache|shared (default: %s)\n", libipv6calc_db_wrapper_IP2Location_access_mode_name(ip2location_db_access_mode));
 		fprintf(stderr, "     by default they are ignored because it is hard to autodetect COMM/LITE/SAMPLE\n");
 		fprintf(stderr, "  [--db-ip2location-lite-to-sample-autoswitch-max-delta-months <MONTHS>]:\n");
 		fprintf(stderr, "     autoswitch from LITE to SAMPLE databases if possible and delta is not more than %d months (0=disabled)\n", ip2location_db_lite_to_sample_autoswitch_max_delta_months);
@@ -341,6 +342,7 @@ void printhelp_common(const uint32_t help_features) {
 		fprintf(stderr, "  [--disable-geoip                 ] : GeoIP support disabled\n");
 		fprintf(stderr, "  [--db-geoip-disable              ] : GeoIP support disabled\n");
 		fprintf(stderr, "  [--db-geoip-dir       <directory>] : GeoIP database directory (default: %s)\n", geoip_db_dir);
+		fprintf(stderr, "  [--db-geoip-mode      <mode>     ] : GeoIP database open mode: standard|memory|mmap|index (default: %s)\n", libipv6calc_db_wrapper_GeoIP_open_mode_name());
 #ifdef SUPPORT_GEOIP_DYN
 		fprintf(stderr, "  [--db-geoip-lib       <file>     ] : GeoIP library file (default: %s)\n", geoip_lib_file);
 #endif
@@ -373,8 +375,16 @@ void printhelp_common(const uint32_t help_features) {
 		fprintf(stderr, "\n");
 		fprintf(stderr, "  [--disable-builtin               ] : BuiltIn support disabled\n");
 		fprintf(stderr, "  [--db-builtin-disable            ] : BuiltIn support disabled\n");
+		fprintf(stderr, "  [--db-builtin-lookup-generic     ] : BuiltIn lookups using generic functions only (no compiled index)\n");
 #endif
 
+		fprintf(stderr, "\n");
+		fprintf(stderr, "  [--db-cache-size        <entries>] : Database result range cache size per type and protocol (0=disabled, also anonymization prefix cache, default: %d)\n", IPV6CALC_DB_CACHE_SIZE_DEFAULT);
+#if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP
+		fprintf(stderr, "  [--db-preload                    ] : External/DBIP (Berkeley DB) data loaded into memory during init\n");
+#endif
+		fprintf(stderr, "  [--db-init-eager                 ] : Database sources initialized on startup (default: on first use)\n");
+
 #if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP || defined SUPPORT_GEOIP || SUPPORT_IP2LOCATION
 		fprintf(stderr, "\n");
 		fprintf(stderr, "  [--db-priorization <entry1>[:...]] : Database priorization order list (overwrites default)\n");
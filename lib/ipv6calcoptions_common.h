@@ -49,6 +49,7 @@ static struct option ipv6calc_longopts_ip2location[] = {
 	{"db-ip2location-comm-to-lite-switch-min-delta-months", 1, NULL, DB_ip2location_comm_to_lite_switch_min_delta_months },
 	{"db-ip2location-only-type", 1, NULL, DB_ip2location_only_type },
 	{"db-ip2location-allow-softlinks", 0, NULL, DB_ip2location_allow_softlinks },
+	{"db-ip2location-mode"         , 1, NULL, DB_ip2location_mode    },
 
 #ifdef SUPPORT_IP2LOCATION_DYN
 	{"db-ip2location-lib"          , 1, NULL, DB_ip2location_lib     },
@@ -72,6 +73,7 @@ static struct option ipv6calc_longopts_geoip[] = {
 	{"disable-geoip"               , 0, NULL, DB_geoip_disable       },
 	{"db-geoip-disable"            , 0, NULL, DB_geoip_disable       },
 	{"db-geoip-dir"                , 1, NULL, DB_geoip_dir           },
+	{"db-geoip-mode"               , 1, NULL, DB_geoip_mode          },
 #ifdef SUPPORT_GEOIP_DYN
 	{"db-geoip-lib"                , 1, NULL, DB_geoip_lib           },
 #endif // SUPPORT_GEOIP_DYN
@@ -106,9 +108,18 @@ static char *ipv6calc_shortopts_builtin = "";
 static struct option ipv6calc_longopts_builtin[] = {
 	{"disable-builtin"             , 0, NULL, DB_builtin_disable    },
 	{"db-builtin-disable"          , 0, NULL, DB_builtin_disable    },
+	{"db-builtin-lookup-generic"   , 0, NULL, DB_builtin_lookup_generic },
 };
 #endif // SUPPORT_BUILTIN
 
+static char *ipv6calc_shortopts_db_cache = "";
+
+static struct option ipv6calc_longopts_db_cache[] = {
+	{"db-cache-size"               , 1, NULL, DB_common_cache_size },
+	{"db-preload"                  , 0, NULL, DB_common_preload },
+	{"db-init-eager"               , 0, NULL, DB_common_init_eager },
+};
+
 #if defined SUPPORT_EXTERNAL || defined SUPPORT_DBIP || defined SUPPORT_GEOIP || SUPPORT_IP2LOCATION
 static char *ipv6calc_shortopts_db_common = "";
 
@@ -28,6 +28,13 @@ typedef struct {
 	uint32_t typeinfo2;		/* typeinfo 2 */
 } ipv6calc_ipaddr;
 
+/* IPv4/6 address range storage structure (first/last inclusive, layout as in ipv6calc_ipaddr) */
+typedef struct {
+	uint32_t first[4];		/* first address of range */
+	uint32_t last[4];		/* last address of range */
+	uint8_t  flag_valid;		/* range structure filled */
+} ipv6calc_ipaddr_range;
+
 
 /**************
  * Macros
@@ -839,10 +839,11 @@ int libipv4addr_anonymize(ipv6calc_ipv4addr *ipv4addrp, unsigned int mask, const
 	DEBUGPRINT_WA(DEBUG_libipv4addr, "called, method=%d mask=%d type=0x%08x", method, mask, ipv4addrp->typeinfo);
 
 	/* anonymize IPv4 address according to settings */
-	uint32_t as_num32, as_num32_comp17, as_num32_decomp17, ipv4addr_anon, p;
+	uint32_t as_num32, as_num32_comp17, as_num32_decomp17, ipv4addr_anon, p, anon_cache_value[2];
 	uint16_t cc_index, c;
 	ipv6calc_ipaddr ipaddr;
-	int i;
+	ipv6calc_ipaddr_range range;
+	int i, registry, lisp_unicast;
 
 	ipv4addr_settype(ipv4addrp, 0); // set typeinfo if not already done
 
@@ -898,13 +899,24 @@ int libipv4addr_anonymize(ipv6calc_ipv4addr *ipv4addrp, unsigned int mask, const
 
 		CONVERT_IPV4ADDRP_IPADDR(ipv4addrp, ipaddr);
 
-		if (((ipv4addrp->typeinfo & IPV4_ADDR_UNICAST) != 0) && ((ipv4addrp->typeinfo & IPV4_ADDR_LISP) != 0)) {
+		lisp_unicast = (((ipv4addrp->typeinfo & IPV4_ADDR_UNICAST) != 0) && ((ipv4addrp->typeinfo & IPV4_ADDR_LISP) != 0)) ? 1 : 0;
+
+		// check prefix cache (not for LISP unicast, a cached range can include such addresses)
+		if ((lisp_unicast == 0) && (libipv6calc_anon_cache_lookup(IPV6CALC_PROTO_IPV4, ipaddr.addr, anon_cache_value) == 1)) {
+			DEBUGPRINT_WA(DEBUG_libipv4addr, "result anonymized IPv4 address from prefix cache: 0x%08x", anon_cache_value[0]);
+			ipv4addr_setdword(ipv4addrp, anon_cache_value[0]);
+			goto END_libipv4addr_anonymize;
+		};
+
+		// get AS number, countrycode and registry in one run (range with identical results is used by prefix cache)
+		libipv6calc_db_wrapper_all_by_addr_range(&ipaddr, &cc_index, NULL, &as_num32, &registry, &range);
+
+		if (lisp_unicast == 1) {
 			as_num32_comp17 = 0x11800;
-			as_num32_comp17 |= (libipv6calc_db_wrapper_registry_num_by_ipv4addr(ipv4addrp) & 0x7) << 12;
+			as_num32_comp17 |= (registry & 0x7) << 12;
 			as_num32_comp17 |= 0x000; // TODO: map LISP information into 11 LSB
+			range.flag_valid = 0; // special result, not stored in prefix cache
 		} else {
-			// get AS number
-			as_num32 = libipv6calc_db_wrapper_as_num32_by_addr(&ipaddr);
 			DEBUGPRINT_WA(DEBUG_libipv4addr, "result of AS number  retrievement: 0x%08x (%d)", as_num32, as_num32);
 
 			as_num32_comp17 = libipv6calc_db_wrapper_as_num32_comp17(as_num32);
@@ -914,11 +926,9 @@ int libipv4addr_anonymize(ipv6calc_ipv4addr *ipv4addrp, unsigned int mask, const
 			DEBUGPRINT_WA(DEBUG_libipv4addr, "result of AS number decompression: 0x%08x (%d)", as_num32_decomp17, as_num32_decomp17);
 		};
 
-		// get countrycode
-		cc_index = libipv6calc_db_wrapper_cc_index_by_addr(&ipaddr, NULL);
 		if (cc_index == COUNTRYCODE_INDEX_UNKNOWN) {
 			// on unknown country, map registry value
-			cc_index = COUNTRYCODE_INDEX_UNKNOWN_REGISTRY_MAP_MIN + libipv6calc_db_wrapper_registry_num_by_ipv4addr(ipv4addrp);
+			cc_index = COUNTRYCODE_INDEX_UNKNOWN_REGISTRY_MAP_MIN + registry;
 		};
 
 		DEBUGPRINT_WA(DEBUG_libipv4addr, "result of CountryCode index retrievement: 0x%03x (%d)", cc_index, cc_index);
@@ -945,9 +955,14 @@ int libipv4addr_anonymize(ipv6calc_ipv4addr *ipv4addrp, unsigned int mask, const
 
 		DEBUGPRINT_WA(DEBUG_libipv4addr, "result anonymized IPv4 address: 0x%08x, bitcounts=%d", ipv4addr_anon, c);
 
+		anon_cache_value[0] = ipv4addr_anon;
+		anon_cache_value[1] = 0;
+		libipv6calc_anon_cache_store(IPV6CALC_PROTO_IPV4, ipaddr.addr, &range, anon_cache_value);
+
 		ipv4addr_setdword(ipv4addrp, ipv4addr_anon);
 	};
 
+END_libipv4addr_anonymize:
 	DEBUGPRINT_NA(DEBUG_libipv4addr, "return");
 
 	return(0);
@@ -1522,3 +1537,127 @@ int libipv4addr_registry_num_by_addr(const ipv6calc_ipv4addr *ipv4addrp) {
 	DEBUGPRINT_WA(DEBUG_libipv4addr, "registry=%d (0x%x)", registry, registry);
 	return(registry);
 };
+
+
+/*
+ * batch lookup of country code index, 32-bit AS number and registry number of IPv4 addresses
+ *  results are identical to libipv4addr_{cc_index,as_num32,registry_num}_by_addr
+ *
+ * in : *ipv4addrp = array of IPv4 address structures
+ * in : count = number of IPv4 address structures
+ * out: cc_index = array of country code index (skipped if NULL)
+ * out: as_num32 = array of 32-bit AS numbers (skipped if NULL)
+ * out: registry = array of registry numbers (skipped if NULL)
+ * ret: 0 = ok, !0 = error
+ */
+int libipv4addr_db_batch_by_addr(const ipv6calc_ipv4addr *ipv4addrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry) {
+	ipv6calc_ipaddr *ipaddr_list = NULL;
+	int *index_list = NULL;
+	uint16_t *cc_index_list = NULL;
+	uint32_t *as_num32_list = NULL;
+	int *registry_list = NULL;
+	int i, n = 0, result = 1;
+
+	int has_cc  = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV4_TO_CC) == 1) ? 1 : 0;
+	int has_as  = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV4_TO_AS) == 1) ? 1 : 0;
+	int has_reg = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV4_TO_REGISTRY) == 1) ? 1 : 0;
+
+	DEBUGPRINT_WA(DEBUG_libipv4addr, "start count=%d", count);
+
+	if (count <= 0) {
+		return(0);
+	};
+
+	ipaddr_list = malloc(sizeof(ipv6calc_ipaddr) * count);
+	index_list = malloc(sizeof(int) * count);
+	if ((ipaddr_list == NULL) || (index_list == NULL)) {
+		goto END_libipv4addr_db_batch_by_addr;
+	};
+
+	if ((cc_index != NULL) && (has_cc == 1)) {
+		cc_index_list = malloc(sizeof(uint16_t) * count);
+		if (cc_index_list == NULL) {
+			goto END_libipv4addr_db_batch_by_addr;
+		};
+	};
+
+	if ((as_num32 != NULL) && (has_as == 1)) {
+		as_num32_list = malloc(sizeof(uint32_t) * count);
+		if (as_num32_list == NULL) {
+			goto END_libipv4addr_db_batch_by_addr;
+		};
+	};
+
+	if ((registry != NULL) && (has_reg == 1)) {
+		registry_list = malloc(sizeof(int) * count);
+		if (registry_list == NULL) {
+			goto END_libipv4addr_db_batch_by_addr;
+		};
+	};
+
+	for (i = 0; i < count; i++) {
+		if ((ipv4addrp[i].typeinfo & IPV4_ADDR_ANONYMIZED) != 0) {
+			// anonymized addresses carry the information inside, no database lookup
+			if (cc_index != NULL) {
+				cc_index[i] = libipv4addr_cc_index_by_addr(&ipv4addrp[i], NULL);
+			};
+			if (as_num32 != NULL) {
+				as_num32[i] = libipv4addr_as_num32_by_addr(&ipv4addrp[i]);
+			};
+			if (registry != NULL) {
+				registry[i] = libipv4addr_registry_num_by_addr(&ipv4addrp[i]);
+			};
+			continue;
+		};
+
+		if (cc_index != NULL) {
+			cc_index[i] = COUNTRYCODE_INDEX_UNKNOWN;
+		};
+		if (as_num32 != NULL) {
+			as_num32[i] = ASNUM_AS_UNKNOWN;
+		};
+		if (registry != NULL) {
+			registry[i] = IPV4_ADDR_REGISTRY_UNKNOWN;
+		};
+
+		CONVERT_IPV4ADDRP_IPADDR(&ipv4addrp[i], ipaddr_list[n]);
+		index_list[n] = i;
+		n++;
+	};
+
+	if ((n > 0) && ((cc_index_list != NULL) || (as_num32_list != NULL) || (registry_list != NULL))) {
+		if (libipv6calc_db_wrapper_batch_by_addr(ipaddr_list, n, cc_index_list, as_num32_list, registry_list) != 0) {
+			goto END_libipv4addr_db_batch_by_addr;
+		};
+
+		for (i = 0; i < n; i++) {
+			if ((cc_index_list != NULL) \
+			    && ((ipv4addrp[index_list[i]].typeinfo & IPV4_ADDR_RESERVED) == 0) \
+			    && ((ipv4addrp[index_list[i]].typeinfo & IPV4_ADDR_GLOBAL) != 0)) {
+				cc_index[index_list[i]] = cc_index_list[i];
+			};
+			if (as_num32_list != NULL) {
+				as_num32[index_list[i]] = as_num32_list[i];
+			};
+			if (registry_list != NULL) {
+				registry[index_list[i]] = registry_list[i];
+			};
+		};
+	};
+
+	result = 0;
+
+END_libipv4addr_db_batch_by_addr:
+	if (result != 0) {
+		ERRORPRINT_WA("batch lookup of IPv4 addresses failed: count=%d", count);
+	};
+
+	free(registry_list);
+	free(as_num32_list);
+	free(cc_index_list);
+	free(index_list);
+	free(ipaddr_list);
+
+	DEBUGPRINT_WA(DEBUG_libipv4addr, "finished count=%d lookups=%d", count, n);
+	return(result);
+};
@@ -2056,7 +2056,7 @@ int libipv6addr_anonymize(ipv6calc_ipv6addr *ipv6addrp, const s_ipv6calc_anon_se
 	uint32_t iid[2];
 	char tempstring[NI_MAXHOST];
 	char helpstring[NI_MAXHOST];
-	int i, j, r;
+	int i, j, r, registry;
 	int calculate_checksum = 0;
 	int calculate_checksum_prefix = 0;
 	int zeroize_prefix = 0;
@@ -2067,10 +2067,11 @@ int libipv6addr_anonymize(ipv6calc_ipv6addr *ipv6addrp, const s_ipv6calc_anon_se
 	ipv6calc_eui64addr eui64addr;
 	ipv6calc_ipv4addr  ipv4addr;
 	ipv6calc_ipaddr    ipaddr;
+	ipv6calc_ipaddr_range range;
 	uint32_t map_value;
 
 	uint16_t cc_index, flags;
-	uint32_t as_num32, ipv6_prefix[2];
+	uint32_t as_num32, ipv6_prefix[2], anon_cache_addr[2];
 
 	int mask_eui64  = ipv6calc_anon_set->mask_eui64;
 	// int mask_mac  = ipv6calc_anon_set->mask_mac; // currently not used
@@ -2193,6 +2194,8 @@ int libipv6addr_anonymize(ipv6calc_ipv6addr *ipv6addrp, const s_ipv6calc_anon_se
 				goto InterfaceIdentifier;
 			};
 
+			range.flag_valid = 0; // prefix cache is only used with range reported by database wrapper
+
 			// switch to prefix anonymization
 			if ((ipv6addrp->typeinfo & IPV6_NEW_ADDR_6BONE) != 0) {
 				DEBUGPRINT_NA(DEBUG_libipv6addr, "IPv6 is 6bone unicast, special prefix anonymization");
@@ -2204,14 +2207,22 @@ int libipv6addr_anonymize(ipv6calc_ipv6addr *ipv6addrp, const s_ipv6calc_anon_se
 				CONVERT_IPV6ADDRP_IPADDR(ipv6addrp, ipaddr);
 				as_num32 = libipv6calc_db_wrapper_cc_index_by_addr(&ipaddr, NULL) << 20;
 			} else {
+				// check prefix cache (only after reserved and special types above, a cached range can include such addresses)
+				anon_cache_addr[0] = ipv6addr_getdword(ipv6addrp, 0);
+				anon_cache_addr[1] = ipv6addr_getdword(ipv6addrp, 1);
+				if (libipv6calc_anon_cache_lookup(IPV6CALC_PROTO_IPV6, anon_cache_addr, ipv6_prefix) == 1) {
+					DEBUGPRINT_WA(DEBUG_libipv6addr, "anonmized prefix from prefix cache: %08x%08x", ipv6_prefix[0], ipv6_prefix[1]);
+					goto PrefixAnonymized;
+				};
+
 				CONVERT_IPV6ADDRP_IPADDR(ipv6addrp, ipaddr);
 
-				cc_index = libipv6calc_db_wrapper_cc_index_by_addr(&ipaddr, NULL);
-				as_num32 = libipv6calc_db_wrapper_as_num32_by_addr(&ipaddr);
+				// get countrycode, AS number and registry in one run (range with identical results is used by prefix cache)
+				libipv6calc_db_wrapper_all_by_addr_range(&ipaddr, &cc_index, NULL, &as_num32, &registry, &range);
 
 				if (cc_index == COUNTRYCODE_INDEX_UNKNOWN) {
 					// on unknown country, map registry value
-					cc_index = COUNTRYCODE_INDEX_UNKNOWN_REGISTRY_MAP_MIN + libipv6calc_db_wrapper_registry_num_by_ipv6addr(ipv6addrp);
+					cc_index = COUNTRYCODE_INDEX_UNKNOWN_REGISTRY_MAP_MIN + registry;
 				};
 			};
 
@@ -2236,6 +2247,9 @@ int libipv6addr_anonymize(ipv6calc_ipv6addr *ipv6addrp, const s_ipv6calc_anon_se
 
 			DEBUGPRINT_WA(DEBUG_libipv6addr, "anonmized prefix for method=%d: %08x%08x", method, ipv6_prefix[0], ipv6_prefix[1]);
 
+			libipv6calc_anon_cache_store(IPV6CALC_PROTO_IPV6, anon_cache_addr, &range, ipv6_prefix);
+
+PrefixAnonymized:
 			anonymized_prefix_nibbles = 0;
 
 			ipv6addr_setdword(ipv6addrp, 0, ipv6_prefix[0]);
@@ -3331,3 +3345,127 @@ int libipv6addr_registry_num_by_addr(const ipv6calc_ipv6addr *ipv6addrp) {
 	DEBUGPRINT_WA(DEBUG_libipv6addr, "registry=%d (0x%x)", registry, registry);
 	return(registry);
 };
+
+
+/*
+ * batch lookup of country code index, 32-bit AS number and registry number of IPv6 addresses
+ *  results are identical to libipv6addr_{cc_index,as_num32,registry_num}_by_addr
+ *
+ * in : *ipv6addrp = array of IPv6 address structures
+ * in : count = number of IPv6 address structures
+ * out: cc_index = array of country code index (skipped if NULL)
+ * out: as_num32 = array of 32-bit AS numbers (skipped if NULL)
+ * out: registry = array of registry numbers (skipped if NULL)
+ * ret: 0 = ok, !0 = error
+ */
+int libipv6addr_db_batch_by_addr(const ipv6calc_ipv6addr *ipv6addrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry) {
+	ipv6calc_ipaddr *ipaddr_list = NULL;
+	int *index_list = NULL;
+	uint16_t *cc_index_list = NULL;
+	uint32_t *as_num32_list = NULL;
+	int *registry_list = NULL;
+	int i, n = 0, result = 1;
+
+	int has_cc  = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV4_TO_CC) == 1) ? 1 : 0;
+	int has_as  = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV4_TO_AS) == 1) ? 1 : 0;
+	int has_reg = (libipv6calc_db_wrapper_has_features(IPV6CALC_DB_IPV6_TO_REGISTRY) == 1) ? 1 : 0;
+
+	const uint32_t typeinfo_special = IPV6_ADDR_ANONYMIZED_PREFIX | IPV6_ADDR_ANONYMIZED_IID | IPV6_ADDR_HAS_PUBLIC_IPV4_IN_IID | IPV6_ADDR_HAS_PUBLIC_IPV4_IN_PREFIX | IPV6_NEW_ADDR_6BONE;
+
+	DEBUGPRINT_WA(DEBUG_libipv6addr, "start count=%d", count);
+
+	if (count <= 0) {
+		return(0);
+	};
+
+	ipaddr_list = malloc(sizeof(ipv6calc_ipaddr) * count);
+	index_list = malloc(sizeof(int) * count);
+	if ((ipaddr_list == NULL) || (index_list == NULL)) {
+		goto END_libipv6addr_db_batch_by_addr;
+	};
+
+	if ((cc_index != NULL) && (has_cc == 1)) {
+		cc_index_list = malloc(sizeof(uint16_t) * count);
+		if (cc_index_list == NULL) {
+			goto END_libipv6addr_db_batch_by_addr;
+		};
+	};
+
+	if ((as_num32 != NULL) && (has_as == 1)) {
+		as_num32_list = malloc(sizeof(uint32_t) * count);
+		if (as_num32_list == NULL) {
+			goto END_libipv6addr_db_batch_by_addr;
+		};
+	};
+
+	if ((registry != NULL) && (has_reg == 1)) {
+		registry_list = malloc(sizeof(int) * count);
+		if (registry_list == NULL) {
+			goto END_libipv6addr_db_batch_by_addr;
+		};
+	};
+
+	for (i = 0; i < count; i++) {
+		if ((ipv6addrp[i].typeinfo & typeinfo_special) != 0) {
+			// anonymized, 6bone or with included IPv4 address, no direct database lookup
+			if (cc_index != NULL) {
+				cc_index[i] = libipv6addr_cc_index_by_addr(&ipv6addrp[i], NULL);
+			};
+			if (as_num32 != NULL) {
+				as_num32[i] = libipv6addr_as_num32_by_addr(&ipv6addrp[i]);
+			};
+			if (registry != NULL) {
+				registry[i] = libipv6addr_registry_num_by_addr(&ipv6addrp[i]);
+			};
+			continue;
+		};
+
+		if (cc_index != NULL) {
+			cc_index[i] = COUNTRYCODE_INDEX_UNKNOWN;
+		};
+		if (as_num32 != NULL) {
+			as_num32[i] = ASNUM_AS_UNKNOWN;
+		};
+		if (registry != NULL) {
+			registry[i] = IPV6_ADDR_REGISTRY_UNKNOWN;
+		};
+
+		CONVERT_IPV6ADDRP_IPADDR(&ipv6addrp[i], ipaddr_list[n]);
+		index_list[n] = i;
+		n++;
+	};
+
+	if ((n > 0) && ((cc_index_list != NULL) || (as_num32_list != NULL) || (registry_list != NULL))) {
+		if (libipv6calc_db_wrapper_batch_by_addr(ipaddr_list, n, cc_index_list, as_num32_list, registry_list) != 0) {
+			goto END_libipv6addr_db_batch_by_addr;
+		};
+
+		for (i = 0; i < n; i++) {
+			if (cc_index_list != NULL) {
+				cc_index[index_list[i]] = cc_index_list[i];
+			};
+			if (as_num32_list != NULL) {
+				as_num32[index_list[i]] = as_num32_list[i];
+			};
+			if (registry_list != NULL) {
+				registry[index_list[i]] = registry_list[i];
+			};
+		};
+	};
+
+	result = 0;
+
+END_libipv6addr_db_batch_by_addr:
+	if (result != 0) {
+		ERRORPRINT_WA("batch lookup of IPv6 addresses failed: count=%d", count);
+	};
+
+	free(registry_list);
+	free(as_num32_list);
+	free(cc_index_list);
+	free(index_list);
+	free(ipaddr_list);
+
+	DEBUGPRINT_WA(DEBUG_libipv6addr, "finished count=%d lookups=%d", count, n);
+	return(result);
+};
@@ -437,3 +437,4 @@ extern int  libipv6addr_get_included_ipv4addr(const ipv6calc_ipv6addr *ipv6addrp
 extern uint16_t libipv6addr_cc_index_by_addr(const ipv6calc_ipv6addr *ipv6addrp, unsigned int *data_source_ptr);
 extern uint32_t libipv6addr_as_num32_by_addr(const ipv6calc_ipv6addr *ipv6addrp);
 extern int libipv6addr_registry_num_by_addr(const ipv6calc_ipv6addr *ipv6addrp);
+extern int libipv6addr_db_batch_by_addr(const ipv6calc_ipv6addr *ipv6addrp, const int count, uint16_t *cc_index, uint32_t *as_num32, int *registry);
@@ -675,6 +675,430 @@ int libipv6calc_anon_supported(const s_ipv6calc_anon_set *ipv6calc_anon_set) {
 };
 
 
+/*
+ * prefix cache for anonymization method keep-type-asn-cc
+ *  value is the anonymized prefix, stored together with the address range reported by the
+ *  database wrapper with constant CountryCode/ASN/registry (not stored if no range is reported)
+ *  direct-mapped by IPv4 /24 or IPv6 /48 prefix, bounded to IPV6CALC_ANON_CACHE_SIZE entries per protocol,
+ *  disabled together with the database result cache (--db-cache-size 0)
+ *  the cache set bound to the calling thread (libipv6calc_anon_cache_ctx_bind) is used, otherwise the default one
+ */
+static s_ipv6calc_anon_cache_ctx anon_cache_default;
+static __thread s_ipv6calc_anon_cache_ctx *anon_cache_bound = NULL;
+
+#define IPV6CALC_ANON_CACHE_CTX ((anon_cache_bound != NULL) ? anon_cache_bound : &anon_cache_default)
+
+
+/*
+ * get slot of prefix cache for address
+ */
+static unsigned int libipv6calc_anon_cache_slot(const int proto, const uint32_t *addr) {
+	uint32_t key[2];
+
+	if (proto == IPV6CALC_PROTO_IPV4) {
+		key[0] = addr[0] & (0xffffffffu << (32 - IPV6CALC_ANON_CACHE_IPV4_BITS));
+		key[1] = 0;
+	} else {
+		key[0] = addr[0];
+		key[1] = addr[1] & (0xffffffffu << (64 - IPV6CALC_ANON_CACHE_IPV6_BITS));
+	};
+
+	return(((key[0] ^ (key[1] * 0x85ebca6b)) * 0x9e3779b1) % IPV6CALC_ANON_CACHE_SIZE);
+};
+
+
+/*
+ * compare address with range boundary (IPv4: [0], IPv6: prefix 0-63)
+ * ret: -1 = addr below, 0 = equal, 1 = addr above
+ */
+static int libipv6calc_anon_cache_cmp(const int proto, const uint32_t *addr, const uint32_t *range_addr) {
+	if (addr[0] != range_addr[0]) {
+		return((addr[0] < range_addr[0]) ? -1 : 1);
+	};
+
+	if ((proto != IPV6CALC_PROTO_IPV4) && (addr[1] != range_addr[1])) {
+		return((addr[1] < range_addr[1]) ? -1 : 1);
+	};
+
+	return(0);
+};
+
+
+/*
+ * lookup anonymized prefix in prefix cache
+ *
+ * in : proto = IPV6CALC_PROTO_IPV4|IPV6CALC_PROTO_IPV6
+ * in : addr = address (IPv4: addr[0], IPv6: addr[0..1])
+ * out: value[0..1] = cached value
+ * ret: 1 = hit, 0 = miss (or cache disabled)
+ */
+int libipv6calc_anon_cache_lookup(const int proto, const uint32_t *addr, uint32_t *value) {
+	s_ipv6calc_anon_cache *cachep = &IPV6CALC_ANON_CACHE_CTX->cache[(proto == IPV6CALC_PROTO_IPV4) ? 0 : 1];
+	const s_ipv6calc_anon_cache_entry *entryp;
+
+	if (libipv6calc_db_wrapper_cache_size == 0) {
+		return(0);
+	};
+
+	if (cachep->entry != NULL) {
+		entryp = &cachep->entry[libipv6calc_anon_cache_slot(proto, addr)];
+
+		if ((entryp->flag_valid == 1)
+		    && (libipv6calc_anon_cache_cmp(proto, addr, entryp->first) >= 0)
+		    && (libipv6calc_anon_cache_cmp(proto, addr, entryp->last) <= 0)
+		) {
+			value[0] = entryp->value[0];
+			value[1] = entryp->value[1];
+			cachep->hit++;
+			return(1);
+		};
+	};
+
+	cachep->miss++;
+	return(0);
+};
+
+
+/*
+ * store anonymized prefix in prefix cache
+ *
+ * in : proto = IPV6CALC_PROTO_IPV4|IPV6CALC_PROTO_IPV6
+ * in : addr = address (IPv4: addr[0], IPv6: addr[0..1])
+ * in : rangep = range containing the address with identical value (nothing stored if not valid)
+ * in : value[0..1] = value to store
+ */
+void libipv6calc_anon_cache_store(const int proto, const uint32_t *addr, const ipv6calc_ipaddr_range *rangep, const uint32_t *value) {
+	s_ipv6calc_anon_cache *cachep = &IPV6CALC_ANON_CACHE_CTX->cache[(proto == IPV6CALC_PROTO_IPV4) ? 0 : 1];
+	s_ipv6calc_anon_cache_entry *entryp;
+
+	if ((libipv6calc_db_wrapper_cache_size == 0) || (rangep->flag_valid != 1)) {
+		return;
+	};
+
+	if (cachep->entry == NULL) {
+		cachep->entry = calloc(IPV6CALC_ANON_CACHE_SIZE, sizeof(s_ipv6calc_anon_cache_entry));
+		if (cachep->entry == NULL) {
+			ERRORPRINT_WA("cannot allocate memory for anonymization prefix cache: %d entries", IPV6CALC_ANON_CACHE_SIZE);
+			return;
+		};
+	};
+
+	entryp = &cachep->entry[libipv6calc_anon_cache_slot(proto, addr)];
+
+	if (entryp->flag_valid == 0) {
+		cachep->entries++;
+	};
+
+	entryp->first[0] = rangep->first[0];
+	entryp->first[1] = rangep->first[1];
+	entryp->last[0] = rangep->last[0];
+	entryp->last[1] = rangep->last[1];
+	entryp->value[0] = value[0];
+	entryp->value[1] = value[1];
+	entryp->flag_valid = 1;
+};
+
+
+/*
+ * bind prefix cache set to calling thread
+ *
+ * in : ctx = prefix cache set (zeroed before first use), NULL: unbind (use default set again)
+ */
+void libipv6calc_anon_cache_ctx_bind(s_ipv6calc_anon_cache_ctx *ctx) {
+	anon_cache_bound = ctx;
+};
+
+
+/*
+ * free prefix cache set
+ *
+ * in : ctx = prefix cache set
+ */
+void libipv6calc_anon_cache_ctx_cleanup(s_ipv6calc_anon_cache_ctx *ctx) {
+	int p;
+
+	for (p = 0; p < 2; p++) {
+		free(ctx->cache[p].entry);
+	};
+
+	memset(ctx, 0, sizeof(s_ipv6calc_anon_cache_ctx));
+};
+
+
+/*
+ * print prefix cache statistics of cache set (to stderr)
+ *
+ * in : ctx = prefix cache set
+ * in : prefix_string = prefix of each line
+ */
+void libipv6calc_anon_cache_ctx_print_statistics(const s_ipv6calc_anon_cache_ctx *ctx, const char *prefix_string) {
+	int p;
+
+	for (p = 0; p < 2; p++) {
+		if ((ctx->cache[p].hit == 0) && (ctx->cache[p].miss == 0)) {
+			continue;
+		};
+
+		fprintf(stderr, "%sAnonymization prefix cache %s: size=%d entries=%d hits=%lu misses=%lu hit-rate=%.1f%%\n"
+			, prefix_string
+			, (p == 0) ? "IPv4" : "IPv6"
+			, IPV6CALC_ANON_CACHE_SIZE
+			, ctx->cache[p].entries
+			, ctx->cache[p].hit
+			, ctx->cache[p].miss
+			, 100.0 * ctx->cache[p].hit / (ctx->cache[p].hit + ctx->cache[p].miss)
+		);
+	};
+};
+
+
+/*
+ * print prefix cache statistics of default cache set (to stderr)
+ *
+ * in : prefix_string = prefix of each line
+ */
+void libipv6calc_anon_cache_print_statistics(const char *prefix_string) {
+	libipv6calc_anon_cache_ctx_print_statistics(&anon_cache_default, prefix_string);
+};
+
+
+/*
+ * address result cache
+ *  key is the binary address together with caller specific type and tag,
+ *  value is the result string
+ *  hash index with open addressing (linear probing, backward shift deletion),
+ *  eviction by CLOCK (second chance) if capacity is reached
+ */
+
+/*
+ * address result cache: hash of key
+ */
+static uint32_t libipv6calc_addr_cache_hash(const uint32_t key_type, const uint32_t key_tag, const uint32_t *key_addr) {
+	uint32_t h = key_type ^ (key_tag * 0x85ebca6b);
+	int i;
+
+	for (i = 0; i < IPV6CALC_ADDR_CACHE_KEY_WORDS; i++) {
+		h = (h ^ key_addr[i]) * 0x9e3779b1;
+	};
+
+	return(h ^ (h >> 16));
+};
+
+
+/*
+ * address result cache: create
+ *
+ * in : capacity = amount of entries
+ * ret: pointer to cache, NULL on error
+ */
+s_ipv6calc_addr_cache *libipv6calc_addr_cache_create(const int capacity) {
+	s_ipv6calc_addr_cache *cachep;
+	uint32_t index_size = 2;
+
+	if ((capacity < IPV6CALC_ADDR_CACHE_LIMIT_MIN) || (capacity > IPV6CALC_ADDR_CACHE_LIMIT_MAX)) {
+		ERRORPRINT_WA("address cache capacity out of range: %d (%d-%d)", capacity, IPV6CALC_ADDR_CACHE_LIMIT_MIN, IPV6CALC_ADDR_CACHE_LIMIT_MAX);
+		return(NULL);
+	};
+
+	while (index_size < 2 * (uint32_t) capacity) {
+		index_size <<= 1;
+	};
+
+	cachep = calloc(1, sizeof(s_ipv6calc_addr_cache));
+	if (cachep == NULL) {
+		goto END_libipv6calc_addr_cache_create_error;
+	};
+
+	cachep->entry = calloc((size_t) capacity, sizeof(s_ipv6calc_addr_cache_entry));
+	if (cachep->entry == NULL) {
+		goto END_libipv6calc_addr_cache_create_error;
+	};
+
+	cachep->index = malloc((size_t) index_size * sizeof(int32_t));
+	if (cachep->index == NULL) {
+		goto END_libipv6calc_addr_cache_create_error;
+	};
+	memset(cachep->index, 0xff, (size_t) index_size * sizeof(int32_t)); // -1
+
+	cachep->index_mask = index_size - 1;
+	cachep->capacity = capacity;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc, "address cache created: capacity=%d index=%u", capacity, index_size);
+
+	return(cachep);
+
+END_libipv6calc_addr_cache_create_error:
+	ERRORPRINT_WA("cannot allocate memory for address cache: %d entries", capacity);
+	libipv6calc_addr_cache_free(cachep);
+	return(NULL);
+};
+
+
+/*
+ * address result cache: free
+ *
+ * in : cachep = pointer to cache (can be NULL)
+ */
+void libipv6calc_addr_cache_free(s_ipv6calc_addr_cache *cachep) {
+	if (cachep == NULL) {
+		return;
+	};
+
+	free(cachep->entry);
+	free(cachep->index);
+	free(cachep);
+};
+
+
+/*
+ * address result cache: lookup
+ *
+ * in : cachep = pointer to cache
+ * in : key_type, key_tag = caller specific key
+ * in : key_addr[0..3] = binary address, key_addr[4] = prefix (see IPV6CALC_ADDR_CACHE_KEY_PREFIX)
+ * mod: resultstring = cached value
+ * ret: 1 = hit, 0 = miss
+ */
+int libipv6calc_addr_cache_lookup(s_ipv6calc_addr_cache *cachep, const uint32_t key_type, const uint32_t key_tag, const uint32_t *key_addr, char *resultstring, const size_t resultstring_length) {
+	s_ipv6calc_addr_cache_entry *entryp;
+	uint32_t h, i, distance = 0;
+
+	cachep->checked++;
+
+	h = libipv6calc_addr_cache_hash(key_type, key_tag, key_addr);
+
+	for (i = h & cachep->index_mask; cachep->index[i] >= 0; i = (i + 1) & cachep->index_mask) {
+		entryp = &cachep->entry[cachep->index[i]];
+
+		if ((entryp->hash == h) && (entryp->key_type == key_type) && (entryp->key_tag == key_tag) && (memcmp(entryp->key_addr, key_addr, sizeof(entryp->key_addr)) == 0)) {
+			entryp->referenced = 1;
+			cachep->hit++;
+			cachep->statistics[(distance < IPV6CALC_ADDR_CACHE_DISTANCE_MAX) ? distance : IPV6CALC_ADDR_CACHE_DISTANCE_MAX]++;
+			snprintf(resultstring, resultstring_length, "%s", entryp->value);
+			DEBUGPRINT_WA(DEBUG_libipv6calc, "address cache hit: entry=%d distance=%u value=%s", cachep->index[i], distance, resultstring);
+			return(1);
+		};
+
+		distance++;
+	};
+
+	return(0);
+};
+
+
+/*
+ * address result cache: remove entry from index (backward shift)
+ */
+static void libipv6calc_addr_cache_index_remove(s_ipv6calc_addr_cache *cachep, const int32_t n) {
+	uint32_t i, j, home;
+
+	// search position of entry
+	for (i = cachep->entry[n].hash & cachep->index_mask; cachep->index[i] != n; i = (i + 1) & cachep->index_mask) {
+		if (cachep->index[i] < 0) {
+			// not found (should not happen)
+			return;
+		};
+	};
+
+	// shift following entries of the cluster back if their home position allows
+	for (j = (i + 1) & cachep->index_mask; cachep->index[j] >= 0; j = (j + 1) & cachep->index_mask) {
+		home = cachep->entry[cachep->index[j]].hash & cachep->index_mask;
+
+		if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+			// home position between gap and current position, stays
+			continue;
+		};
+
+		cachep->index[i] = cachep->index[j];
+		i = j;
+	};
+
+	cachep->index[i] = -1;
+};
+
+
+/*
+ * address result cache: store (key must not be already stored)
+ *
+ * in : cachep = pointer to cache
+ * in : key_type, key_tag = caller specific key
+ * in : key_addr[0..3] = binary address, key_addr[4] = prefix (see IPV6CALC_ADDR_CACHE_KEY_PREFIX)
+ * in : value = value to store
+ */
+void libipv6calc_addr_cache_store(s_ipv6calc_addr_cache *cachep, const uint32_t key_type, const uint32_t key_tag, const uint32_t *key_addr, const char *value) {
+	s_ipv6calc_addr_cache_entry *entryp;
+	int32_t n;
+	uint32_t i;
+
+	if (strlen(value) >= IPV6CALC_ADDR_CACHE_VALUE_SIZE) {
+		cachep->skipped++;
+		return;
+	};
+
+	if (cachep->count < cachep->capacity) {
+		// unused entry available
+		n = cachep->count;
+		cachep->count++;
+	} else {
+		// CLOCK: skip referenced entries (clearing the reference) and evict first unreferenced one
+		while (cachep->entry[cachep->hand].referenced != 0) {
+			cachep->entry[cachep->hand].referenced = 0;
+			cachep->hand = (cachep->hand + 1) % cachep->capacity;
+		};
+
+		n = cachep->hand;
+		cachep->hand = (cachep->hand + 1) % cachep->capacity;
+
+		libipv6calc_addr_cache_index_remove(cachep, n);
+		cachep->evicted++;
+	};
+
+	entryp = &cachep->entry[n];
+	entryp->key_type = key_type;
+	entryp->key_tag = key_tag;
+	memcpy(entryp->key_addr, key_addr, sizeof(entryp->key_addr));
+	entryp->hash = libipv6calc_addr_cache_hash(key_type, key_tag, key_addr);
+	entryp->referenced = 0;
+	snprintf(entryp->value, sizeof(entryp->value), "%s", value);
+
+	for (i = entryp->hash & cachep->index_mask; cachep->index[i] >= 0; i = (i + 1) & cachep->index_mask);
+	cachep->index[i] = n;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc, "address cache store: entry=%d value=%s", n, entryp->value);
+};
+
+
+/*
+ * address result cache: print statistics (to stderr)
+ *
+ * in : cachep = pointer to cache
+ * in : prefix_string = prefix of each line
+ */
+void libipv6calc_addr_cache_print_statistics(const s_ipv6calc_addr_cache *cachep, const char *prefix_string) {
+	int i;
+
+	fprintf(stderr, "%sCache capacity=%d entries=%d lookups=%lu hits=%lu evicted=%lu not-cached=%lu hit-rate=%.1f%%\n"
+		, prefix_string
+		, cachep->capacity
+		, cachep->count
+		, cachep->checked
+		, cachep->hit
+		, cachep->evicted
+		, cachep->skipped
+		, (cachep->checked > 0) ? 100.0 * cachep->hit / cachep->checked : 0.0
+	);
+
+	for (i = 0; i <= IPV6CALC_ADDR_CACHE_DISTANCE_MAX; i++) {
+		fprintf(stderr, "%sCache distance: %s%2d  hits: %8lu\n"
+			, prefix_string
+			, (i == IPV6CALC_ADDR_CACHE_DISTANCE_MAX) ? ">=" : "  "
+			, i
+			, cachep->statistics[i]
+		);
+	};
+};
+
+
 /*
  * return pointer to registry name by number
  */
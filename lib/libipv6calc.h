@@ -49,6 +49,63 @@ typedef struct {
 	{ "keep-type-asn-cc" , 3, "special reliable anonymization, keep type & Autonomous System Number and CountryCode" }
 };
 
+/* prefix cache for anonymization method keep-type-asn-cc (result is constant within the DB range reported for CountryCode/ASN/registry) */
+#define IPV6CALC_ANON_CACHE_SIZE	65536	// entries per protocol
+#define IPV6CALC_ANON_CACHE_IPV4_BITS	24	// slot: IPv4 prefix length
+#define IPV6CALC_ANON_CACHE_IPV6_BITS	48	// slot: IPv6 prefix length
+
+typedef struct {
+	uint32_t first[2];	// range (IPv4: [0], IPv6: prefix 0-63)
+	uint32_t last[2];
+	uint32_t value[2];
+	int flag_valid;
+} s_ipv6calc_anon_cache_entry;
+
+typedef struct {
+	s_ipv6calc_anon_cache_entry *entry;
+	int entries;			// used entries
+	unsigned long int hit;
+	unsigned long int miss;
+} s_ipv6calc_anon_cache;
+
+typedef struct {
+	s_ipv6calc_anon_cache cache[2];	// 0: IPv4, 1: IPv6
+} s_ipv6calc_anon_cache_ctx;
+
+/* address result cache (used by log processing tools), key is the binary address */
+#define IPV6CALC_ADDR_CACHE_LIMIT_MIN		1
+#define IPV6CALC_ADDR_CACHE_LIMIT_DEFAULT	100000
+#define IPV6CALC_ADDR_CACHE_LIMIT_MAX		1000000
+#define IPV6CALC_ADDR_CACHE_VALUE_SIZE		128	// longer values are not cached
+#define IPV6CALC_ADDR_CACHE_DISTANCE_MAX	8	// statistics: probe distance limit
+#define IPV6CALC_ADDR_CACHE_KEY_WORDS		5	// binary address (4 words) and prefix
+
+/* key word 4: prefix length in use (e.g. 1.2.3.4/24 must not share results with 1.2.3.4) */
+#define IPV6CALC_ADDR_CACHE_KEY_PREFIX(flag_prefixuse, prefixlength)	(((flag_prefixuse) == 1) ? (0x100u | (uint32_t) (prefixlength)) : 0u)
+
+typedef struct {
+	uint32_t key_type;	// caller specific, e.g. input type
+	uint32_t key_tag;	// caller specific, e.g. output type
+	uint32_t key_addr[IPV6CALC_ADDR_CACHE_KEY_WORDS];	// binary address (word 0-3, unused words are 0), prefix (word 4)
+	uint32_t hash;
+	int referenced;		// CLOCK reference bit
+	char value[IPV6CALC_ADDR_CACHE_VALUE_SIZE];
+} s_ipv6calc_addr_cache_entry;
+
+typedef struct {
+	s_ipv6calc_addr_cache_entry *entry;
+	int32_t *index;		// open addressing, entry number, -1 = empty
+	uint32_t index_mask;
+	int capacity;
+	int count;		// used entries
+	int hand;		// CLOCK hand
+	unsigned long int checked;
+	unsigned long int hit;
+	unsigned long int evicted;
+	unsigned long int skipped;	// value too long to cache
+	unsigned long int statistics[IPV6CALC_ADDR_CACHE_DISTANCE_MAX + 1];
+} s_ipv6calc_addr_cache;
+
 /* Registries (main registries must below 8 for anonymization mapping) */
 #define REGISTRY_APNIC        0x02
 #define REGISTRY_RIPENCC      0x03
@@ -136,6 +193,18 @@ extern int   libipv6calc_anon_set_by_name(s_ipv6calc_anon_set *ipv6calc_anon_set
 extern void  libipv6calc_anon_infostring(char* string, const int stringlength, const s_ipv6calc_anon_set *ipv6calc_anon_set);
 extern const char *libipv6calc_anon_method_name(const s_ipv6calc_anon_set *ipv6calc_anon_set);
 extern int   libipv6calc_anon_supported(const s_ipv6calc_anon_set *ipv6calc_anon_set);
+extern int   libipv6calc_anon_cache_lookup(const int proto, const uint32_t *addr, uint32_t *value);
+extern void  libipv6calc_anon_cache_store(const int proto, const uint32_t *addr, const ipv6calc_ipaddr_range *rangep, const uint32_t *value);
+extern void  libipv6calc_anon_cache_print_statistics(const char *prefix_string);
+extern void  libipv6calc_anon_cache_ctx_bind(s_ipv6calc_anon_cache_ctx *ctx);
+extern void  libipv6calc_anon_cache_ctx_cleanup(s_ipv6calc_anon_cache_ctx *ctx);
+extern void  libipv6calc_anon_cache_ctx_print_statistics(const s_ipv6calc_anon_cache_ctx *ctx, const char *prefix_string);
+
+extern s_ipv6calc_addr_cache *libipv6calc_addr_cache_create(const int capacity);
+extern void  libipv6calc_addr_cache_free(s_ipv6calc_addr_cache *cachep);
+extern int   libipv6calc_addr_cache_lookup(s_ipv6calc_addr_cache *cachep, const uint32_t key_type, const uint32_t key_tag, const uint32_t *key_addr, char *resultstring, const size_t resultstring_length);
+extern void  libipv6calc_addr_cache_store(s_ipv6calc_addr_cache *cachep, const uint32_t key_type, const uint32_t key_tag, const uint32_t *key_addr, const char *value);
+extern void  libipv6calc_addr_cache_print_statistics(const s_ipv6calc_addr_cache *cachep, const char *prefix_string);
 
 extern const char *libipv6calc_registry_string_by_num(const int registry);
 
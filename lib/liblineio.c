@@ -0,0 +1,450 @@
+/*
+ * Project    : ipv6calc
+ * File       : liblineio.c
+ * Version    : $Id$
+ *
+ * Information:
+ *  Buffered line reader and writer for the log tools
+ *   input is read in large blocks by read() or regular files are mapped by mmap(),
+ *   lines are located by memchr() and handed out without copying (pointer and length),
+ *   output is collected and written by large write()
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "libipv6calc.h"
+#include "libipv6calcdebug.h"
+#include "liblineio.h"
+
+
+/*
+ * create line reader
+ *
+ * in : fd = file descriptor to read from
+ * in : size = size of buffer (at least line_max)
+ * in : line_max = maximum line length including terminating '\0' of a copy (longer lines are split like by fgets)
+ * ret: pointer to reader, NULL on error
+ */
+s_ipv6calc_line_reader *liblineio_reader_create(const int fd, const size_t size, const size_t line_max) {
+	s_ipv6calc_line_reader *readerp;
+
+	if ((line_max < 2) || (size < line_max)) {
+		ERRORPRINT_WA("unsupported buffer size/maximum line length: %lu/%lu", (unsigned long int) size, (unsigned long int) line_max);
+		return (NULL);
+	};
+
+	readerp = calloc(1, sizeof(s_ipv6calc_line_reader));
+	if (readerp == NULL) {
+		return (NULL);
+	};
+
+	readerp->buffer = malloc(size);
+	if (readerp->buffer == NULL) {
+		free(readerp);
+		return (NULL);
+	};
+
+	readerp->fd = fd;
+	readerp->size = size;
+	readerp->line_max = line_max;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc, "line reader created: fd=%d size=%lu line_max=%lu", fd, (unsigned long int) size, (unsigned long int) line_max);
+
+	return (readerp);
+};
+
+
+/*
+ * close current input file of line reader
+ *
+ * in : readerp = pointer to reader
+ */
+static void liblineio_reader_close(s_ipv6calc_line_reader *readerp) {
+	if (readerp->map != NULL) {
+		munmap((void *) readerp->map, readerp->map_size);
+		readerp->map = NULL;
+		readerp->map_size = 0;
+	};
+
+	if ((readerp->input != NULL) && (readerp->fd >= 0) && (readerp->fd != STDIN_FILENO)) {
+		close(readerp->fd);
+	};
+
+	if (readerp->input != NULL) {
+		readerp->fd = -1;
+	};
+
+	readerp->start = 0;
+	readerp->end = 0;
+};
+
+
+/*
+ * open next input file of line reader
+ *  regular files are mapped (fallback: read), others are read ("-" is stdin)
+ *
+ * in : readerp = pointer to reader
+ * ret: 0 = ok, 1 = no more input file, -1 = error
+ */
+static int liblineio_reader_next(s_ipv6calc_line_reader *readerp) {
+	const char *name;
+	struct stat st;
+	void *map;
+
+	liblineio_reader_close(readerp);
+
+	if ((readerp->input == NULL) || (readerp->input_next >= readerp->inputs)) {
+		return (1);
+	};
+
+	name = readerp->input[readerp->input_next++];
+	readerp->flag_eof = 0;
+
+	if (strcmp(name, "-") == 0) {
+		readerp->fd = STDIN_FILENO;
+		return (0);
+	};
+
+	readerp->fd = open(name, O_RDONLY);
+	if (readerp->fd < 0) {
+		ERRORPRINT_WA("can't open input file: %s (%s)", name, strerror(errno));
+		readerp->flag_error = 1;
+		return (-1);
+	};
+
+	if ((fstat(readerp->fd, &st) == 0) && (S_ISREG(st.st_mode)) && (st.st_size > 0)) {
+		/* read-only mapping, lines are handed out in place (no copy-on-write of pages) */
+		map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, readerp->fd, 0);
+		if (map != MAP_FAILED) {
+			madvise(map, (size_t) st.st_size, MADV_SEQUENTIAL);
+			readerp->map = map;
+			readerp->map_size = (size_t) st.st_size;
+		};
+	};
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc, "input file opened: %s (%s)", name, (readerp->map != NULL) ? "mmap" : "read");
+
+	return (0);
+};
+
+
+/*
+ * open line reader for list of input files
+ *
+ * in : input = list of input files ("-" is stdin)
+ * in : inputs = amount of input files (0: stdin)
+ * in : size = size of buffer (at least line_max)
+ * in : line_max = maximum line length including terminating '\0' of a copy (longer lines are split like by fgets)
+ * ret: pointer to reader, NULL on error
+ */
+s_ipv6calc_line_reader *liblineio_reader_open(const char **input, const int inputs, const size_t size, const size_t line_max) {
+	s_ipv6calc_line_reader *readerp;
+	int i;
+
+	if (inputs == 0) {
+		return (liblineio_reader_create(STDIN_FILENO, size, line_max));
+	};
+
+	/* check all input files before start */
+	for (i = 0; i < inputs; i++) {
+		if ((strcmp(input[i], "-") != 0) && (access(input[i], R_OK) != 0)) {
+			ERRORPRINT_WA("can't open input file: %s (%s)", input[i], strerror(errno));
+			return (NULL);
+		};
+	};
+
+	readerp = liblineio_reader_create(-1, size, line_max);
+	if (readerp == NULL) {
+		return (NULL);
+	};
+
+	readerp->input = input;
+	readerp->inputs = inputs;
+
+	if (liblineio_reader_next(readerp) != 0) {
+		liblineio_reader_free(readerp);
+		return (NULL);
+	};
+
+	return (readerp);
+};
+
+
+/*
+ * free line reader
+ *
+ * in : readerp = pointer to reader (NULL is ignored)
+ */
+void liblineio_reader_free(s_ipv6calc_line_reader *readerp) {
+	if (readerp == NULL) {
+		return;
+	};
+
+	liblineio_reader_close(readerp);
+
+	free(readerp->buffer);
+	free(readerp);
+};
+
+
+/*
+ * get next line
+ *  line is not terminated by '\0' and contains '\n' if existing (like fgets)
+ *  it points into the buffer/mapping, is read-only and valid until next call
+ *  on end of an input file the next one is opened, a line never spans input files
+ *
+ * in : readerp = pointer to reader
+ * out: *linep = pointer to line
+ * ret: length of line, 0 on end of input (or error, see flag_error)
+ */
+size_t liblineio_reader_getline(s_ipv6calc_line_reader *readerp, const char **linep) {
+	const char *charptr;
+	size_t length, available;
+	ssize_t result;
+
+	while (1 == 1) {
+		if (readerp->map != NULL) {
+			/* mapped file */
+			available = readerp->map_size - readerp->start;
+
+			length = (available < readerp->line_max - 1) ? available : readerp->line_max - 1;
+			charptr = memchr(readerp->map + readerp->start, '\n', length);
+			if (charptr != NULL) {
+				length = charptr - (readerp->map + readerp->start) + 1;
+			};
+
+			if (length > 0) {
+				*linep = readerp->map + readerp->start;
+				break;
+			};
+		} else if (readerp->fd >= 0) {
+			available = readerp->end - readerp->start;
+
+			/* look for end of line within maximum line length */
+			length = (available < readerp->line_max - 1) ? available : readerp->line_max - 1;
+			charptr = memchr(readerp->buffer + readerp->start, '\n', length);
+			if (charptr != NULL) {
+				length = charptr - (readerp->buffer + readerp->start) + 1;
+				*linep = readerp->buffer + readerp->start;
+				break;
+			};
+
+			if ((length == readerp->line_max - 1) || ((readerp->flag_eof == 1) && (length > 0))) {
+				/* line too long (split) or last line without '\n' */
+				*linep = readerp->buffer + readerp->start;
+				break;
+			};
+
+			if (readerp->flag_eof == 0) {
+				/* move unconsumed data to begin of buffer */
+				if (readerp->start > 0) {
+					if (available > 0) {
+						memmove(readerp->buffer, readerp->buffer + readerp->start, available);
+					};
+					readerp->start = 0;
+					readerp->end = available;
+				};
+
+				result = read(readerp->fd, readerp->buffer + readerp->end, readerp->size - readerp->end);
+				if (result < 0) {
+					if (errno == EINTR) {
+						continue;
+					};
+					ERRORPRINT_WA("read error: %s", strerror(errno));
+					readerp->flag_error = 1;
+					readerp->flag_eof = 1;
+				} else if (result == 0) {
+					readerp->flag_eof = 1;
+				} else {
+					readerp->end += result;
+				};
+				continue;
+			};
+		};
+
+		/* end of current input, continue with next input file */
+		if (liblineio_reader_next(readerp) != 0) {
+			return (0);
+		};
+	};
+
+	readerp->start += length;
+
+	return (length);
+};
+
+
+/*
+ * check for next line available without blocking read
+ *  (e.g. to hand over collected lines early while reading from a live pipe)
+ *
+ * in : readerp = pointer to reader
+ * ret: 1 = available, 0 = next call of getline may block
+ */
+int liblineio_reader_pending(const s_ipv6calc_line_reader *readerp) {
+	size_t available;
+
+	if (readerp->map != NULL) {
+		return ((readerp->start < readerp->map_size) ? 1 : 0);
+	};
+
+	available = readerp->end - readerp->start;
+
+	if ((available == 0) || (readerp->fd < 0)) {
+		/* nothing buffered (next input file could be a pipe, too) */
+		return (0);
+	};
+
+	if ((readerp->flag_eof == 1) || (available >= readerp->line_max - 1)) {
+		/* last line without '\n' or line to be split */
+		return (1);
+	};
+
+	return ((memchr(readerp->buffer + readerp->start, '\n', available) != NULL) ? 1 : 0);
+};
+
+
+/*
+ * create line writer
+ *
+ * in : fd = file descriptor to write to
+ * in : size = size of buffer
+ * ret: pointer to writer, NULL on error
+ */
+s_ipv6calc_line_writer *liblineio_writer_create(const int fd, const size_t size) {
+	s_ipv6calc_line_writer *writerp;
+
+	writerp = calloc(1, sizeof(s_ipv6calc_line_writer));
+	if (writerp == NULL) {
+		return (NULL);
+	};
+
+	writerp->buffer = malloc(size);
+	if (writerp->buffer == NULL) {
+		free(writerp);
+		return (NULL);
+	};
+
+	writerp->fd = fd;
+	writerp->size = size;
+
+	DEBUGPRINT_WA(DEBUG_libipv6calc, "line writer created: fd=%d size=%lu", fd, (unsigned long int) size);
+
+	return (writerp);
+};
+
+
+/*
+ * write data unbuffered, retry on partial write
+ *
+ * in : writerp = pointer to writer
+ * in : data = pointer to data
+ * in : length = length of data
+ * ret: 0 = ok, -1 = error
+ */
+static int liblineio_writer_write_fd(s_ipv6calc_line_writer *writerp, const char *data, size_t length) {
+	ssize_t result;
+
+	while (length > 0) {
+		result = write(writerp->fd, data, length);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			};
+			if (writerp->flag_error == 0) {
+				ERRORPRINT_WA("write error: %s", strerror(errno));
+			};
+			writerp->flag_error = 1;
+			return (-1);
+		};
+		data += result;
+		length -= result;
+	};
+
+	return (0);
+};
+
+
+/*
+ * flush buffered data
+ *
+ * in : writerp = pointer to writer
+ * ret: 0 = ok, -1 = error
+ */
+int liblineio_writer_flush(s_ipv6calc_line_writer *writerp) {
+	int result;
+
+	result = liblineio_writer_write_fd(writerp, writerp->buffer, writerp->used);
+	writerp->used = 0;
+
+	return (result);
+};
+
+
+/*
+ * free line writer, buffered data is flushed before
+ *
+ * in : writerp = pointer to writer (NULL is ignored)
+ * ret: 0 = ok, -1 = error
+ */
+int liblineio_writer_free(s_ipv6calc_line_writer *writerp) {
+	int result;
+
+	if (writerp == NULL) {
+		return (0);
+	};
+
+	result = liblineio_writer_flush(writerp);
+
+	free(writerp->buffer);
+	free(writerp);
+
+	return (result);
+};
+
+
+/*
+ * write data (buffered)
+ *
+ * in : writerp = pointer to writer
+ * in : data = pointer to data
+ * in : length = length of data
+ * ret: 0 = ok, -1 = error
+ */
+int liblineio_writer_write(s_ipv6calc_line_writer *writerp, const char *data, const size_t length) {
+	if (writerp->used + length > writerp->size) {
+		if (liblineio_writer_flush(writerp) != 0) {
+			return (-1);
+		};
+
+		if (length >= writerp->size) {
+			/* larger than buffer, write directly */
+			return (liblineio_writer_write_fd(writerp, data, length));
+		};
+	};
+
+	memcpy(writerp->buffer + writerp->used, data, length);
+	writerp->used += length;
+
+	return (0);
+};
+
+
+/*
+ * write string (buffered)
+ *
+ * in : writerp = pointer to writer
+ * in : string = string
+ * ret: 0 = ok, -1 = error
+ */
+int liblineio_writer_puts(s_ipv6calc_line_writer *writerp, const char *string) {
+	return (liblineio_writer_write(writerp, string, strlen(string)));
+};
@@ -0,0 +1,62 @@
+/*
+ * Project    : ipv6calc
+ * File       : liblineio.h
+ * Version    : $Id$
+ *
+ * Information:
+ *  Header file for liblineio.c
+ */
+
+#include <stddef.h>
+
+#ifndef _liblineio_h
+
+#define _liblineio_h 1
+
+/* size of read/write buffer */
+#define LIBLINEIO_BUFFER_SIZE	(256 * 1024)
+
+/* maximum amount of input files */
+#define LIBLINEIO_INPUT_MAX	256
+
+/* line reader: large blocks by read() or mmap() of regular files, lines are handed out as slices (pointer and length) of the buffer/mapping */
+typedef struct {
+	int fd;
+	char *buffer;
+	size_t size;
+	size_t line_max;	// maximum length of a line including terminating '\0' of a copy (like fgets), longer lines are split
+	size_t start;		// start of unconsumed data
+	size_t end;		// end of valid data
+	int flag_eof;
+	int flag_error;
+	const char *map;	// read-only mapping of regular file (NULL: read by read())
+	size_t map_size;
+	const char **input;	// list of input files (NULL: given file descriptor only)
+	int inputs;
+	int input_next;
+} s_ipv6calc_line_reader;
+
+/* line writer: output is collected and written by large write() */
+typedef struct {
+	int fd;
+	char *buffer;
+	size_t size;
+	size_t used;
+	int flag_error;
+} s_ipv6calc_line_writer;
+
+#endif
+
+
+/* prototypes */
+extern s_ipv6calc_line_reader *liblineio_reader_create(const int fd, const size_t size, const size_t line_max);
+extern s_ipv6calc_line_reader *liblineio_reader_open(const char **input, const int inputs, const size_t size, const size_t line_max);
+extern void liblineio_reader_free(s_ipv6calc_line_reader *readerp);
+extern size_t liblineio_reader_getline(s_ipv6calc_line_reader *readerp, const char **linep);
+extern int liblineio_reader_pending(const s_ipv6calc_line_reader *readerp);
+
+extern s_ipv6calc_line_writer *liblineio_writer_create(const int fd, const size_t size);
+extern int liblineio_writer_free(s_ipv6calc_line_writer *writerp);
+extern int liblineio_writer_write(s_ipv6calc_line_writer *writerp, const char *data, const size_t length);
+extern int liblineio_writer_puts(s_ipv6calc_line_writer *writerp, const char *string);
+extern int liblineio_writer_flush(s_ipv6calc_line_writer *writerp);
@@ -20,8 +20,10 @@
  *   ipv6calcActionAsn			on
  *   ipv6calcActionRegistry		on
  *   ipv6calcCache			off (default: on)
- *   ipv6calcCacheLimit			>= IPV6CALC_CACHE_LRI_LIMIT_MIN
+ *   ipv6calcCacheLimit			IPV6CALC_CACHE_LIMIT_MIN - IPV6CALC_CACHE_LIMIT_MAX
  *   ipv6calcCacheStatisticsInterval	0:disable 
+ *   ipv6calcCacheShared			0:disable (default), <entries> (shared by all child processes)
+ *   ipv6calcLazy			on (default: off, retrieve only on access by log format %{<variable>}Z)
  *   ipv6calcDebuglevel			>0 (see defines below)
  *
  *  ipv6calc behavior can be controlled by config, e.g
@@ -43,6 +45,10 @@
 #include <http_log.h>
 #include <http_protocol.h>
 #include <apr_strings.h>
+#include <apr_shm.h>
+#include <apr_thread_proc.h>
+#include <apr_thread_mutex.h>
+#include <mod_log_config.h>
 
 // ipv6calc related includes
 #undef PACKAGE_BUGREPORT
@@ -98,8 +104,10 @@ int    longopts_maxentries = 0;
 static const char *set_ipv6calc_enable(cmd_parms *cmd, void *dummy, int arg);
 static const char *set_ipv6calc_no_fallback(cmd_parms *cmd, void *dummy, int arg);
 static const char *set_ipv6calc_cache(cmd_parms *cmd, void *dummy, int arg);
+static const char *set_ipv6calc_lazy(cmd_parms *cmd, void *dummy, int arg);
 static const char *set_ipv6calc_cache_limit(cmd_parms *cmd, void *dummy, const char *value, int arg);
 static const char *set_ipv6calc_cache_statistics_interval(cmd_parms *cmd, void *dummy, const char *value, int arg);
+static const char *set_ipv6calc_cache_shared(cmd_parms *cmd, void *dummy, const char *value, int arg);
 static const char *set_ipv6calc_debuglevel(cmd_parms *cmd, void *dummy, const char *value, int arg);
 
 static const char *set_ipv6calc_action_anonymize(cmd_parms *cmd, void *dummy, int arg);
@@ -109,29 +117,109 @@ static const char *set_ipv6calc_action_registry(cmd_parms *cmd, void *dummy, int
 
 static const char *set_ipv6calc_option(cmd_parms *cmd, void *dummy, const char *name, const char *value, int arg);
 
+static const char *ipv6calc_log_handler(request_rec *r, char *a);
+
 
 /***************************
- * Cache (Last Recently Inserted)
+ * Cache (hash table per protocol, open addressing with linear probing, CLOCK eviction)
+ *
+ * entries are stored in a fixed array (capacity = ipv6calcCacheLimit), the index
+ * table (power of 2, at least twice the capacity) contains entry numbers, removal
+ * from the index is done by backward shift (no tombstones)
  ***************************/
-#define IPV6CALC_CACHE_LRI_SIZE 200
-#define IPV6CALC_CACHE_LRI_LIMIT_MIN 20
+#define IPV6CALC_CACHE_LIMIT_MIN		20
+#define IPV6CALC_CACHE_LIMIT_DEFAULT		1024
+#define IPV6CALC_CACHE_LIMIT_MAX		100000
+
+#define IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX	8
+
+/* cached values */
+typedef struct {
+	char anon[48];
+	char cc[8];
+	char asn[12];
+	char registry[64];
+} ipv6calc_cache_value;
 
-static long int ipv6calc_cache_lri_checked[2] = {0, 0};
+typedef struct {
+	uint32_t key_addr[4];	// binary address (IPv4: key_addr[3])
+	uint32_t hash;
+	int      referenced;	// CLOCK reference bit
+	ipv6calc_cache_value value;
+} ipv6calc_cache_entry;
 
-static int      ipv6calc_cache_lri_max[2] = {0, 0};
-static int      ipv6calc_cache_lri_last[2] = {0, 0 };
-static long int ipv6calc_cache_lri_statistics[2][IPV6CALC_CACHE_LRI_SIZE];
+typedef struct {
+	ipv6calc_cache_entry *entry;
+	int32_t  *index;	// entry number, -1: empty
+	uint32_t index_mask;
+	int      capacity;
+	int      count;
+	int      hand;		// CLOCK hand
+	unsigned long int checked;
+	unsigned long int hit;
+	unsigned long int evicted;
+	unsigned long int statistics[IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX + 1]; // hits by probe distance
+} ipv6calc_cache_table;
 
-static char     ipv6calc_cache_lri_value_anon[2][IPV6CALC_CACHE_LRI_SIZE][APRMAXHOSTLEN];
-static char     ipv6calc_cache_lri_value_cc[2][IPV6CALC_CACHE_LRI_SIZE][APRMAXHOSTLEN];
-static char     ipv6calc_cache_lri_value_asn[2][IPV6CALC_CACHE_LRI_SIZE][APRMAXHOSTLEN];
-static char     ipv6calc_cache_lri_value_registry[2][IPV6CALC_CACHE_LRI_SIZE][APRMAXHOSTLEN];
 
-static struct in_addr  ipv6calc_cache_lri_ipv4_token[IPV6CALC_CACHE_LRI_SIZE];
-#if APR_HAVE_IPV6
-static struct in6_addr ipv6calc_cache_lri_ipv6_token[IPV6CALC_CACHE_LRI_SIZE];
+/***************************
+ * Per-thread data (worker/event MPM: requests of a child process are handled by several threads)
+ *
+ * created on first use in a thread, contains the database lookup context and the
+ * anonymization prefix cache bound to the thread and the cache tables of the thread,
+ * destroyed on exit of the thread
+ ***************************/
+typedef struct {
+	apr_pool_t *pool;
+	s_ipv6calc_db_wrapper_ctx db_ctx;
+	s_ipv6calc_anon_cache_ctx anon_cache_ctx;
+	ipv6calc_cache_table cache[2];
+} ipv6calc_thread_data;
+
+#if APR_HAS_THREADS
+static apr_threadkey_t *ipv6calc_thread_key = NULL;
+static apr_thread_mutex_t *ipv6calc_lookup_mutex = NULL; // lookups are serialized if a database source does not support concurrent lookups
+#else
+static ipv6calc_thread_data *ipv6calc_thread_data_single = NULL;
 #endif
 
+static int ipv6calc_thread_cache_limit = 0; // 0: no cache tables
+
+
+/***************************
+ * Shared cache (hash table in shared memory, used by all child processes)
+ *
+ * created in post_config before child processes are forked, set associative with
+ * IPV6CALC_CACHE_SHARED_WAYS entries per set, the set is selected by a hash of the
+ * binary address
+ *
+ * lock-free: each entry is protected by a sequence number (odd while written),
+ * a reader treats an entry changed while copied as miss, a writer skips the store
+ * if another writer holds the entry
+ ***************************/
+#define IPV6CALC_CACHE_SHARED_WAYS		4
+#define IPV6CALC_CACHE_SHARED_LIMIT_MIN		1024
+#define IPV6CALC_CACHE_SHARED_LIMIT_MAX		(1024 * 1024)
+
+typedef struct {
+	uint32_t seq;		// sequence number, odd while entry is written
+	uint32_t key_pi;	// proto index + 1, 0: unused
+	uint32_t key_addr[4];	// binary address (IPv4: key_addr[3])
+	ipv6calc_cache_value value;
+} ipv6calc_cache_shared_entry;
+
+typedef struct {
+	uint32_t sets;
+	unsigned long int checked;
+	unsigned long int hit;
+	unsigned long int stored;
+	unsigned long int skipped;
+	ipv6calc_cache_shared_entry entry[];
+} ipv6calc_cache_shared_table;
+
+static apr_shm_t *ipv6calc_cache_shared_shm = NULL;
+static ipv6calc_cache_shared_table *ipv6calc_cache_shared = NULL;
+
 
 /***************************
  * Static values
@@ -153,9 +241,12 @@ typedef struct {
 
 	int no_fallback;
 
+	int lazy;
+
 	int cache;
 	int cache_limit;
 	unsigned long int cache_statistics_interval;
+	int cache_shared;
 
 	uint32_t debuglevel;
 
@@ -182,6 +273,18 @@ int ipv6calc_option_list_entries = 0;
 #define mod_ipv6calc_pi_IPV4	0
 #define mod_ipv6calc_pi_IPV6	1
 
+/* values to retrieve */
+#define IPV6CALC_RETRIEVE_ANON	0x1	// anonymized address
+#define IPV6CALC_RETRIEVE_DB	0x2	// CountryCode, ASN, Registry
+#define IPV6CALC_RETRIEVE_ALL	(IPV6CALC_RETRIEVE_ANON | IPV6CALC_RETRIEVE_DB)
+
+/* values of connection (memoized for keepalive requests) */
+typedef struct {
+	const ipv6calc_server_config *config;
+	int retrieved;	// IPV6CALC_RETRIEVE_*
+	ipv6calc_cache_value value;
+} ipv6calc_conn_data;
+
 
 /*
  * Config options (ipv6calc_cmds)
@@ -190,8 +293,10 @@ static const command_rec ipv6calc_cmds[] = {
 	AP_INIT_FLAG("ipv6calcEnable", set_ipv6calc_enable, NULL, OR_FILEINFO, "Turn on mod_ipv6calc"),
 	AP_INIT_FLAG("ipv6calcNoFallback", set_ipv6calc_no_fallback, NULL, OR_FILEINFO, "Do not fallback in case of issues with mod_ipv6calc"),
 	AP_INIT_FLAG("ipv6calcCache", set_ipv6calc_cache, NULL, OR_FILEINFO, "Turn off mod_ipv6calc cache"),
+	AP_INIT_FLAG("ipv6calcLazy", set_ipv6calc_lazy, NULL, OR_FILEINFO, "Retrieve values only on access by log format %{<variable>}Z"),
 	AP_INIT_TAKE1("ipv6calcCacheLimit",  (const char *(*)()) set_ipv6calc_cache_limit, NULL, OR_FILEINFO, "mod_ipv6calc cache limit: <value>"),
 	AP_INIT_TAKE1("ipv6calcCacheStatisticsInterval",  (const char *(*)()) set_ipv6calc_cache_statistics_interval, NULL, OR_FILEINFO, "mod_ipv6calc cache statistics interval: <value> (0=disabled)"),
+	AP_INIT_TAKE1("ipv6calcCacheShared",  (const char *(*)()) set_ipv6calc_cache_shared, NULL, OR_FILEINFO, "mod_ipv6calc shared cache entries: <value> (0=disabled)"),
 	AP_INIT_TAKE1("ipv6calcDebuglevel",  (const char *(*)()) set_ipv6calc_debuglevel, NULL, OR_FILEINFO, "Debug level of module (binary or'ed): <value>"),
 	AP_INIT_FLAG("ipv6calcActionAnonymize", set_ipv6calc_action_anonymize, NULL, OR_FILEINFO, "Store anonymized IP address in IPV6CALC_CLIENT_IP_ANON"),
 	AP_INIT_FLAG("ipv6calcActionCountrycode", set_ipv6calc_action_countrycode, NULL, OR_FILEINFO, "Store Country Code of IP address in IPV6CALC_CLIENT_COUNTRYCODE"),
@@ -274,6 +379,9 @@ static int ipv6calc_support_init(server_rec *s) {
 		, "start ipv6calc database wrapper initialization"
 	);
 
+	// initialize database sources now, before worker processes are created
+	libipv6calc_db_wrapper_init_eager = 1;
+
 	result = libipv6calc_db_wrapper_init("");
 	if (result != 0) {
 		config->enabled = 0;
@@ -309,10 +417,460 @@ static int ipv6calc_support_init(server_rec *s) {
 };
 
 
+/*
+ * shared cache: cleanup on pool destroy (segment itself is destroyed by APR)
+ */
+static apr_status_t ipv6calc_cache_shared_cleanup(void *data) {
+	ipv6calc_cache_shared = NULL;
+	ipv6calc_cache_shared_shm = NULL;
+	return APR_SUCCESS;
+};
+
+
+/*
+ * shared cache: create table in anonymous shared memory
+ * in : pool = pool the shared memory is bound to
+ * in : s = server
+ * in : entries = requested amount of entries
+ * ret: 0 = ok, 1 = error
+ */
+static int ipv6calc_cache_shared_create(apr_pool_t *pool, server_rec *s, const int entries) {
+	apr_status_t status;
+	apr_size_t size;
+	uint32_t sets;
+
+	sets = (entries + IPV6CALC_CACHE_SHARED_WAYS - 1) / IPV6CALC_CACHE_SHARED_WAYS;
+	size = sizeof(ipv6calc_cache_shared_table) + (apr_size_t) sets * IPV6CALC_CACHE_SHARED_WAYS * sizeof(ipv6calc_cache_shared_entry);
+
+	status = apr_shm_create(&ipv6calc_cache_shared_shm, size, NULL, pool);
+	if (status != APR_SUCCESS) {
+		ap_log_error(APLOG_MARK, APLOG_WARNING, status, s
+			, "shared cache: can't create anonymous shared memory segment of size %lu"
+			, (unsigned long int) size
+		);
+		ipv6calc_cache_shared_shm = NULL;
+		return(1);
+	};
+
+	ipv6calc_cache_shared = (ipv6calc_cache_shared_table *) apr_shm_baseaddr_get(ipv6calc_cache_shared_shm);
+	memset(ipv6calc_cache_shared, 0, size);
+	ipv6calc_cache_shared->sets = sets;
+
+	apr_pool_cleanup_register(pool, NULL, ipv6calc_cache_shared_cleanup, apr_pool_cleanup_null);
+
+	ap_log_error(APLOG_MARK, APLOG_NOTICE, 0, s
+		, "module shared cache: ON  entries=%u  size=%lu"
+		, sets * IPV6CALC_CACHE_SHARED_WAYS
+		, (unsigned long int) size
+	);
+
+	return(0);
+};
+
+
+/*
+ * cache: hash of key
+ * in : key_pi = proto index + 1
+ * in : key_addr = binary address
+ * ret: hash
+ */
+static uint32_t ipv6calc_cache_hash(const uint32_t key_pi, const uint32_t *key_addr) {
+	uint32_t h = key_pi;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		h = (h ^ key_addr[i]) * 0x9e3779b1;
+	};
+
+	return(h ^ (h >> 16));
+};
+
+
+/*
+ * cache: set environment from cached value
+ * in : r = request
+ * in : config = server config
+ * in : value = cached value
+ * in : name = name of cache (for logging)
+ */
+static void ipv6calc_cache_set_env(request_rec *r, const ipv6calc_server_config *config, const ipv6calc_cache_value *value, const char *name) {
+	int mod_ipv6calc_APLOG_DEBUG = (config->debuglevel & IPV6CALC_DEBUG_MAP_DEBUG_TO_NOTICE) ? APLOG_NOTICE : APLOG_DEBUG;
+
+	if (config->action_countrycode == 1) {
+		ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
+			, "client IP country code (from %s): %s"
+			, name
+			, value->cc
+		);
+
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_COUNTRYCODE", value->cc);
+	} else {
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_COUNTRYCODE", "disabled");
+	};
+
+	if (config->action_asn == 1) {
+		ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
+			, "client IP ASN (from %s): %s"
+			, name
+			, value->asn
+		);
+
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_ASN", value->asn);
+	} else {
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_ASN", "disabled");
+	};
+
+	if (config->action_registry == 1) {
+		ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
+			, "client IP Registry (from %s): %s"
+			, name
+			, value->registry
+		);
+
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_REGISTRY", value->registry);
+	} else {
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_REGISTRY", "disabled");
+	};
+
+	if (config->action_anonymize == 1) {
+		ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
+			, "client IP address anonymized (from %s): %s"
+			, name
+			, value->anon
+		);
+
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", value->anon);
+		apr_table_set(r->subprocess_env, "IPV6CALC_ANON_METHOD", anon_method_name);
+	} else {
+		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", "disabled");
+		apr_table_set(r->subprocess_env, "IPV6CALC_ANON_METHOD", "disabled");
+	};
+};
+
+
+/*
+ * cache: create tables
+ * in : pool = pool for memory allocation
+ * in : cache = tables (one per protocol)
+ * in : capacity = amount of entries per protocol
+ */
+static void ipv6calc_cache_create(apr_pool_t *pool, ipv6calc_cache_table *cache, const int capacity) {
+	uint32_t index_size = 2;
+	int pi;
+
+	while (index_size < 2 * (uint32_t) capacity) {
+		index_size <<= 1;
+	};
+
+	for (pi = 0; pi < 2; pi++) {
+		memset(&cache[pi], 0, sizeof(ipv6calc_cache_table));
+		cache[pi].entry = apr_pcalloc(pool, (apr_size_t) capacity * sizeof(ipv6calc_cache_entry));
+		cache[pi].index = apr_palloc(pool, (apr_size_t) index_size * sizeof(int32_t));
+		memset(cache[pi].index, 0xff, (apr_size_t) index_size * sizeof(int32_t)); // -1
+		cache[pi].index_mask = index_size - 1;
+		cache[pi].capacity = capacity;
+	};
+};
+
+
+/*
+ * cache: lookup
+ * in : cache = tables (one per protocol)
+ * in : pi = proto index
+ * in : key_addr = binary address
+ * ret: entry (NULL = miss)
+ */
+static ipv6calc_cache_entry *ipv6calc_cache_lookup(ipv6calc_cache_table *cache, const int pi, const uint32_t *key_addr) {
+	ipv6calc_cache_table *table = &cache[pi];
+	ipv6calc_cache_entry *entry;
+	uint32_t h, i, distance = 0;
+
+	table->checked++;
+
+	h = ipv6calc_cache_hash(pi + 1, key_addr);
+
+	for (i = h & table->index_mask; table->index[i] >= 0; i = (i + 1) & table->index_mask) {
+		entry = &table->entry[table->index[i]];
+
+		if ((entry->hash == h) && (memcmp(entry->key_addr, key_addr, sizeof(entry->key_addr)) == 0)) {
+			entry->referenced = 1;
+			table->hit++;
+			table->statistics[(distance < IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX) ? distance : IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX]++;
+			return(entry);
+		};
+
+		distance++;
+	};
+
+	return(NULL);
+};
+
+
+/*
+ * cache: remove entry from index (backward shift)
+ * in : table = cache table
+ * in : n = entry number
+ */
+static void ipv6calc_cache_index_remove(ipv6calc_cache_table *table, const int32_t n) {
+	uint32_t i, j, home;
+
+	// search position of entry
+	for (i = table->entry[n].hash & table->index_mask; table->index[i] != n; i = (i + 1) & table->index_mask) {
+		if (table->index[i] < 0) {
+			// not found (should not happen)
+			return;
+		};
+	};
+
+	// shift following entries of the cluster back if their home position allows
+	for (j = (i + 1) & table->index_mask; table->index[j] >= 0; j = (j + 1) & table->index_mask) {
+		home = table->entry[table->index[j]].hash & table->index_mask;
+
+		if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+			// home position between gap and current position, stays
+			continue;
+		};
+
+		table->index[i] = table->index[j];
+		i = j;
+	};
+
+	table->index[i] = -1;
+};
+
+
+/*
+ * cache: store (an existing entry of the same address is updated)
+ * in : cache = tables (one per protocol)
+ * in : pi = proto index
+ * in : key_addr = binary address
+ * in : value = value to store
+ * ret: entry number used
+ */
+static int ipv6calc_cache_store(ipv6calc_cache_table *cache, const int pi, const uint32_t *key_addr, const ipv6calc_cache_value *value) {
+	ipv6calc_cache_table *table = &cache[pi];
+	int32_t n;
+	uint32_t i, h;
+
+	h = ipv6calc_cache_hash(pi + 1, key_addr);
+
+	for (i = h & table->index_mask; table->index[i] >= 0; i = (i + 1) & table->index_mask) {
+		n = table->index[i];
+
+		if ((table->entry[n].hash == h) && (memcmp(table->entry[n].key_addr, key_addr, sizeof(table->entry[n].key_addr)) == 0)) {
+			// already stored (e.g. by another request of the same address meanwhile)
+			table->entry[n].value = *value;
+			return(n);
+		};
+	};
+
+	if (table->count < table->capacity) {
+		// unused entry available
+		n = table->count;
+		table->count++;
+	} else {
+		// CLOCK: skip referenced entries (clearing the reference) and evict first unreferenced one
+		while (table->entry[table->hand].referenced != 0) {
+			table->entry[table->hand].referenced = 0;
+			table->hand = (table->hand + 1) % table->capacity;
+		};
+
+		n = table->hand;
+		table->hand = (table->hand + 1) % table->capacity;
+
+		ipv6calc_cache_index_remove(table, n);
+		table->evicted++;
+	};
+
+	memcpy(table->entry[n].key_addr, key_addr, sizeof(table->entry[n].key_addr));
+	table->entry[n].hash = h;
+	table->entry[n].referenced = 0;
+	table->entry[n].value = *value;
+
+	for (i = table->entry[n].hash & table->index_mask; table->index[i] >= 0; i = (i + 1) & table->index_mask);
+	table->index[i] = n;
+
+	return(n);
+};
+
+
+/*
+ * shared cache: select set by hash of key
+ * ret: pointer to first entry of set
+ */
+static ipv6calc_cache_shared_entry *ipv6calc_cache_shared_set(const uint32_t key_pi, const uint32_t *key_addr) {
+	return(&ipv6calc_cache_shared->entry[(ipv6calc_cache_hash(key_pi, key_addr) % ipv6calc_cache_shared->sets) * IPV6CALC_CACHE_SHARED_WAYS]);
+};
+
+
+/*
+ * shared cache: lookup
+ * in : key_pi = proto index + 1
+ * in : key_addr = binary address
+ * out: result = copy of entry
+ * ret: 1 = hit, 0 = miss
+ */
+static int ipv6calc_cache_shared_lookup(const uint32_t key_pi, const uint32_t *key_addr, ipv6calc_cache_shared_entry *result) {
+	ipv6calc_cache_shared_entry *set;
+	uint32_t seq;
+	int w;
+
+	set = ipv6calc_cache_shared_set(key_pi, key_addr);
+
+	for (w = 0; w < IPV6CALC_CACHE_SHARED_WAYS; w++) {
+		seq = __atomic_load_n(&set[w].seq, __ATOMIC_ACQUIRE);
+		if ((seq & 1) != 0) {
+			// entry is currently written
+			continue;
+		};
+
+		memcpy(result, &set[w], sizeof(ipv6calc_cache_shared_entry));
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&set[w].seq, __ATOMIC_RELAXED) != seq) {
+			// entry was changed while copied
+			continue;
+		};
+
+		if ((result->key_pi == key_pi) && (memcmp(result->key_addr, key_addr, sizeof(result->key_addr)) == 0)) {
+			__atomic_fetch_add(&ipv6calc_cache_shared->hit, 1, __ATOMIC_RELAXED);
+			return(1);
+		};
+	};
+
+	return(0);
+};
+
+
+/*
+ * shared cache: store
+ * in : key_pi = proto index + 1
+ * in : key_addr = binary address
+ * in : value = value to store
+ */
+static void ipv6calc_cache_shared_store(const uint32_t key_pi, const uint32_t *key_addr, const ipv6calc_cache_value *value) {
+	ipv6calc_cache_shared_entry *set, *entry = NULL;
+	uint32_t seq;
+	int w;
+
+	set = ipv6calc_cache_shared_set(key_pi, key_addr);
+
+	// select entry of same address, otherwise unused entry, otherwise replace entry selected by address
+	for (w = 0; w < IPV6CALC_CACHE_SHARED_WAYS; w++) {
+		if ((__atomic_load_n(&set[w].key_pi, __ATOMIC_RELAXED) == key_pi) && (memcmp(set[w].key_addr, key_addr, sizeof(set[w].key_addr)) == 0)) {
+			entry = &set[w];
+			break;
+		};
+	};
+
+	if (entry == NULL) {
+		for (w = 0; w < IPV6CALC_CACHE_SHARED_WAYS; w++) {
+			if (__atomic_load_n(&set[w].key_pi, __ATOMIC_RELAXED) == 0) {
+				entry = &set[w];
+				break;
+			};
+		};
+	};
+
+	if (entry == NULL) {
+		entry = &set[(key_addr[0] ^ key_addr[1] ^ key_addr[2] ^ key_addr[3]) % IPV6CALC_CACHE_SHARED_WAYS];
+	};
+
+	// acquire entry
+	seq = __atomic_load_n(&entry->seq, __ATOMIC_RELAXED);
+	if (((seq & 1) != 0) || (! __atomic_compare_exchange_n(&entry->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))) {
+		// entry is currently written by another process
+		__atomic_fetch_add(&ipv6calc_cache_shared->skipped, 1, __ATOMIC_RELAXED);
+		return;
+	};
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	entry->key_pi = key_pi;
+	memcpy(entry->key_addr, key_addr, sizeof(entry->key_addr));
+	entry->value = *value;
+
+	// release entry
+	__atomic_store_n(&entry->seq, seq + 2, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&ipv6calc_cache_shared->stored, 1, __ATOMIC_RELAXED);
+};
+
+
 /***************************
  * Hooks functions
  ***************************/
 
+/*
+ * thread data: destroy (on exit of thread)
+ * in : data = thread data
+ */
+static void ipv6calc_thread_data_destroy(void *data) {
+	ipv6calc_thread_data *thread_data = (ipv6calc_thread_data *) data;
+
+	libipv6calc_db_wrapper_ctx_bind(NULL);
+	libipv6calc_anon_cache_ctx_bind(NULL);
+
+	libipv6calc_db_wrapper_ctx_cleanup(&thread_data->db_ctx);
+	libipv6calc_anon_cache_ctx_cleanup(&thread_data->anon_cache_ctx);
+
+	apr_pool_destroy(thread_data->pool);
+};
+
+
+/*
+ * thread data: get data of calling thread, created on first use
+ *  contexts are bound to the thread, so also non-reentrant library functions (e.g. anonymization) use them
+ * ret: thread data (NULL = error)
+ */
+static ipv6calc_thread_data *ipv6calc_thread_data_get(void) {
+	ipv6calc_thread_data *thread_data = NULL;
+	apr_pool_t *pool;
+
+#if APR_HAS_THREADS
+	if ((ipv6calc_thread_key == NULL) || (apr_threadkey_private_get((void **) &thread_data, ipv6calc_thread_key) != APR_SUCCESS)) {
+		return(NULL);
+	};
+#else
+	thread_data = ipv6calc_thread_data_single;
+#endif
+
+	if (thread_data != NULL) {
+		return(thread_data);
+	};
+
+	// own pool, not related to pools of other threads
+	if (apr_pool_create(&pool, NULL) != APR_SUCCESS) {
+		return(NULL);
+	};
+
+	thread_data = apr_pcalloc(pool, sizeof(ipv6calc_thread_data));
+	thread_data->pool = pool;
+
+	if (libipv6calc_db_wrapper_ctx_init(&thread_data->db_ctx) != 0) {
+		apr_pool_destroy(pool);
+		return(NULL);
+	};
+
+	libipv6calc_db_wrapper_ctx_bind(&thread_data->db_ctx);
+	libipv6calc_anon_cache_ctx_bind(&thread_data->anon_cache_ctx);
+
+	if (ipv6calc_thread_cache_limit > 0) {
+		ipv6calc_cache_create(pool, thread_data->cache, ipv6calc_thread_cache_limit);
+	};
+
+#if APR_HAS_THREADS
+	if (apr_threadkey_private_set(thread_data, ipv6calc_thread_key) != APR_SUCCESS) {
+		ipv6calc_thread_data_destroy(thread_data);
+		return(NULL);
+	};
+#else
+	ipv6calc_thread_data_single = thread_data;
+#endif
+
+	return(thread_data);
+};
+
+
 /*
  * ipv6calc_cleanup
  */
@@ -322,6 +880,22 @@ static apr_status_t ipv6calc_cleanup(void *cfgdata) {
 	return APR_SUCCESS;
 };
 
+/*
+ * ipv6calc_pre_config
+ */
+static int ipv6calc_pre_config(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t *ptemp) {
+	APR_OPTIONAL_FN_TYPE(ap_register_log_handler) *log_pfn_register;
+
+	// register log format %{<variable>}Z
+	log_pfn_register = APR_RETRIEVE_OPTIONAL_FN(ap_register_log_handler);
+	if (log_pfn_register) {
+		log_pfn_register(pconf, "Z", ipv6calc_log_handler, 0);
+	};
+
+	return OK;
+};
+
+
 /*
  * ipv6calc_post_config
  */
@@ -381,6 +955,12 @@ static int ipv6calc_post_config(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t
 		, (config->action_registry > 0) ? "ON" : "OFF"
 	);
 
+	if (config->lazy == 1) {
+		ap_log_error(APLOG_MARK, APLOG_NOTICE, 0, s
+			, "module lazy retrieval: ON (values only available by log format %%{<variable>}Z)"
+		);
+	};
+
 	ap_log_error(APLOG_MARK, APLOG_NOTICE, 0, s
 		, "%s module debug level: 0x%08x (%d)"
 		, (config->debuglevel == 0) ? "default" : "configured"
@@ -396,7 +976,7 @@ static int ipv6calc_post_config(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t
 		ap_log_error(APLOG_MARK, APLOG_NOTICE, 0, s
 			, "module cache: ON (default)  limit=%d (%s)  statistics_interval=%lu (%s)"
 			, config->cache_limit
-			, (config->cache_limit == IPV6CALC_CACHE_LRI_LIMIT_MIN) ? "default/minimum" : "configured"
+			, (config->cache_limit == IPV6CALC_CACHE_LIMIT_DEFAULT) ? "default" : "configured"
 			, config->cache_statistics_interval
 			, (config->cache_statistics_interval == 0) ? "default" : "configured"
 		);
@@ -408,6 +988,25 @@ static int ipv6calc_post_config(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t
 		return(1);
 	};
 
+	if ((config->cache == 1) && (config->cache_shared > 0)) {
+		if (ipv6calc_cache_shared_create(pconf, s, config->cache_shared) != 0) {
+			if (config->no_fallback) {
+				ap_log_error(APLOG_MARK, APLOG_ERR, 0, s
+					, "shared cache creation failed (NO-FALLBACK activated, STOP NOW)"
+				);
+				return(1);
+			};
+
+			ap_log_error(APLOG_MARK, APLOG_WARNING, 0, s
+				, "shared cache creation failed (continue without)"
+			);
+		};
+	} else {
+		ap_log_error(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, s
+			, "module shared cache: OFF"
+		);
+	};
+
 	string[0] = '\0';
 	libipv6calc_db_wrapper_features(string, sizeof(string));
 	ap_log_error(APLOG_MARK, APLOG_NOTICE, 0, s
@@ -509,6 +1108,43 @@ static void ipv6calc_child_init(apr_pool_t *p, server_rec *s) {
 
 	ipv6calc_support_init(s);
 
+	if (config->cache == 1) {
+		ipv6calc_thread_cache_limit = config->cache_limit;
+	};
+
+#if APR_HAS_THREADS
+	if (apr_threadkey_private_create(&ipv6calc_thread_key, ipv6calc_thread_data_destroy, p) != APR_SUCCESS) {
+		ap_log_error(APLOG_MARK, APLOG_ERR, 0, s
+			, "can't create key for thread data (disable module now)"
+		);
+		config->enabled = 0;
+		return;
+	};
+
+	if (libipv6calc_db_wrapper_ctx_threadsafe() == 0) {
+		ap_log_error(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, s
+			, "database source does not support concurrent lookups, serialize them"
+		);
+
+		if (apr_thread_mutex_create(&ipv6calc_lookup_mutex, APR_THREAD_MUTEX_DEFAULT, p) != APR_SUCCESS) {
+			ap_log_error(APLOG_MARK, APLOG_ERR, 0, s
+				, "can't create lookup mutex (disable module now)"
+			);
+			config->enabled = 0;
+			return;
+		};
+	};
+#endif
+
+	// data of this thread, also prepares lookup structures before threads are started
+	if (ipv6calc_thread_data_get() == NULL) {
+		ap_log_error(APLOG_MARK, APLOG_ERR, 0, s
+			, "can't create thread data (disable module now)"
+		);
+		config->enabled = 0;
+		return;
+	};
+
 	/* check for KeepTypeAsnCC support */
 	if ((libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV4_REQ_DB) == 1) \
 	    && (libipv6calc_db_wrapper_has_features(ANON_METHOD_KEEPTYPEASNCC_IPV6_REQ_DB) == 1)) {
@@ -529,18 +1165,24 @@ static void ipv6calc_child_init(apr_pool_t *p, server_rec *s) {
 
 
 /*
- * ipv6calc_post_read_request  (ACTION CODE)
+ * retrieve values of client IP address
+ *  lookup in cache (returns all values on hit), otherwise retrieve requested values,
+ *  store in cache once all values are retrieved
+ * in : r = request
+ * in : config = server config
+ * in : retrieve = values to retrieve (IPV6CALC_RETRIEVE_*)
+ * mod: retrieved = values already retrieved (IPV6CALC_RETRIEVE_*)
+ * mod: value = values
  */
-static int ipv6calc_post_read_request(request_rec *r) {
-	int i, hit;
+static void ipv6calc_retrieve(request_rec *r, const ipv6calc_server_config *config, const int retrieve, int *retrieved, ipv6calc_cache_value *value) {
+	int i;
 	int pi; // proto index (0:IPv4, 1:IPv6
 	int p_mapped; // proto mapped (IPv6 in IPv4)
 
-	int mod_ipv6calc_APLOG_DEBUG = APLOG_DEBUG;
+	int mod_ipv6calc_APLOG_DEBUG = (config->debuglevel & IPV6CALC_DEBUG_MAP_DEBUG_TO_NOTICE) ? APLOG_NOTICE : APLOG_DEBUG;
 
 	// Apache/APR related includes
 	apr_sockaddr_t *client_addr_p; // structure defined in apr_network_io.h
-	ipv6calc_server_config* config;
 
 	// ipv6calc related
 	ipv6calc_ipaddr ipaddr;
@@ -551,25 +1193,33 @@ static int ipv6calc_post_read_request(request_rec *r) {
 
 	// workflow related
 	char client_addr_string_anonymized[APRMAXHOSTLEN];
-	char cc[APRMAXHOSTLEN];
-	char asn[APRMAXHOSTLEN];
-	char registry[APRMAXHOSTLEN];
+	char cc[APRMAXHOSTLEN] = "";
+	char asn[APRMAXHOSTLEN] = "";
+	char registry[APRMAXHOSTLEN] = "";
+	const char *result_anon_p = "";
 	unsigned int data_source;
+	int truncated = 0;
+
+	// cache related
+	uint32_t cache_key_addr[4] = { 0, 0, 0, 0 };
+	ipv6calc_cache_table *cache;
+	ipv6calc_cache_entry *cache_entry;
+	unsigned long int cache_shared_checked;
+	ipv6calc_cache_shared_entry cache_shared_entry;
 
 	int result;
 
-	// *** workflow
-	// get config	
-	config = (ipv6calc_server_config*) ap_get_module_config(r->server->module_config, &ipv6calc_module);
+	// lookup contexts and cache of this thread
+	ipv6calc_thread_data *thread_data = ipv6calc_thread_data_get();
 
-	// check enabled	
-	if (config->enabled == 0) {
-		return OK;
+	if (thread_data == NULL) {
+		ap_log_rerror(APLOG_MARK, APLOG_ERR, 0, r
+			, "can't get thread data, skip retrieval"
+		);
+		return;
 	};
 
-	if (config->debuglevel & IPV6CALC_DEBUG_MAP_DEBUG_TO_NOTICE) {
-		mod_ipv6calc_APLOG_DEBUG = APLOG_NOTICE;
-	};
+	cache = thread_data->cache;
 
 	// get client address (aka REMOTE_IP)
 #if (((AP_SERVER_MAJORVERSION_NUMBER == 2) && (AP_SERVER_MINORVERSION_NUMBER >= 4)) || (AP_SERVER_MAJORVERSION_NUMBER > 2))
@@ -614,200 +1264,120 @@ static int ipv6calc_post_read_request(request_rec *r) {
 #endif
 	} else {
 		// unsupported family, do nothing
-		return OK;
+		return;
 	};
 
-	/* cache lookup */
-	if (config->cache == 1) {
-		hit = -1;
-
+	/* cache key (also required for store after values were retrieved by several calls) */
+	if ((pi == mod_ipv6calc_pi_IPV4) && (p_mapped == 0)) {
+		cache_key_addr[3] = client_addr_p->sa.sin.sin_addr.s_addr;
 #if APR_HAVE_IPV6
-#define IPV6CALC_COMPARE(entry) \
-			     (    pi == mod_ipv6calc_pi_IPV4 \
-			       && ( \
-				      (p_mapped == 0 && ipv6calc_cache_lri_ipv4_token[entry].s_addr == client_addr_p->sa.sin.sin_addr.s_addr) \
-				   || (p_mapped == 1 && ipv6calc_cache_lri_ipv4_token[entry].s_addr == client_addr_p->sa.sin6.sin6_addr.s6_addr32[3]) \
-				  ) \
-			     ) \
-			  || (    pi == mod_ipv6calc_pi_IPV6 \
-			       && ipv6calc_cache_lri_ipv6_token[entry].s6_addr32[3] == client_addr_p->sa.sin6.sin6_addr.s6_addr32[3] \
-			       && ipv6calc_cache_lri_ipv6_token[entry].s6_addr32[2] == client_addr_p->sa.sin6.sin6_addr.s6_addr32[2] \
-			       && ipv6calc_cache_lri_ipv6_token[entry].s6_addr32[1] == client_addr_p->sa.sin6.sin6_addr.s6_addr32[1] \
-			       && ipv6calc_cache_lri_ipv6_token[entry].s6_addr32[0] == client_addr_p->sa.sin6.sin6_addr.s6_addr32[0] \
-			     )
-#else
-#define IPV6CALC_COMPARE(entry) \
-			     (    pi == mod_ipv6calc_pi_IPV4 \
-			       && ipv6calc_cache_lri_ipv4_token[entry].s_addr == client_addr_p->sa.sin.sin_addr.s_addr \
-			     )
+	} else if (pi == mod_ipv6calc_pi_IPV4) {
+		cache_key_addr[3] = client_addr_p->sa.sin6.sin6_addr.s6_addr32[3];
+	} else if (pi == mod_ipv6calc_pi_IPV6) {
+		memcpy(cache_key_addr, client_addr_p->sa.sin6.sin6_addr.s6_addr32, sizeof(cache_key_addr));
 #endif
+	};
 
+	/* cache lookup */
+	if ((config->cache == 1) && (*retrieved == 0)) {
+		if (config->debuglevel & IPV6CALC_DEBUG_CACHE_LOOKUP) {
+			ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
+				, "IPv%s address to lookup in cache: %08x %08x %08x %08x"
+				, (pi == 0) ? "4" : "6"
+				, cache_key_addr[0]
+				, cache_key_addr[1]
+				, cache_key_addr[2]
+				, cache_key_addr[3]
+			);
+		};
 
-		if (ipv6calc_cache_lri_max[pi] > 0) {
-			ipv6calc_cache_lri_checked[pi]++;
-
-			if (config->debuglevel & IPV6CALC_DEBUG_CACHE_LOOKUP) {
-				if (pi == mod_ipv6calc_pi_IPV4) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "IPv4 address to lookup in cache: %08x"
-						, (p_mapped == 0) ? client_addr_p->sa.sin.sin_addr.s_addr : client_addr_p->sa.sin6.sin6_addr.s6_addr32[3]
-					);
-				} else if (pi == mod_ipv6calc_pi_IPV6) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "IPv6 address to lookup in cache: %08x %08x %08x %08x"
-						, client_addr_p->sa.sin6.sin6_addr.s6_addr32[0]
-						, client_addr_p->sa.sin6.sin6_addr.s6_addr32[1]
-						, client_addr_p->sa.sin6.sin6_addr.s6_addr32[2]
-						, client_addr_p->sa.sin6.sin6_addr.s6_addr32[3]
-					);
-				};
-			};
-
-			if (config->debuglevel & IPV6CALC_DEBUG_CACHE_ENTRIES) {
-				for (i = 0; i < ipv6calc_cache_lri_max[pi]; i++) {
-					if (pi == mod_ipv6calc_pi_IPV4) {
-						ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-							, "IPv4 address in cache       %3d: %08x"
-							, i
-							, ipv6calc_cache_lri_ipv4_token[i].s_addr
-						);
-					} else if (pi == mod_ipv6calc_pi_IPV6) {
-						ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-							, "IPv6 address in cache       %3d: %08x %08x %08x %08x"
-							, i
-							, ipv6calc_cache_lri_ipv6_token[i].s6_addr32[0]
-							, ipv6calc_cache_lri_ipv6_token[i].s6_addr32[1]
-							, ipv6calc_cache_lri_ipv6_token[i].s6_addr32[2]
-							, ipv6calc_cache_lri_ipv6_token[i].s6_addr32[3]
-						);
-					};
-				};
-			};
-
-			if (config->debuglevel & IPV6CALC_DEBUG_CACHE_LOOKUP) {
+		if (config->debuglevel & IPV6CALC_DEBUG_CACHE_ENTRIES) {
+			for (i = 0; i < cache[pi].count; i++) {
 				ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-					, "check for IPv%s address in cache on last inserted entry: %d"
+					, "IPv%s address in cache       %5d: %08x %08x %08x %08x  referenced=%d"
 					, (pi == 0) ? "4" : "6"
-					, ipv6calc_cache_lri_last[pi] - 1
+					, i
+					, cache[pi].entry[i].key_addr[0]
+					, cache[pi].entry[i].key_addr[1]
+					, cache[pi].entry[i].key_addr[2]
+					, cache[pi].entry[i].key_addr[3]
+					, cache[pi].entry[i].referenced
 				);
 			};
+		};
 
-			/* check last seen one first */
-			if (IPV6CALC_COMPARE(ipv6calc_cache_lri_last[pi] - 1)) {
-				ipv6calc_cache_lri_statistics[pi][0]++;
-				hit = ipv6calc_cache_lri_last[pi] - 1;
-			};
+		cache_entry = ipv6calc_cache_lookup(cache, pi, cache_key_addr);
 
-			/* run backwards to first entry */
-			if ((hit < 0) && (ipv6calc_cache_lri_last[pi] > 1)) {
-				if (config->debuglevel & IPV6CALC_DEBUG_CACHE_LOOKUP) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "check for IPv%s address in cache backwards to first entry"
-						, (pi == 0) ? "4" : "6"
-					);
-				};
+		if (cache_entry != NULL) {
+			ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
+				, "retrieve data of IPv%s address from cache entry: %d"
+				, (pi == 0) ? "4" : "6"
+				, (int) (cache_entry - cache[pi].entry)
+			);
 
-				for (i = ipv6calc_cache_lri_last[pi] - 1; i > 0; i--) {
-					if (IPV6CALC_COMPARE(i - 1)) {
-						ipv6calc_cache_lri_statistics[pi][ipv6calc_cache_lri_last[pi] - i]++;
-						hit = i - 1;
-						break;
-					};
-				};
-			};
+			*value = cache_entry->value;
+			*retrieved = IPV6CALC_RETRIEVE_ALL;
+			return;
+		};
 
-			/* round robin */ 
-			if ((hit < 0) && (ipv6calc_cache_lri_last[pi] < ipv6calc_cache_lri_max[pi])) {
-				if (config->debuglevel & IPV6CALC_DEBUG_CACHE_LOOKUP) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "check for IPv%s address in cache round robin from last entry"
-						, (pi == 0) ? "4" : "6"
-					);
-				};
+		// print cache statistics
+		if (	config->cache_statistics_interval > 0
+		    &&  ((cache[pi].checked % config->cache_statistics_interval) == 0)
+		) {
+			ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
+				, "cache statistics for IPv%s: checked=%lu hit=%lu (%2lu%%) entries=%d/%d evicted=%lu"
+				, (pi == 0) ? "4" : "6"
+				, cache[pi].checked
+				, cache[pi].hit
+				, (cache[pi].hit * 100) / cache[pi].checked
+				, cache[pi].count
+				, cache[pi].capacity
+				, cache[pi].evicted
+			);
 
-				for (i = ipv6calc_cache_lri_max[pi]; i > ipv6calc_cache_lri_last[pi]; i--) {
-					if (IPV6CALC_COMPARE(i - 1)) {
-						ipv6calc_cache_lri_statistics[pi][ipv6calc_cache_lri_max[pi] - i + ipv6calc_cache_lri_last[pi]]++;
-						hit = i - 1;
-						break;
-					};
-				};
+			for (i = 0; i <= IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX; i++) {
+				ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
+					, "cache hit statistics for IPv%s: probe distance %s%d: %lu / %lu (%2lu%%)"
+					, (pi == 0) ? "4" : "6"
+					, (i == IPV6CALC_CACHE_STATISTICS_DISTANCE_MAX) ? ">=" : "  "
+					, i
+					, cache[pi].statistics[i]
+					, cache[pi].checked
+					, (cache[pi].statistics[i] * 100) / cache[pi].checked
+				);
 			};
+		};
+
+		/* shared cache lookup */
+		if (ipv6calc_cache_shared != NULL) {
+			cache_shared_checked = __atomic_add_fetch(&ipv6calc_cache_shared->checked, 1, __ATOMIC_RELAXED);
 
-			if (hit >= 0) {
+			if (ipv6calc_cache_shared_lookup(pi + 1, cache_key_addr, &cache_shared_entry) == 1) {
 				ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
-					, "retrieve data of IPv%s address from cache position: %d"
+					, "retrieve data of IPv%s address from shared cache"
 					, (pi == 0) ? "4" : "6"
-					, hit
 				);
 
-				if (config->action_countrycode == 1) {
-					ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
-						, "client IP country code (from cache): %s"
-						, ipv6calc_cache_lri_value_cc[pi][hit]
-					);
-
-					apr_table_set(r->subprocess_env
-						, "IPV6CALC_CLIENT_COUNTRYCODE"
-						, ipv6calc_cache_lri_value_cc[pi][hit]
-					); 
-				};
-
-				if (config->action_asn == 1) {
-					ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
-						, "client IP ASN (from cache): %s"
-						, ipv6calc_cache_lri_value_asn[pi][hit]
-					);
-
-					apr_table_set(r->subprocess_env
-						, "IPV6CALC_CLIENT_ASN"
-						, ipv6calc_cache_lri_value_asn[pi][hit]
-					); 
-				};
-
-				if (config->action_registry == 1) {
-					ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
-						, "client IP Registry (from cache): %s"
-						, ipv6calc_cache_lri_value_registry[pi][hit]
-					);
+				// store also in cache of this process
+				ipv6calc_cache_store(cache, pi, cache_key_addr, &cache_shared_entry.value);
 
-					apr_table_set(r->subprocess_env
-						, "IPV6CALC_CLIENT_REGISTRY"
-						, ipv6calc_cache_lri_value_registry[pi][hit]
-					); 
-				};
-
-				if (config->action_anonymize == 1) {
-					ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
-						, "client IP address anonymized (from cache): %s"
-						, ipv6calc_cache_lri_value_anon[pi][hit]
-					);
-
-					apr_table_set(r->subprocess_env
-						, "IPV6CALC_CLIENT_IP_ANON"
-						, ipv6calc_cache_lri_value_anon[pi][hit]
-					); 
-
-					apr_table_set(r->subprocess_env, "IPV6CALC_ANON_METHOD", anon_method_name);
-				};
-
-				return OK;
+				*value = cache_shared_entry.value;
+				*retrieved = IPV6CALC_RETRIEVE_ALL;
+				return;
 			};
 
-			// print cache statistics
+			// print shared cache statistics
 			if (	config->cache_statistics_interval > 0
-			    &&  ((ipv6calc_cache_lri_checked[pi] % config->cache_statistics_interval) == 0)
+			    &&  ((cache_shared_checked % config->cache_statistics_interval) == 0)
 			) {
-				for (i = 0; i < config->cache_limit; i++) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "cache hit statistics for IPv%s: distance %3d: %lu / %lu (%2lu%%)"
-						, (pi == 0) ? "4" : "6"
-						, i
-						, ipv6calc_cache_lri_statistics[pi][i]
-						, ipv6calc_cache_lri_checked[pi]
-						, (ipv6calc_cache_lri_statistics[pi][i] * 100) / ipv6calc_cache_lri_checked[pi]
-					);
-				};
+				ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
+					, "shared cache statistics: checked=%lu hit=%lu (%2lu%%) stored=%lu skipped=%lu"
+					, cache_shared_checked
+					, ipv6calc_cache_shared->hit
+					, (ipv6calc_cache_shared->hit * 100) / cache_shared_checked
+					, ipv6calc_cache_shared->stored
+					, ipv6calc_cache_shared->skipped
+				);
 			};
 		};
 	};
@@ -838,52 +1408,20 @@ static int ipv6calc_post_read_request(request_rec *r) {
 #endif
 	};
 
-	/* store address in cache */
-	if (config->cache == 1) {
-		if (ipv6calc_cache_lri_max[pi] < config->cache_limit) {
-			ipv6calc_cache_lri_last[pi]++;
-			ipv6calc_cache_lri_max[pi]++;
-		} else {
-			if (ipv6calc_cache_lri_last[pi] == config->cache_limit) {
-				ipv6calc_cache_lri_last[pi] = 1;
-			} else {
-				ipv6calc_cache_lri_last[pi]++;
-			};
-		};
-
-		if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
-			ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-				, "store IPv%s address in cache on position: %d"
-				, (pi == 0) ? "4" : "6"
-				, ipv6calc_cache_lri_last[pi] - 1
-			);
-		};
-
-		if (pi == mod_ipv6calc_pi_IPV4) {
-			// store token
-			if (p_mapped == 0) {
-				ipv6calc_cache_lri_ipv4_token[ipv6calc_cache_lri_last[pi] - 1] = client_addr_p->sa.sin.sin_addr;
-			} else {
-				ipv6calc_cache_lri_ipv4_token[ipv6calc_cache_lri_last[pi] - 1].s_addr = client_addr_p->sa.sin6.sin6_addr.s6_addr32[3];
-			};
-#if APR_HAVE_IPV6
-		} else if (pi == mod_ipv6calc_pi_IPV6) {
-			// store token
-			ipv6calc_cache_lri_ipv6_token[ipv6calc_cache_lri_last[pi] - 1] = client_addr_p->sa.sin6.sin6_addr;
-#endif
-		};
+#if APR_HAS_THREADS
+	if (ipv6calc_lookup_mutex != NULL) {
+		apr_thread_mutex_lock(ipv6calc_lookup_mutex);
 	};
+#endif
 
 	// retrieve data
-	int result_cc = -1;
 	int result_registry = -1;
 	const char *data_source_string = "-";
 	uint32_t asn_num = 0;
+	uint16_t cc_index = COUNTRYCODE_INDEX_UNKNOWN;
+	int registry_num = REGISTRY_UNKNOWN;
 
-	if (	(config->action_countrycode == 1)
-	     ||	(config->action_asn == 1)
-	     ||	(config->action_registry == 1)
-	) {
+	if ((retrieve & IPV6CALC_RETRIEVE_DB) != 0) {
 		int retrieve_cc = 0;
 		int retrieve_asn = 0;
 		int retrieve_registry = 0;
@@ -928,12 +1466,34 @@ static int ipv6calc_post_read_request(request_rec *r) {
 			);
 		};
 
+		if (config->action_countrycode == 0) {
+			retrieve_cc = 0;
+		};
+
+		if (config->action_asn == 0) {
+			retrieve_asn = 0;
+		};
+
+		if (config->action_registry == 0) {
+			retrieve_registry = 0;
+		};
+
+		// retrieve CountryCode, ASN and Registry in one run
+		if ((retrieve_cc != 0) || (retrieve_asn != 0) || (retrieve_registry != 0)) {
+			libipv6calc_db_wrapper_all_by_addr_r(&thread_data->db_ctx, &ipaddr
+				, (retrieve_cc != 0) ? &cc_index : NULL
+				, (retrieve_cc != 0) ? &data_source : NULL
+				, (retrieve_asn != 0) ? &asn_num : NULL
+				, (retrieve_registry != 0) ? &registry_num : NULL
+				, NULL
+			);
+		};
+
 		// set country code of IP in environment
 		if (config->action_countrycode == 1) {
 			if (retrieve_cc != 0) {
-				result_cc = libipv6calc_db_wrapper_country_code_by_addr(cc, sizeof(cc), &ipaddr, &data_source);
-
-				if ((result_cc == 0) && (strlen(cc) > 0)) {
+				if (cc_index <= COUNTRYCODE_INDEX_LETTER_MAX) {
+					libipv6calc_db_wrapper_country_code_by_cc_index(cc, sizeof(cc), cc_index);
 					data_source_string = libipv6calc_db_wrapper_get_data_source_name_by_number(data_source);
 				} else {
 					snprintf(cc, sizeof(cc), "%s", "-");
@@ -947,27 +1507,11 @@ static int ipv6calc_post_read_request(request_rec *r) {
 			} else {
 				snprintf(cc, sizeof(cc), "%s", "-");
 			};
-
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_COUNTRYCODE", cc); 
-
-			if (config->cache == 1) {
-				// store value
-				snprintf(ipv6calc_cache_lri_value_cc[pi][ipv6calc_cache_lri_last[pi] - 1], sizeof(ipv6calc_cache_lri_value_cc[pi][ipv6calc_cache_lri_last[pi] - 1]), "%s", cc);
-				if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "store CountryCode of IPv%s address in cache on position: %d"
-						, (pi == 0) ? "4" : "6"
-						, ipv6calc_cache_lri_last[pi] - 1
-					);
-				};
-			};
 		};
 
 		// set ASN of IP in environment
 		if (config->action_asn == 1) {
 			if (retrieve_asn != 0) {
-				asn_num = libipv6calc_db_wrapper_as_num32_by_addr(&ipaddr);
-
 				snprintf(asn, sizeof(asn), "%u", asn_num);
 
 				ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
@@ -977,26 +1521,18 @@ static int ipv6calc_post_read_request(request_rec *r) {
 			} else {
 				snprintf(asn, sizeof(asn), "-");
 			};
-
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_ASN", asn); 
-
-			if (config->cache == 1) {
-				// store value
-				snprintf(ipv6calc_cache_lri_value_asn[pi][ipv6calc_cache_lri_last[pi] - 1], sizeof(ipv6calc_cache_lri_value_asn[pi][ipv6calc_cache_lri_last[pi] - 1]), "%s", asn);
-				if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "store ASN of IPv%s address in cache on position: %d"
-						, (pi == 0) ? "4" : "6"
-						, ipv6calc_cache_lri_last[pi] - 1
-					);
-				};
-			};
 		};
 
 		// set Registry of IP in environment
 		if (config->action_registry == 1) {
 			if (retrieve_registry != 0) {
-				result_registry = libipv6calc_db_wrapper_registry_string_by_ipaddr(&ipaddr, registry, sizeof(registry));
+				if (registry_num == REGISTRY_RESERVED) {
+					// retrieve detailed reserved information
+					result_registry = libipv6calc_db_wrapper_registry_string_by_ipaddr(&ipaddr, registry, sizeof(registry));
+				} else {
+					snprintf(registry, sizeof(registry), "%s", libipv6calc_registry_string_by_num(registry_num));
+					result_registry = (registry_num != REGISTRY_UNKNOWN) ? 0 : 1;
+				};
 
 				if (((result_registry == 0) || (result_registry == 2)) && (strlen(registry) > 0)) {
 					// everything ok
@@ -1011,39 +1547,16 @@ static int ipv6calc_post_read_request(request_rec *r) {
 			} else {
 				snprintf(registry, sizeof(registry), "%s", "-");
 			};
-
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_REGISTRY", registry); 
-
-			if (config->cache == 1) {
-				// store value
-				snprintf(ipv6calc_cache_lri_value_registry[pi][ipv6calc_cache_lri_last[pi] - 1], sizeof(ipv6calc_cache_lri_value_asn[pi][ipv6calc_cache_lri_last[pi] - 1]), "%s", registry);
-				if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
-					ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-						, "store Registry of IPv%s address in cache on position: %d"
-						, (pi == 0) ? "4" : "6"
-						, ipv6calc_cache_lri_last[pi] - 1
-					);
-				};
-			};
 		};
-	};
-
-	// set special value if not enabled
-	if (config->action_countrycode == 0) {
-		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_COUNTRYCODE", "disabled"); 
-	};
-
-	if (config->action_asn == 0) {
-		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_ASN", "disabled"); 
-	};
 
-	if (config->action_registry == 0)  {
-		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_REGISTRY", "disabled"); 
+		truncated |= (snprintf(value->cc, sizeof(value->cc), "%s", cc) >= (int) sizeof(value->cc));
+		truncated |= (snprintf(value->asn, sizeof(value->asn), "%s", asn) >= (int) sizeof(value->asn));
+		truncated |= (snprintf(value->registry, sizeof(value->registry), "%s", registry) >= (int) sizeof(value->registry));
+		*retrieved |= IPV6CALC_RETRIEVE_DB;
 	};
 
-
-	// set anonymized IP address in environment
-	if (config->action_anonymize == 1) {
+	// anonymize IP address
+	if ((retrieve & IPV6CALC_RETRIEVE_ANON) != 0) {
 		if (pi == mod_ipv6calc_pi_IPV4) {
 			libipv4addr_anonymize(&ipv4addr, config->ipv6calc_anon_set.mask_ipv4, config->ipv6calc_anon_set.method);
 			CONVERT_IPV4ADDRP_IPADDR(&ipv4addr, ipaddr);
@@ -1062,48 +1575,185 @@ static int ipv6calc_post_read_request(request_rec *r) {
 		// get address string
 		result = libipaddr_ipaddrstruct_to_string(&ipaddr, client_addr_string_anonymized, sizeof(client_addr_string_anonymized), 0); 
 
-		char *result_anon_p;
-
 		if (result == 0) {
 			ap_log_rerror(APLOG_MARK, mod_ipv6calc_APLOG_DEBUG, 0, r
 				, "client IP address anonymized: %s"
 				, client_addr_string_anonymized
 			);
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", client_addr_string_anonymized);
 			result_anon_p = client_addr_string_anonymized;
-
-			apr_table_set(r->subprocess_env, "IPV6CALC_ANON_METHOD", anon_method_name);
 		} else {
 #if (((AP_SERVER_MAJORVERSION_NUMBER == 2) && (AP_SERVER_MINORVERSION_NUMBER >= 4)) || (AP_SERVER_MAJORVERSION_NUMBER > 2))
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", r->connection->client_ip); 
 			result_anon_p = r->connection->client_ip;
 #else
-			apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", r->connection->remote_ip);
 			result_anon_p = r->connection->remote_ip;
 #endif
 		};
 
-		if (config->cache == 1) {
-			// store value
-			snprintf(ipv6calc_cache_lri_value_anon[pi][ipv6calc_cache_lri_last[pi] - 1], sizeof(ipv6calc_cache_lri_value_anon[pi][ipv6calc_cache_lri_last[pi] - 1]), "%s", result_anon_p);
+		truncated |= (snprintf(value->anon, sizeof(value->anon), "%s", result_anon_p) >= (int) sizeof(value->anon));
+		*retrieved |= IPV6CALC_RETRIEVE_ANON;
+	};
+
+#if APR_HAS_THREADS
+	if (ipv6calc_lookup_mutex != NULL) {
+		apr_thread_mutex_unlock(ipv6calc_lookup_mutex);
+	};
+#endif
+
+	/* store values in cache */
+	if ((config->cache == 1) && (*retrieved == IPV6CALC_RETRIEVE_ALL)) {
+		if (truncated == 0) {
+			result = ipv6calc_cache_store(cache, pi, cache_key_addr, value);
 
 			if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
 				ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
-					, "store anonymized IPv%s address in cache on position: %d"
+					, "store IPv%s address in cache entry: %d"
 					, (pi == 0) ? "4" : "6"
-					, ipv6calc_cache_lri_last[pi] - 1
+					, result
 				);
 			};
+
+			if (ipv6calc_cache_shared != NULL) {
+				ipv6calc_cache_shared_store(pi + 1, cache_key_addr, value);
+			};
+		} else if (config->debuglevel & IPV6CALC_DEBUG_CACHE_STORE) {
+			ap_log_rerror(APLOG_MARK, APLOG_NOTICE, 0, r
+				, "IPv%s address not stored in cache, value too long"
+				, (pi == 0) ? "4" : "6"
+			);
 		};
-	} else {
-		apr_table_set(r->subprocess_env, "IPV6CALC_CLIENT_IP_ANON", "disabled"); 
-		apr_table_set(r->subprocess_env, "IPV6CALC_ANON_METHOD", "disabled");
+	};
+};
+
+
+/*
+ * get values of connection (memoized for keepalive requests)
+ * in : r = request
+ * in : config = server config
+ * ret: connection data
+ */
+static ipv6calc_conn_data *ipv6calc_conn_data_get(request_rec *r, const ipv6calc_server_config *config) {
+	ipv6calc_conn_data *conn_data;
+
+	conn_data = (ipv6calc_conn_data *) ap_get_module_config(r->connection->conn_config, &ipv6calc_module);
+
+	if (conn_data == NULL) {
+		conn_data = apr_pcalloc(r->connection->pool, sizeof(ipv6calc_conn_data));
+		ap_set_module_config(r->connection->conn_config, &ipv6calc_module, conn_data);
+	};
+
+	if (conn_data->config != config) {
+		// (other) virtual host with potentially different actions
+		conn_data->config = config;
+		conn_data->retrieved = 0;
+	};
+
+	return(conn_data);
+};
+
+
+/*
+ * ipv6calc_post_read_request  (ACTION CODE)
+ */
+static int ipv6calc_post_read_request(request_rec *r) {
+	ipv6calc_server_config* config;
+	ipv6calc_conn_data *conn_data;
+
+	// get config	
+	config = (ipv6calc_server_config*) ap_get_module_config(r->server->module_config, &ipv6calc_module);
+
+	// check enabled	
+	if (config->enabled == 0) {
+		return OK;
+	};
+
+	// values are retrieved on access by log format
+	if (config->lazy == 1) {
+		return OK;
 	};
 
+	conn_data = ipv6calc_conn_data_get(r, config);
+
+	if (conn_data->retrieved != IPV6CALC_RETRIEVE_ALL) {
+		ipv6calc_retrieve(r, config, IPV6CALC_RETRIEVE_ALL, &conn_data->retrieved, &conn_data->value);
+
+		if (conn_data->retrieved != IPV6CALC_RETRIEVE_ALL) {
+			// unsupported family, do nothing
+			return OK;
+		};
+	};
+
+	ipv6calc_cache_set_env(r, config, &conn_data->value, "connection");
+
 	return OK;
 };
 
 
+/*
+ * ipv6calc_log_handler  (ACTION CODE, lazy)
+ *  log format %{<name>}Z, name is one of the environment variables set otherwise
+ */
+static const char *ipv6calc_log_handler(request_rec *r, char *a) {
+	ipv6calc_server_config* config;
+	ipv6calc_conn_data *conn_data;
+	int retrieve, action, field;
+
+	config = (ipv6calc_server_config*) ap_get_module_config(r->server->module_config, &ipv6calc_module);
+
+	if (config->enabled == 0) {
+		return NULL;
+	};
+
+	if (strcmp(a, "IPV6CALC_CLIENT_IP_ANON") == 0) {
+		retrieve = IPV6CALC_RETRIEVE_ANON;
+		action = config->action_anonymize;
+		field = 0;
+	} else if (strcmp(a, "IPV6CALC_ANON_METHOD") == 0) {
+		return((config->action_anonymize == 1) ? anon_method_name : "disabled");
+	} else if (strcmp(a, "IPV6CALC_CLIENT_COUNTRYCODE") == 0) {
+		retrieve = IPV6CALC_RETRIEVE_DB;
+		action = config->action_countrycode;
+		field = 1;
+	} else if (strcmp(a, "IPV6CALC_CLIENT_ASN") == 0) {
+		retrieve = IPV6CALC_RETRIEVE_DB;
+		action = config->action_asn;
+		field = 2;
+	} else if (strcmp(a, "IPV6CALC_CLIENT_REGISTRY") == 0) {
+		retrieve = IPV6CALC_RETRIEVE_DB;
+		action = config->action_registry;
+		field = 3;
+	} else {
+		// unsupported
+		return NULL;
+	};
+
+	if (action == 0) {
+		return "disabled";
+	};
+
+	conn_data = ipv6calc_conn_data_get(r, config);
+
+	if ((conn_data->retrieved & retrieve) == 0) {
+		ipv6calc_retrieve(r, config, retrieve, &conn_data->retrieved, &conn_data->value);
+
+		if ((conn_data->retrieved & retrieve) == 0) {
+			// unsupported family
+			return NULL;
+		};
+	};
+
+	switch (field) {
+		case 0:
+			return(conn_data->value.anon);
+		case 1:
+			return(conn_data->value.cc);
+		case 2:
+			return(conn_data->value.asn);
+		default:
+			return(conn_data->value.registry);
+	};
+};
+
+
 /***************************
  * Module config option handlers
  ***************************/
@@ -1156,6 +1806,22 @@ static const char *set_ipv6calc_cache(cmd_parms *cmd, void *dummy, int arg) {
 };
 
 
+/*
+ * set_ipv6calc_lazy
+ */
+static const char *set_ipv6calc_lazy(cmd_parms *cmd, void *dummy, int arg) {
+	ipv6calc_server_config *config = (ipv6calc_server_config*) ap_get_module_config(cmd->server->module_config, &ipv6calc_module);
+	
+	if (!config) {
+		return NULL;
+	};
+	
+	config->lazy = arg;
+	
+	return NULL;
+};
+
+
 /*
  * set_ipv6calc_cache_limit
  */
@@ -1166,20 +1832,20 @@ static const char *set_ipv6calc_cache_limit(cmd_parms *cmd, void *dummy, const c
 		return NULL;
 	};
 
-	if (atoi(value) < IPV6CALC_CACHE_LRI_LIMIT_MIN) {
+	if (atoi(value) < IPV6CALC_CACHE_LIMIT_MIN) {
 		ap_log_error(APLOG_MARK, APLOG_WARNING, 0, cmd->server
 			, "given cache limit below minimum (%d), skip: %s"
-			, IPV6CALC_CACHE_LRI_LIMIT_MIN
+			, IPV6CALC_CACHE_LIMIT_MIN
 			, value
 		);
 
 		return NULL;
 	};
 
-	if (atoi(value) > IPV6CALC_CACHE_LRI_SIZE) {
+	if (atoi(value) > IPV6CALC_CACHE_LIMIT_MAX) {
 		ap_log_error(APLOG_MARK, APLOG_WARNING, 0, cmd->server
-			, "given cache limit below maximum (%d), skip: %s"
-			, IPV6CALC_CACHE_LRI_SIZE
+			, "given cache limit above maximum (%d), skip: %s"
+			, IPV6CALC_CACHE_LIMIT_MAX
 			, value
 		);
 
@@ -1227,6 +1893,48 @@ static const char *set_ipv6calc_cache_statistics_interval(cmd_parms *cmd, void *
 	return NULL;
 };
 
+
+/*
+ * set_ipv6calc_cache_shared
+ */
+static const char *set_ipv6calc_cache_shared(cmd_parms *cmd, void *dummy, const char *value, int arg) {
+	ipv6calc_server_config *config = (ipv6calc_server_config*) ap_get_module_config(cmd->server->module_config, &ipv6calc_module);
+
+	if (!config) {
+		return NULL;
+	};
+
+	if ((atoi(value) != 0) && (atoi(value) < IPV6CALC_CACHE_SHARED_LIMIT_MIN)) {
+		ap_log_error(APLOG_MARK, APLOG_WARNING, 0, cmd->server
+			, "given shared cache entries below minimum (%d), skip: %s"
+			, IPV6CALC_CACHE_SHARED_LIMIT_MIN
+			, value
+		);
+
+		return NULL;
+	};
+
+	if (atoi(value) > IPV6CALC_CACHE_SHARED_LIMIT_MAX) {
+		ap_log_error(APLOG_MARK, APLOG_WARNING, 0, cmd->server
+			, "given shared cache entries above maximum (%d), skip: %s"
+			, IPV6CALC_CACHE_SHARED_LIMIT_MAX
+			, value
+		);
+
+		return NULL;
+	};
+
+	ap_log_error(APLOG_MARK, APLOG_INFO, 0, cmd->server
+		, "set shared cache entries: %s"
+		, value
+	);
+
+	config->cache_shared = atoi(value);
+
+	return NULL;
+};
+
+
 /*
  * set_ipv6calc_debuglevel
  */
@@ -1364,10 +2072,13 @@ static void *ipv6calc_create_svr_conf(apr_pool_t* pool, server_rec* svr) {
 
 	svr_cfg->no_fallback = 0;
 
+	svr_cfg->lazy = 0;
+
 	// cache settings
 	svr_cfg->cache = 1; // default: on
-	svr_cfg->cache_limit = IPV6CALC_CACHE_LRI_LIMIT_MIN; /* optimum ?? */
+	svr_cfg->cache_limit = IPV6CALC_CACHE_LIMIT_DEFAULT;
 	svr_cfg->cache_statistics_interval = 0; // disabled
+	svr_cfg->cache_shared = 0; // disabled
 
 	svr_cfg->debuglevel = 0;
 
@@ -1385,6 +2096,7 @@ static void *ipv6calc_create_svr_conf(apr_pool_t* pool, server_rec* svr) {
  * ipv6calc_register_hooks
  */
 static void ipv6calc_register_hooks(apr_pool_t *p) {
+	ap_hook_pre_config(ipv6calc_pre_config, NULL, NULL, APR_HOOK_MIDDLE);
 	ap_hook_post_config(ipv6calc_post_config, NULL, NULL, APR_HOOK_MIDDLE);
 	ap_hook_child_init(ipv6calc_child_init, NULL, NULL, APR_HOOK_MIDDLE);
 	ap_hook_post_read_request(ipv6calc_post_read_request, NULL, NULL, APR_HOOK_MIDDLE);
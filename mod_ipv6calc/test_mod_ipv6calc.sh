@@ -113,6 +113,8 @@ create_apache_root_and_start() {
 	[ "$action_reg" = "0" ]    && perl -pi -e 's/(ipv6calcActionRegistry\s+).*$/$1 off/g'    $dir_base/conf.d/ipv6calc.conf
 	[ "$action_anon" = "0" ]   && perl -pi -e 's/(ipv6calcActionAnonymize\s+).*$/$1 off/g'   $dir_base/conf.d/ipv6calc.conf
 
+	[ "$cache_shared" = "1" ]  && perl -pi -e 's/#(ipv6calcCacheShared\s+.*)$/$1/g'          $dir_base/conf.d/ipv6calc.conf
+
 
 	echo "INFO  : start httpd with ServerRoot $dir_base"
 	/usr/sbin/httpd -X -e info -d $dir_base &
@@ -306,6 +308,8 @@ $(basename "$0") [<options>] [-S|-K|-W]
 	-R	disable action Registry
 	-N	disable action Anonymization
 
+	-s	enable shared cache
+
 	-b <base directory
 
 	-a <address>	disable autoretrievement of local IP, use given one instead
@@ -314,7 +318,7 @@ END
 }
 
 #### Options
-while getopts "rACRNca:fSKWb:mlgideh\?" opt; do
+while getopts "rACRNsca:fSKWb:mlgideh\?" opt; do
 	case $opt in
 	    b)
 		if [ -d "$OPTARG" ]; then
@@ -371,6 +375,9 @@ while getopts "rACRNca:fSKWb:mlgideh\?" opt; do
 	    N)
 		action_anon="0"
 		;;
+	    s)
+		cache_shared=1
+		;;
 	    r)
 		repeat=1
 		;;
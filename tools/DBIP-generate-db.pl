@@ -26,9 +26,18 @@ use Net::IP;
 use Text::CSV_PP;
 use Data::Dumper;
 
+# create binary database row (dbformat=2, see databases/lib/libipv6calc_db_wrapper.h)
+#  marker 0x00, number of 32-bit keys, flags (0x01: value), offset of data, keys and value (network byte order), data
+sub db_row_binary {
+	my ($value, $data, @keys) = @_;
+	my $flags = (defined $value) ? 0x01 : 0x00;
+	my $offset = 4 + 4 * (scalar(@keys) + ((defined $value) ? 1 : 0));
+	return pack("CCCCN*", 0x00, scalar(@keys), $flags, $offset, @keys, ((defined $value) ? ($value) : ())) . $data;
+};
+
 
 my %opts;
-getopts ("s:qdAS:O:I:h?", \%opts);
+getopts ("s:qdATS:O:I:h?", \%opts);
 
 my $file_input;
 my $dir_output = ".";
@@ -40,13 +49,14 @@ my $line_start = 0;
 
 if (defined $opts{'h'} || defined $opts{'?'}) {
         print qq|
-Usage:  PROGNAME -I <input file> [-O <output directory>] [-S <suffix>] [-A]
+Usage:  PROGNAME -I <input file> [-O <output directory>] [-S <suffix>] [-A] [-T]
 
 Options:
         -I <input file>        DB-IP.com CSV input file (support also csv.gz)
         -O <output directory>  optional output directory for DB files, default: .
         -S <suffix>            optional suffix
         -A                     atomic operation (generate .new and move on success)
+        -T                     create text rows (dbformat=1, for older versions)
         -d                     debug
         -s <line>              start from given line number (diagnostics)
         -q                     quiet
@@ -170,7 +180,7 @@ tie %h_info4, 'BerkeleyDB::Btree', -Filename => $filename_ipv4, -Subname => 'inf
 tie %h_info6, 'BerkeleyDB::Btree', -Filename => $filename_ipv6, -Subname => 'info', -Flags => DB_CREATE, -Mode => 0644 || die "Cannot open file $filename_ipv6: $! $BerkeleyDB::Error\n";
 
 $h_info4{'dbusage'} = "ipv6calc";
-$h_info4{'dbformat'} = "1"; # ';' separated values
+$h_info4{'dbformat'} = (defined $opts{'T'}) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 $h_info4{'dbdate'} = $date;
 $h_info4{'dbtype'} = $type + 4;
 $h_info4{'dbproto'} = '4';
@@ -178,7 +188,7 @@ $h_info4{'dbcreated'} = $now_string;
 $h_info4{'dbcreated_unixtime'} = time;
 
 $h_info6{'dbusage'} = "ipv6calc";
-$h_info6{'dbformat'} = "1"; # ';' separated values
+$h_info6{'dbformat'} = (defined $opts{'T'}) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 $h_info6{'dbdate'} = $date;
 $h_info6{'dbtype'} = $type + 6;
 $h_info6{'dbproto'} = '6';
@@ -372,7 +382,11 @@ while (<$FILE>) {
 
 		print "INFO : IPv4: $start " . sprintf("(%08x)", $start_value) . " $end " . sprintf("(%08x)", $end_value) . " $data\n" if (defined $opts{'d'});
 
-		push @a_ipv4, sprintf("%08x", $start_value) . ";" . sprintf("%08x", $end_value) . ";" . $data;
+		if (defined $opts{'T'}) {
+			push @a_ipv4, sprintf("%08x", $start_value) . ";" . sprintf("%08x", $end_value) . ";" . $data;
+		} else {
+			push @a_ipv4, db_row_binary(undef, $data, $start_value, $end_value);
+		};
 	} else {
 		$counter_ipv6++;
 
@@ -390,7 +404,11 @@ while (<$FILE>) {
 
 		print "INFO : IPv6: $start " . sprintf("(%08x:%08x)", hex($start_value_0_15), hex($start_value_16_31)) . " $end " . sprintf("(%08x:%08x)", hex($end_value_0_15), hex($end_value_16_31)) . " $data\n" if (defined $opts{'d'});
 
-		push @a_ipv6, $start_value_0_15 . ";" . $start_value_16_31 . ";" . $end_value_0_15 . ";" . $end_value_16_31 . ";" . $data;
+		if (defined $opts{'T'}) {
+			push @a_ipv6, $start_value_0_15 . ";" . $start_value_16_31 . ";" . $end_value_0_15 . ";" . $end_value_16_31 . ";" . $data;
+		} else {
+			push @a_ipv6, db_row_binary(undef, $data, hex($start_value_0_15), hex($start_value_16_31), hex($end_value_0_15), hex($end_value_16_31));
+		};
 	};
 
 };
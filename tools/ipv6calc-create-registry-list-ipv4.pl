@@ -35,12 +35,13 @@ my $debug = 0;
 
 sub help {
 	print qq|
-Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A]] [-d <debuglevel>]
+Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A] [-T]] [-d <debuglevel>]
 	-S <SRC-DIR>	source directory
 	-D <DST-DIR>	destination directory
 	-H		create header file(s)
 	-B		create Berkeley DB file(s)
 	-A		atomic operation (generate .new and move on success)
+	-T		create Berkeley DB file(s) with text rows (dbformat=1, for older versions)
 	-d <debuglevel> debug level
 	-h		this online help
 
@@ -49,8 +50,8 @@ Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A]] [-d <debuglevel>]
 };
 
 # parse options
-our ($opt_h, $opt_S, $opt_D, $opt_B, $opt_H, $opt_A, $opt_d);
-getopts('d:hS:D:BHA') || help();
+our ($opt_h, $opt_S, $opt_D, $opt_B, $opt_H, $opt_A, $opt_T, $opt_d);
+getopts('d:hS:D:BHAT') || help();
 
 if (defined $opt_h) {
 	help();
@@ -135,6 +136,15 @@ my %date_created;
 
 
 # convert a dotted IPv4 address into 32-bit decimal
+# create binary database row (dbformat=2, see databases/lib/libipv6calc_db_wrapper.h)
+#  marker 0x00, number of 32-bit keys, flags (0x01: value), offset of data, keys and value (network byte order), data
+sub db_row_binary {
+	my ($value, $data, @keys) = @_;
+	my $flags = (defined $value) ? 0x01 : 0x00;
+	my $offset = 4 + 4 * (scalar(@keys) + ((defined $value) ? 1 : 0));
+	return pack("CCCCN*", 0x00, scalar(@keys), $flags, $offset, @keys, ((defined $value) ? ($value) : ())) . $data;
+};
+
 sub ipv4_to_dec {
 	my $ipv4 = shift || die "Missing IPv4 address";
 
@@ -603,7 +613,7 @@ if (defined $opt_B) {
 	tie %h_ipv4_info, 'BerkeleyDB::Btree', -Filename => $file_dst_db_reg, -Subname => 'info', -Flags => DB_CREATE, -Mode => 0644 || die "Cannot open file $file_dst_db_reg: $! $BerkeleyDB::Error\n";
 
 	$h_ipv4_info{'dbusage'} = "ipv6calc";
-	$h_ipv4_info{'dbformat'} = "1"; # ';' separated values
+	$h_ipv4_info{'dbformat'} = (defined $opt_T) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 	$h_ipv4_info{'dbdate'} = $date;
 	$h_ipv4_info{'dbtype'} = $type;
 	$h_ipv4_info{'dbcreated'} = $now_string;
@@ -621,7 +631,11 @@ if (defined $opt_B) {
 		my $distance = $assignments{$ipv4}->{'distance'};
 		my $registry = $assignments{$ipv4}->{'registry'};
 
-		push @a_ipv4, sprintf("%08x;%08x;%s",$ipv4, ($ipv4 + $distance - 1), "REGISTRY_" . $registry);
+		if (defined $opt_T) {
+			push @a_ipv4, sprintf("%08x;%08x;%s",$ipv4, ($ipv4 + $distance - 1), "REGISTRY_" . $registry);
+		} else {
+			push @a_ipv4, db_row_binary(undef, "REGISTRY_" . $registry, $ipv4, ($ipv4 + $distance - 1));
+		};
 	};
 
 	untie @a_ipv4;
@@ -636,7 +650,11 @@ if (defined $opt_B) {
 		my $distance = $assignments_iana{$ipv4}->{'distance'};
 		my $registry = $assignments_iana{$ipv4}->{'registry'};
 
-		push @a_ipv4_iana, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), "REGISTRY_" . $registry);
+		if (defined $opt_T) {
+			push @a_ipv4_iana, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), "REGISTRY_" . $registry);
+		} else {
+			push @a_ipv4_iana, db_row_binary(undef, "REGISTRY_" . $registry, $ipv4, ($ipv4 + $distance - 1));
+		};
 	};
 
 	untie @a_ipv4_iana;
@@ -651,7 +669,11 @@ if (defined $opt_B) {
 		my $distance = $assignments_info{$ipv4}->{'distance'};
 		my $info = $assignments_info{$ipv4}->{'info'};
 
-		push @a_ipv4_info, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), $info);
+		if (defined $opt_T) {
+			push @a_ipv4_info, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), $info);
+		} else {
+			push @a_ipv4_info, db_row_binary(undef, $info, $ipv4, ($ipv4 + $distance - 1));
+		};
 	};
 
 	untie @a_ipv4_info;
@@ -677,7 +699,7 @@ if (defined $opt_B) {
 	$type = "2034"; # External IPv4->CountryCode
 	$date = $string;
 	$now_string = strftime "%Y%m%d-%H%M%S%z", gmtime;
-	my $info = "dbusage=ipv6calc;dbformat=1;dbdate=$date;dbtype=" . $type . ";dbproto=4;dbcreated=$now_string";
+	my $info = "dbusage=ipv6calc;dbformat=" . ((defined $opt_T) ? "1" : "2") . ";dbdate=$date;dbtype=" . $type . ";dbproto=4;dbcreated=$now_string";
 
 	if (defined $opt_A) {
 		$file_dst_db_cc_orig = $file_dst_db_cc;
@@ -695,7 +717,7 @@ if (defined $opt_B) {
 	tie %h_info, 'BerkeleyDB::Btree', -Filename => $file_dst_db_cc, -Subname => 'info', -Flags => DB_CREATE, -Mode => 0644 || die "Cannot open file $file_dst_db_cc: $! $BerkeleyDB::Error\n";
 
 	$h_info{'dbusage'} = "ipv6calc";
-	$h_info{'dbformat'} = "1"; # ';' separated values
+	$h_info{'dbformat'} = (defined $opt_T) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 	$h_info{'dbdate'} = $date;
 	$h_info{'dbtype'} = $type;
 	$h_info{'dbcreated'} = $now_string;
@@ -712,7 +734,11 @@ if (defined $opt_B) {
 		my $distance = $ip_countrycode{$ipv4}->{'distance'};
 		my $cc = $ip_countrycode{$ipv4}->{'cc'};
 
-		push @a, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), $cc);
+		if (defined $opt_T) {
+			push @a, sprintf("%08x;%08x;%s", $ipv4, ($ipv4 + $distance - 1), $cc);
+		} else {
+			push @a, db_row_binary(undef, $cc, $ipv4, ($ipv4 + $distance - 1));
+		};
 	};
 
 	untie @a;
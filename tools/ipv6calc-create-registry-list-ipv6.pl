@@ -41,12 +41,13 @@ my $debug = 0;
 
 sub help {
 	print qq|
-Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A]] [-d <debuglevel>]
+Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A] [-T]] [-d <debuglevel>]
 	-S <SRC-DIR>	source directory
 	-D <DST-DIR>	destination directory
 	-H		create header file(s)
 	-B		create Berkeley DB file(s)
 	-A		atomic operation (generate .new and move on success)
+	-T		create Berkeley DB file(s) with text rows (dbformat=1, for older versions)
 	-d <debuglevel> debug level
 	-h		this online help
 
@@ -55,8 +56,8 @@ Usage: $progname [-S <SRC-DIR>] [-D <DST-DIR>] [-H] [-B [-A]] [-d <debuglevel>]
 };
 
 ## parse options
-our ($opt_h, $opt_S, $opt_D, $opt_B, $opt_H, $opt_A, $opt_d);
-getopts('d:hS:D:BHA') || help();
+our ($opt_h, $opt_S, $opt_D, $opt_B, $opt_H, $opt_A, $opt_T, $opt_d);
+getopts('d:hS:D:BHAT') || help();
 
 if (defined $opt_h) {
 	help();
@@ -459,6 +460,15 @@ my %data;
 my %data_cc;
 my %data_info;
 
+# create binary database row (dbformat=2, see databases/lib/libipv6calc_db_wrapper.h)
+#  marker 0x00, number of 32-bit keys, flags (0x01: value), offset of data, keys and value (network byte order), data
+sub db_row_binary {
+	my ($value, $data, @keys) = @_;
+	my $flags = (defined $value) ? 0x01 : 0x00;
+	my $offset = 4 + 4 * (scalar(@keys) + ((defined $value) ? 1 : 0));
+	return pack("CCCCN*", 0x00, scalar(@keys), $flags, $offset, @keys, ((defined $value) ? ($value) : ())) . $data;
+};
+
 sub fill_data {
 	my $parray = shift || die "missing array pointer";
 	my $reg = shift || die "missing registry";
@@ -599,7 +609,7 @@ if (defined $opt_B) {
 	# external database
 	my $type = "2026"; # External IPv6->Registry
 	my $date = $string;
-	my $info = "dbusage=ipv6calc;dbformat=1;dbdate=$date;dbtype=" . $type . ";dbproto=6;dbcreated=$now_string";
+	my $info = "dbusage=ipv6calc;dbformat=" . ((defined $opt_T) ? "1" : "2") . ";dbdate=$date;dbtype=" . $type . ";dbproto=6;dbcreated=$now_string";
 
 	if (defined $opt_A) {
 		$file_dst_db_reg_orig = $file_dst_db_reg;
@@ -617,7 +627,7 @@ if (defined $opt_B) {
 	tie %h_info, 'BerkeleyDB::Btree', -Filename => $file_dst_db_reg, -Subname => 'info', -Flags => DB_CREATE, -Mode => 0644 || die "Cannot open file $file_dst_db_reg: $! $BerkeleyDB::Error\n";
 
 	$h_info{'dbusage'} = "ipv6calc";
-	$h_info{'dbformat'} = "1"; # ';' separated values
+	$h_info{'dbformat'} = (defined $opt_T) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 	$h_info{'dbdate'} = $date;
 	$h_info{'dbtype'} = $type;
 	$h_info{'dbcreated'} = $now_string;
@@ -632,7 +642,11 @@ if (defined $opt_B) {
 	tie @a, 'BerkeleyDB::Recno', -Filename => $file_dst_db_reg, -Subname => 'data', -Flags => DB_CREATE || die "Cannot open file $file_dst_db_reg: $! $BerkeleyDB::Error\n";
 
 	foreach my $ipv6 (sort keys %data) {
-		push @a, sprintf("%s;%s;%s;%s;%d;REGISTRY_%s", $data{$ipv6}->{'ipv6_00_31'}, $data{$ipv6}->{'ipv6_32_63'}, $data{$ipv6}->{'mask_00_31'}, $data{$ipv6}->{'mask_32_63'}, $data{$ipv6}->{'mask_length'}, $data{$ipv6}->{'reg'});
+		if (defined $opt_T) {
+			push @a, sprintf("%s;%s;%s;%s;%d;REGISTRY_%s", $data{$ipv6}->{'ipv6_00_31'}, $data{$ipv6}->{'ipv6_32_63'}, $data{$ipv6}->{'mask_00_31'}, $data{$ipv6}->{'mask_32_63'}, $data{$ipv6}->{'mask_length'}, $data{$ipv6}->{'reg'});
+		} else {
+			push @a, db_row_binary($data{$ipv6}->{'mask_length'}, "REGISTRY_" . $data{$ipv6}->{'reg'}, hex($data{$ipv6}->{'ipv6_00_31'}), hex($data{$ipv6}->{'ipv6_32_63'}), hex($data{$ipv6}->{'mask_00_31'}), hex($data{$ipv6}->{'mask_32_63'}));
+		};
 	};
 
 	untie @a;
@@ -642,7 +656,11 @@ if (defined $opt_B) {
 	tie @a, 'BerkeleyDB::Recno', -Filename => $file_dst_db_reg, -Subname => 'data-info', -Flags => DB_CREATE || die "Cannot open file $file_dst_db_reg: $! $BerkeleyDB::Error\n";
 
 	foreach my $ipv6 (sort keys %data_info) {
-		push @a, sprintf("%s;%s;%s;%s;%s", $data_info{$ipv6}->{'ipv6_00_31'}, $data_info{$ipv6}->{'ipv6_32_63'}, $data_info{$ipv6}->{'mask_00_31'}, $data_info{$ipv6}->{'mask_32_63'}, $data_info{$ipv6}->{'reg'});
+		if (defined $opt_T) {
+			push @a, sprintf("%s;%s;%s;%s;%s", $data_info{$ipv6}->{'ipv6_00_31'}, $data_info{$ipv6}->{'ipv6_32_63'}, $data_info{$ipv6}->{'mask_00_31'}, $data_info{$ipv6}->{'mask_32_63'}, $data_info{$ipv6}->{'reg'});
+		} else {
+			push @a, db_row_binary(undef, $data_info{$ipv6}->{'reg'}, hex($data_info{$ipv6}->{'ipv6_00_31'}), hex($data_info{$ipv6}->{'ipv6_32_63'}), hex($data_info{$ipv6}->{'mask_00_31'}), hex($data_info{$ipv6}->{'mask_32_63'}));
+		};
 	};
 
 	untie @a;
@@ -667,7 +685,7 @@ if (defined $opt_B) {
 	# external database
 	$type = "2036"; # External IPv6->CountryCode
 	$date = $string;
-	$info = "dbusage=ipv6calc;dbformat=1;dbdate=$date;dbtype=" . $type . ";dbproto=6;dbcreated=$now_string";
+	$info = "dbusage=ipv6calc;dbformat=" . ((defined $opt_T) ? "1" : "2") . ";dbdate=$date;dbtype=" . $type . ";dbproto=6;dbcreated=$now_string";
 
 	if (defined $opt_A) {
 		$file_dst_db_cc_orig = $file_dst_db_cc;
@@ -681,7 +699,7 @@ if (defined $opt_B) {
 	tie %h_info, 'BerkeleyDB::Btree', -Filename => $file_dst_db_cc, -Subname => 'info', -Flags => DB_CREATE, -Mode => 0644 || die "Cannot open file $file_dst_db_cc: $! $BerkeleyDB::Error\n";
 
 	$h_info{'dbusage'} = "ipv6calc";
-	$h_info{'dbformat'} = "1"; # ';' separated values
+	$h_info{'dbformat'} = (defined $opt_T) ? "1" : "2"; # 1: ';' separated values, 2: binary rows
 	$h_info{'dbdate'} = $date;
 	$h_info{'dbtype'} = $type;
 	$h_info{'dbcreated'} = $now_string;
@@ -694,7 +712,11 @@ if (defined $opt_B) {
 	tie @a, 'BerkeleyDB::Recno', -Filename => $file_dst_db_cc, -Subname => 'data', -Flags => DB_CREATE || die "Cannot open file $file_dst_db_cc: $! $BerkeleyDB::Error\n";
 
 	foreach my $ipv6 (sort keys %data_cc) {
-		push @a, sprintf("%s;%s;%s;%s;%s", $data_cc{$ipv6}->{'ipv6_00_31'}, $data_cc{$ipv6}->{'ipv6_32_63'}, $data_cc{$ipv6}->{'mask_00_31'}, $data_cc{$ipv6}->{'mask_32_63'}, $data_cc{$ipv6}->{'reg'});
+		if (defined $opt_T) {
+			push @a, sprintf("%s;%s;%s;%s;%s", $data_cc{$ipv6}->{'ipv6_00_31'}, $data_cc{$ipv6}->{'ipv6_32_63'}, $data_cc{$ipv6}->{'mask_00_31'}, $data_cc{$ipv6}->{'mask_32_63'}, $data_cc{$ipv6}->{'reg'});
+		} else {
+			push @a, db_row_binary(undef, $data_cc{$ipv6}->{'reg'}, hex($data_cc{$ipv6}->{'ipv6_00_31'}), hex($data_cc{$ipv6}->{'ipv6_32_63'}), hex($data_cc{$ipv6}->{'mask_00_31'}), hex($data_cc{$ipv6}->{'mask_32_63'}));
+		};
 	};
 
 	untie @a;
@@ -0,0 +1,166 @@
+#!/usr/bin/perl -W
+#
+# Perl converter for ipv6calc proprietary Berkeley DB files (External, DB-IP.com)
+#  into ipv6calc compiled database files (memory mapped by the database wrapper)
+#
+# Project    : ipv6calc
+# File       : ipv6calc-db-compile.pl
+# Version    : $Id$
+# License    : GNU GPL version 2
+#
+# File layout: see databases/lib/libipv6calc_db_wrapper.h (IPV6CALC_DB_MMAP_*)
+
+use strict;
+use warnings;
+
+use Getopt::Std;
+use BerkeleyDB;
+use File::Basename;
+
+my $MAGIC = "IP6CDBM\0";
+my $VERSION = 1;
+my $HEADER_SIZE = 32;
+my $SECTION_SIZE = 48;
+my $FLAG_VALUE = 0x01;
+
+my %opts;
+getopts ("O:dqh?", \%opts);
+
+if (defined $opts{'h'} || defined $opts{'?'} || scalar(@ARGV) == 0) {
+        print qq|
+Usage:  PROGNAME [-O <output directory>] [-q] [-d] <db file> [<db file> ...]
+
+Converts ipv6calc Berkeley DB files (External, DB-IP.com) into compiled
+database files (<db file>m), which are used by ipv6calc instead of
+the Berkeley DB data if available and matching the creation time.
+
+Options:
+        -O <output directory>  optional output directory, default: directory of db file
+        -d                     debug
+        -q                     quiet
+|;
+        exit 0;
+};
+
+my $debug = defined $opts{'d'} ? 1 : 0;
+my $quiet = defined $opts{'q'} ? 1 : 0;
+
+
+# string pool, identical strings are stored once
+my $pool;
+my %pool_offset;
+
+sub pool_add($) {
+	my $string = shift;
+
+	if (! defined $pool_offset{$string}) {
+		$pool_offset{$string} = length($pool);
+		$pool .= $string . "\0";
+	};
+
+	return $pool_offset{$string};
+};
+
+
+# parse a Berkeley DB row (binary dbformat=2 or ';' separated hex text dbformat=1)
+#  returns (value or undef, data, keys)
+sub row_parse($$$) {
+	my ($row, $keys, $value_expected) = @_;
+
+	if (substr($row, 0, 1) eq "\0") {
+		my ($marker, $nkeys, $flags, $offset) = unpack("CCCC", $row);
+		my @words = unpack("N*", substr($row, 4, $offset - 4));
+		my $value = (($flags & $FLAG_VALUE) != 0) ? pop(@words) : undef;
+		die "unexpected number of keys in binary row: $nkeys (expected: $keys)\n" if ($nkeys != $keys);
+		return ($value, substr($row, $offset), @words);
+	};
+
+	my @fields = split(/;/, $row, $keys + $value_expected + 1);
+	die "unexpected number of fields in text row: $row\n" if (scalar(@fields) != $keys + $value_expected + 1);
+	my @words = map { hex($_) } @fields[0 .. $keys - 1];
+	my $value = ($value_expected != 0) ? int($fields[$keys]) : undef;
+	return ($value, $fields[$keys + $value_expected], @words);
+};
+
+
+sub compile_file($) {
+	my $file_input = shift;
+
+	my $file_output = $file_input . "m";
+	if (defined $opts{'O'}) {
+		$file_output = $opts{'O'} . "/" . basename($file_input) . "m";
+	};
+
+	my $keys = (basename($file_input) =~ /-ipv6-/) ? 4 : 2;
+
+	$pool = "\0";
+	%pool_offset = ();
+
+	my @sections;
+
+	# info
+	my %h_info;
+	tie %h_info, 'BerkeleyDB::Btree', -Filename => $file_input, -Subname => 'info', -Flags => DB_RDONLY or die "Cannot open file $file_input (info): $! $BerkeleyDB::Error\n";
+	my @info_strings = map { pool_add($_ . "=" . $h_info{$_}) } sort keys %h_info;
+	untie %h_info;
+
+	push @sections, { name => 'info', rows => scalar(@info_strings), keys => 0, flags => 0, keys_data => "", values_data => "", strings_data => pack("N*", @info_strings) };
+
+	# data, data-iana, data-info
+	for my $subname ('data', 'data-iana', 'data-info') {
+		my @a_data;
+		tie @a_data, 'BerkeleyDB::Recno', -Filename => $file_input, -Subname => $subname, -Flags => DB_RDONLY or next;
+
+		# IPv6 registry data contains prefix length as value (longest match)
+		my $value_expected = (($subname eq 'data') && (basename($file_input) =~ /-ipv6-registry/)) ? 1 : 0;
+
+		my ($keys_data, $values_data, $strings_data) = ("", "", "");
+		my $rows = 0;
+
+		for my $row (@a_data) {
+			my ($value, $data, @words) = row_parse($row, $keys, $value_expected);
+			$keys_data .= pack("N*", @words);
+			$values_data .= pack("N", $value) if ($value_expected != 0);
+			$strings_data .= pack("N", pool_add($data));
+			$rows++;
+		};
+
+		untie @a_data;
+
+		print STDERR "Section $subname: rows=$rows keys=$keys value=$value_expected\n" if ($debug == 1);
+
+		push @sections, { name => $subname, rows => $rows, keys => $keys, flags => ($value_expected != 0) ? $FLAG_VALUE : 0, keys_data => $keys_data, values_data => $values_data, strings_data => $strings_data };
+	};
+
+	# layout
+	my $offset = $HEADER_SIZE + $SECTION_SIZE * scalar(@sections);
+	my ($table, $arrays) = ("", "");
+
+	for my $section (@sections) {
+		my $keys_offset = $offset;
+		$offset += length($section->{'keys_data'});
+		my $values_offset = (length($section->{'values_data'}) > 0) ? $offset : 0;
+		$offset += length($section->{'values_data'});
+		my $strings_offset = $offset;
+		$offset += length($section->{'strings_data'});
+
+		$table .= pack("a16N8", $section->{'name'}, $section->{'rows'}, $section->{'keys'}, $section->{'flags'}, $keys_offset, $values_offset, $strings_offset, 0, 0);
+		$arrays .= $section->{'keys_data'} . $section->{'values_data'} . $section->{'strings_data'};
+	};
+
+	my $header = $MAGIC . pack("N6", $VERSION, scalar(@sections), $offset, length($pool), 0, 0);
+
+	open(my $fh, ">", $file_output . ".new") or die "Cannot create file $file_output.new: $!\n";
+	binmode($fh);
+	print $fh $header . $table . $arrays . $pool;
+	close($fh) or die "Cannot write file $file_output.new: $!\n";
+
+	rename($file_output . ".new", $file_output) or die "Cannot rename file $file_output.new: $!\n";
+
+	print "Compiled database created: $file_output (sections=" . scalar(@sections) . " size=" . ($offset + length($pool)) . ")\n" if ($quiet == 0);
+};
+
+
+for my $file (@ARGV) {
+	compile_file($file);
+};